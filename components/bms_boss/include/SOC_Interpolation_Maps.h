@@ -32,6 +32,7 @@ static lib_interpolation_mapping_S SOC_OCV_FUNC = {
     .number_points  = COUNTOF(SOC_OCVMap),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_OCVMap)),
 };
 
 static lib_interpolation_point_S   OCV_SOCMap[] = {
@@ -53,6 +54,7 @@ static lib_interpolation_mapping_S OCV_SOC_FUNC = {
     .number_points  = COUNTOF(OCV_SOCMap),
     .saturate_left  = true,
     .saturate_right = true,
+    .search         = LIB_INTERPOLATION_SEARCH_BINARY,
 };
 
 static lib_interpolation_point_S   SOC_dOCVMap[] = {
@@ -74,6 +76,7 @@ static lib_interpolation_mapping_S SOC_dOCV_FUNC = {
     .number_points  = COUNTOF(SOC_dOCVMap),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_dOCVMap)),
 };
 
 static lib_interpolation_point_S   SOC_Ri_Discharge_Map[] = {
@@ -95,6 +98,7 @@ static lib_interpolation_mapping_S SOC_Ri_DISCHARGE_FUNC = {
     .number_points  = COUNTOF(SOC_Ri_Discharge_Map),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_Ri_Discharge_Map)),
 };
 
 static lib_interpolation_point_S   SOC_R1_Discharge_Map[] = {
@@ -116,6 +120,7 @@ static lib_interpolation_mapping_S SOC_R1_DISCHARGE_FUNC = {
     .number_points  = COUNTOF(SOC_R1_Discharge_Map),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_R1_Discharge_Map)),
 };
 
 static lib_interpolation_point_S   SOC_C1_Discharge_Map[] = {
@@ -137,6 +142,7 @@ static lib_interpolation_mapping_S SOC_C1_DISCHARGE_FUNC = {
     .number_points  = COUNTOF(SOC_C1_Discharge_Map),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_C1_Discharge_Map)),
 };
 
 static lib_interpolation_point_S   SOC_R2_Discharge_Map[] = {
@@ -158,6 +164,7 @@ static lib_interpolation_mapping_S SOC_R2_DISCHARGE_FUNC = {
     .number_points  = COUNTOF(SOC_R2_Discharge_Map),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_R2_Discharge_Map)),
 };
 
 static lib_interpolation_point_S   SOC_C2_Discharge_Map[] = {
@@ -179,6 +186,7 @@ static lib_interpolation_mapping_S SOC_C2_DISCHARGE_FUNC = {
     .number_points  = COUNTOF(SOC_C2_Discharge_Map),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_C2_Discharge_Map)),
 };
 
 static lib_interpolation_point_S   SOC_Ri_Charge_Map[] = {
@@ -200,6 +208,7 @@ static lib_interpolation_mapping_S SOC_Ri_CHARGE_FUNC = {
     .number_points  = COUNTOF(SOC_Ri_Charge_Map),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_Ri_Charge_Map)),
 };
 
 static lib_interpolation_point_S   SOC_R1_Charge_Map[] = {
@@ -221,6 +230,7 @@ static lib_interpolation_mapping_S SOC_R1_CHARGE_FUNC = {
     .number_points  = COUNTOF(SOC_R1_Charge_Map),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_R1_Charge_Map)),
 };
 
 static lib_interpolation_point_S   SOC_R2_Charge_Map[] = {
@@ -242,6 +252,7 @@ static lib_interpolation_mapping_S SOC_R2_CHARGE_FUNC = {
     .number_points  = COUNTOF(SOC_R2_Charge_Map),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_R2_Charge_Map)),
 };
 
 static lib_interpolation_point_S   SOC_C1_Charge_Map[] = {
@@ -263,6 +274,7 @@ static lib_interpolation_mapping_S SOC_C1_CHARGE_FUNC = {
     .number_points  = COUNTOF(SOC_C1_Charge_Map),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_C1_Charge_Map)),
 };
 
 static lib_interpolation_point_S   SOC_C2_Charge_Map[] = {
@@ -284,4 +296,5 @@ static lib_interpolation_mapping_S SOC_C2_CHARGE_FUNC = {
     .number_points  = COUNTOF(SOC_C2_Charge_Map),
     .saturate_left  = true,
     .saturate_right = true,
+    LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNTOF(SOC_C2_Charge_Map)),
 };
\ No newline at end of file
@@ -31,13 +31,6 @@
 
 MAX_S max_chip;
 
-/******************************************************************************
- *          P R I V A T E  F U N C T I O N  P R O T O T Y P E S
- ******************************************************************************/
-
-void MAX_translateConfig(MAX_config_S* config, uint8_t* data);
-void MAX_decodeResponse(MAX_response_S* chip, uint8_t* data);
-
 /******************************************************************************
  *                       P U B L I C  F U N C T I O N S
  ******************************************************************************/
@@ -82,7 +75,7 @@ bool MAX_readWriteToChip(void)
         return false;
     }
 
-    uint8_t data[3] = { 0x00 };
+    uint8_t data[MAX_FRAME_LENGTH] = { 0x00 };
 
     MAX_translateConfig(&max_chip.config, (uint8_t*)&data);
     HW_SPI_transmitReceive(max_chip.dev, (uint8_t*)&data, sizeof(data));
@@ -108,10 +101,6 @@ void MAX_setOutputCell(MAX_selectedCell_E cell)
     MAX_readWriteToChip();
 }
 
-/******************************************************************************
- *                     P R I V A T E  F U N C T I O N S
- ******************************************************************************/
-
 /**
  * @brief  Translate MAX1492* configuration to message frame
  *
@@ -180,7 +169,7 @@ void MAX_translateConfig(MAX_config_S* config, uint8_t* data)
     }
     data[2] |= (config->low_power_mode) ? 1 << 7 : 0;
 
-    for (uint8_t i = 0; i < 3U; i++)
+    for (uint8_t i = 0; i < MAX_FRAME_LENGTH; i++)
     {
         /**< Bits must be reversed because SPI bus transmits MSB first whereas MAX takes LSB first */
         data[i] = reverse_byte(data[i]);
@@ -195,7 +184,7 @@ void MAX_translateConfig(MAX_config_S* config, uint8_t* data)
  */
 void MAX_decodeResponse(MAX_response_S* chip, uint8_t* data)
 {
-    for (uint8_t i = 0; i < 3U; i++)
+    for (uint8_t i = 0; i < MAX_FRAME_LENGTH; i++)
     {
         /**< Bits must be reversed because SPI bus transmits MSB first whereas MAX takes LSB first */
         data[i] = reverse_byte(data[i]);
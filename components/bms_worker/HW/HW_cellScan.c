@@ -0,0 +1,355 @@
+/**
+ * @file HW_cellScan.c
+ * @brief  Source code for the timer driven MAX14921 cell scan
+ *
+ * Reads every cell of the segment in one burst paced by TIM3, instead of one
+ * cell per 1kHz tick. The MAX14921 only switches its output when chip select
+ * rises at the end of a frame, so at each step the frame selecting the next cell
+ * is handed to the SPI DMA first, and the current cell is then read from the
+ * newest conversions in the ADC DMA buffer while that frame is still shifting.
+ *
+ * The bus is locked for the whole burst and chip select is driven here for each
+ * frame, since HW_SPI_lock() can't be called from an ISR.
+ */
+
+/******************************************************************************
+ *                             I N C L U D E S
+ ******************************************************************************/
+
+// System Includes
+#include "string.h"
+
+// Firmware Includes
+#include "HW.h"
+#include "HW_adc.h"
+#include "HW_cellScan.h"
+#include "HW_gpio.h"
+#include "HW_spi.h"
+#include "HW_tim.h"
+
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+#define SCAN_SPI_PORT    (&HW_spi_ports[HW_spi_devices[max_chip.dev].port])
+#define SCAN_NCS_PIN     (HW_spi_devices[max_chip.dev].ncs_pin)
+#define SCAN_TIMER       (&htim[HW_TIM_PORT_CELL_SCAN])
+
+/******************************************************************************
+ *                              E X T E R N S
+ ******************************************************************************/
+
+extern MAX_S max_chip;
+
+/******************************************************************************
+ *                         P R I V A T E  V A R S
+ ******************************************************************************/
+
+static struct
+{
+    volatile HW_cellScan_state_E state;
+    volatile bool                frame_busy;
+
+    uint8_t                      frames[MAX_CELL_COUNT - 1U][MAX_FRAME_LENGTH];    /**< frames[i] selects cell first_cell - 1 - i */
+    uint8_t                      response[MAX_FRAME_LENGTH];
+    uint8_t                      frame_count;
+    uint8_t                      next_frame;
+    MAX_selectedCell_E           cell;                                             /**< Cell on the MAX output, read at the next step */
+    MAX_selectedCell_E           frame_cell;                                       /**< Cell selected by the frame in flight */
+    uint16_t                     counts[MAX_CELL_COUNT];
+
+    uint32_t                     start_cycles;
+    uint16_t                     latency_min_us;
+    uint16_t                     latency_max_us;
+    HW_cellScan_stats_S          stats;
+} scan;
+
+/******************************************************************************
+ *                     P R I V A T E  F U N C T I O N S
+ ******************************************************************************/
+
+/**
+ * @brief  SPI RX DMA completion. Raising chip select latches the frame and moves
+ *         the MAX output to the cell it selects
+ *
+ * @param hdma DMA channel
+ */
+static void frameComplete(DMA_HandleTypeDef* hdma)
+{
+    UNUSED(hdma);
+
+    while (LL_SPI_IsActiveFlag_BSY(SCAN_SPI_PORT->handle))
+    {
+        ;
+    }
+
+    LL_SPI_DisableDMAReq_RX(SCAN_SPI_PORT->handle);
+    LL_SPI_DisableDMAReq_TX(SCAN_SPI_PORT->handle);
+    HW_GPIO_writePin(SCAN_NCS_PIN, true);
+
+    max_chip.config.output.output.cell = scan.frame_cell;
+    scan.frame_busy                    = false;
+
+    if (scan.state != HW_CELLSCAN_RUNNING)
+    {
+        // the burst was abandoned while this frame was shifting
+        HW_SPI_release(max_chip.dev);
+    }
+}
+
+/**
+ * @brief  SPI DMA error on either channel. Abandons the burst, the frame may have
+ *         been partly shifted so the MAX output is no longer known
+ *
+ * @param hdma DMA channel
+ */
+static void frameError(DMA_HandleTypeDef* hdma)
+{
+    UNUSED(hdma);
+
+    HAL_TIM_Base_Stop_IT(SCAN_TIMER);
+    HAL_DMA_Abort(SCAN_SPI_PORT->rx_dma);
+    HAL_DMA_Abort(SCAN_SPI_PORT->tx_dma);
+    LL_SPI_DisableDMAReq_RX(SCAN_SPI_PORT->handle);
+    LL_SPI_DisableDMAReq_TX(SCAN_SPI_PORT->handle);
+    HW_GPIO_writePin(SCAN_NCS_PIN, true);
+
+    // any cell but the first makes drv_inputAD reselect it with a full frame
+    max_chip.config.output.output.cell = MAX_CELL1;
+    scan.frame_busy                    = false;
+    scan.state                         = HW_CELLSCAN_IDLE;
+    scan.stats.errors++;
+
+    HW_SPI_release(max_chip.dev);
+}
+
+/**
+ * @brief  Clock out the next frame
+ *
+ * @retval true = Frame started, false = DMA busy, chip select untouched
+ */
+static bool startFrame(void)
+{
+    const HW_spi_port_S* port = SCAN_SPI_PORT;
+
+    if ((HAL_DMA_GetState(port->rx_dma) != HAL_DMA_STATE_READY) ||
+        (HAL_DMA_GetState(port->tx_dma) != HAL_DMA_STATE_READY)
+        )
+    {
+        return false;
+    }
+
+    // nothing shifts until the SPI requests are enabled below
+    bool started = HAL_DMA_Start_IT(port->rx_dma, (uint32_t)&port->handle->DR, (uint32_t)scan.response, MAX_FRAME_LENGTH) == HAL_OK;
+
+    started &= HAL_DMA_Start_IT(port->tx_dma, (uint32_t)scan.frames[scan.next_frame], (uint32_t)&port->handle->DR, MAX_FRAME_LENGTH) == HAL_OK;
+
+    if (!started)
+    {
+        HAL_DMA_Abort(port->rx_dma);
+        HAL_DMA_Abort(port->tx_dma);
+        return false;
+    }
+
+    scan.frame_cell = (MAX_selectedCell_E)(scan.frame_count - 1U - scan.next_frame);
+    scan.frame_busy = true;
+    HW_GPIO_writePin(SCAN_NCS_PIN, false);
+
+    LL_SPI_EnableDMAReq_RX(port->handle);
+    LL_SPI_EnableDMAReq_TX(port->handle);
+
+    scan.next_frame++;
+
+    return true;
+}
+
+/**
+ * @brief  Record the burst statistics and hand the results over
+ */
+static void finishBurst(void)
+{
+    const uint32_t cycles_per_us = HW_getCycleFrequencyHz() / 1000000U;
+
+    scan.stats.burst_us       = (uint16_t)((HW_getCycleCount() - scan.start_cycles) / cycles_per_us);
+    scan.stats.cells          = (uint8_t)(scan.frame_count + 1U);
+    scan.stats.latency_max_us = scan.latency_max_us;
+    scan.stats.jitter_us      = (scan.frame_count > 0U) ? (uint16_t)(scan.latency_max_us - scan.latency_min_us) : 0U;
+    scan.stats.bursts++;
+
+    scan.state = HW_CELLSCAN_COMPLETE;
+}
+
+/******************************************************************************
+ *                       P U B L I C  F U N C T I O N S
+ ******************************************************************************/
+
+/**
+ * @brief  Start a burst reading first_cell down to MAX_CELL1. The MAX output must
+ *         already show first_cell and have settled
+ *
+ * @param first_cell Cell currently on the MAX output
+ *
+ * @retval true = Burst started, false = A burst or frame is in progress or the bus is busy
+ */
+bool HW_cellScan_start(MAX_selectedCell_E first_cell)
+{
+    // a frame abandoned by an overrun still owns the frame buffers until it completes
+    if ((scan.state != HW_CELLSCAN_IDLE) || scan.frame_busy || (first_cell >= MAX_CELL_COUNT))
+    {
+        return false;
+    }
+
+    if (!HW_SPI_lock(max_chip.dev))
+    {
+        return false;
+    }
+
+    MAX_config_S config = max_chip.config;
+
+    config.sampling           = false;
+    config.diagnostic_enabled = false;
+    config.low_power_mode     = false;
+    config.output.state       = MAX_CELL_VOLTAGE;
+
+    for (uint8_t i = 0U; i < first_cell; i++)
+    {
+        config.output.output.cell = first_cell - 1U - i;
+        MAX_translateConfig(&config, scan.frames[i]);
+    }
+
+    scan.frame_count    = first_cell;
+    scan.next_frame     = 0U;
+    scan.cell           = first_cell;
+    scan.latency_min_us = UINT16_MAX;
+    scan.latency_max_us = 0U;
+    scan.start_cycles   = HW_getCycleCount();
+
+    // the output shows the first cell already, read it before any frame moves it
+    scan.counts[first_cell] = HW_ADC_getLatestCountFromBank2Channel(ADC_BANK2_CHANNEL_BMS_CHIP, HW_CELLSCAN_ADC_SAMPLES);
+
+    if (first_cell == MAX_CELL1)
+    {
+        HW_SPI_release(max_chip.dev);
+        finishBurst();
+        return true;
+    }
+
+    max_chip.config.sampling           = false;
+    max_chip.config.diagnostic_enabled = false;
+    max_chip.config.low_power_mode     = false;
+    max_chip.config.output.state       = MAX_CELL_VOLTAGE;
+
+    SCAN_SPI_PORT->rx_dma->XferCpltCallback  = &frameComplete;
+    SCAN_SPI_PORT->rx_dma->XferErrorCallback = &frameError;
+    SCAN_SPI_PORT->tx_dma->XferCpltCallback  = NULL;
+    SCAN_SPI_PORT->tx_dma->XferErrorCallback = &frameError;
+
+    scan.state = HW_CELLSCAN_RUNNING;
+
+    if (!startFrame())
+    {
+        scan.state = HW_CELLSCAN_IDLE;
+        HW_SPI_release(max_chip.dev);
+        return false;
+    }
+
+    __HAL_TIM_SET_COUNTER(SCAN_TIMER, 0U);
+    __HAL_TIM_CLEAR_FLAG(SCAN_TIMER, TIM_FLAG_UPDATE);
+    HAL_TIM_Base_Start_IT(SCAN_TIMER);
+
+    return true;
+}
+
+/**
+ * @brief  Timer step. Queues the frame for the next cell, then reads the cell
+ *         the last frame selected
+ */
+void HW_cellScan_stepISR(void)
+{
+    // the counter restarted at the update event, so it holds the interrupt latency
+    const uint16_t latency = (uint16_t)__HAL_TIM_GET_COUNTER(SCAN_TIMER);
+
+    if (scan.state != HW_CELLSCAN_RUNNING)
+    {
+        return;
+    }
+
+    if (scan.frame_busy)
+    {
+        // the output hasn't moved to the next cell yet, frameComplete() frees the bus
+        HAL_TIM_Base_Stop_IT(SCAN_TIMER);
+        scan.state = HW_CELLSCAN_IDLE;
+        scan.stats.overruns++;
+        return;
+    }
+
+    scan.latency_min_us = (latency < scan.latency_min_us) ? latency : scan.latency_min_us;
+    scan.latency_max_us = (latency > scan.latency_max_us) ? latency : scan.latency_max_us;
+    scan.cell           = max_chip.config.output.output.cell;
+
+    if ((scan.next_frame < scan.frame_count) && !startFrame())
+    {
+        HAL_TIM_Base_Stop_IT(SCAN_TIMER);
+        HW_SPI_release(max_chip.dev);
+        scan.state = HW_CELLSCAN_IDLE;
+        scan.stats.overruns++;
+        return;
+    }
+
+    scan.counts[scan.cell] = HW_ADC_getLatestCountFromBank2Channel(ADC_BANK2_CHANNEL_BMS_CHIP, HW_CELLSCAN_ADC_SAMPLES);
+
+    if (scan.cell == MAX_CELL1)
+    {
+        HAL_TIM_Base_Stop_IT(SCAN_TIMER);
+        HW_SPI_release(max_chip.dev);
+        finishBurst();
+    }
+}
+
+/**
+ * @brief  Take the results of a completed burst
+ *
+ * @param counts ADC count of each cell read, indexed by cell
+ *
+ * @retval true = A burst completed since the last call, false = Nothing to collect
+ */
+bool HW_cellScan_collect(uint16_t counts[MAX_CELL_COUNT])
+{
+    if (scan.state != HW_CELLSCAN_COMPLETE)
+    {
+        return false;
+    }
+
+    memcpy(counts, scan.counts, sizeof(scan.counts));
+
+    if (scan.frame_count > 0U)
+    {
+        MAX_decodeResponse(&max_chip.state, scan.response);
+    }
+
+    scan.state = HW_CELLSCAN_IDLE;
+
+    return true;
+}
+
+HW_cellScan_state_E HW_cellScan_getState(void)
+{
+    return scan.state;
+}
+
+const HW_cellScan_stats_S* HW_cellScan_getStats(void)
+{
+    return &scan.stats;
+}
+
+/**
+ * @brief  Cell rate achieved by the last burst
+ *
+ * @retval Cells per second
+ */
+uint16_t HW_cellScan_getCellsPerSecond(void)
+{
+    const uint16_t burst_us = scan.stats.burst_us;
+
+    return (burst_us == 0U) ? 0U : (uint16_t)(((uint32_t)scan.stats.cells * 1000000UL) / burst_us);
+}
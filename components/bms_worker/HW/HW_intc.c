@@ -20,6 +20,8 @@
 extern ADC_HandleTypeDef hadc1;
 extern ADC_HandleTypeDef hadc2;
 extern DMA_HandleTypeDef hdma_adc1;
+extern DMA_HandleTypeDef hdma_spi_rx;
+extern DMA_HandleTypeDef hdma_spi_tx;
 extern CAN_HandleTypeDef hcan;
 
 /******************************************************************************
@@ -90,6 +92,22 @@ void DMA1_Channel1_IRQHandler(void)
     HAL_DMA_IRQHandler(&hdma_adc1);
 }
 
+/**
+ * @brief This function handles DMA1 channel2 global interrupt, SPI1 RX.
+ */
+void DMA1_Channel2_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_spi_rx);
+}
+
+/**
+ * @brief This function handles DMA1 channel3 global interrupt, SPI1 TX.
+ */
+void DMA1_Channel3_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_spi_tx);
+}
+
 void ADC1_2_IRQHandler(void)
 {
     HAL_ADC_IRQHandler(&hadc1);
@@ -105,8 +123,12 @@ void TIM4_IRQHandler(void)
 #endif
 }
 
+/**
+ * @brief This function handles TIM3 global interrupt, the cell scan step.
+ */
 void TIM3_IRQHandler(void)
 {
+    HAL_TIM_IRQHandler(&htim[HW_TIM_PORT_CELL_SCAN]);
 }
 
 void TIM2_IRQHandler(void)
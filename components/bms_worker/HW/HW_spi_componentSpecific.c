@@ -11,6 +11,15 @@
 #include "HW_spi.h"
 #include "stm32f1xx_ll_bus.h"
 
+// Other Includes
+#include "SystemConfig.h"
+
+
+/******************************************************************************
+ *                         P R I V A T E  V A R S
+ ******************************************************************************/
+
+DMA_HandleTypeDef hdma_spi_tx, hdma_spi_rx;
 
 /******************************************************************************
  *                           P U B L I C  V A R S
@@ -19,6 +28,8 @@
 const HW_spi_port_S   HW_spi_ports[HW_SPI_PORT_COUNT] = {
     [HW_SPI_PORT_SPI1] = {
         .handle = SPI1,
+        .rx_dma = &hdma_spi_rx,
+        .tx_dma = &hdma_spi_tx,
     },
 };
 
@@ -61,9 +72,41 @@ HW_StatusTypeDef_E HW_SPI_init_componentSpecific(void)
         Error_Handler();
     }
 
+    // SPI1 requests are fixed to these channels on the F1
+    hdma_spi_rx.Instance                 = DMA1_Channel2;
+    hdma_spi_rx.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+    hdma_spi_rx.Init.PeriphInc           = DMA_PINC_DISABLE;
+    hdma_spi_rx.Init.MemInc              = DMA_MINC_ENABLE;
+    hdma_spi_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi_rx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    hdma_spi_rx.Init.Mode                = DMA_NORMAL;
+    hdma_spi_rx.Init.Priority            = DMA_PRIORITY_HIGH;
+    if (HAL_DMA_Init(&hdma_spi_rx) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    hdma_spi_tx.Instance                 = DMA1_Channel3;
+    hdma_spi_tx.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+    hdma_spi_tx.Init.PeriphInc           = DMA_PINC_DISABLE;
+    hdma_spi_tx.Init.MemInc              = DMA_MINC_ENABLE;
+    hdma_spi_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi_tx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    hdma_spi_tx.Init.Mode                = DMA_NORMAL;
+    hdma_spi_tx.Init.Priority            = DMA_PRIORITY_HIGH;
+    if (HAL_DMA_Init(&hdma_spi_tx) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
     // enable SPI
     LL_SPI_Enable(HW_spi_ports[HW_SPI_PORT_SPI1].handle);
 
+    // the cell scan raises chip select from the RX completion to latch each frame
+    HAL_NVIC_SetPriority(DMA1_Channel2_IRQn, CELL_SCAN_IRQ_PRIO, 0U);
+    HAL_NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+    HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, CELL_SCAN_IRQ_PRIO, 0U);
+    HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+
     return HW_OK;
 }
 
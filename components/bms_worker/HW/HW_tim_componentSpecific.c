@@ -14,6 +14,7 @@
 
 // Firmware Includes
 #include "FeatureDefines_generated.h"
+#include "HW_cellScan.h"
 #include "HW_tim.h"
 
 /******************************************************************************
@@ -145,6 +146,20 @@ HW_StatusTypeDef_E HW_TIM_init(void)
     HAL_TIM_PWM_Start(&htim[HW_TIM_PORT_PWM], TIM_CHANNEL_1);
     HAL_TIM_PWM_Start(&htim[HW_TIM_PORT_PWM], TIM_CHANNEL_2);
 #endif // if !((APP_VARIANT_ID == 1U) && ((BMSW_NODE_ID % 2) == 0U))
+
+    // Cell scan step timer, counts in us and is started for each burst by HW_cellScan
+    htim[HW_TIM_PORT_CELL_SCAN].Instance               = TIM3;
+    htim[HW_TIM_PORT_CELL_SCAN].Init.Prescaler         = (HW_TIM_TICK_GETCLKFREQ() / 1000000U) - 1U;
+    htim[HW_TIM_PORT_CELL_SCAN].Init.CounterMode       = TIM_COUNTERMODE_UP;
+    htim[HW_TIM_PORT_CELL_SCAN].Init.Period            = HW_CELLSCAN_STEP_US - 1U;
+    htim[HW_TIM_PORT_CELL_SCAN].Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+    htim[HW_TIM_PORT_CELL_SCAN].Init.RepetitionCounter = 0;
+    htim[HW_TIM_PORT_CELL_SCAN].Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_Base_Init(&htim[HW_TIM_PORT_CELL_SCAN]) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
     return HW_OK;
 }
 
@@ -159,6 +174,8 @@ HW_StatusTypeDef_E HW_TIM_deInit(void)
     HAL_TIM_PWM_Stop(&htim[HW_TIM_PORT_TACH], TIM_CHANNEL_1);
     __HAL_RCC_TIM1_CLK_DISABLE();
 #endif
+    HAL_TIM_Base_Stop_IT(&htim[HW_TIM_PORT_CELL_SCAN]);
+    __HAL_RCC_TIM3_CLK_DISABLE();
     return HW_OK;
 }
 
@@ -178,6 +195,26 @@ void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
         HAL_NVIC_EnableIRQ(TIM1_CC_IRQn);
 #endif
     }
+    else if (htim_base->Instance == TIM3)
+    {
+        __HAL_RCC_TIM3_CLK_ENABLE();
+
+        HAL_NVIC_SetPriority(TIM3_IRQn, CELL_SCAN_IRQ_PRIO, 0);
+        HAL_NVIC_EnableIRQ(TIM3_IRQn);
+    }
+}
+
+/**
+ * @brief  Called from HAL_TIM_PeriodElapsedCallback for every timer but the tick
+ *
+ * @param tim TIM peripheral
+ */
+void HW_TIM_periodElapsedCb(TIM_HandleTypeDef* tim)
+{
+    if (tim->Instance == TIM3)
+    {
+        HW_cellScan_stepISR();
+    }
 }
 
 /**
@@ -18,6 +18,7 @@
 #include "drv_mux.h"
 #include "HW.h"
 #include "HW_adc.h"
+#include "HW_cellScan.h"
 #include "HW_dma.h"
 #include "HW_gpio.h"
 #include "HW_tim.h"
@@ -109,25 +110,34 @@ static void drv_inputAD_1kHz_PRD(void)
 
     if ((BMS.state == BMS_HOLDING) || (BMS.state == BMS_PARASITIC_MEASUREMENT))
     {
-        const MAX_selectedCell_E current_cell = BMS_getCurrentOutputCell();
+        const MAX_selectedCell_E first_cell = BMS_CONFIGURED_SERIES_CELLS - 1;
+        uint16_t                 counts[MAX_CELL_COUNT];
 
-        if (current_cell == MAX_CELL1)
+        if (HW_cellScan_collect(counts))
         {
-            drv_inputAD_private_setAnalogVoltage(DRV_INPUTAD_ANALOG_CELL1 + current_cell,
-                                                 HW_ADC_getVFromBank2Channel(ADC_BANK2_CHANNEL_BMS_CHIP) * ADC_VOLTAGE_DIVISION);
+            for (uint8_t i = 0U; i <= first_cell; i++)
+            {
+                drv_inputAD_private_setAnalogVoltage(DRV_INPUTAD_ANALOG_CELL1 + i, HW_ADC_getVFromCount(counts[i]) * ADC_VOLTAGE_DIVISION);
+            }
             BMS_measurementComplete();
         }
-        else
+        else if (BMS.delayed_measurement)
+        {
+            // the first cell was just selected, give it a tick to settle
+            BMS.delayed_measurement = false;
+        }
+        else if (HW_cellScan_getState() == HW_CELLSCAN_IDLE)
         {
-            if (BMS.delayed_measurement)
+            if (BMS_getCurrentOutputCell() != first_cell)
             {
-                BMS.delayed_measurement = false;
+                // a burst was abandoned part way through, start over from the first cell
+                BMS_setOutputCell(first_cell);
+                BMS.delayed_measurement = true;
             }
             else
             {
-                BMS_setOutputCell(current_cell - 1);
-                drv_inputAD_private_setAnalogVoltage(DRV_INPUTAD_ANALOG_CELL1 + current_cell,
-                                                     HW_ADC_getVFromBank2Channel(ADC_BANK2_CHANNEL_BMS_CHIP) * ADC_VOLTAGE_DIVISION);
+                // retried next tick if the bus is busy
+                HW_cellScan_start(first_cell);
             }
         }
     }
@@ -16,6 +16,11 @@
 // Firmware Includes
 #include "HW_spi.h"
 
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+#define MAX_FRAME_LENGTH    3U /**< Bytes per SPI frame, in both directions */
 
 /******************************************************************************
  *                             T Y P E D E F S
@@ -110,3 +115,5 @@ typedef struct
 bool MAX_init(void);
 bool MAX_readWriteToChip(void);
 void MAX_setOutputCell(MAX_selectedCell_E cell);
+void MAX_translateConfig(MAX_config_S* config, uint8_t* data);
+void MAX_decodeResponse(MAX_response_S* chip, uint8_t* data);
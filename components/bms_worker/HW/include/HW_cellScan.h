@@ -0,0 +1,57 @@
+/**
+ * @file HW_cellScan.h
+ * @brief  Header file for the timer driven MAX14921 cell scan
+ */
+
+#pragma once
+
+/******************************************************************************
+ *                             I N C L U D E S
+ ******************************************************************************/
+
+// System Includes
+#include "stdbool.h"
+#include "stdint.h"
+
+// Firmware Includes
+#include "HW_MAX14921.h"
+
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+#define HW_CELLSCAN_STEP_US        100U /**< Time per cell: a 48us frame at 500kHz, settling, then the ADC window */
+#define HW_CELLSCAN_ADC_SAMPLES    8U   /**< Conversions averaged per cell, 3.25us apart */
+
+/******************************************************************************
+ *                             T Y P E D E F S
+ ******************************************************************************/
+
+typedef enum
+{
+    HW_CELLSCAN_IDLE = 0x00U,
+    HW_CELLSCAN_RUNNING,
+    HW_CELLSCAN_COMPLETE,    /**< Results are waiting for HW_cellScan_collect() */
+} HW_cellScan_state_E;
+
+typedef struct
+{
+    uint32_t bursts;            // completed bursts
+    uint32_t overruns;          // bursts abandoned because a frame was still in flight at the next step
+    uint32_t errors;            // bursts abandoned on an SPI DMA error
+    uint16_t burst_us;          // first to last sample of the last burst
+    uint16_t latency_max_us;    // worst step interrupt latency over the last burst
+    uint16_t jitter_us;         // spread of the step interrupt latency over the last burst
+    uint8_t  cells;             // cells read by the last burst
+} HW_cellScan_stats_S;
+
+/******************************************************************************
+ *            P U B L I C  F U N C T I O N  P R O T O T Y P E S
+ ******************************************************************************/
+
+bool                       HW_cellScan_start(MAX_selectedCell_E first_cell);
+bool                       HW_cellScan_collect(uint16_t counts[MAX_CELL_COUNT]);
+HW_cellScan_state_E        HW_cellScan_getState(void);
+const HW_cellScan_stats_S* HW_cellScan_getStats(void);
+uint16_t                   HW_cellScan_getCellsPerSecond(void);
+void                       HW_cellScan_stepISR(void);
@@ -31,6 +31,7 @@ typedef enum
     HW_TIM_PORT_TACH,
     HW_TIM_PORT_PWM,
 #endif
+    HW_TIM_PORT_CELL_SCAN,
     HW_TIM_PORT_COUNT,
 } HW_TIM_port_E;
 
@@ -21,6 +21,9 @@
 
 // Interrupt priorities, lower number is higher priority
 // tick interrupt is highest priority
+// the cell scan ISRs make no RTOS calls and sit above the kernel so its critical
+// sections don't add to the step jitter
+#define CELL_SCAN_IRQ_PRIO configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY - 1U
 #define DMA_IRQ_PRIO       configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 4U
 #define ADC_IRQ_PRIO       DMA_IRQ_PRIO + 1U
 #define CAN_RX_IRQ_PRIO    configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 7U
@@ -19,6 +19,9 @@
 /**< Driver Includes */
 #include "HW_MAX14921.h"
 
+/**< Other Includes */
+#include "cellStats.h"
+
 /******************************************************************************
  *                             T Y P E D E F S
  ******************************************************************************/
@@ -36,21 +39,12 @@ typedef enum
     BMS_ERROR,
 } BMS_State_E;
 
-typedef enum
-{
-    BMS_CELL_DISCONNECTED = 0x00,
-    BMS_CELL_CONNECTED,
-    BMS_CELL_FAULT_UV,
-    BMS_CELL_FAULT_OV,
-    BMS_CELL_ERROR,
-} BMS_Cell_E;
-
 typedef struct
 {
-    float32_t  voltage;
-    float32_t  parasitic_corr;
-    BMS_Cell_E state;
-} BMS_Cell_S;
+    float32_t   voltage[MAX_CELL_COUNT];           // [V], precision 1mV
+    float32_t   parasitic_corr[MAX_CELL_COUNT];    // [V], precision 1mV
+    cellStats_S stats;                             // classification of the last measurement
+} BMS_Cells_S;
 
 typedef struct
 {
@@ -58,7 +52,7 @@ typedef struct
     bool        delayed_measurement;
     bool        fault;
     uint16_t    balancing_cells;
-    BMS_Cell_S  cells[MAX_CELL_COUNT];      // [V], precision 1V
+    BMS_Cells_S cells;
     float32_t   pack_voltage;               // [V], precision 1V
     float32_t   calculated_pack_voltage;    // [V], precision 1V
 
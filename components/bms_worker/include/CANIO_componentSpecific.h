@@ -19,6 +19,7 @@
 #include "cooling.h"
 #include "drv_tempSensors.h"
 #include "Environment.h"
+#include "HW_cellScan.h"
 #include "Module.h"
 
 /******************************************************************************
@@ -60,24 +61,24 @@
 # define set_cellTemp11(m, b, n, s)                        set(m, b, n, s, ENV.values.temps[CH11].temp)
 # define set_cellTemp10(m, b, n, s)                        set(m, b, n, s, ENV.values.temps[CH10].temp)
 #endif // if APP_VARIANT_ID == 0U
-#define set_cellVoltage5(m, b, n, s)                       set(m, b, n, s, BMS.cells[5].voltage)
-#define set_cellVoltage4(m, b, n, s)                       set(m, b, n, s, BMS.cells[4].voltage)
-#define set_cellVoltage3(m, b, n, s)                       set(m, b, n, s, BMS.cells[3].voltage)
-#define set_cellVoltage2(m, b, n, s)                       set(m, b, n, s, BMS.cells[2].voltage)
-#define set_cellVoltage1(m, b, n, s)                       set(m, b, n, s, BMS.cells[1].voltage)
-#define set_cellVoltage0(m, b, n, s)                       set(m, b, n, s, BMS.cells[0].voltage)
-#define set_cellVoltage11(m, b, n, s)                      set(m, b, n, s, BMS.cells[11].voltage)
-#define set_cellVoltage10(m, b, n, s)                      set(m, b, n, s, BMS.cells[10].voltage)
-#define set_cellVoltage9(m, b, n, s)                       set(m, b, n, s, BMS.cells[9].voltage)
-#define set_cellVoltage8(m, b, n, s)                       set(m, b, n, s, BMS.cells[8].voltage)
-#define set_cellVoltage7(m, b, n, s)                       set(m, b, n, s, BMS.cells[7].voltage)
-#define set_cellVoltage6(m, b, n, s)                       set(m, b, n, s, BMS.cells[6].voltage)
+#define set_cellVoltage5(m, b, n, s)                       set(m, b, n, s, BMS.cells.voltage[5])
+#define set_cellVoltage4(m, b, n, s)                       set(m, b, n, s, BMS.cells.voltage[4])
+#define set_cellVoltage3(m, b, n, s)                       set(m, b, n, s, BMS.cells.voltage[3])
+#define set_cellVoltage2(m, b, n, s)                       set(m, b, n, s, BMS.cells.voltage[2])
+#define set_cellVoltage1(m, b, n, s)                       set(m, b, n, s, BMS.cells.voltage[1])
+#define set_cellVoltage0(m, b, n, s)                       set(m, b, n, s, BMS.cells.voltage[0])
+#define set_cellVoltage11(m, b, n, s)                      set(m, b, n, s, BMS.cells.voltage[11])
+#define set_cellVoltage10(m, b, n, s)                      set(m, b, n, s, BMS.cells.voltage[10])
+#define set_cellVoltage9(m, b, n, s)                       set(m, b, n, s, BMS.cells.voltage[9])
+#define set_cellVoltage8(m, b, n, s)                       set(m, b, n, s, BMS.cells.voltage[8])
+#define set_cellVoltage7(m, b, n, s)                       set(m, b, n, s, BMS.cells.voltage[7])
+#define set_cellVoltage6(m, b, n, s)                       set(m, b, n, s, BMS.cells.voltage[6])
 #define set_segmentVoltageHighRes(m, b, n, s)              set(m, b, n, s, BMS.pack_voltage)
 #define set_segmentVoltageHighResCalculated(m, b, n, s)    set(m, b, n, s, BMS.calculated_pack_voltage)
-#define set_cellVoltage15(m, b, n, s)                      set(m, b, n, s, BMS.cells[15].voltage)
-#define set_cellVoltage14(m, b, n, s)                      set(m, b, n, s, BMS.cells[14].voltage)
-#define set_cellVoltage13(m, b, n, s)                      set(m, b, n, s, BMS.cells[13].voltage)
-#define set_cellVoltage12(m, b, n, s)                      set(m, b, n, s, BMS.cells[12].voltage)
+#define set_cellVoltage15(m, b, n, s)                      set(m, b, n, s, BMS.cells.voltage[15])
+#define set_cellVoltage14(m, b, n, s)                      set(m, b, n, s, BMS.cells.voltage[14])
+#define set_cellVoltage13(m, b, n, s)                      set(m, b, n, s, BMS.cells.voltage[13])
+#define set_cellVoltage12(m, b, n, s)                      set(m, b, n, s, BMS.cells.voltage[12])
 #define set_boardRelativeHumidity(m, b, n, s)              set(m, b, n, s, ENV.values.board.rh)
 #define set_boardAmbientTemp(m, b, n, s)                   set(m, b, n, s, ENV.values.board.ambient_temp)
 #if APP_VARIANT_ID == 1U
@@ -110,3 +111,7 @@
 #define set_coolPct0(m, b, n, s)                           set(m, b, n, s, (drv_cooling_getPower(&cooling[COOLING_CHANNEL_FAN1]) * 100.0f))
 #define set_coolState0(m, b, n, s)                         set(m, b, n, s, (drv_cooling_getState(&cooling[COOLING_CHANNEL_FAN1]) != COOLING_OFF) ? \
                                                                CAN_DIGITALSTATUS_ON : CAN_DIGITALSTATUS_OFF)
+#define set_cellScanTimeUs(m, b, n, s)                     set(m, b, n, s, HW_cellScan_getStats()->burst_us)
+#define set_cellScanRate(m, b, n, s)                       set(m, b, n, s, HW_cellScan_getCellsPerSecond())
+#define set_cellScanJitterUs(m, b, n, s)                   set(m, b, n, s, HW_cellScan_getStats()->jitter_us)
+#define set_cellScanAborted(m, b, n, s)                    set(m, b, n, s, HW_cellScan_getStats()->overruns + HW_cellScan_getStats()->errors)
@@ -0,0 +1,62 @@
+/**
+ * @file cellStats.h
+ * @brief  Header file for the cell statistics kernel
+ */
+
+#pragma once
+
+/******************************************************************************
+ *                             I N C L U D E S
+ ******************************************************************************/
+
+/**< System Includes */
+#include "stdbool.h"
+#include "stdint.h"
+
+/**< Other Includes */
+#include "LIB_FloatTypes.h"
+
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+#define CELLSTATS_MAX_CELLS    16U    // one bit per cell in the masks
+
+/******************************************************************************
+ *                             T Y P E D E F S
+ ******************************************************************************/
+
+typedef struct
+{
+    float32_t disconnected_low;     // [V] at or below, the cell is in error
+    float32_t disconnected_high;    // [V] at or above, the cell is in error
+    float32_t undervoltage;         // [V] below, a connected cell is undervoltage
+    float32_t overvoltage;          // [V] above, a connected cell is overvoltage
+} cellStats_limits_S;
+
+/**
+ * @brief Result of one pass over the cells. Masks have bit i set for cell i
+ */
+typedef struct
+{
+    uint16_t  connected;
+    uint16_t  undervoltage;
+    uint16_t  overvoltage;
+    uint16_t  error;
+    uint16_t  balance;             // above the balancing threshold
+    uint16_t  balance_isolated;    // balance cells with neither neighbour in balance
+
+    float32_t min;                 // [V], starts from 5V
+    float32_t max;                 // [V], starts from 0V
+    float32_t sum;                 // [V]
+} cellStats_S;
+
+/******************************************************************************
+ *            P U B L I C  F U N C T I O N  P R O T O T Y P E S
+ ******************************************************************************/
+
+void cellStats_run(const float32_t*          voltages,
+                   uint8_t                   count,
+                   const cellStats_limits_S* limits,
+                   float32_t                 balance_threshold,
+                   cellStats_S*              stats);
@@ -19,6 +19,7 @@
 #include "HW_tim.h"
 
 /**< Other Includes */
+#include "cellStats.h"
 #include "Module.h"
 #include "string.h"
 
@@ -45,6 +46,8 @@
 #define CELL_VOLTAGE_THRESH_UV              2.0f
 #define CELL_VOLTAGE_THRESH_OV              4.225f
 
+_Static_assert(BMS_CONFIGURED_SERIES_CELLS <= CELLSTATS_MAX_CELLS, "Cell masks are 16 bits");
+
 /******************************************************************************
  *                              E X T E R N S
  ******************************************************************************/
@@ -74,6 +77,13 @@ static struct bms_S
     bool        determineCellsToBalance;
 } bms;
 
+static const cellStats_limits_S cellLimits = {
+    .disconnected_low  = CELL_DISCONNECTED_THRESH_LOW,
+    .disconnected_high = CELL_DISCONNECTED_THRESH_HIGH,
+    .undervoltage      = CELL_VOLTAGE_THRESH_UV,
+    .overvoltage       = CELL_VOLTAGE_THRESH_OV,
+};
+
 /******************************************************************************
  *                     P R I V A T E  F U N C T I O N S
  ******************************************************************************/
@@ -83,18 +93,13 @@ static struct bms_S
  */
 static void checkFault(void)
 {
-    bool       hasUv = false, hasOv = false, hasNc = false;
+    const bool hasUv       = BMS.cells.stats.undervoltage != 0x00;
+    const bool hasOv       = BMS.cells.stats.overvoltage != 0x00;
+    const bool hasNc       = BMS.cells.stats.error != 0x00;
     const bool analogError = max_chip.state.va_undervoltage;
     const bool packError   = max_chip.state.vp_undervoltage;
     const bool chipError   = analogError || packError;
 
-    for (uint8_t i = 0; i < BMS_CONFIGURED_SERIES_CELLS; i++)
-    {
-        hasUv |= BMS.cells[i].state == BMS_CELL_FAULT_UV;
-        hasOv |= BMS.cells[i].state == BMS_CELL_FAULT_OV;
-        hasNc |= BMS.cells[i].state == BMS_CELL_ERROR;
-    }
-
     const bool cellDisconnected = drv_timer_run(&bms.timerDisconnected, hasNc) == DRV_TIMER_EXPIRED;
     const bool cellUndervoltage = drv_timer_run(&bms.timerUndervoltage, hasUv) == DRV_TIMER_EXPIRED;
     const bool chipInError      = drv_timer_run(&bms.timerChipError, chipError) == DRV_TIMER_EXPIRED;
@@ -110,51 +115,17 @@ static void checkFault(void)
 
 /**
  * @brief  Calculates the segments statistics.
+ *
+ * @param balance_threshold Cells above this voltage are balancing candidates
  */
-static void calcSegStats(void)
+static void calcSegStats(float32_t balance_threshold)
 {
-    for (uint8_t i = 0; i < BMS_CONFIGURED_SERIES_CELLS; i++)
-    {
-        if ((BMS.cells[i].voltage > CELL_DISCONNECTED_THRESH_LOW) &&
-            (BMS.cells[i].voltage < CELL_DISCONNECTED_THRESH_HIGH)
-            )
-        {
-            if (BMS.cells[i].voltage < CELL_VOLTAGE_THRESH_UV)
-            {
-                BMS.cells[i].state = BMS_CELL_FAULT_UV;
-                continue;
-            }
-            else if (BMS.cells[i].voltage > CELL_VOLTAGE_THRESH_OV)
-            {
-                BMS.cells[i].state = BMS_CELL_FAULT_OV;
-                continue;
-            }
-            BMS.cells[i].state = BMS_CELL_CONNECTED;
-        }
-        else
-        {
-            BMS.cells[i].state = BMS_CELL_ERROR;
-        }
-    }
-
-    float32_t batt_tmp  = 0;
-    uint8_t   tmp_count = 0;
-
-    BMS.voltage.max             = 0x00;
-    BMS.voltage.min             = 5.0f;
-    BMS.voltage.avg             = 0x00;
-    BMS.calculated_pack_voltage = 0x00;
-
-    for (uint8_t i = 0; i < BMS_CONFIGURED_SERIES_CELLS; i++)
-    {
-        tmp_count++;
-        BMS.voltage.max              = (BMS.voltage.max > BMS.cells[i].voltage) ? BMS.voltage.max : BMS.cells[i].voltage;
-        BMS.voltage.min              = (BMS.voltage.min < BMS.cells[i].voltage) ? BMS.voltage.min : BMS.cells[i].voltage;
-        batt_tmp                    += BMS.cells[i].voltage;
-        BMS.calculated_pack_voltage += BMS.cells[i].voltage;
-    }
+    cellStats_run(BMS.cells.voltage, BMS_CONFIGURED_SERIES_CELLS, &cellLimits, balance_threshold, &BMS.cells.stats);
 
-    BMS.voltage.avg = batt_tmp / tmp_count;
+    BMS.voltage.max             = BMS.cells.stats.max;
+    BMS.voltage.min             = BMS.cells.stats.min;
+    BMS.voltage.avg             = BMS.cells.stats.sum / BMS_CONFIGURED_SERIES_CELLS;
+    BMS.calculated_pack_voltage = BMS.cells.stats.sum;
 
     checkFault();    // If cells are in error, it will override from sampling state
 }
@@ -238,7 +209,7 @@ void BMS_measurementComplete(void)
     {
         for (uint8_t i = 0; i < BMS_CONFIGURED_SERIES_CELLS; i++)
         {
-            BMS.cells[i].parasitic_corr = (drv_inputAD_getAnalogVoltage(DRV_INPUTAD_ANALOG_CELL1 + i)) / 128.0f;
+            BMS.cells.parasitic_corr[i] = (drv_inputAD_getAnalogVoltage(DRV_INPUTAD_ANALOG_CELL1 + i)) / 128.0f;
             BMS.state                   = BMS_WAITING;
         }
     }
@@ -256,28 +227,16 @@ void BMS_measurementComplete(void)
         for (uint8_t i = 0; i < BMS_CONFIGURED_SERIES_CELLS; i++)
         {
             // Adding parasitic correction makes our measurements less accurate
-            BMS.cells[i].voltage = drv_inputAD_getAnalogVoltage(DRV_INPUTAD_ANALOG_CELL1 + i);    // - BMS.cells[i].parasitic_corr;
+            BMS.cells.voltage[i] = drv_inputAD_getAnalogVoltage(DRV_INPUTAD_ANALOG_CELL1 + i);    // - BMS.cells.parasitic_corr[i];
         }
-        calcSegStats();
+        calcSegStats(target + BMS_CONFIGURED_BALANCING_MARGIN);
 
         if (bms.determineCellsToBalance)
         {
-            for (uint8_t i = 0; i < BMS_CONFIGURED_SERIES_CELLS; i++)
-            {
-                bms.balancingCells |= (BMS.cells[i].voltage > (target + BMS_CONFIGURED_BALANCING_MARGIN)) ? 1 << i : 0x00;
-            }
-
-            bms.balancingCellsEntireCycle |= (bms.balancingCells & 0x01) && !(bms.balancingCells & 0x02) ? 0x01 : 0x00;
-
-            for (uint8_t i = 1; i < BMS_CONFIGURED_SERIES_CELLS; i++)
-            {
-                const bool balancingPrev = (bms.balancingCells & (0x01 << (i - 1))) != 0x00;
-                const bool balancingNext = (bms.balancingCells & (0x01 << (i + 1))) != 0x00;
-                const bool balancing     = (bms.balancingCells & (0x01 << i)) != 0x00;
-                bms.balancingCellsEntireCycle |= balancing & !(balancingPrev || balancingNext) ? 1 << i : 0x00;
-            }
-
-            bms.determineCellsToBalance = false;
+            // both were cleared when determineCellsToBalance was set
+            bms.balancingCells            |= BMS.cells.stats.balance;
+            bms.balancingCellsEntireCycle |= BMS.cells.stats.balance_isolated;
+            bms.determineCellsToBalance    = false;
         }
     }
 }
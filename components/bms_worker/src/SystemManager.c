@@ -124,5 +124,8 @@ static void SYS1Hz_PRD()
     drv_outputAD_toggleDigitalState(DRV_OUTPUTAD_DIGITAL_LED);
 }
 const ModuleDesc_S SYS_desc = {
-    .periodic1Hz_CLK = &SYS1Hz_PRD,
+    .periodic_CLK = &SYS1Hz_PRD,
+    .periodMs     = 1000U,
+    .phaseMs      = MODULE_PHASE_AUTO,
+    .wcetUs       = 10U,
 };
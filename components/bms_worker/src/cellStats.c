@@ -0,0 +1,130 @@
+/**
+ * @file cellStats.c
+ * @brief  Source code for the cell statistics kernel
+ *
+ * Classifies every cell, finds the min, max and sum of their voltages and picks
+ * the balancing candidates in a single pass without a branch per cell.
+ *
+ * The worker has no FPU, so each float comparison is a call into the soft-float
+ * library. Comparisons are instead done on an integer key of the float bits that
+ * orders the same way as the floats themselves, which makes them single
+ * instructions that the compiler turns into conditional execution.
+ */
+
+/******************************************************************************
+ *                             I N C L U D E S
+ ******************************************************************************/
+
+/**< Module header */
+#include "cellStats.h"
+
+/**< System Includes */
+#include "string.h"
+
+/******************************************************************************
+ *                     P R I V A T E  F U N C T I O N S
+ ******************************************************************************/
+
+/**
+ * @brief  Map a float to a signed integer with the same ordering. The magnitude
+ *         bits of a float already order like an integer, so the key is the
+ *         magnitude negated for negative floats. -0 and 0 share key 0 as they
+ *         compare equal as floats
+ *
+ * @param f Value to map, not NaN
+ *
+ * @retval The ordered key
+ */
+static inline int32_t floatKey(float32_t f)
+{
+    int32_t bits;
+
+    memcpy(&bits, &f, sizeof(bits));
+
+    const int32_t sign      = bits >> 31;
+    const int32_t magnitude = bits & 0x7fffffff;
+
+    return (magnitude ^ sign) - sign;
+}
+
+/**
+ * @brief  Inverse of floatKey, key 0 gives 0 rather than -0
+ */
+static inline float32_t floatFromKey(int32_t key)
+{
+    const int32_t sign = key >> 31;
+    const int32_t bits = ((key ^ sign) - sign) | (int32_t)((uint32_t)sign & 0x80000000U);
+    float32_t     f;
+
+    memcpy(&f, &bits, sizeof(f));
+
+    return f;
+}
+
+/**
+ * @brief  Select a when the condition is 1, b when it is 0
+ */
+static inline int32_t selectKey(uint32_t condition, int32_t a, int32_t b)
+{
+    return b ^ ((a ^ b) & -(int32_t)condition);
+}
+
+/******************************************************************************
+ *                       P U B L I C  F U N C T I O N S
+ ******************************************************************************/
+
+/**
+ * @brief  Compute the statistics of a set of cells
+ *
+ * @param voltages Voltage of each cell [V]
+ * @param count Number of cells, at most CELLSTATS_MAX_CELLS
+ * @param limits Classification thresholds
+ * @param balance_threshold Cells above this voltage are balancing candidates [V]
+ * @param stats Result
+ */
+void cellStats_run(const float32_t*          voltages,
+                   uint8_t                   count,
+                   const cellStats_limits_S* limits,
+                   float32_t                 balance_threshold,
+                   cellStats_S*              stats)
+{
+    const int32_t low_key     = floatKey(limits->disconnected_low);
+    const int32_t high_key    = floatKey(limits->disconnected_high);
+    const int32_t uv_key      = floatKey(limits->undervoltage);
+    const int32_t ov_key      = floatKey(limits->overvoltage);
+    const int32_t balance_key = floatKey(balance_threshold);
+
+    uint32_t  in_range = 0U;
+    uint32_t  uv       = 0U;
+    uint32_t  ov       = 0U;
+    uint32_t  balance  = 0U;
+    int32_t   min_key  = floatKey(5.0f);
+    int32_t   max_key  = floatKey(0.0f);
+    float32_t sum      = 0.0f;
+
+    for (uint8_t i = 0U; i < count; i++)
+    {
+        const int32_t  key       = floatKey(voltages[i]);
+        const uint32_t connected = (uint32_t)(key > low_key) & (uint32_t)(key < high_key);
+
+        in_range |= connected << i;
+        uv       |= (connected & (uint32_t)(key < uv_key)) << i;
+        ov       |= (connected & (uint32_t)(key > ov_key)) << i;
+        balance  |= (uint32_t)(key > balance_key) << i;
+        min_key   = selectKey((uint32_t)(key < min_key), key, min_key);
+        max_key   = selectKey((uint32_t)(key > max_key), key, max_key);
+        sum      += voltages[i];
+    }
+
+    const uint32_t all = (1UL << count) - 1U;
+
+    stats->connected        = (uint16_t)(in_range & ~(uv | ov));
+    stats->undervoltage     = (uint16_t)uv;
+    stats->overvoltage      = (uint16_t)ov;
+    stats->error            = (uint16_t)(~in_range & all);
+    stats->balance          = (uint16_t)balance;
+    stats->balance_isolated = (uint16_t)(balance & ~(balance << 1) & ~(balance >> 1));
+    stats->min              = floatFromKey(min_key);
+    stats->max              = floatFromKey(max_key);
+    stats->sum              = sum;
+}
@@ -24,6 +24,7 @@
 # include "HW_can.h"
 # include "lib_uds.h"
 # include "LIB_app.h"
+# include "Module.h"
 # include "ModuleDesc.h"
 # include "task.h"
 # include "Utility.h"
@@ -263,8 +264,20 @@ void uds_cb_DIDRead(uint8_t *payload, uint8_t payloadLengthBytes)
         }
 
         default:
-            uds_sendNegativeResponse(UDS_SID_READ_DID, UDS_NRC_GENERAL_REJECT);
+        {
+            uint8_t       profile[sizeof(Module_profile_S)];
+            const uint8_t profileLengthBytes = Module_readProfileDID(did.u16, profile, sizeof(profile));
+
+            if (profileLengthBytes > 0U)
+            {
+                uds_sendPositiveResponse(UDS_SID_READ_DID, UDS_NRC_NONE, profile, profileLengthBytes);
+            }
+            else
+            {
+                uds_sendNegativeResponse(UDS_SID_READ_DID, UDS_NRC_GENERAL_REJECT);
+            }
             break;
+        }
     }
 }
 
@@ -0,0 +1,112 @@
+#define _POSIX_C_SOURCE    199309L
+
+#include "cellStats.h"
+#include "referenceCellStats.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define PASSES     1000000U
+#define VECTORS    64U
+
+static const cellStats_limits_S limits = {
+    .disconnected_low  = 1.5f,
+    .disconnected_high = 4.5f,
+    .undervoltage      = 2.0f,
+    .overvoltage       = 4.225f,
+};
+
+static float32_t            voltages[VECTORS][CELLSTATS_MAX_CELLS];
+static ref_cell_S           cells[VECTORS][CELLSTATS_MAX_CELLS];
+static volatile uint16_t    sink;
+
+static double nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+static double benchmarkReference(void)
+{
+    cellStats_S  stats;
+    uint16_t     mask  = 0U;
+    const double start = nowNs();
+
+    for (uint32_t i = 0U; i < PASSES; i++)
+    {
+        referenceCellStats(cells[i % VECTORS], CELLSTATS_MAX_CELLS, &limits, 3.9f, &stats);
+        mask ^= stats.connected ^ stats.balance_isolated;
+    }
+
+    const double elapsed = nowNs() - start;
+
+    sink = mask;
+    return elapsed / (double)PASSES;
+}
+
+static double benchmarkKernel(void)
+{
+    cellStats_S  stats;
+    uint16_t     mask  = 0U;
+    const double start = nowNs();
+
+    for (uint32_t i = 0U; i < PASSES; i++)
+    {
+        cellStats_run(voltages[i % VECTORS], CELLSTATS_MAX_CELLS, &limits, 3.9f, &stats);
+        mask ^= stats.connected ^ stats.balance_isolated;
+    }
+
+    const double elapsed = nowNs() - start;
+
+    sink = mask;
+    return elapsed / (double)PASSES;
+}
+
+void setUp(void)
+{
+    // a pack sitting around nominal with the odd cell out of every band
+    uint32_t state = 12345U;
+    for (uint8_t v = 0U; v < VECTORS; v++)
+    {
+        for (uint8_t i = 0U; i < CELLSTATS_MAX_CELLS; i++)
+        {
+            state               = (state * 1103515245U) + 12345U;
+            voltages[v][i]      = ((float32_t)(state >> 8) / (float32_t)(1U << 24)) * 3.5f + 1.0f;
+            cells[v][i].voltage = voltages[v][i];
+        }
+    }
+}
+
+void tearDown(void)
+{
+}
+
+void test_report_time_per_pass(void)
+{
+    printf("%u cells, ns per pass: reference %.1f, kernel %.1f\n",
+           CELLSTATS_MAX_CELLS,
+           benchmarkReference(),
+           benchmarkKernel());
+
+    for (uint8_t v = 0U; v < VECTORS; v++)
+    {
+        cellStats_S expected;
+        cellStats_S actual;
+
+        referenceCellStats(cells[v], CELLSTATS_MAX_CELLS, &limits, 3.9f, &expected);
+        cellStats_run(voltages[v], CELLSTATS_MAX_CELLS, &limits, 3.9f, &actual);
+
+        TEST_ASSERT_EQUAL_UINT16(expected.connected, actual.connected);
+        TEST_ASSERT_EQUAL_UINT16(expected.balance_isolated, actual.balance_isolated);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_report_time_per_pass);
+    return UNITY_END();
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// calcSegStats() and the balancing selection of BMS_measurementComplete() as they
+// were before cellStats, kept as the reference the kernel has to agree with
+
+#include "cellStats.h"
+
+typedef enum
+{
+    REF_CELL_DISCONNECTED = 0x00,
+    REF_CELL_CONNECTED,
+    REF_CELL_FAULT_UV,
+    REF_CELL_FAULT_OV,
+    REF_CELL_ERROR,
+} ref_cell_E;
+
+typedef struct
+{
+    float32_t  voltage;
+    float32_t  parasitic_corr;
+    ref_cell_E state;
+} ref_cell_S;
+
+static void referenceCellStats(ref_cell_S* cells, uint8_t count, const cellStats_limits_S* limits, float32_t balance_threshold, cellStats_S* stats)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if ((cells[i].voltage > limits->disconnected_low) &&
+            (cells[i].voltage < limits->disconnected_high)
+            )
+        {
+            if (cells[i].voltage < limits->undervoltage)
+            {
+                cells[i].state = REF_CELL_FAULT_UV;
+                continue;
+            }
+            else if (cells[i].voltage > limits->overvoltage)
+            {
+                cells[i].state = REF_CELL_FAULT_OV;
+                continue;
+            }
+            cells[i].state = REF_CELL_CONNECTED;
+        }
+        else
+        {
+            cells[i].state = REF_CELL_ERROR;
+        }
+    }
+
+    stats->max = 0x00;
+    stats->min = 5.0f;
+    stats->sum = 0x00;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        stats->max  = (stats->max > cells[i].voltage) ? stats->max : cells[i].voltage;
+        stats->min  = (stats->min < cells[i].voltage) ? stats->min : cells[i].voltage;
+        stats->sum += cells[i].voltage;
+    }
+
+    stats->connected    = 0x00;
+    stats->undervoltage = 0x00;
+    stats->overvoltage  = 0x00;
+    stats->error        = 0x00;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        stats->connected    |= (cells[i].state == REF_CELL_CONNECTED) ? 1 << i : 0x00;
+        stats->undervoltage |= (cells[i].state == REF_CELL_FAULT_UV) ? 1 << i : 0x00;
+        stats->overvoltage  |= (cells[i].state == REF_CELL_FAULT_OV) ? 1 << i : 0x00;
+        stats->error        |= (cells[i].state == REF_CELL_ERROR) ? 1 << i : 0x00;
+    }
+
+    uint16_t balancingCells            = 0x00;
+    uint16_t balancingCellsEntireCycle = 0x00;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        balancingCells |= (cells[i].voltage > balance_threshold) ? 1 << i : 0x00;
+    }
+
+    balancingCellsEntireCycle |= (balancingCells & 0x01) && !(balancingCells & 0x02) ? 0x01 : 0x00;
+
+    for (uint8_t i = 1; i < count; i++)
+    {
+        const bool balancingPrev = (balancingCells & (0x01 << (i - 1))) != 0x00;
+        const bool balancingNext = (balancingCells & (0x01 << (i + 1))) != 0x00;
+        const bool balancing     = (balancingCells & (0x01 << i)) != 0x00;
+        balancingCellsEntireCycle |= balancing & !(balancingPrev || balancingNext) ? 1 << i : 0x00;
+    }
+
+    stats->balance          = balancingCells;
+    stats->balance_isolated = balancingCellsEntireCycle;
+}
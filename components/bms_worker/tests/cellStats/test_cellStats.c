@@ -0,0 +1,122 @@
+#include "cellStats.h"
+#include "referenceCellStats.h"
+#include "unity.h"
+
+#define VECTORS    100000U
+
+static const cellStats_limits_S limits = {
+    .disconnected_low  = 1.5f,
+    .disconnected_high = 4.5f,
+    .undervoltage      = 2.0f,
+    .overvoltage       = 4.225f,
+};
+
+// values a cell lands on often enough to matter: the thresholds themselves and
+// their neighbours, equal cells, and the out of range readings of a broken tap
+static const float32_t edges[] = { 1.5f, 4.5f, 2.0f, 4.225f, 3.703f, 0.0f, -0.0f, -0.4f, -1.2f, 5.0f, 6.5f, 1.49999988f, 2.00000024f };
+
+static uint32_t rngState = 0x2545F491U;
+
+static uint32_t nextRandom(void)
+{
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static float32_t randomVoltage(void)
+{
+    const uint32_t r = nextRandom();
+
+    if ((r & 0x7U) == 0U)
+    {
+        return edges[(r >> 3) % (sizeof(edges) / sizeof(edges[0]))];
+    }
+
+    // -1V to 7V
+    return (((float32_t)(r >> 8) / (float32_t)(1U << 24)) * 8.0f) - 1.0f;
+}
+
+static void assertSameStats(const cellStats_S* expected, const cellStats_S* actual)
+{
+    TEST_ASSERT_EQUAL_UINT16(expected->connected, actual->connected);
+    TEST_ASSERT_EQUAL_UINT16(expected->undervoltage, actual->undervoltage);
+    TEST_ASSERT_EQUAL_UINT16(expected->overvoltage, actual->overvoltage);
+    TEST_ASSERT_EQUAL_UINT16(expected->error, actual->error);
+    TEST_ASSERT_EQUAL_UINT16(expected->balance, actual->balance);
+    TEST_ASSERT_EQUAL_UINT16(expected->balance_isolated, actual->balance_isolated);
+    TEST_ASSERT_TRUE(expected->min == actual->min);
+    TEST_ASSERT_TRUE(expected->max == actual->max);
+    TEST_ASSERT_TRUE(expected->sum == actual->sum);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_random_cells_match_the_reference(void)
+{
+    for (uint32_t v = 0U; v < VECTORS; v++)
+    {
+        const uint8_t   count     = (uint8_t)(1U + (nextRandom() % CELLSTATS_MAX_CELLS));
+        const float32_t threshold = ((v & 0x3U) == 0U) ? edges[v % (sizeof(edges) / sizeof(edges[0]))] : randomVoltage();
+        ref_cell_S      cells[CELLSTATS_MAX_CELLS];
+        float32_t       voltages[CELLSTATS_MAX_CELLS];
+        cellStats_S     expected;
+        cellStats_S     actual;
+
+        for (uint8_t i = 0U; i < count; i++)
+        {
+            // runs of equal cells so ties and neighbouring balance cells show up
+            voltages[i]      = ((i > 0U) && ((nextRandom() & 0x3U) == 0U)) ? voltages[i - 1U] : randomVoltage();
+            cells[i].voltage = voltages[i];
+        }
+
+        referenceCellStats(cells, count, &limits, threshold, &expected);
+        cellStats_run(voltages, count, &limits, threshold, &actual);
+
+        assertSameStats(&expected, &actual);
+    }
+}
+
+void test_classifies_each_band(void)
+{
+    const float32_t voltages[] = { 1.0f, 1.8f, 3.7f, 4.3f, 4.6f, 4.1f };
+    cellStats_S     stats;
+
+    cellStats_run(voltages, 6U, &limits, 3.9f, &stats);
+
+    TEST_ASSERT_EQUAL_UINT16(0x24U, stats.connected);
+    TEST_ASSERT_EQUAL_UINT16(0x02U, stats.undervoltage);
+    TEST_ASSERT_EQUAL_UINT16(0x08U, stats.overvoltage);
+    TEST_ASSERT_EQUAL_UINT16(0x11U, stats.error);
+    TEST_ASSERT_EQUAL_UINT16(0x38U, stats.balance);
+    TEST_ASSERT_EQUAL_UINT16(0x00U, stats.balance_isolated);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(4.6f, stats.max);
+}
+
+void test_isolated_balance_cells_have_no_balancing_neighbour(void)
+{
+    const float32_t voltages[] = { 4.0f, 3.0f, 4.0f, 4.0f, 3.0f, 3.0f, 4.0f, 3.0f, 4.0f, 3.0f, 3.0f, 3.0f, 3.0f, 3.0f, 3.0f, 4.0f };
+    cellStats_S     stats;
+
+    cellStats_run(voltages, 16U, &limits, 3.5f, &stats);
+
+    TEST_ASSERT_EQUAL_UINT16(0x814DU, stats.balance);
+    TEST_ASSERT_EQUAL_UINT16(0x8141U, stats.balance_isolated);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_random_cells_match_the_reference);
+    RUN_TEST(test_classifies_each_band);
+    RUN_TEST(test_isolated_balance_cells_have_no_balancing_neighbour);
+    return UNITY_END();
+}
@@ -67,6 +67,12 @@ static data_S data;
 HW_StatusTypeDef_E HW_init(void)
 {
     memset(&data, 0x00, sizeof(data));
+
+    // Free-running cycle counter used for execution time profiling
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0U;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
     return (HAL_Init() == HAL_OK) ? HW_OK : HW_ERROR;
 }
 
@@ -80,6 +86,27 @@ uint32_t HW_getTick(void)
     return HAL_GetTick();
 }
 
+/**
+ * @brief  Get the core cycle count. Wraps around, so only differences between
+ *         two readings are meaningful
+ *
+ * @retval Core cycles since the counter was enabled
+ */
+uint32_t HW_getCycleCount(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief  Get the rate at which the cycle count increments
+ *
+ * @retval Core clock frequency in Hz
+ */
+uint32_t HW_getCycleFrequencyHz(void)
+{
+    return SystemCoreClock;
+}
+
 /**
  * @brief  Delay the execution in blocking mode for amount of ticks
  *
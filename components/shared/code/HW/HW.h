@@ -30,6 +30,8 @@ typedef enum
 
 HW_StatusTypeDef_E HW_init(void);
 uint32_t           HW_getTick(void);
+uint32_t           HW_getCycleCount(void);
+uint32_t           HW_getCycleFrequencyHz(void);
 void               HW_delay(uint32_t delay);
 void               HW_usDelay(uint8_t us);
 void               HW_systemHardReset(void);
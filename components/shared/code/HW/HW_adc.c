@@ -50,16 +50,6 @@ static inputs_S inputs;
  *                     P R I V A T E  F U N C T I O N S
  ******************************************************************************/
 
-/**
- * @brief  Get analog input voltage in V from ADC count
- * @param cnt ADC count
- * @retval unit:  V
- */
-static float32_t HW_ADC_private_getVFromCount(uint16_t cnt)
-{
-    return ((float32_t)cnt) * (float32_t)(((float32_t)ADC_REF_VOLTAGE) / ((float32_t)ADC_MAX_COUNT));
-}
-
 /**
  * @brief Firmware functinputsn to initiate ADC calibraton.
  *
@@ -126,12 +116,12 @@ void HW_ADC_unpackADCBuffer(void)
     for (uint8_t i = 0; i < ADC_BANK1_CHANNEL_COUNT; i++)
     {
         lib_simpleFilter_cumAvg_average(&inputs.adcData_bank1[i]);
-        inputs.voltages1[i] = HW_ADC_private_getVFromCount((uint16_t)inputs.adcData_bank1[i].value);
+        inputs.voltages1[i] = HW_ADC_getVFromCount((uint16_t)inputs.adcData_bank1[i].value);
     }
     for (uint8_t i = 0; i < ADC_BANK2_CHANNEL_COUNT; i++)
     {
         lib_simpleFilter_cumAvg_average(&inputs.adcData_bank2[i]);
-        inputs.voltages2[i] = HW_ADC_private_getVFromCount((uint16_t)inputs.adcData_bank2[i].value);
+        inputs.voltages2[i] = HW_ADC_getVFromCount((uint16_t)inputs.adcData_bank2[i].value);
     }
 }
 
@@ -157,6 +147,47 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
     }
 }
 
+/**
+ * @brief  Get analog input voltage in V from ADC count
+ * @param cnt ADC count
+ * @retval unit:  V
+ */
+float32_t HW_ADC_getVFromCount(uint16_t cnt)
+{
+    return ((float32_t)cnt) * (float32_t)(((float32_t)ADC_REF_VOLTAGE) / ((float32_t)ADC_MAX_COUNT));
+}
+
+/**
+ * @brief  Average the newest conversions of a bank 2 channel straight from the
+ *         DMA buffer, for callers that need the input at a known instant rather
+ *         than the average of the whole buffer. Safe to call from an ISR
+ *
+ * @param channel Channel to read
+ * @param samples Number of conversions to average, at most HW_ADC_BUF_LEN / ADC_BANK2_CHANNEL_COUNT
+ *
+ * @retval ADC count
+ */
+uint16_t HW_ADC_getLatestCountFromBank2Channel(HW_adcChannels_bank2_E channel, uint8_t samples)
+{
+    // the DMA counter holds the transfers left before the buffer wraps, so the
+    // entry before the one it points at is the newest complete conversion
+    uint16_t index = (uint16_t)(HW_ADC_BUF_LEN - __HAL_DMA_GET_COUNTER(hadc1.DMA_Handle));
+    uint32_t sum   = 0U;
+
+    for (uint8_t taken = 0U; taken < samples;)
+    {
+        index = (index == 0U) ? (HW_ADC_BUF_LEN - 1U) : (index - 1U);
+
+        if ((index % ADC_BANK2_CHANNEL_COUNT) == channel)
+        {
+            sum += inputs.adcBuffer[index] >> 16U;
+            taken++;
+        }
+    }
+
+    return (uint16_t)(sum / samples);
+}
+
 float32_t HW_ADC_getVFromBank1Channel(HW_adcChannels_bank1_E channel)
 {
     return inputs.voltages1[channel];
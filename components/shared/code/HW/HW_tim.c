@@ -123,15 +123,34 @@ void HW_TIM_configureRunTimeStatsTimer(void)
 }
 
 /**
- * @brief  RTOS Profiling has a ~1us accuracy by using the OS CLK and internal counter
+ * @brief  RTOS Profiling has a ~1us accuracy by using the OS CLK and internal counter.
+ *         Safe to call from any context as long as nothing preempts the tick ISR
+ *         (TICK_INT_PRIORITY is 0): an ISR that runs after the counter wrapped but
+ *         before the tick ISR sees the pending update flag, and a caller the tick ISR
+ *         preempts between the reads sees the tick change and reads again
  *
  * @retval Elapsed time in us from clock start
  */
 uint64_t HW_TIM_getBaseTick()
 {
-    // return fast_clk;
+    uint32_t tick;
+    uint32_t cnt;
+    bool     wrapped;
 
-    return ((uint64_t)HW_getTick() * 1000) + htim_tick.Instance->CNT;
+    do
+    {
+        tick    = HW_getTick();
+        cnt     = htim_tick.Instance->CNT;
+        wrapped = (htim_tick.Instance->SR & TIM_SR_UIF) != 0U;
+
+        if (wrapped)
+        {
+            // the counter wrapped but the tick isn't counted yet, take cnt from after the wrap
+            cnt = htim_tick.Instance->CNT;
+        }
+    } while (tick != HW_getTick());
+
+    return ((uint64_t)(tick + (wrapped ? 1U : 0U)) * 1000U) + cnt;
 }
 
 /**
@@ -9,12 +9,86 @@
 
 #include "HW_uart.h"
 
+/******************************************************************************
+ *                             T Y P E D E F S
+ ******************************************************************************/
+
+typedef struct
+{
+    uint8_t*             buffer;
+    uint32_t             size;
+    uint32_t             lastPos;  // DMA write offset at the previous receive event
+    uint32_t             rxCount;  // free-running count of bytes written by the DMA
+    HW_UART_rxCallback_t callback;
+} HW_UART_rxIdle_S;
+
 /******************************************************************************
  *                           P U B L I C  V A R S
  ******************************************************************************/
 
 UART_HandleTypeDef huart[HW_UART_PORT_COUNT];
 
+/******************************************************************************
+ *                         P R I V A T E  V A R S
+ ******************************************************************************/
+
+static HW_UART_rxIdle_S rxIdle[HW_UART_PORT_COUNT];
+
+/******************************************************************************
+ *                     P R I V A T E  F U N C T I O N S
+ ******************************************************************************/
+
+static HW_UART_port_E getPort(const UART_HandleTypeDef* handle)
+{
+    for (uint8_t port = 0U; port < HW_UART_PORT_COUNT; port++)
+    {
+        if (handle == &huart[port])
+        {
+            return (HW_UART_port_E)port;
+        }
+    }
+
+    return HW_UART_PORT_COUNT;
+}
+
+/**
+ * @brief Account for the bytes written by the DMA since the last receive event
+ *        and notify the owner of the port. Called from the UART idle-line
+ *        interrupt and the DMA half and full transfer interrupts, which
+ *        guarantees that less than one buffer length is written between calls.
+ */
+static void rxEvent(HW_UART_port_E port)
+{
+    HW_UART_rxIdle_S* const rx = &rxIdle[port];
+
+    if ((rx->callback == NULL) || (rx->size == 0U))
+    {
+        return;
+    }
+
+    const uint32_t pos = (rx->size - __HAL_DMA_GET_COUNTER(huart[port].hdmarx)) % rx->size;
+
+    rx->rxCount += (pos + rx->size - rx->lastPos) % rx->size;
+    rx->lastPos  = pos;
+
+    rx->callback(rx->rxCount);
+}
+
+static HW_StatusTypeDef_E startIdle(HW_UART_port_E port)
+{
+    HW_UART_rxIdle_S* const rx = &rxIdle[port];
+
+    if (HAL_UART_Receive_DMA(&huart[port], rx->buffer, (uint16_t)rx->size) != HAL_OK)
+    {
+        return HW_ERROR;
+    }
+
+    __HAL_UART_CLEAR_IDLEFLAG(&huart[port]);
+    __HAL_UART_ENABLE_IT(&huart[port], UART_IT_IDLE);
+
+    return HW_OK;
+}
+
 /******************************************************************************
  *                       P U B L I C  F U N C T I O N S
  ******************************************************************************/
@@ -26,13 +100,101 @@ HW_StatusTypeDef_E HW_UART_startDMARX(HW_UART_port_E port, uint32_t* data, uint3
 
 HW_StatusTypeDef_E HW_UART_stopDMA(HW_UART_port_E port)
 {
+    __HAL_UART_DISABLE_IT(&huart[port], UART_IT_IDLE);
+
     return (HAL_UART_DMAStop(&huart[port]) == HAL_OK) ? HW_OK : HW_ERROR;
 }
 
+/**
+ * @brief Start a circular DMA receive which reports new data on the idle-line
+ *        interrupt as well as on the DMA half and full transfer interrupts
+ *
+ * @param port UART port
+ * @param data Circular receive buffer
+ * @param size Size of the receive buffer in bytes
+ * @param callback Called from interrupt context with the updated byte count
+ */
+HW_StatusTypeDef_E HW_UART_startDMARXIdle(HW_UART_port_E port, uint8_t* data, uint32_t size, HW_UART_rxCallback_t callback)
+{
+    HW_UART_rxIdle_S* const rx = &rxIdle[port];
+
+    if ((data == NULL) || (size == 0U) || (size > UINT16_MAX))
+    {
+        return HW_ERROR;
+    }
+
+    rx->buffer   = data;
+    rx->size     = size;
+    rx->lastPos  = 0U;
+    rx->rxCount  = 0U;
+    rx->callback = callback;
+
+    return startIdle(port);
+}
+
+/**
+ * @brief Restart an idle-line receiver after an error. The DMA restarts at the
+ *        beginning of the buffer, so the byte count is advanced to the next
+ *        buffer lap to keep rxCount % size equal to the write offset.
+ */
+HW_StatusTypeDef_E HW_UART_restartDMARXIdle(HW_UART_port_E port)
+{
+    HW_UART_rxIdle_S* const rx = &rxIdle[port];
+
+    if (rx->buffer == NULL)
+    {
+        return HW_ERROR;
+    }
+
+    (void)HW_UART_stopDMA(port);
+
+    rx->rxCount += (rx->size - rx->lastPos) % rx->size;
+    rx->lastPos  = 0U;
+
+    return startIdle(port);
+}
+
+/**
+ * @brief UART interrupt handler, to be called from the USARTx_IRQHandler of
+ *        the component in place of HAL_UART_IRQHandler
+ */
+void HW_UART_IRQHandler(HW_UART_port_E port)
+{
+    UART_HandleTypeDef* const handle = &huart[port];
+
+    if ((__HAL_UART_GET_FLAG(handle, UART_FLAG_IDLE) != RESET) &&
+        (__HAL_UART_GET_IT_SOURCE(handle, UART_IT_IDLE) != RESET))
+    {
+        __HAL_UART_CLEAR_IDLEFLAG(handle);
+        rxEvent(port);
+    }
+
+    HAL_UART_IRQHandler(handle);
+}
+
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef* handle)
+{
+    const HW_UART_port_E port = getPort(handle);
+
+    if (port < HW_UART_PORT_COUNT)
+    {
+        rxEvent(port);
+    }
+}
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef* handle)
+{
+    const HW_UART_port_E port = getPort(handle);
+
+    if (port < HW_UART_PORT_COUNT)
+    {
+        rxEvent(port);
+    }
+}
+
 HW_StatusTypeDef_E HW_UART_init(void)
 {
     HW_StatusTypeDef_E status = HW_UART_init_componentSpecific();
 
     return status;
 }
-
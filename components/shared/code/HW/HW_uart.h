@@ -13,6 +13,18 @@
 #include "HW_uart_componentSpecific.h"
 #include "LIB_Types.h"
 
+/******************************************************************************
+ *                             T Y P E D E F S
+ ******************************************************************************/
+
+/**
+ * @brief Called from interrupt context whenever the idle-line receiver has
+ *        new data. rxCount is the free-running number of bytes written by the
+ *        DMA since the receiver was started, so the write offset into the
+ *        buffer is rxCount % size.
+ */
+typedef void (*HW_UART_rxCallback_t)(uint32_t rxCount);
+
 /******************************************************************************
  *                              E X T E R N S
  ******************************************************************************/
@@ -28,3 +40,7 @@ HW_StatusTypeDef_E HW_UART_init_componentSpecific(void);
 HW_StatusTypeDef_E HW_UART_deInit(void);
 HW_StatusTypeDef_E HW_UART_startDMARX(HW_UART_port_E huart, uint32_t* data, uint32_t size);
 HW_StatusTypeDef_E HW_UART_stopDMA(HW_UART_port_E port);
+
+HW_StatusTypeDef_E HW_UART_startDMARXIdle(HW_UART_port_E port, uint8_t* data, uint32_t size, HW_UART_rxCallback_t callback);
+HW_StatusTypeDef_E HW_UART_restartDMARXIdle(HW_UART_port_E port);
+void               HW_UART_IRQHandler(HW_UART_port_E port);
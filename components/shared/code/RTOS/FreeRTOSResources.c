@@ -35,6 +35,7 @@
 #define PERIODIC_TASK_100Hz    (1U) << (1U)
 #define PERIODIC_TASK_10Hz     (1U) << (2U)
 #define PERIODIC_TASK_1Hz      (1U) << (3U)
+#define PERIODIC_TASK_SCHEDULE (1U) << (4U)
 
 
 /******************************************************************************
@@ -64,6 +65,8 @@ static StaticTask_t Task10Hz;
 static StackType_t  task10HzStack[configMINIMAL_STACK_SIZE];
 static StaticTask_t Task1Hz;
 static StackType_t  task1HzStack[configMINIMAL_STACK_SIZE];
+static StaticTask_t TaskSchedule;
+static StackType_t  taskScheduleStack[configMINIMAL_STACK_SIZE];
 #if FEATURE_IS_ENABLED(NVM_TASK)
 static StaticTask_t TaskNvm;
 static StackType_t  taskNvmStack[configMINIMAL_STACK_SIZE];
@@ -74,6 +77,7 @@ extern void Module_1kHz_TSK(void);
 extern void Module_100Hz_TSK(void);
 extern void Module_10Hz_TSK(void);
 extern void Module_1Hz_TSK(void);
+extern void Module_schedule_TSK(void);
 #if FEATURE_IS_ENABLED(NVM_TASK)
 extern void lib_nvm_run(void);
 #endif
@@ -141,6 +145,20 @@ RTOS_taskDesc_t ModuleTasks[] = {
         },
         .periodMs = pdMS_TO_TICKS(1000U),
     },
+    {
+        .function    = &Module_schedule_TSK,
+        .name        = "Task Schedule",
+        .priority    = 3U,
+        .stack       = taskScheduleStack,
+        .stackSize   = sizeof(taskScheduleStack) / sizeof(StackType_t),
+        .stateBuffer = &TaskSchedule,
+        .parameters  = NULL,
+        .event       = {
+            .group = &PeriodicEvent,
+            .bit   = PERIODIC_TASK_SCHEDULE,
+        },
+        .periodMs = pdMS_TO_TICKS(1U),
+    },
 };
 RTOS_taskDesc_t FreerunTasks[] = {
 #if FEATURE_IS_ENABLED(NVM_TASK)
@@ -20,6 +20,7 @@
 #include "timers.h"
 
 // Other Includes
+#include "HW.h"
 #include "Utility.h"
 
 
@@ -34,6 +35,8 @@ typedef struct
     RTOS_taskDesc_t    swiTasks[RTOS_SWI_PRI_COUNT];                       // task descriptions
     EventGroupHandle_t swiEvents[RTOS_SWI_PRI_COUNT];                      // event group per priority
     uint8_t            swiCountPerPri[RTOS_SWI_PRI_COUNT];                 // count of SWIs defined in each priority
+    RTOS_swiStats_S    swiStats[RTOS_SWI_STATS_COUNT];                     // latency statistics, handed out in creation order
+    uint8_t            swiStatsCount;                                      // count of statistics entries handed out
 } rtos_S;
 
 
@@ -53,6 +56,16 @@ static const char* taskNames[RTOS_SWI_PRI_COUNT] = {
  *                     P R I V A T E  F U N C T I O N S
  ******************************************************************************/
 
+/**
+ * usesNotify
+ * @brief whether SWIs of a priority wake their task with direct task notifications
+ * @param priority SWI priority
+ */
+static bool usesNotify(RTOS_swiPri_E priority)
+{
+    return (RTOS_SWI_NOTIFY_PRIORITIES & (1UL << (uint32_t)priority)) != 0UL;
+}
+
 /**
  * swiTaskFxn
  * @brief function that each SWI task sits in while waiting for a SWI to fire.
@@ -68,7 +81,41 @@ static void swiTaskFxn(void* pvParameters)
     for (;;)
     {
         // wait forever for an event bit to get set. Yields back to scheduler
-        EventBits_t events = RTOS_EVENT_ALL & xEventGroupWaitBits(rtos.swiEvents[priority], RTOS_EVENT_ALL, pdTRUE, pdFALSE, portMAX_DELAY);
+        EventBits_t events = 0UL;
+        if (usesNotify(priority))
+        {
+            // the bits are cleared below, together with taking the invocations they stand for
+            uint32_t notified = 0UL;
+            (void)xTaskNotifyWait(0UL, 0UL, &notified, portMAX_DELAY);
+            events = RTOS_EVENT_ALL & notified;
+        }
+        else
+        {
+            events = RTOS_EVENT_ALL & xEventGroupWaitBits(rtos.swiEvents[priority], RTOS_EVENT_ALL, pdTRUE, pdFALSE, portMAX_DELAY);
+        }
+
+        // the runs serve every invocation made up to now. An invocation made after this still
+        // sets its bit again, so it is either taken here or gets a run of its own, never both.
+        // An event group bit is set outside the invoke's critical section, so it can still wake
+        // a run for invocations already taken; such a run isn't counted
+        uint32_t    pendingSince[RTOS_SWI_MAX_PER_PRI];
+        EventBits_t served = 0UL;
+        taskENTER_CRITICAL();
+        if (usesNotify(priority))
+        {
+            (void)ulTaskNotifyValueClear(NULL, events);
+        }
+        for (EventBits_t remaining = events; remaining != 0U;)
+        {
+            const uint32_t index = 31UL - u32CountLeadingZeroes(remaining);
+            remaining &= ~(1UL << index);
+
+            if (SWI_statsTakePending(rtos.swiTable[priority][index].stats, &pendingSince[index]))
+            {
+                served |= 1UL << index;
+            }
+        }
+        taskEXIT_CRITICAL();
 
         // once event bit has set, fire all SWIs that have their bits set
         while (events != 0U)
@@ -82,14 +129,20 @@ static void swiTaskFxn(void* pvParameters)
             const volatile RTOS_swiHandle_T* swi = &rtos.swiTable[priority][index];
             if (*swi->handler != NULL)
             {
+                const uint32_t start = HW_getCycleCount();
+
                 // call the SWI handler
                 (*swi->handler)();
+
+                if ((served & (1UL << index)) != 0UL)
+                {
+                    SWI_statsRan(swi->stats, pendingSince[index], start, HW_getCycleCount());
+                }
             }
         }
     }
 }
 
-
 /******************************************************************************
  *                       P U B L I C  F U N C T I O N S
  ******************************************************************************/
@@ -152,6 +205,7 @@ RTOS_swiHandle_T* SWI_create(RTOS_swiPri_E priority, RTOS_swiFn_t handler)
         swi->handler  = handler;                // link to SWI handler
         swi->priority = priority;               // link SWI priority
         swi->event    = 1UL << (uint32_t)index; // set event bit mask
+        swi->stats    = (rtos.swiStatsCount < RTOS_SWI_STATS_COUNT) ? &rtos.swiStats[rtos.swiStatsCount++] : NULL;
 
         return swi;
     }
@@ -164,8 +218,23 @@ RTOS_swiHandle_T* SWI_create(RTOS_swiPri_E priority, RTOS_swiFn_t handler)
  */
 void SWI_invoke(RTOS_swiHandle_T* handle)
 {
-    // set the event bit for the given SWI
-    (void)xEventGroupSetBits(rtos.swiEvents[handle->priority], handle->event);
+    // set the event bit for the given SWI. A task notification is set in the same critical
+    // section as the statistics, so the SWI task sees both or neither
+    if (usesNotify((RTOS_swiPri_E)handle->priority))
+    {
+        taskENTER_CRITICAL();
+        SWI_statsInvoked(handle->stats, HW_getCycleCount());
+        (void)xTaskNotify(rtos.swiTasks[handle->priority].handle, handle->event, eSetBits);
+        taskEXIT_CRITICAL();
+    }
+    else
+    {
+        taskENTER_CRITICAL();
+        SWI_statsInvoked(handle->stats, HW_getCycleCount());
+        taskEXIT_CRITICAL();
+
+        (void)xEventGroupSetBits(rtos.swiEvents[handle->priority], handle->event);
+    }
 }
 
 /**
@@ -177,12 +246,24 @@ void SWI_invoke(RTOS_swiHandle_T* handle)
  */
 bool SWI_invokeFromISR(RTOS_swiHandle_T* handle)
 {
-    // whether the daemon task (which is used to set the bit, since this is called from an ISR) was woken in order to set the bit
-    // (i.e. the daemon task is a higher priority than the interrupt which is invoking the SWI)
+    // whether the task that sets the bit was woken and has a higher priority than the interrupted one.
+    // for event groups that is the daemon task, since the bit can't be set from an ISR directly
     BaseType_t higherPrioTaskWoken = pdFALSE;
-    BaseType_t result              = xEventGroupSetBitsFromISR(rtos.swiEvents[handle->priority],
-                                                               handle->event,
-                                                               &higherPrioTaskWoken);
+    BaseType_t result              = pdPASS;
+    const UBaseType_t interruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    SWI_statsInvoked(handle->stats, HW_getCycleCount());
+    if (usesNotify((RTOS_swiPri_E)handle->priority))
+    {
+        result = xTaskNotifyFromISR(rtos.swiTasks[handle->priority].handle, handle->event, eSetBits, &higherPrioTaskWoken);
+        taskEXIT_CRITICAL_FROM_ISR(interruptStatus);
+    }
+    else
+    {
+        taskEXIT_CRITICAL_FROM_ISR(interruptStatus);
+        result = xEventGroupSetBitsFromISR(rtos.swiEvents[handle->priority],
+                                           handle->event,
+                                           &higherPrioTaskWoken);
+    }
 
     // required in order to switch contexts when the ISR returns
     portYIELD_FROM_ISR(higherPrioTaskWoken);
@@ -207,3 +288,25 @@ void SWI_enable(void)
 {
     taskEXIT_CRITICAL();
 }
+
+/**
+ * SWI_getStats
+ * @brief get the latency statistics of the given SWI
+ * @param handle SWI handle
+ * @return the statistics, or NULL if the SWI keeps none
+ */
+const RTOS_swiStats_S* SWI_getStats(const RTOS_swiHandle_T* handle)
+{
+    return (handle != NULL) ? handle->stats : NULL;
+}
+
+/**
+ * SWI_resetStats
+ * @brief clear the latency statistics of every SWI
+ */
+void SWI_resetStats(void)
+{
+    taskENTER_CRITICAL();
+    memset(rtos.swiStats, 0x00, sizeof(rtos.swiStats));
+    taskEXIT_CRITICAL();
+}
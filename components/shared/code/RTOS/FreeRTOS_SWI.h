@@ -11,6 +11,7 @@
 
 #include "FreeRTOS_types.h"
 #include "FreeRTOSConfig.h"
+#include "Utility.h"
 
 
 /******************************************************************************
@@ -20,6 +21,15 @@
 #define RTOS_SWI_PRI_OFFSET     12U              // SWI priority offset from other interrupts
 #define RTOS_SWI_MAX_PER_PRI    RTOS_EVENT_COUNT // number of SWIs allowed per priority level
 
+#define RTOS_SWI_STATS_COUNT           8U // SWIs, in creation order, that keep latency statistics
+#define RTOS_SWI_HISTOGRAM_BINS        8U
+#define RTOS_SWI_HISTOGRAM_MIN_LOG2    6U // bin 0 counts under 2^(MIN_LOG2 + 1) cycles, bin i counts [2^(MIN_LOG2 + i), 2^(MIN_LOG2 + i + 1))
+
+// priorities whose SWI task is woken by direct task notifications rather than an event group
+#ifndef RTOS_SWI_NOTIFY_PRIORITIES
+# define RTOS_SWI_NOTIFY_PRIORITIES    (1U << RTOS_SWI_PRI_0)
+#endif
+
 
 /******************************************************************************
  *                             T Y P E D E F S
@@ -36,14 +46,113 @@ typedef enum
 // function pointer type
 typedef void (*RTOS_swiFn_t)(void);
 
+// invoke-to-run latency and run time of one SWI, in cycles of HW_getCycleCount()
+typedef struct
+{
+    uint32_t invocations;
+    uint32_t coalesced;                                   // invocations made while the SWI was already pending
+    uint32_t runs;
+    uint32_t max_latency_cycles;                          // from the oldest pending invocation to the start of the run
+    uint32_t max_run_cycles;
+    uint16_t latency_histogram[RTOS_SWI_HISTOGRAM_BINS];  // log2 buckets, saturating
+    uint16_t run_histogram[RTOS_SWI_HISTOGRAM_BINS];      // log2 buckets, saturating
+    uint32_t pending_since;                               // cycle count of the oldest pending invocation
+    bool     pending;
+} RTOS_swiStats_S;
+
 typedef struct
 {
-    RTOS_swiFn_t handler;                    // function to be called when SWI runs
+    RTOS_swiFn_t     handler;                    // function to be called when SWI runs
+    RTOS_swiStats_S* stats;                      // NULL once RTOS_SWI_STATS_COUNT SWIs have been created
     uint32_t     priority: 2;                // priority of this SWI
     uint32_t     event   : RTOS_EVENT_COUNT; // bitmask for the event bit for this SWI
 } RTOS_swiHandle_T;
 
 
+/******************************************************************************
+ *                               M A C R O S
+ ******************************************************************************/
+
+// Histogram bucket of a duration in cycles
+static inline uint8_t SWI_histogramBin(uint32_t cycles)
+{
+    const uint16_t log2 = (cycles == 0U) ? 0U : (uint16_t)(31U - u32CountLeadingZeroes(cycles));
+
+    if (log2 <= RTOS_SWI_HISTOGRAM_MIN_LOG2)
+    {
+        return 0U;
+    }
+
+    return (uint8_t)((log2 < (RTOS_SWI_HISTOGRAM_MIN_LOG2 + RTOS_SWI_HISTOGRAM_BINS)) ? (log2 - RTOS_SWI_HISTOGRAM_MIN_LOG2) : (RTOS_SWI_HISTOGRAM_BINS - 1U));
+}
+
+// Count an invocation, coalescing it with one that is still pending. Call with SWIs disabled.
+static inline void SWI_statsInvoked(RTOS_swiStats_S* stats, uint32_t now)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    stats->invocations++;
+    if (stats->pending)
+    {
+        stats->coalesced++;
+    }
+    else
+    {
+        stats->pending       = true;
+        stats->pending_since = now;
+    }
+}
+
+// Take the pending invocations for a run. Call with SWIs disabled.
+// Returns false, leaving pendingSince alone, when an earlier run already served them
+static inline bool SWI_statsTakePending(RTOS_swiStats_S* stats, uint32_t* pendingSince)
+{
+    if ((stats == NULL) || !stats->pending)
+    {
+        return false;
+    }
+
+    stats->pending = false;
+    *pendingSince  = stats->pending_since;
+    return true;
+}
+
+// Count a run that was invoked at pendingSince and ran from start to end
+static inline void SWI_statsRan(RTOS_swiStats_S* stats, uint32_t pendingSince, uint32_t start, uint32_t end)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    const uint32_t latency    = start - pendingSince;
+    const uint32_t run        = end - start;
+    uint16_t*      latencyBin = &stats->latency_histogram[SWI_histogramBin(latency)];
+    uint16_t*      runBin     = &stats->run_histogram[SWI_histogramBin(run)];
+
+    stats->runs++;
+    if (latency > stats->max_latency_cycles)
+    {
+        stats->max_latency_cycles = latency;
+    }
+    if (run > stats->max_run_cycles)
+    {
+        stats->max_run_cycles = run;
+    }
+    if (*latencyBin < UINT16_MAX)
+    {
+        (*latencyBin)++;
+    }
+    if (*runBin < UINT16_MAX)
+    {
+        (*runBin)++;
+    }
+}
+
+
 /******************************************************************************
  *            P U B L I C  F U N C T I O N  P R O T O T Y P E S
  ******************************************************************************/
@@ -57,6 +166,9 @@ bool              SWI_invokeFromISR(RTOS_swiHandle_T* handle);
 void              SWI_disable(void);
 void              SWI_enable(void);
 
+const RTOS_swiStats_S* SWI_getStats(const RTOS_swiHandle_T* handle);
+void                   SWI_resetStats(void);
+
 void              RTOS_getSwiTaskMemory(RTOS_swiPri_E swiPriority,
                                         StaticTask_t  ** ppxSwiTaskTCBBuffer,
                                         StackType_t   ** ppxSwiTaskStackBuffer,
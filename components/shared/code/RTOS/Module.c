@@ -13,6 +13,7 @@
 /**< System Includes*/
 #include "stddef.h"
 #include "stdint.h"
+#include "string.h"
 #include "SystemConfig.h"
 
 // FreeRTOS Includes
@@ -21,9 +22,17 @@
 
 /**< Other Includes */
 #include "FeatureDefines_generated.h"
+#include "HW.h"
 #include "lib_utility.h"
 #include "Utility.h"
 
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+/**< Periodic tasks are the ones before the idle task */
+#define MODULE_PERIODIC_TASK_CNT    MODULE_IDLE_TASK
+
 /******************************************************************************
  *                         P R I V A T E  V A R S
  ******************************************************************************/
@@ -35,6 +44,328 @@ extern const ModuleDesc_S * modules[MODULE_CNT];
 
 static Module_taskStats_S stats[MODULE_TASK_CNT] = { 0 };
 
+static const uint16_t taskRateHz[MODULE_PERIODIC_TASK_CNT] = {
+    [MODULE_1Hz_TASK]   = 1U,
+    [MODULE_10Hz_TASK]  = 10U,
+    [MODULE_100Hz_TASK] = 100U,
+    [MODULE_1kHz_TASK]  = 1000U,
+};
+
+static struct
+{
+    Module_profile_S     modules[MODULE_PERIODIC_TASK_CNT][MODULE_CNT];
+    Module_profile_S     scheduled[MODULE_CNT];
+    Module_taskProfile_S tasks[MODULE_PERIODIC_TASK_CNT];
+    uint8_t              cursorTask;
+    uint8_t              cursorModule;
+} profile;
+
+/**
+ * @brief  Static schedule of the modules' periodic_CLK callbacks, built by
+ *         Module_Init and run from the schedule task
+ */
+static struct
+{
+    uint8_t  order[MODULE_CNT];                 /**< Scheduled modules in rate monotonic order */
+    uint8_t  count;
+    uint8_t  rejected;                          /**< Modules with a periodic_CLK whose periodMs doesn't fit */
+    uint16_t phaseMs[MODULE_CNT];               /**< MODULE_PHASE_AUTO for modules that are not scheduled */
+    uint16_t slotLoadUs[MODULE_SCHEDULE_SLOTS]; /**< Sum of wcetUs of the callbacks due in each slot */
+    uint32_t hyperperiodMs;
+    uint32_t tick;
+} schedule;
+
+/******************************************************************************
+ *                     P R I V A T E  F U N C T I O N S
+ ******************************************************************************/
+
+static void (*getPeriodic(const ModuleDesc_S* module, Module_taskSpeeds_E task))(void)
+{
+    switch (task)
+    {
+        case MODULE_1kHz_TASK:
+            return module->periodic1kHz_CLK;
+
+        case MODULE_100Hz_TASK:
+            return module->periodic100Hz_CLK;
+
+        case MODULE_10Hz_TASK:
+            return module->periodic10Hz_CLK;
+
+        case MODULE_1Hz_TASK:
+            return module->periodic1Hz_CLK;
+
+        default:
+            return NULL;
+    }
+}
+
+static uint8_t histogramBin(uint32_t cycles)
+{
+    uint8_t log2 = 0U;
+
+    while ((cycles >>= 1U) != 0U)
+    {
+        log2++;
+    }
+
+    return (uint8_t)SATURATE(MODULE_PROFILE_HISTOGRAM_MIN_LOG2, log2, MODULE_PROFILE_HISTOGRAM_MIN_LOG2 + MODULE_PROFILE_HISTOGRAM_BINS - 1U) -
+           MODULE_PROFILE_HISTOGRAM_MIN_LOG2;
+}
+
+static void recordProfile(Module_profile_S* entry, uint32_t cycles)
+{
+    const uint8_t bin = histogramBin(cycles);
+
+    if ((entry->count == 0U) || (cycles < entry->min_cycles))
+    {
+        entry->min_cycles = cycles;
+    }
+    if (cycles > entry->max_cycles)
+    {
+        entry->max_cycles = cycles;
+    }
+    entry->total_cycles += cycles;
+    entry->count++;
+    if (entry->histogram[bin] < UINT16_MAX)
+    {
+        entry->histogram[bin]++;
+    }
+}
+
+/**
+ * @brief  Run every module's callback for a periodic task, timing each one
+ * @param task Periodic task being run
+ */
+static void runModules(Module_taskSpeeds_E task)
+{
+    /**< Run each of the modules periodic function in order */
+    for (uint8_t i = 0U; i < COUNTOF(modules); i++)
+    {
+        void (*periodic)(void) = getPeriodic(modules[i], task);
+
+        if (periodic != NULL)
+        {
+            const uint32_t start = HW_getCycleCount();
+            (*periodic)();
+            recordProfile(&profile.modules[task][i], HW_getCycleCount() - start);
+        }
+    }
+}
+
+/**
+ * @brief  Run the scheduled callbacks due in this 1ms slot, shortest period first
+ */
+static void runSchedule(void)
+{
+    for (uint8_t i = 0U; i < schedule.count; i++)
+    {
+        const uint8_t       module = schedule.order[i];
+        const ModuleDesc_S* desc   = modules[module];
+
+        if ((schedule.tick % desc->periodMs) == schedule.phaseMs[module])
+        {
+            const uint32_t start = HW_getCycleCount();
+            (*desc->periodic_CLK)();
+            recordProfile(&profile.scheduled[module], HW_getCycleCount() - start);
+        }
+    }
+
+    if (++schedule.tick >= schedule.hyperperiodMs)
+    {
+        schedule.tick = 0U;
+    }
+}
+
+/**
+ * @brief  Time a periodic task as a whole against its period
+ * @param task Periodic task that ran
+ * @param taskStart Cycle count when the task started
+ */
+static void recordTaskProfile(Module_taskSpeeds_E task, uint32_t taskStart)
+{
+    Module_taskProfile_S* taskProfile = &profile.tasks[task];
+    const uint32_t        taskCycles  = HW_getCycleCount() - taskStart;
+
+    if (taskCycles > taskProfile->max_cycles)
+    {
+        taskProfile->max_cycles = taskCycles;
+    }
+    if (taskCycles > taskProfile->budget_cycles)
+    {
+        taskProfile->deadline_misses++;
+    }
+}
+
+static bool fitsSchedule(uint16_t periodMs)
+{
+    return (periodMs != 0U) && (((MODULE_SCHEDULE_SLOTS % periodMs) == 0U) || ((periodMs % MODULE_SCHEDULE_SLOTS) == 0U));
+}
+
+/**
+ * @brief  Rate monotonic order: shorter periods first, then longer runs so
+ *         they are placed while the slots are still quiet
+ */
+static bool schedulesBefore(const ModuleDesc_S* a, const ModuleDesc_S* b)
+{
+    return (a->periodMs < b->periodMs) || ((a->periodMs == b->periodMs) && (a->wcetUs > b->wcetUs));
+}
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0U)
+    {
+        const uint32_t remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+
+    return a;
+}
+
+/**
+ * @brief  Slots a callback runs in repeat every periodMs, folded into the
+ *         schedule's slots for periods longer than it
+ */
+static uint16_t slotStep(uint16_t periodMs)
+{
+    return (periodMs < MODULE_SCHEDULE_SLOTS) ? periodMs : MODULE_SCHEDULE_SLOTS;
+}
+
+static uint16_t peakSlotLoadUs(uint16_t phaseMs, uint16_t periodMs)
+{
+    uint16_t peak = 0U;
+
+    for (uint16_t slot = phaseMs % MODULE_SCHEDULE_SLOTS; slot < MODULE_SCHEDULE_SLOTS; slot += slotStep(periodMs))
+    {
+        peak = (schedule.slotLoadUs[slot] > peak) ? schedule.slotLoadUs[slot] : peak;
+    }
+
+    return peak;
+}
+
+static void addSlotLoad(uint16_t phaseMs, uint16_t periodMs, uint16_t wcetUs)
+{
+    for (uint16_t slot = phaseMs % MODULE_SCHEDULE_SLOTS; slot < MODULE_SCHEDULE_SLOTS; slot += slotStep(periodMs))
+    {
+        const uint32_t load = (uint32_t)schedule.slotLoadUs[slot] + wcetUs;
+
+        schedule.slotLoadUs[slot] = (load > UINT16_MAX) ? UINT16_MAX : (uint16_t)load;
+    }
+}
+
+/**
+ * @brief  Number of fixed rate callbacks whose task is released in a slot
+ */
+static uint8_t fixedRateCallbacks(uint16_t slot)
+{
+    uint8_t count = 0U;
+
+    for (uint8_t task = 0U; task < MODULE_PERIODIC_TASK_CNT; task++)
+    {
+        if ((slot % (1000U / taskRateHz[task])) != 0U)
+        {
+            continue;
+        }
+
+        for (uint8_t i = 0U; i < COUNTOF(modules); i++)
+        {
+            count += (getPeriodic(modules[i], (Module_taskSpeeds_E)task) != NULL) ? 1U : 0U;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief  Least loaded phase for a callback, preferring slots where fewer
+ *         fixed rate callbacks run
+ */
+static uint16_t quietestPhase(uint16_t periodMs)
+{
+    uint16_t best      = 0U;
+    uint16_t bestLoad  = UINT16_MAX;
+    uint8_t  bestFixed = UINT8_MAX;
+
+    for (uint16_t phase = 0U; phase < slotStep(periodMs); phase++)
+    {
+        const uint16_t load  = peakSlotLoadUs(phase, periodMs);
+        const uint8_t  fixed = fixedRateCallbacks(phase);
+
+        if ((load < bestLoad) || ((load == bestLoad) && (fixed < bestFixed)))
+        {
+            best      = phase;
+            bestLoad  = load;
+            bestFixed = fixed;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief  Build the static schedule of the periodic_CLK callbacks. Modules
+ *         with a fixed phase are placed first, then the others take the
+ *         quietest slots in rate monotonic order. A callback whose periodMs
+ *         doesn't fit the slots is counted in rejected and never runs.
+ */
+static void buildSchedule(void)
+{
+    memset(&schedule, 0x00U, sizeof(schedule));
+    schedule.hyperperiodMs = 1U;
+
+    for (uint8_t i = 0U; i < COUNTOF(modules); i++)
+    {
+        schedule.phaseMs[i] = MODULE_PHASE_AUTO;
+
+        if (modules[i]->periodic_CLK == NULL)
+        {
+            continue;
+        }
+
+        if (!fitsSchedule(modules[i]->periodMs))
+        {
+            schedule.rejected++;
+            continue;
+        }
+
+        uint8_t position = schedule.count++;
+        while ((position > 0U) && schedulesBefore(modules[i], modules[schedule.order[position - 1U]]))
+        {
+            schedule.order[position] = schedule.order[position - 1U];
+            position--;
+        }
+        schedule.order[position] = i;
+
+        schedule.hyperperiodMs = (schedule.hyperperiodMs / gcd(schedule.hyperperiodMs, modules[i]->periodMs)) * modules[i]->periodMs;
+    }
+
+    for (uint8_t pass = 0U; pass < 2U; pass++)
+    {
+        for (uint8_t i = 0U; i < schedule.count; i++)
+        {
+            const uint8_t       module = schedule.order[i];
+            const ModuleDesc_S* desc   = modules[module];
+            const bool          pinned = desc->phaseMs != MODULE_PHASE_AUTO;
+
+            if (pinned != (pass == 0U))
+            {
+                continue;
+            }
+
+            schedule.phaseMs[module] = pinned ? (desc->phaseMs % desc->periodMs) : quietestPhase(desc->periodMs);
+            addSlotLoad(schedule.phaseMs[module], desc->periodMs, desc->wcetUs);
+        }
+    }
+}
+
+static uint16_t cyclesToUs(uint64_t cycles)
+{
+    const uint64_t us = (cycles * 1000000ULL) / HW_getCycleFrequencyHz();
+
+    return (us > UINT16_MAX) ? UINT16_MAX : (uint16_t)us;
+}
+
 /******************************************************************************
  *                       P U B L I C  F U N C T I O N S
  ******************************************************************************/
@@ -60,6 +391,9 @@ void Module_Init(void)
         stats[i].iterations       = 0x00U;
     }
 
+    Module_resetProfiles();
+    buildSchedule();
+
     Module_componentSpecific_Init();
 
     /**< Run each of the modules Init function in order */
@@ -86,16 +420,11 @@ void Module_componentSpecific_1kHz(void)
  */
 void Module_1kHz_TSK(void)
 {
-    Module_componentSpecific_1kHz();
+    const uint32_t start = HW_getCycleCount();
 
-    /**< Run each of the modules 1kHz function in order */
-    for (uint8_t i = 0U; i < COUNTOF(modules); i++)
-    {
-        if (modules[i]->periodic1kHz_CLK != NULL)
-        {
-            (*modules[i]->periodic1kHz_CLK)();
-        }
-    }
+    Module_componentSpecific_1kHz();
+    runModules(MODULE_1kHz_TASK);
+    recordTaskProfile(MODULE_1kHz_TASK, start);
 
     stats[MODULE_1kHz_TASK].total_percentage = (uint8_t)ulTaskGetRunTimePercent(NULL);
     stats[MODULE_1kHz_TASK].iterations++;
@@ -116,16 +445,11 @@ void Module_componentSpecific_100Hz(void)
  */
 void Module_100Hz_TSK(void)
 {
-    Module_componentSpecific_100Hz();
+    const uint32_t start = HW_getCycleCount();
 
-    /**< Run each of the modules 100Hz function in order */
-    for (uint8_t i = 0U; i < COUNTOF(modules); i++)
-    {
-        if (modules[i]->periodic100Hz_CLK != NULL)
-        {
-            (*modules[i]->periodic100Hz_CLK)();
-        }
-    }
+    Module_componentSpecific_100Hz();
+    runModules(MODULE_100Hz_TASK);
+    recordTaskProfile(MODULE_100Hz_TASK, start);
 
     stats[MODULE_100Hz_TASK].total_percentage = (uint8_t)ulTaskGetRunTimePercent(NULL);
     stats[MODULE_100Hz_TASK].iterations++;
@@ -146,16 +470,11 @@ void Module_componentSpecific_10Hz(void)
  */
 void Module_10Hz_TSK(void)
 {
-    Module_componentSpecific_10Hz();
+    const uint32_t start = HW_getCycleCount();
 
-    /**< Run each of the modules 10Hz function in order */
-    for (uint8_t i = 0U; i < COUNTOF(modules); i++)
-    {
-        if (modules[i]->periodic10Hz_CLK != NULL)
-        {
-            (*modules[i]->periodic10Hz_CLK)();
-        }
-    }
+    Module_componentSpecific_10Hz();
+    runModules(MODULE_10Hz_TASK);
+    recordTaskProfile(MODULE_10Hz_TASK, start);
 
     stats[MODULE_10Hz_TASK].total_percentage = (uint8_t)ulTaskGetRunTimePercent(NULL);
     stats[MODULE_10Hz_TASK].iterations++;
@@ -176,22 +495,26 @@ void Module_componentSpecific_1Hz(void)
  */
 void Module_1Hz_TSK(void)
 {
-    Module_componentSpecific_1Hz();
+    const uint32_t start = HW_getCycleCount();
 
-    /**< Run each of the modules 1Hz function in order */
-    for (uint8_t i = 0U; i < COUNTOF(modules); i++)
-    {
-        if (modules[i]->periodic1Hz_CLK != NULL)
-        {
-            (*modules[i]->periodic1Hz_CLK)();
-        }
-    }
+    Module_componentSpecific_1Hz();
+    runModules(MODULE_1Hz_TASK);
+    recordTaskProfile(MODULE_1Hz_TASK, start);
 
     stats[MODULE_1Hz_TASK].total_percentage = (uint8_t)ulTaskGetRunTimePercent(NULL);
     stats[MODULE_1Hz_TASK].iterations++;
     stats[MODULE_1Hz_TASK].stack_left       = (uint16_t)uxTaskGetStackHighWaterMark(NULL);
 }
 
+/**
+ * @brief  Scheduled callbacks task, run every 1ms below the fixed-rate tasks
+ *         so the callbacks never delay the 1kHz chain
+ */
+void Module_schedule_TSK(void)
+{
+    runSchedule();
+}
+
 /**
  * @brief  Idle task used by FreeRTOS
  */
@@ -224,4 +547,201 @@ uint32_t Module_getTotalRuntimeIterations(Module_taskSpeeds_E task)
 uint8_t Module_getMinStackLeft(Module_taskSpeeds_E task)
 {
     return (uint8_t)SATURATE(0, stats[task].stack_left, 256);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Clears all execution time profiles
+ */
+void Module_resetProfiles(void)
+{
+    memset(&profile, 0x00U, sizeof(profile));
+
+    for (uint8_t task = 0U; task < MODULE_PERIODIC_TASK_CNT; task++)
+    {
+        profile.tasks[task].budget_cycles = HW_getCycleFrequencyHz() / taskRateHz[task];
+    }
+}
+
+/**
+ * @brief Returns the execution time profile of a module at one rate
+ * @param task Periodic task the module runs in
+ * @param module Index of the module in execution order
+ * @returns The profile, or NULL if task or module is out of range
+ */
+const Module_profile_S* Module_getProfile(Module_taskSpeeds_E task, uint8_t module)
+{
+    if ((task >= MODULE_PERIODIC_TASK_CNT) || (module >= MODULE_CNT))
+    {
+        return NULL;
+    }
+
+    return &profile.modules[task][module];
+}
+
+/**
+ * @brief Returns the execution time profile of a whole periodic task
+ * @param task Periodic task to get the profile of
+ * @returns The profile, or NULL if task is not a periodic task
+ */
+const Module_taskProfile_S* Module_getTaskProfile(Module_taskSpeeds_E task)
+{
+    if (task >= MODULE_PERIODIC_TASK_CNT)
+    {
+        return NULL;
+    }
+
+    return &profile.tasks[task];
+}
+
+/**
+ * @brief Copies the profile record read by a profiling DID
+ * @param did Data identifier, see MODULE_PROFILE_DID, MODULE_PROFILE_TASK_DID and MODULE_SCHEDULE_DID
+ * @param data Buffer to copy the record to
+ * @param size Size of the buffer
+ * @returns Length of the record, or 0 if did is not a profiling DID or the
+ *          record does not fit
+ */
+uint8_t Module_readProfileDID(uint16_t did, uint8_t* data, uint8_t size)
+{
+    const void*              record = NULL;
+    uint8_t                  length = 0U;
+    Module_scheduleProfile_S scheduleProfile;
+
+    if ((did >= MODULE_PROFILE_DID) && (did < (MODULE_PROFILE_DID + (MODULE_PERIODIC_TASK_CNT << 6U))))
+    {
+        record = Module_getProfile((Module_taskSpeeds_E)((did - MODULE_PROFILE_DID) >> 6U), (uint8_t)(did & 0x3fU));
+        length = sizeof(Module_profile_S);
+    }
+    else if ((did >= MODULE_SCHEDULED_PROFILE_DID) && (did < (MODULE_SCHEDULED_PROFILE_DID + MODULE_CNT)))
+    {
+        record = Module_getScheduledProfile((uint8_t)(did - MODULE_SCHEDULED_PROFILE_DID));
+        length = sizeof(Module_profile_S);
+    }
+    else if ((did >= MODULE_PROFILE_TASK_DID) && (did < (MODULE_PROFILE_TASK_DID + MODULE_PERIODIC_TASK_CNT)))
+    {
+        record = Module_getTaskProfile((Module_taskSpeeds_E)(did - MODULE_PROFILE_TASK_DID));
+        length = sizeof(Module_taskProfile_S);
+    }
+    else if (did == MODULE_SCHEDULE_DID)
+    {
+        scheduleProfile = (Module_scheduleProfile_S) {
+            .hyperperiodMs   = schedule.hyperperiodMs,
+            .worstSlotLoadUs = Module_getScheduleWorstSlotLoadUs(),
+            .scheduled       = schedule.count,
+            .rejected        = schedule.rejected,
+        };
+        record = &scheduleProfile;
+        length = sizeof(Module_scheduleProfile_S);
+    }
+
+    if ((record == NULL) || (length > size))
+    {
+        return 0U;
+    }
+
+    memcpy(data, record, length);
+    return length;
+}
+
+/**
+ * @brief Moves the rolling profile cursor to the next module callback that
+ *        exists, cycling through every rate
+ * @returns The task of the profile now under the cursor
+ */
+uint8_t Module_advanceProfileCursor(void)
+{
+    for (uint16_t i = 0U; i < (MODULE_PERIODIC_TASK_CNT * MODULE_CNT); i++)
+    {
+        if (++profile.cursorModule >= MODULE_CNT)
+        {
+            profile.cursorModule = 0U;
+            profile.cursorTask   = (uint8_t)((profile.cursorTask + 1U) % MODULE_PERIODIC_TASK_CNT);
+        }
+
+        if (getPeriodic(modules[profile.cursorModule], (Module_taskSpeeds_E)profile.cursorTask) != NULL)
+        {
+            break;
+        }
+    }
+
+    return profile.cursorTask;
+}
+
+uint8_t Module_getProfileCursorModule(void)
+{
+    return profile.cursorModule;
+}
+
+uint16_t Module_getProfileCursorMeanUs(void)
+{
+    const Module_profile_S* entry = &profile.modules[profile.cursorTask][profile.cursorModule];
+
+    return (entry->count == 0U) ? 0U : cyclesToUs(entry->total_cycles / entry->count);
+}
+
+uint16_t Module_getProfileCursorMaxUs(void)
+{
+    return cyclesToUs(profile.modules[profile.cursorTask][profile.cursorModule].max_cycles);
+}
+
+uint16_t Module_getProfileCursorDeadlineMisses(void)
+{
+    const uint32_t misses = profile.tasks[profile.cursorTask].deadline_misses;
+
+    return (misses > UINT16_MAX) ? UINT16_MAX : (uint16_t)misses;
+}
+
+/**
+ * @brief Returns the execution time profile of a module's scheduled callback
+ * @param module Index of the module in execution order
+ * @returns The profile, or NULL if module is out of range
+ */
+const Module_profile_S* Module_getScheduledProfile(uint8_t module)
+{
+    if (module >= MODULE_CNT)
+    {
+        return NULL;
+    }
+
+    return &profile.scheduled[module];
+}
+
+/**
+ * @brief Returns the slot a module's scheduled callback runs in within its period
+ * @param module Index of the module in execution order
+ * @returns The phase in ms, or MODULE_PHASE_AUTO if the module is not scheduled
+ */
+uint16_t Module_getSchedulePhase(uint8_t module)
+{
+    return (module < MODULE_CNT) ? schedule.phaseMs[module] : MODULE_PHASE_AUTO;
+}
+
+/**
+ * @brief Returns the worst case execution time of the scheduled callbacks due in a slot
+ * @param slot 1ms slot, below MODULE_SCHEDULE_SLOTS
+ */
+uint16_t Module_getScheduleSlotLoadUs(uint16_t slot)
+{
+    return (slot < MODULE_SCHEDULE_SLOTS) ? schedule.slotLoadUs[slot] : 0U;
+}
+
+uint16_t Module_getScheduleWorstSlotLoadUs(void)
+{
+    uint16_t worst = 0U;
+
+    for (uint16_t slot = 0U; slot < MODULE_SCHEDULE_SLOTS; slot++)
+    {
+        worst = (schedule.slotLoadUs[slot] > worst) ? schedule.slotLoadUs[slot] : worst;
+    }
+
+    return worst;
+}
+
+/**
+ * @brief Returns the number of periodic_CLK callbacks left out of the schedule
+ *        because their periodMs doesn't fit MODULE_SCHEDULE_SLOTS
+ */
+uint8_t Module_getScheduleRejected(void)
+{
+    return schedule.rejected;
+}
@@ -33,6 +33,24 @@
 #define set_taskStack10Hz(m, b, n, s)          set(m, b, n, s, Module_getMinStackLeft(MODULE_10Hz_TASK))
 #define set_taskStack1Hz(m, b, n, s)           set(m, b, n, s, Module_getMinStackLeft(MODULE_1Hz_TASK))
 
+/**< Packing the task signal, which comes first, moves the profile cursor to the next profiled module */
+#define set_moduleProfileTask(m, b, n, s)              set(m, b, n, s, Module_advanceProfileCursor())
+#define set_moduleProfileModule(m, b, n, s)            set(m, b, n, s, Module_getProfileCursorModule())
+#define set_moduleProfileMeanUs(m, b, n, s)            set(m, b, n, s, Module_getProfileCursorMeanUs())
+#define set_moduleProfileMaxUs(m, b, n, s)             set(m, b, n, s, Module_getProfileCursorMaxUs())
+#define set_moduleProfileDeadlineMisses(m, b, n, s)    set(m, b, n, s, Module_getProfileCursorDeadlineMisses())
+
+#define MODULE_PROFILE_HISTOGRAM_BINS          14U
+#define MODULE_PROFILE_HISTOGRAM_MIN_LOG2      5U     /**< Bin 0 counts runs under 2^(MIN_LOG2 + 1) cycles, bin i counts [2^(MIN_LOG2 + i), 2^(MIN_LOG2 + i + 1)) */
+#define MODULE_PROFILE_TASK_DID                0x0180U /**< + task, reads a Module_taskProfile_S */
+#define MODULE_PROFILE_DID                     0x0200U /**< + (task << 6) + module, reads a Module_profile_S */
+#define MODULE_SCHEDULE_DID                    0x0190U /**< reads a Module_scheduleProfile_S */
+#define MODULE_SCHEDULED_PROFILE_DID           0x0300U /**< + module, reads the Module_profile_S of periodic_CLK */
+
+#ifndef MODULE_SCHEDULE_SLOTS
+# define MODULE_SCHEDULE_SLOTS                 100U    /**< 1ms slots balanced by the schedule, periodMs must divide or be a multiple of it */
+#endif
+
 /******************************************************************************
  *                              E X T E R N S
  ******************************************************************************/
@@ -43,6 +61,7 @@ extern void Module_1kHz_TSK(void);
 extern void Module_100Hz_TSK(void);
 extern void Module_10Hz_TSK(void);
 extern void Module_1Hz_TSK(void);
+extern void Module_schedule_TSK(void);
 
 /******************************************************************************
  *                             T Y P E D E F S
@@ -65,6 +84,40 @@ typedef struct
     uint16_t stack_left;
 } Module_taskStats_S;
 
+/**
+ * @brief  Execution time of one module's periodic callback at one rate, in
+ *         cycles of HW_getCycleCount(). Includes time spent preempted.
+ */
+typedef struct
+{
+    uint64_t total_cycles;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint32_t count;
+    uint16_t histogram[MODULE_PROFILE_HISTOGRAM_BINS]; // log2 buckets, saturating
+} Module_profile_S;
+
+/**
+ * @brief  Execution time of a whole periodic task against its period
+ */
+typedef struct
+{
+    uint32_t budget_cycles;   // Task period in cycles
+    uint32_t max_cycles;
+    uint32_t deadline_misses; // Runs that took longer than the period
+} Module_taskProfile_S;
+
+/**
+ * @brief  Shape of the static schedule of the periodic_CLK callbacks
+ */
+typedef struct
+{
+    uint32_t hyperperiodMs;
+    uint16_t worstSlotLoadUs;
+    uint8_t  scheduled;
+    uint8_t  rejected;        // periodic_CLK callbacks that never run, their periodMs doesn't fit MODULE_SCHEDULE_SLOTS
+} Module_scheduleProfile_S;
+
 /******************************************************************************
  *            P U B L I C  F U N C T I O N  P R O T O T Y P E S
  ******************************************************************************/
@@ -79,3 +132,19 @@ float32_t Module_getTotalRuntimePercentage(Module_taskSpeeds_E task);
 uint32_t  Module_getTotalRuntimeIterations(Module_taskSpeeds_E task);
 uint8_t   Module_getMinStackLeft(Module_taskSpeeds_E task);
 void      Module_ApplicationIdleHook(void);
+
+const Module_profile_S*     Module_getProfile(Module_taskSpeeds_E task, uint8_t module);
+const Module_taskProfile_S* Module_getTaskProfile(Module_taskSpeeds_E task);
+void                        Module_resetProfiles(void);
+uint8_t                     Module_readProfileDID(uint16_t did, uint8_t* data, uint8_t size);
+uint8_t                     Module_advanceProfileCursor(void);
+uint8_t                     Module_getProfileCursorModule(void);
+uint16_t                    Module_getProfileCursorMeanUs(void);
+uint16_t                    Module_getProfileCursorMaxUs(void);
+uint16_t                    Module_getProfileCursorDeadlineMisses(void);
+
+const Module_profile_S*     Module_getScheduledProfile(uint8_t module);
+uint16_t                    Module_getSchedulePhase(uint8_t module);
+uint16_t                    Module_getScheduleSlotLoadUs(uint16_t slot);
+uint16_t                    Module_getScheduleWorstSlotLoadUs(void);
+uint8_t                     Module_getScheduleRejected(void);
@@ -8,6 +8,18 @@
 
 #pragma once
 
+/******************************************************************************
+ *                             I N C L U D E S
+ ******************************************************************************/
+
+#include "LIB_Types.h"
+
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+#define MODULE_PHASE_AUTO    0xFFFFU /**< Let the Module Manager place periodic_CLK in the least loaded slot */
+
 /******************************************************************************
  *                             T Y P E D E F S
  ******************************************************************************/
@@ -22,4 +34,8 @@ typedef struct
     void (*periodic100Hz_CLK)(void); // Pointer to module 100Hz periodic function
     void (*periodic10Hz_CLK)(void);  // Pointer to module 10Hz periodic function
     void (*periodic1Hz_CLK)(void);   // Pointer to module 1Hz periodic function
+    void (*periodic_CLK)(void);      // Pointer to module periodic function run every periodMs
+    uint16_t periodMs;               // Period of periodic_CLK, a divisor or multiple of MODULE_SCHEDULE_SLOTS
+    uint16_t phaseMs;                // Offset of periodic_CLK into its period, or MODULE_PHASE_AUTO
+    uint16_t wcetUs;                 // Worst case execution time of periodic_CLK, used to balance the slots
 } ModuleDesc_S;
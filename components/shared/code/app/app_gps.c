@@ -12,9 +12,9 @@
 #include "drv_outputAD.h"
 #include "drv_timer.h"
 #include "FreeRTOS.h"
+#include "FreeRTOS_SWI.h"
 #include "HW_gpio.h"
 #include "HW_uart.h"
-#include "lib_buffer.h"
 #include "lwgps.h"
 #include "task.h"
 #include <ctype.h>
@@ -53,9 +53,18 @@ static struct
     drv_timer_S                timeout;
 
 #if FEATURE_IS_ENABLED(FEATURE_GPSTRANSCEIVER)
-    LIB_BUFFER_CIRC_CREATE(dmaBuffer, volatile uint8_t, BUFFER_SIZE);
-    LIB_BUFFER_FIFO_CREATE(sentence, uint8_t, MAX_NMEA_SENTENCE);
+    uint8_t           dmaBuffer[BUFFER_SIZE];
+    volatile uint32_t rxHead;           // free-running count of bytes written by the DMA
+    uint32_t          rxTail;           // free-running count of bytes scanned by the SWI
+    uint32_t          sentenceStart;    // free-running count at the start of the current sentence
+    uint32_t          rxHeadLastSecond;
+    bool              discardSentence;  // current sentence was partially lost, skip to the next line
+    volatile bool     resync;
+    bool              overrun;
+    RTOS_swiHandle_T* rxSwi;
     lwgps_t           currentGPS;
+    uint16_t          rxBytesPerSecond;
+    uint16_t          droppedSentences;
     uint16_t          crcFailures;
     uint16_t          invalidTransactions;
     uint16_t          samples;
@@ -206,18 +215,21 @@ static bool parsePairmsgChecksum(const char* payload, const char* checksum)
     return calc == expected;
 }
 
-static bool parsePairmsg(const uint8_t* sentence, size_t len)
+static bool parsePairmsg(uint32_t offset, uint32_t len)
 {
-    char   buffer[MAX_NMEA_SENTENCE + 1U];
-    size_t copyLen  = len;
-    char   * cursor = NULL;
+    char     buffer[MAX_NMEA_SENTENCE + 1U];
+    uint32_t copyLen  = len;
+    char     * cursor = NULL;
 
     if (copyLen > MAX_NMEA_SENTENCE)
     {
         copyLen = MAX_NMEA_SENTENCE;
     }
 
-    memcpy(buffer, sentence, copyLen);
+    // PAIRMSG fields are tokenized in place, so this is the only sentence type copied out of the DMA buffer
+    const uint32_t firstLen = (copyLen < (BUFFER_SIZE - offset)) ? copyLen : (BUFFER_SIZE - offset);
+    memcpy(buffer, &gps.dmaBuffer[offset], firstLen);
+    memcpy(&buffer[firstLen], &gps.dmaBuffer[0], copyLen - firstLen);
     buffer[copyLen] = '\0';
 
     while (copyLen > 0U)
@@ -401,13 +413,25 @@ static bool parsePairmsg(const uint8_t* sentence, size_t len)
     return true;
 }
 
-static void parse(uint8_t* sentence, size_t len)
+/**
+ * @brief Parse a complete sentence in place in the DMA buffer
+ *
+ * @param offset Offset of the first byte of the sentence in the DMA buffer
+ * @param len Length of the sentence, which may wrap around the end of the buffer
+ */
+static void parse(uint32_t offset, uint32_t len)
 {
-    lwgps_process(&gps.currentGPS, sentence, len);
+    const uint32_t firstLen = (len < (BUFFER_SIZE - offset)) ? len : (BUFFER_SIZE - offset);
+
+    lwgps_process(&gps.currentGPS, &gps.dmaBuffer[offset], firstLen);
+    if (firstLen < len)
+    {
+        lwgps_process(&gps.currentGPS, &gps.dmaBuffer[0], len - firstLen);
+    }
 
     if (gps.currentGPS.p.stat == STAT_UNKNOWN)
     {
-        if (parsePairmsg(sentence, len))
+        if (parsePairmsg(offset, len))
         {
             drv_timer_start(&gps.timeout, GPS_TIMEOUT_MS);
             gps.samples++;
@@ -421,6 +445,7 @@ static void parse(uint8_t* sentence, size_t len)
     else if (gps.currentGPS.p.stat == STAT_CHECKSUM_FAIL)
     {
         gps.crcFailures++;
+        gps.droppedSentences++;
     }
     else
     {
@@ -430,16 +455,91 @@ static void parse(uint8_t* sentence, size_t len)
         gps.samples++;
     }
 }
+
+/**
+ * @brief Called from the UART interrupt whenever the idle-line receiver has new data
+ */
+static void rxCallback(uint32_t rxCount)
+{
+    gps.rxHead = rxCount;
+    (void)SWI_invokeFromISR(gps.rxSwi);
+}
+
+/**
+ * @brief Frame the received data into sentences and hand them to the parser
+ *        by offset and length into the DMA buffer
+ */
+static void app_gps_rx_SWI(void)
+{
+    const uint32_t head = gps.rxHead;
+
+    if (gps.resync || ((head - gps.sentenceStart) > BUFFER_SIZE))
+    {
+        // The receiver was restarted or the DMA lapped the unparsed data, so the
+        // sentence in progress is lost. A restart is deliberate and not counted
+        if (!gps.resync)
+        {
+            gps.overrun = true;
+            gps.droppedSentences++;
+        }
+        gps.resync          = false;
+        gps.rxTail          = head;
+        gps.sentenceStart   = head;
+        gps.discardSentence = true;
+        return;
+    }
+
+    while (gps.rxTail != head)
+    {
+        const uint32_t offset = gps.rxTail % BUFFER_SIZE;
+        uint32_t       span   = head - gps.rxTail;
+
+        if (span > (BUFFER_SIZE - offset))
+        {
+            span = BUFFER_SIZE - offset;
+        }
+
+        const uint8_t* eol = memchr(&gps.dmaBuffer[offset], '\n', span);
+        if (eol == NULL)
+        {
+            gps.rxTail += span;
+            continue;
+        }
+
+        gps.rxTail += (uint32_t)(eol - &gps.dmaBuffer[offset]) + 1U;
+
+        const uint32_t len = gps.rxTail - gps.sentenceStart;
+        if (gps.discardSentence)
+        {
+            gps.discardSentence = false;
+        }
+        else if (len > MAX_NMEA_SENTENCE)
+        {
+            gps.droppedSentences++;
+        }
+        else
+        {
+            parse(gps.sentenceStart % BUFFER_SIZE, len);
+        }
+
+        gps.sentenceStart = gps.rxTail;
+    }
+}
 #endif // if FEATURE_IS_ENABLED(FEATURE_GPSTRANSCEIVER)
 
 /******************************************************************************
  *                       P U B L I C  F U N C T I O N S
  ******************************************************************************/
 
+/**
+ * @brief Discard the sentence in progress after the receiver has been restarted
+ *        May be called from interrupt context
+ */
 void app_gps_resetBuffers(void)
 {
-    LIB_BUFFER_CIRC_CLEAR(&gps.dmaBuffer);
-    LIB_BUFFER_FIFO_CLEAR(&gps.sentence);
+#if FEATURE_IS_ENABLED(FEATURE_GPSTRANSCEIVER)
+    gps.resync = true;
+#endif // FEATURE_GPSTRANSCEIVER
 }
 
 void app_gps_getPos(app_gps_pos_S* pos)
@@ -538,6 +638,16 @@ uint16_t app_gps_getSentenceCountPairMsg(void)
     return gps.sentenceCountPairMsg;
 }
 
+uint16_t app_gps_getRxBytesPerSecond(void)
+{
+    return gps.rxBytesPerSecond;
+}
+
+uint16_t app_gps_getDroppedSentences(void)
+{
+    return gps.droppedSentences;
+}
+
 uint16_t app_gps_getUartErrorOreCount(void)
 {
     return gps.uartErrorOreCount;
@@ -625,8 +735,8 @@ static void app_gps_init(void)
     drv_timer_init(&gps.timeout);
 
 #if FEATURE_IS_ENABLED(FEATURE_GPSTRANSCEIVER)
-    LIB_BUFFER_CIRC_CLEAR(&gps.dmaBuffer);
-    HW_UART_startDMARX(HW_UART_PORT_GPS, (uint32_t*)&gps.dmaBuffer, BUFFER_SIZE);
+    gps.rxSwi = SWI_create(RTOS_SWI_PRI_0, &app_gps_rx_SWI);
+    HW_UART_startDMARXIdle(HW_UART_PORT_GPS, gps.dmaBuffer, BUFFER_SIZE, &rxCallback);
     drv_outputAD_setDigitalActiveState(DRV_OUTPUTAD_DIGITAL_MCU_UART_EN, DRV_IO_ACTIVE);
 #endif // FEATURE_GPSTRANSCEIVER
 }
@@ -634,29 +744,11 @@ static void app_gps_init(void)
 static void app_gps_periodic_100Hz(void)
 {
 #if FEATURE_IS_ENABLED(FEATURE_GPSTRANSCEIVER)
-    bool overrun = false;
-
-    while (LIB_BUFFER_CIRC_PEEK(&gps.dmaBuffer))
-    {
-        uint8_t ch = LIB_BUFFER_CIRC_GETSET(&gps.dmaBuffer, 0U);
-
-        if (LIB_BUFFER_CIRC_PEEKN(&gps.dmaBuffer, -1))
-        {
-            HW_UART_stopDMA(HW_UART_PORT_GPS);
-            app_gps_resetBuffers();
-            HW_UART_startDMARX(HW_UART_PORT_GPS, (uint32_t*)&gps.dmaBuffer, BUFFER_SIZE);
-            overrun = true;
-        }
-        else
-        {
-            LIB_BUFFER_FIFO_INSERT(&gps.sentence, ch);
-            if (ch == '\n')
-            {
-                parse((uint8_t*)&gps.sentence.buffer, LIB_BUFFER_FIFO_GETLENGTH(&gps.sentence));
-                LIB_BUFFER_FIFO_CLEAR(&gps.sentence);
-            }
-        }
-    }
+    // Sentences are parsed by the receive SWI, this only latches the overrun reported since the last run
+    taskENTER_CRITICAL();
+    const bool overrun = gps.overrun;
+    gps.overrun = false;
+    taskEXIT_CRITICAL();
 
     const bool gpsValid     = drv_timer_getState(&gps.timeout) == DRV_TIMER_RUNNING;
     const bool gpsDataValid = app_gps_isValid();
@@ -669,7 +761,19 @@ static void app_gps_periodic_100Hz(void)
 #endif // !FEATURE_GPSTRANSCEIVER
 }
 
+static void app_gps_periodic_1Hz(void)
+{
+#if FEATURE_IS_ENABLED(FEATURE_GPSTRANSCEIVER)
+    const uint32_t head  = gps.rxHead;
+    const uint32_t bytes = head - gps.rxHeadLastSecond;
+
+    gps.rxBytesPerSecond = (bytes > UINT16_MAX) ? UINT16_MAX : (uint16_t)bytes;
+    gps.rxHeadLastSecond = head;
+#endif // FEATURE_GPSTRANSCEIVER
+}
+
 const ModuleDesc_S app_gps_desc = {
     .moduleInit        = &app_gps_init,
     .periodic100Hz_CLK = &app_gps_periodic_100Hz,
+    .periodic1Hz_CLK   = &app_gps_periodic_1Hz,
 };
@@ -93,6 +93,8 @@ uint16_t                  app_gps_getSentenceCountGsa(void);
 uint16_t                  app_gps_getSentenceCountGsv(void);
 uint16_t                  app_gps_getSentenceCountRmc(void);
 uint16_t                  app_gps_getSentenceCountPairMsg(void);
+uint16_t                  app_gps_getRxBytesPerSecond(void);
+uint16_t                  app_gps_getDroppedSentences(void);
 uint16_t                  app_gps_getUartErrorOreCount(void);
 uint16_t                  app_gps_getUartErrorFeCount(void);
 uint16_t                  app_gps_getUartErrorNeCount(void);
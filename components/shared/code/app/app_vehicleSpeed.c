@@ -416,6 +416,62 @@ float32_t app_vehicleSpeed_getAxleSlip(axle_E axle)
     return calculateSlip(vel_axle, vel_veh);
 }
 
+/**
+ * @brief Wheel speed measured as of now rather than as of the last 100Hz update. Wheels on
+ *        timer channels are measured from their captured edges, any other or unavailable
+ *        wheel reads as its last update
+ * @param wheel Wheel to sample
+ * @return Wheel speed in rpm
+ */
+float32_t app_vehicleSpeed_sampleWheelSpeedRotational(wheel_E wheel)
+{
+    if ((app_wheelSpeed_config.sensorType[wheel] == WS_SENSORTYPE_TIM_CHANNEL) && !isWheelUnavailable(wheel))
+    {
+        return HW_TIM_getFreq(app_wheelSpeed_config.config[wheel].channel_freq) * 60.0f;
+    }
+
+    return (float32_t)vehicle.rpm_wheel[wheel];
+}
+
+/**
+ * @brief Axle speed measured as of now, see app_vehicleSpeed_sampleWheelSpeedRotational
+ * @param axle Axle to sample
+ * @return Axle speed in rpm
+ */
+float32_t app_vehicleSpeed_sampleAxleSpeedRotational(axle_E axle)
+{
+    const wheel_E wheelLeft  = (axle == AXLE_FRONT) ? WHEEL_FL : WHEEL_RL;
+    const wheel_E wheelRight = otherWheelOnAxle(wheelLeft);
+    float32_t     sum        = 0.0f;
+    uint8_t       count      = 0U;
+
+    if (!isWheelUnavailable(wheelLeft))
+    {
+        sum += app_vehicleSpeed_sampleWheelSpeedRotational(wheelLeft);
+        count++;
+    }
+    if (!isWheelUnavailable(wheelRight))
+    {
+        sum += app_vehicleSpeed_sampleWheelSpeedRotational(wheelRight);
+        count++;
+    }
+
+    return (count > 0U) ? (sum / (float32_t)count) : (float32_t)getFallbackWheelRpm(wheelLeft);
+}
+
+/**
+ * @brief Axle slip against the vehicle speed, with the axle speed measured as of now
+ * @param axle Axle to sample
+ * @return Slip ratio
+ */
+float32_t app_vehicleSpeed_sampleAxleSlip(axle_E axle)
+{
+    const float32_t vel_axle = RPM_TO_MPS(app_vehicleSpeed_sampleAxleSpeedRotational(axle));
+    const float32_t vel_veh  = app_vehicleSpeed_getVehicleSpeed();
+
+    return calculateSlip(vel_axle, vel_veh);
+}
+
 #if FEATURE_IS_ENABLED(FEATURE_VEHICLESPEED_LEADER) || FEATURE_IS_ENABLED(FEATURE_VEHICLESPEED_USEODOMETER)
 float32_t app_vehicleSpeed_getOdometer(void)
 {
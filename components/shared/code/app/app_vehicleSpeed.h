@@ -81,6 +81,9 @@ uint16_t  app_vehicleSpeed_getWheelSpeedRotational(wheel_E wheel);
 float32_t app_vehicleSpeed_getWheelSpeedLinear(wheel_E wheel);
 float32_t app_vehicleSpeed_getTireSlip(wheel_E wheel);
 float32_t app_vehicleSpeed_getAxleSlip(axle_E axle);
+float32_t app_vehicleSpeed_sampleWheelSpeedRotational(wheel_E wheel);
+float32_t app_vehicleSpeed_sampleAxleSpeedRotational(axle_E axle);
+float32_t app_vehicleSpeed_sampleAxleSlip(axle_E axle);
 
 float32_t app_vehicleSpeed_getVehicleSpeed(void);
 #if FEATURE_IS_ENABLED(FEATURE_VEHICLESPEED_LEADER) || FEATURE_IS_ENABLED(FEATURE_VEHICLESPEED_USEODOMETER)
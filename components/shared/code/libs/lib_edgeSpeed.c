@@ -0,0 +1,123 @@
+/**
+ * @file lib_edgeSpeed.c
+ * @brief Source code for the edge timestamp speed library
+ */
+
+/******************************************************************************
+ *                             I N C L U D E S
+ ******************************************************************************/
+
+#include "lib_edgeSpeed.h"
+
+#include <string.h>
+
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+#define RING_MASK    (LIB_EDGESPEED_RING_SIZE - 1U)
+
+_Static_assert((LIB_EDGESPEED_RING_SIZE & RING_MASK) == 0U, "LIB_EDGESPEED_RING_SIZE must be a power of two");
+
+/******************************************************************************
+ *                       P U B L I C  F U N C T I O N S
+ ******************************************************************************/
+
+/**
+ * @brief Forget every edge of a ring
+ * @param ring The ring to reset
+ */
+void lib_edgeSpeed_reset(lib_edgeSpeed_ring_S* ring)
+{
+    memset((void*)ring, 0x00U, sizeof(*ring));
+}
+
+/**
+ * @brief Record an edge. Safe to call from an ISR while lower priority code reads the rate,
+ *        since the edge is stored before it is counted and readers never look at the slot
+ *        being written. An edge dated before the newest one is dropped, the rate math
+ *        relies on the edges being in order
+ * @param ring The ring to record into
+ * @param tick Timestamp of the edge
+ */
+void lib_edgeSpeed_push(lib_edgeSpeed_ring_S* ring, uint64_t tick)
+{
+    const uint32_t count = ring->count;
+
+    if ((count != 0U) && (tick < ring->edges[(count - 1U) & RING_MASK]))
+    {
+        return;
+    }
+
+    ring->edges[count & RING_MASK] = tick;
+    ring->count                    = count + 1U;
+}
+
+/**
+ * @brief Get the timestamp of the newest edge
+ * @param ring The ring to read
+ * @return Timestamp of the newest edge, 0 if there is none
+ */
+uint64_t lib_edgeSpeed_getLastEdge(const lib_edgeSpeed_ring_S* ring)
+{
+    const uint32_t count = ring->count;
+
+    return (count == 0U) ? 0U : ring->edges[(count - 1U) & RING_MASK];
+}
+
+/**
+ * @brief Get the rate at which edges arrive
+ * @param ring The ring to read
+ * @param config Measurement window and timeout
+ * @param now Current time in the same ticks as the edges
+ * @return Edges per second
+ */
+float32_t lib_edgeSpeed_getEdgeRate(const lib_edgeSpeed_ring_S* ring, const lib_edgeSpeed_config_S* config, uint64_t now)
+{
+    const uint32_t count = ring->count;
+
+    if (count < 2U)
+    {
+        return 0.0f;
+    }
+
+    const uint64_t newest      = ring->edges[(count - 1U) & RING_MASK];
+    const uint64_t sinceNewest = (now > newest) ? (now - newest) : 0U;
+
+    if (sinceNewest >= config->timeoutTicks)
+    {
+        return 0.0f;
+    }
+
+    const uint32_t available = ((count - 1U) < config->maxIntervals) ? (count - 1U) : config->maxIntervals;
+    uint32_t       intervals = 1U;
+    uint64_t       oldest    = ring->edges[(count - 2U) & RING_MASK];
+
+    for (uint32_t i = 2U; i <= available; i++)
+    {
+        const uint64_t edge = ring->edges[(count - 1U - i) & RING_MASK];
+
+        if ((newest - edge) > config->windowTicks)
+        {
+            break;
+        }
+
+        intervals = i;
+        oldest    = edge;
+    }
+
+    const uint64_t span = newest - oldest;
+
+    if (span == 0U)
+    {
+        return 0.0f;
+    }
+
+    // the period in progress is already longer than the measured ones
+    if ((sinceNewest * intervals) > span)
+    {
+        return (float32_t)config->ticksPerSecond / (float32_t)sinceNewest;
+    }
+
+    return ((float32_t)intervals * (float32_t)config->ticksPerSecond) / (float32_t)span;
+}
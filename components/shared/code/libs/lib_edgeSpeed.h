@@ -0,0 +1,56 @@
+/**
+ * @file lib_edgeSpeed.h
+ * @brief Header file for the edge timestamp speed library
+ *
+ * Usage
+ * 1. Declare a lib_edgeSpeed_ring_S per sensor and reset it
+ * 2. Push the timestamp of every sensor edge with lib_edgeSpeed_push(), e.g. from an input capture ISR
+ * 3. Get the edge rate at any time with lib_edgeSpeed_getEdgeRate()
+ *
+ * The rate is measured over the edges within the configured window of the
+ * newest one: at low speed that is a single period, at high speed the edges
+ * in the window are counted over their exact span. Between edges, the time
+ * since the newest edge bounds the current period from below, so a slowing
+ * sensor reads slower before its next edge arrives.
+ */
+
+#pragma once
+
+/******************************************************************************
+ *                             I N C L U D E S
+ ******************************************************************************/
+
+#include "LIB_Types.h"
+
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+#define LIB_EDGESPEED_RING_SIZE    16U    // must be a power of two
+
+/******************************************************************************
+ *                             T Y P E D E F S
+ ******************************************************************************/
+
+typedef struct
+{
+    volatile uint64_t edges[LIB_EDGESPEED_RING_SIZE];    // [ticks] timestamps of the newest edges
+    volatile uint32_t count;                             // edges pushed since the last reset
+} lib_edgeSpeed_ring_S;
+
+typedef struct
+{
+    uint64_t windowTicks;     // [ticks] average over the edges at most this long before the newest one
+    uint64_t timeoutTicks;    // [ticks] report a rate of 0 once no edge arrived for this long
+    uint32_t ticksPerSecond;
+    uint8_t  maxIntervals;    // average over at most this many edge intervals, less than LIB_EDGESPEED_RING_SIZE - 1
+} lib_edgeSpeed_config_S;
+
+/******************************************************************************
+ *            P U B L I C  F U N C T I O N  P R O T O T Y P E S
+ ******************************************************************************/
+
+void      lib_edgeSpeed_reset(lib_edgeSpeed_ring_S* ring);
+void      lib_edgeSpeed_push(lib_edgeSpeed_ring_S* ring, uint64_t tick);
+uint64_t  lib_edgeSpeed_getLastEdge(const lib_edgeSpeed_ring_S* ring);
+float32_t lib_edgeSpeed_getEdgeRate(const lib_edgeSpeed_ring_S* ring, const lib_edgeSpeed_config_S* config, uint64_t now);
@@ -24,6 +24,122 @@ static float32_t lib_interpolation_private_doInterpolation(lib_interpolation_poi
     return start->y + dy2y1 * (dxx1 / dx2x1);
 }
 
+/**
+ * @brief Find the segment of a mapping containing x
+ * @param mapping Pointer to mapping
+ * @param x The value to look up, strictly between the first and last points
+ * @return Index i such that points[i].x <= x < points[i + 1].x
+ */
+static uint8_t lib_interpolation_private_findSegment(lib_interpolation_mapping_S * const mapping, float32_t x)
+{
+    uint8_t i = 0U;
+
+    if (mapping->search == LIB_INTERPOLATION_SEARCH_BINARY)
+    {
+        uint8_t hi = (uint8_t)(mapping->number_points - 1U);
+
+        while ((i + 1U) < hi)
+        {
+            const uint8_t mid = (uint8_t)((i + hi) / 2U);
+
+            if (mapping->points[mid].x > x)
+            {
+                hi = mid;
+            }
+            else
+            {
+                i = mid;
+            }
+        }
+    }
+    else
+    {
+        while (mapping->points[i + 1U].x <= x)
+        {
+            i++;
+        }
+    }
+
+    return i;
+}
+
+/**
+ * @brief Find the segment of a breakpoint axis containing v, saturating at both ends
+ * @param breakpoints Strictly increasing breakpoints
+ * @param number_breakpoints Number of breakpoints, at least 2
+ * @param search How to find the segment
+ * @param inv_spacing 1 / breakpoint spacing for LIB_INTERPOLATION_SEARCH_UNIFORM
+ * @param v The value to look up
+ * @param fraction Position of v within the segment, from 0 to 1
+ * @return Index of the first breakpoint of the segment
+ */
+static uint8_t lib_interpolation_private_findAxis(const float32_t * const  breakpoints,
+                                                  uint8_t                  number_breakpoints,
+                                                  lib_interpolation_search_E search,
+                                                  float32_t                inv_spacing,
+                                                  float32_t                v,
+                                                  float32_t * const        fraction)
+{
+    const uint8_t last = (uint8_t)(number_breakpoints - 1U);
+    uint8_t       i    = 0U;
+
+    if (v <= breakpoints[0])
+    {
+        *fraction = 0.0f;
+        return 0U;
+    }
+
+    if (!(v < breakpoints[last]))
+    {
+        *fraction = 1.0f;
+        return (uint8_t)(last - 1U);
+    }
+
+    switch (search)
+    {
+        case LIB_INTERPOLATION_SEARCH_UNIFORM:
+        {
+            const float32_t t = (v - breakpoints[0]) * inv_spacing;
+
+            i         = (uint8_t)t;
+            i         = (i < last) ? i : (uint8_t)(last - 1U);
+            *fraction = t - (float32_t)i;
+            return i;
+        }
+
+        case LIB_INTERPOLATION_SEARCH_BINARY:
+        {
+            uint8_t hi = last;
+
+            while ((i + 1U) < hi)
+            {
+                const uint8_t mid = (uint8_t)((i + hi) / 2U);
+
+                if (breakpoints[mid] > v)
+                {
+                    hi = mid;
+                }
+                else
+                {
+                    i = mid;
+                }
+            }
+        }
+        break;
+
+        case LIB_INTERPOLATION_SEARCH_LINEAR:
+        default:
+            while (breakpoints[i + 1U] <= v)
+            {
+                i++;
+            }
+            break;
+    }
+
+    *fraction = (v - breakpoints[i]) / (breakpoints[i + 1U] - breakpoints[i]);
+    return i;
+}
+
 /******************************************************************************
  *            P U B L I C  F U N C T I O N  P R O T O T Y P E S
  ******************************************************************************/
@@ -46,22 +162,52 @@ void lib_interpolation_init(lib_interpolation_mapping_S * const mapping, float32
  */
 float32_t lib_interpolation_interpolate(lib_interpolation_mapping_S * const mapping, float32_t x)
 {
+    const uint8_t last = (uint8_t)(mapping->number_points - 1U);
+
     if (x <= mapping->points[0].x)
     {
         return (mapping->saturate_left) ? mapping->points[0].y :
                lib_interpolation_private_doInterpolation(&mapping->points[0], &mapping->points[1], x);
     }
 
-    for (uint8_t i = 0; i < mapping->number_points - 1; i++)
+    // also catches NaN, which saturates right like it always has
+    if (!(x < mapping->points[last].x))
     {
-        if (mapping->points[i + 1].x > x)
-        {
-            return lib_interpolation_private_doInterpolation(&mapping->points[i], &mapping->points[i + 1], x);
-        }
+        return (mapping->saturate_right) ? mapping->points[last].y :
+               lib_interpolation_private_doInterpolation(&mapping->points[last - 1U], &mapping->points[last], x);
+    }
+
+    if (mapping->search == LIB_INTERPOLATION_SEARCH_UNIFORM)
+    {
+        const float32_t t = (x - mapping->points[0].x) * mapping->inv_spacing;
+        uint8_t         i = (uint8_t)t;
+
+        i = (i < last) ? i : (uint8_t)(last - 1U);
+
+        return mapping->points[i].y + (mapping->points[i + 1U].y - mapping->points[i].y) * (t - (float32_t)i);
     }
 
-    return (mapping->saturate_right) ? mapping->points[mapping->number_points - 1].y :
-           lib_interpolation_private_doInterpolation(&mapping->points[mapping->number_points - 2],
-                                                     &mapping->points[mapping->number_points - 1],
-                                                     x);
+    const uint8_t i = lib_interpolation_private_findSegment(mapping, x);
+
+    return lib_interpolation_private_doInterpolation(&mapping->points[i], &mapping->points[i + 1U], x);
+}
+
+/**
+ * @brief Bilinearly interpolate a value in a 2D table, saturating at the edges
+ * @param table Pointer to table
+ * @param x The value to look up along the x breakpoints
+ * @param y The value to look up along the y breakpoints
+ * @return The value corresponding to (x, y) in the table
+ */
+float32_t lib_interpolation_table2d(const lib_interpolation_table2d_S * const table, float32_t x, float32_t y)
+{
+    float32_t       fx    = 0.0f;
+    float32_t       fy    = 0.0f;
+    const uint8_t   ix    = lib_interpolation_private_findAxis(table->x, table->number_x, table->search, table->inv_spacing_x, x, &fx);
+    const uint8_t   iy    = lib_interpolation_private_findAxis(table->y, table->number_y, table->search, table->inv_spacing_y, y, &fy);
+    const float32_t * row = &table->z[(uint16_t)iy * table->number_x + ix];
+    const float32_t z0    = row[0] + (row[1] - row[0]) * fx;
+    const float32_t z1    = row[table->number_x] + (row[table->number_x + 1U] - row[table->number_x]) * fx;
+
+    return z0 + (z1 - z0) * fy;
 }
@@ -13,7 +13,19 @@
  *    set the saturate left member to true. The same is applicable to the right.
  *    In other words:
  *    - f(c) = (c < point[0].x) ? point[0].x : interpolate(c)
- * 4. Initialize a point with lib_interpolation_init
+ * 4. Pick how the segment containing x is found. Linear is the default and is the
+ *    fastest for a handful of points. Large maps should use
+ *    .search = LIB_INTERPOLATION_SEARCH_BINARY, and maps whose x are evenly spaced
+ *    should use LIB_INTERPOLATION_UNIFORM(first x, last x, COUNTOF(points)), which
+ *    finds the segment in constant time and without a division
+ * 5. Initialize a point with lib_interpolation_init
+ *
+ * 2D tables
+ * 1. Declare the x and y breakpoints, ordered as above, and the z values in row
+ *    major order, i.e. z[iy * number_x + ix] is the value at (x[ix], y[iy])
+ * 2. Declare a lib_interpolation_table2d_S. The search applies to both axes, use
+ *    LIB_INTERPOLATION_UNIFORM_2D() when both are evenly spaced
+ * 3. Look values up with lib_interpolation_table2d, which saturates at every edge
  */
 
 #pragma once
@@ -24,10 +36,33 @@
 
 #include "LIB_Types.h"
 
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+#define LIB_INTERPOLATION_INV_SPACING(first_x, last_x, number_points) \
+        ((float32_t)((number_points) - 1U) / ((float32_t)(last_x) - (float32_t)(first_x)))
+
+// Designated initializers for evenly spaced mappings and tables
+#define LIB_INTERPOLATION_UNIFORM(first_x, last_x, number_points) \
+        .search      = LIB_INTERPOLATION_SEARCH_UNIFORM,          \
+        .inv_spacing = LIB_INTERPOLATION_INV_SPACING(first_x, last_x, number_points)
+#define LIB_INTERPOLATION_UNIFORM_2D(first_x, last_x, number_x, first_y, last_y, number_y) \
+        .search        = LIB_INTERPOLATION_SEARCH_UNIFORM,                                 \
+        .inv_spacing_x = LIB_INTERPOLATION_INV_SPACING(first_x, last_x, number_x),         \
+        .inv_spacing_y = LIB_INTERPOLATION_INV_SPACING(first_y, last_y, number_y)
+
 /******************************************************************************
  *                             T Y P E D E F S
  ******************************************************************************/
 
+typedef enum
+{
+    LIB_INTERPOLATION_SEARCH_LINEAR = 0x00U,
+    LIB_INTERPOLATION_SEARCH_BINARY,
+    LIB_INTERPOLATION_SEARCH_UNIFORM,
+} lib_interpolation_search_E;
+
 typedef struct
 {
     float32_t x;
@@ -36,16 +71,31 @@ typedef struct
 
 typedef struct
 {
-    lib_interpolation_point_S * points;
-    const uint8_t             number_points;
-    const bool                saturate_left;
-    const bool                saturate_right;
-    float32_t                 result;
+    lib_interpolation_point_S        * points;
+    const uint8_t                    number_points;
+    const bool                       saturate_left;
+    const bool                       saturate_right;
+    const lib_interpolation_search_E search;
+    const float32_t                  inv_spacing;    // 1 / (x[i + 1] - x[i]) for LIB_INTERPOLATION_SEARCH_UNIFORM
+    float32_t                        result;
 } lib_interpolation_mapping_S;
 
+typedef struct
+{
+    const float32_t                  * x;
+    const float32_t                  * y;
+    const float32_t                  * z;
+    const uint8_t                    number_x;
+    const uint8_t                    number_y;
+    const lib_interpolation_search_E search;
+    const float32_t                  inv_spacing_x;
+    const float32_t                  inv_spacing_y;
+} lib_interpolation_table2d_S;
+
 /******************************************************************************
  *            P U B L I C  F U N C T I O N  P R O T O T Y P E S
  ******************************************************************************/
 
 void      lib_interpolation_init(lib_interpolation_mapping_S * const mapping, float32_t init_value);
 float32_t lib_interpolation_interpolate(lib_interpolation_mapping_S * const mapping, float32_t x);
+float32_t lib_interpolation_table2d(const lib_interpolation_table2d_S * const table, float32_t x, float32_t y);
@@ -0,0 +1,162 @@
+#include "lib_edgeSpeed.h"
+#include "unity.h"
+
+#define TICKS_PER_SECOND    1000000U
+#define PERIOD_TICKS        1000U    // 1 kHz
+
+static const lib_edgeSpeed_config_S config = {
+    .windowTicks    = 50000U,
+    .timeoutTicks   = 500000U,
+    .ticksPerSecond = TICKS_PER_SECOND,
+    .maxIntervals   = 8U,
+};
+
+static lib_edgeSpeed_ring_S ring;
+
+static uint64_t pushSteady(uint64_t first, uint64_t period, uint32_t edges)
+{
+    uint64_t tick = first;
+
+    for (uint32_t i = 0U; i < edges; i++)
+    {
+        tick = first + (period * i);
+        lib_edgeSpeed_push(&ring, tick);
+    }
+
+    return tick;
+}
+
+void setUp(void)
+{
+    lib_edgeSpeed_reset(&ring);
+}
+
+void tearDown(void)
+{
+}
+
+void test_needs_two_edges_for_a_rate(void)
+{
+    TEST_ASSERT_EQUAL_UINT64(0U, lib_edgeSpeed_getLastEdge(&ring));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, 100U));
+
+    lib_edgeSpeed_push(&ring, 5000U);
+    TEST_ASSERT_EQUAL_UINT64(5000U, lib_edgeSpeed_getLastEdge(&ring));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, 5100U));
+
+    lib_edgeSpeed_push(&ring, 5000U + PERIOD_TICKS);
+    TEST_ASSERT_EQUAL_FLOAT(1000.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, 5000U + PERIOD_TICKS));
+}
+
+void test_steady_rate(void)
+{
+    const uint64_t newest = pushSteady(PERIOD_TICKS, PERIOD_TICKS, 10U);
+
+    for (uint64_t since = 0U; since <= PERIOD_TICKS; since += 100U)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(1000.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, newest + since));
+    }
+}
+
+void test_only_edges_in_the_window_are_averaged(void)
+{
+    // 200 Hz edges that fall out of the window, then 50 Hz ones
+    pushSteady(1000U, 5000U, 4U);
+    const uint64_t newest = pushSteady(36000U, 20000U, 3U);
+
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, newest));
+}
+
+void test_only_max_intervals_are_averaged(void)
+{
+    // 10 kHz edges older than maxIntervals, then 1 kHz ones
+    pushSteady(1000U, 100U, 6U);
+    const uint64_t newest = pushSteady(2000U, PERIOD_TICKS, config.maxIntervals + 1U);
+
+    TEST_ASSERT_EQUAL_FLOAT(1000.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, newest));
+}
+
+void test_decelerating_wheel_reads_slower_between_edges(void)
+{
+    const uint64_t newest = pushSteady(PERIOD_TICKS, PERIOD_TICKS, 10U);
+    float32_t      last   = lib_edgeSpeed_getEdgeRate(&ring, &config, newest + PERIOD_TICKS);
+
+    TEST_ASSERT_EQUAL_FLOAT(1000.0f, last);
+
+    // once the period in progress outlasts the average one, it bounds the rate from above
+    for (uint64_t since = PERIOD_TICKS + 250U; since <= 10U * PERIOD_TICKS; since += 250U)
+    {
+        const float32_t rate = lib_edgeSpeed_getEdgeRate(&ring, &config, newest + since);
+
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, (float32_t)TICKS_PER_SECOND / (float32_t)since, rate);
+        TEST_ASSERT_TRUE(rate < last);
+        last = rate;
+    }
+}
+
+void test_times_out_without_edges(void)
+{
+    const uint64_t newest = pushSteady(PERIOD_TICKS, PERIOD_TICKS, 10U);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f,
+                             (float32_t)TICKS_PER_SECOND / (float32_t)(config.timeoutTicks - 1U),
+                             lib_edgeSpeed_getEdgeRate(&ring, &config, newest + config.timeoutTicks - 1U));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, newest + config.timeoutTicks));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, newest + (2U * config.timeoutTicks)));
+}
+
+void test_now_before_the_newest_edge_reads_the_measured_rate(void)
+{
+    const uint64_t newest = pushSteady(PERIOD_TICKS, PERIOD_TICKS, 10U);
+
+    TEST_ASSERT_EQUAL_FLOAT(1000.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, newest - 10U));
+}
+
+void test_backwards_edge_is_dropped(void)
+{
+    const uint64_t newest = pushSteady(PERIOD_TICKS, PERIOD_TICKS, 10U);
+
+    // a timestamp read torn around a tick rollover lands about 1 ms early
+    lib_edgeSpeed_push(&ring, newest - PERIOD_TICKS - 1U);
+
+    TEST_ASSERT_EQUAL_UINT64(newest, lib_edgeSpeed_getLastEdge(&ring));
+    TEST_ASSERT_EQUAL_FLOAT(1000.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, newest));
+
+    lib_edgeSpeed_push(&ring, newest + PERIOD_TICKS);
+    TEST_ASSERT_EQUAL_FLOAT(1000.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, newest + PERIOD_TICKS));
+}
+
+void test_count_wraps_past_the_ring(void)
+{
+    // slow edges fill the ring first so a wrong slot after the wrap changes the rate
+    uint64_t newest = pushSteady(1000U, 4000U, LIB_EDGESPEED_RING_SIZE);
+
+    for (uint32_t edge = 0U; edge < (3U * LIB_EDGESPEED_RING_SIZE) + 5U; edge++)
+    {
+        newest += PERIOD_TICKS;
+        lib_edgeSpeed_push(&ring, newest);
+
+        TEST_ASSERT_EQUAL_UINT64(newest, lib_edgeSpeed_getLastEdge(&ring));
+        if (edge >= config.maxIntervals)
+        {
+            TEST_ASSERT_EQUAL_FLOAT(1000.0f, lib_edgeSpeed_getEdgeRate(&ring, &config, newest));
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32((4U * LIB_EDGESPEED_RING_SIZE) + 5U, ring.count);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_needs_two_edges_for_a_rate);
+    RUN_TEST(test_steady_rate);
+    RUN_TEST(test_only_edges_in_the_window_are_averaged);
+    RUN_TEST(test_only_max_intervals_are_averaged);
+    RUN_TEST(test_decelerating_wheel_reads_slower_between_edges);
+    RUN_TEST(test_times_out_without_edges);
+    RUN_TEST(test_now_before_the_newest_edge_reads_the_measured_rate);
+    RUN_TEST(test_backwards_edge_is_dropped);
+    RUN_TEST(test_count_wraps_past_the_ring);
+    return UNITY_END();
+}
@@ -0,0 +1,101 @@
+#define _POSIX_C_SOURCE    199309L
+
+#include "lib_interpolation.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define MAP_POINTS    64U
+#define LOOKUPS       1000000U
+
+static lib_interpolation_point_S points[MAP_POINTS];
+static float32_t                 inputs[1024U];
+static volatile float32_t        sink;
+
+static double nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+static double benchmark(lib_interpolation_mapping_S* mapping)
+{
+    float32_t  sum   = 0.0f;
+    const double start = nowNs();
+
+    for (uint32_t i = 0U; i < LOOKUPS; i++)
+    {
+        sum += lib_interpolation_interpolate(mapping, inputs[i & 1023U]);
+    }
+
+    const double elapsed = nowNs() - start;
+
+    sink = sum;
+    return elapsed / (double)LOOKUPS;
+}
+
+void setUp(void)
+{
+    for (uint8_t i = 0U; i < MAP_POINTS; i++)
+    {
+        points[i].x = (float32_t)i * 2.5f;
+        points[i].y = (float32_t)((i * 37U) % 11U);
+    }
+
+    // deterministic spread across and slightly beyond the map
+    uint32_t state = 12345U;
+    for (uint16_t i = 0U; i < 1024U; i++)
+    {
+        state     = (state * 1103515245U) + 12345U;
+        inputs[i] = ((float32_t)(state >> 8) / (float32_t)(1U << 24)) * 165.0f - 2.5f;
+    }
+}
+
+void tearDown(void)
+{
+}
+
+void test_report_lookup_time_per_search(void)
+{
+    lib_interpolation_mapping_S linear = {
+        .points         = points,
+        .number_points  = MAP_POINTS,
+        .saturate_left  = true,
+        .saturate_right = true,
+    };
+    lib_interpolation_mapping_S binary = {
+        .points         = points,
+        .number_points  = MAP_POINTS,
+        .saturate_left  = true,
+        .saturate_right = true,
+        .search         = LIB_INTERPOLATION_SEARCH_BINARY,
+    };
+    lib_interpolation_mapping_S uniform = {
+        .points         = points,
+        .number_points  = MAP_POINTS,
+        .saturate_left  = true,
+        .saturate_right = true,
+        LIB_INTERPOLATION_UNIFORM(0.0f, (MAP_POINTS - 1U) * 2.5f, MAP_POINTS),
+    };
+
+    printf("%u point map, ns per lookup: linear %.1f, binary %.1f, uniform %.1f\n",
+           MAP_POINTS,
+           benchmark(&linear),
+           benchmark(&binary),
+           benchmark(&uniform));
+
+    for (uint16_t i = 0U; i < 1024U; i++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, lib_interpolation_interpolate(&linear, inputs[i]), lib_interpolation_interpolate(&uniform, inputs[i]));
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_report_lookup_time_per_search);
+    return UNITY_END();
+}
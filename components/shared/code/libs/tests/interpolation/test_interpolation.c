@@ -0,0 +1,267 @@
+#include "lib_interpolation.h"
+#include "unity.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define COUNT(x)    ((uint8_t)(sizeof(x) / sizeof((x)[0])))
+
+static lib_interpolation_point_S unevenPoints[] = {
+    { .x = -3.0f,  .y = 10.0f },
+    { .x = -1.0f,  .y = -2.0f },
+    { .x =  0.25f, .y = 4.5f  },
+    { .x =  0.5f,  .y = 4.5f  },
+    { .x =  2.0f,  .y = 7.0f  },
+    { .x =  7.5f,  .y = -1.0f },
+    { .x =  9.0f,  .y = 0.0f  },
+};
+
+static lib_interpolation_point_S evenPoints[] = {
+    { .x =  0.0f, .y = 2.42f  },
+    { .x = 10.0f, .y = 3.178f },
+    { .x = 20.0f, .y = 3.37f  },
+    { .x = 30.0f, .y = 3.52f  },
+    { .x = 40.0f, .y = 3.62f  },
+    { .x = 50.0f, .y = 3.75f  },
+    { .x = 60.0f, .y = 3.84f  },
+    { .x = 70.0f, .y = 3.94f  },
+    { .x = 80.0f, .y = 4.05f  },
+    { .x = 90.0f, .y = 4.09f  },
+    { .x = 100.0f, .y = 4.20f },
+};
+
+static const float32_t tableX[] = { 0.0f, 1000.0f, 2000.0f, 3000.0f };
+static const float32_t tableY[] = { 0.0f, 50.0f, 100.0f };
+static const float32_t tableZ[] = {
+    0.0f,  10.0f, 20.0f, 30.0f,
+    5.0f,  15.0f, 35.0f, 40.0f,
+    10.0f, 25.0f, 45.0f, 80.0f,
+};
+
+// The linear scan this library has always done, kept as the reference
+static float32_t referenceInterpolate(const lib_interpolation_point_S* points, uint8_t n, bool left, bool right, float32_t x)
+{
+#define LERP(a, b)    (points[a].y + (points[b].y - points[a].y) * ((x - points[a].x) / (points[b].x - points[a].x)))
+    if (x <= points[0].x)
+    {
+        return left ? points[0].y : LERP(0, 1);
+    }
+
+    for (uint8_t i = 0; i < n - 1; i++)
+    {
+        if (points[i + 1].x > x)
+        {
+            return LERP(i, i + 1);
+        }
+    }
+
+    return right ? points[n - 1].y : LERP(n - 2, n - 1);
+#undef LERP
+}
+
+static void assertSameBits(float32_t expected, float32_t actual, float32_t x)
+{
+    if (isnan(expected))
+    {
+        TEST_ASSERT_TRUE(isnan(actual));
+        return;
+    }
+
+    if (expected != actual)
+    {
+        printf("  x = %.9g\n", (double)x);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(expected, actual);
+    TEST_ASSERT_TRUE(expected == actual);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_linear_and_binary_search_match_reference_exactly(void)
+{
+    for (uint8_t saturate = 0U; saturate < 2U; saturate++)
+    {
+        lib_interpolation_mapping_S linear = {
+            .points         = unevenPoints,
+            .number_points  = COUNT(unevenPoints),
+            .saturate_left  = saturate != 0U,
+            .saturate_right = saturate != 0U,
+        };
+        lib_interpolation_mapping_S binary = {
+            .points         = unevenPoints,
+            .number_points  = COUNT(unevenPoints),
+            .saturate_left  = saturate != 0U,
+            .saturate_right = saturate != 0U,
+            .search         = LIB_INTERPOLATION_SEARCH_BINARY,
+        };
+
+        for (int32_t step = -5000; step <= 12000; step++)
+        {
+            const float32_t x        = (float32_t)step / 1000.0f;
+            const float32_t expected = referenceInterpolate(unevenPoints, COUNT(unevenPoints), saturate != 0U, saturate != 0U, x);
+
+            assertSameBits(expected, lib_interpolation_interpolate(&linear, x), x);
+            assertSameBits(expected, lib_interpolation_interpolate(&binary, x), x);
+        }
+
+        for (uint8_t i = 0U; i < COUNT(unevenPoints); i++)
+        {
+            const float32_t x        = unevenPoints[i].x;
+            const float32_t expected = referenceInterpolate(unevenPoints, COUNT(unevenPoints), saturate != 0U, saturate != 0U, x);
+
+            assertSameBits(expected, lib_interpolation_interpolate(&linear, x), x);
+            assertSameBits(expected, lib_interpolation_interpolate(&binary, x), x);
+        }
+    }
+}
+
+void test_nan_saturates_right_for_every_search(void)
+{
+    lib_interpolation_mapping_S linear = {
+        .points         = unevenPoints,
+        .number_points  = COUNT(unevenPoints),
+        .saturate_left  = true,
+        .saturate_right = true,
+    };
+    lib_interpolation_mapping_S binary = {
+        .points         = unevenPoints,
+        .number_points  = COUNT(unevenPoints),
+        .saturate_left  = true,
+        .saturate_right = true,
+        .search         = LIB_INTERPOLATION_SEARCH_BINARY,
+    };
+    lib_interpolation_mapping_S uniform = {
+        .points         = evenPoints,
+        .number_points  = COUNT(evenPoints),
+        .saturate_left  = true,
+        .saturate_right = true,
+        LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNT(evenPoints)),
+    };
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, lib_interpolation_interpolate(&linear, NAN));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, lib_interpolation_interpolate(&binary, NAN));
+    TEST_ASSERT_EQUAL_FLOAT(4.20f, lib_interpolation_interpolate(&uniform, NAN));
+}
+
+void test_uniform_grid_matches_reference(void)
+{
+    for (uint8_t saturate = 0U; saturate < 2U; saturate++)
+    {
+        lib_interpolation_mapping_S uniform = {
+            .points         = evenPoints,
+            .number_points  = COUNT(evenPoints),
+            .saturate_left  = saturate != 0U,
+            .saturate_right = saturate != 0U,
+            LIB_INTERPOLATION_UNIFORM(0.0f, 100.0f, COUNT(evenPoints)),
+        };
+
+        for (int32_t step = -2000; step <= 12000; step++)
+        {
+            const float32_t x        = (float32_t)step / 100.0f;
+            const float32_t expected = referenceInterpolate(evenPoints, COUNT(evenPoints), saturate != 0U, saturate != 0U, x);
+
+            TEST_ASSERT_FLOAT_WITHIN(1e-5f, expected, lib_interpolation_interpolate(&uniform, x));
+        }
+
+        for (uint8_t i = 0U; i < COUNT(evenPoints); i++)
+        {
+            TEST_ASSERT_EQUAL_FLOAT(evenPoints[i].y, lib_interpolation_interpolate(&uniform, evenPoints[i].x));
+        }
+    }
+}
+
+void test_table2d_hits_grid_points_and_blends_between_them(void)
+{
+    const lib_interpolation_table2d_S table = {
+        .x        = tableX,
+        .y        = tableY,
+        .z        = tableZ,
+        .number_x = COUNT(tableX),
+        .number_y = COUNT(tableY),
+        .search   = LIB_INTERPOLATION_SEARCH_BINARY,
+    };
+
+    for (uint8_t iy = 0U; iy < COUNT(tableY); iy++)
+    {
+        for (uint8_t ix = 0U; ix < COUNT(tableX); ix++)
+        {
+            TEST_ASSERT_EQUAL_FLOAT(tableZ[iy * COUNT(tableX) + ix], lib_interpolation_table2d(&table, tableX[ix], tableY[iy]));
+        }
+    }
+
+    TEST_ASSERT_EQUAL_FLOAT(7.5f,  lib_interpolation_table2d(&table, 500.0f, 25.0f));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, lib_interpolation_table2d(&table, 1250.0f, 0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(60.0f, lib_interpolation_table2d(&table, 3000.0f, 75.0f));
+}
+
+void test_table2d_saturates_outside_the_grid(void)
+{
+    const lib_interpolation_table2d_S table = {
+        .x        = tableX,
+        .y        = tableY,
+        .z        = tableZ,
+        .number_x = COUNT(tableX),
+        .number_y = COUNT(tableY),
+    };
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f,  lib_interpolation_table2d(&table, -100.0f, -5.0f));
+    TEST_ASSERT_EQUAL_FLOAT(80.0f, lib_interpolation_table2d(&table, 5000.0f, 500.0f));
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, lib_interpolation_table2d(&table, -100.0f, 500.0f));
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, lib_interpolation_table2d(&table, 5000.0f, -5.0f));
+}
+
+void test_table2d_searches_agree(void)
+{
+    const lib_interpolation_table2d_S linear = {
+        .x        = tableX,
+        .y        = tableY,
+        .z        = tableZ,
+        .number_x = COUNT(tableX),
+        .number_y = COUNT(tableY),
+    };
+    const lib_interpolation_table2d_S binary = {
+        .x        = tableX,
+        .y        = tableY,
+        .z        = tableZ,
+        .number_x = COUNT(tableX),
+        .number_y = COUNT(tableY),
+        .search   = LIB_INTERPOLATION_SEARCH_BINARY,
+    };
+    const lib_interpolation_table2d_S uniform = {
+        .x        = tableX,
+        .y        = tableY,
+        .z        = tableZ,
+        .number_x = COUNT(tableX),
+        .number_y = COUNT(tableY),
+        LIB_INTERPOLATION_UNIFORM_2D(0.0f, 3000.0f, COUNT(tableX), 0.0f, 100.0f, COUNT(tableY)),
+    };
+
+    for (int32_t x = -200; x <= 3200; x += 37)
+    {
+        for (int32_t y = -10; y <= 110; y += 3)
+        {
+            const float32_t expected = lib_interpolation_table2d(&linear, (float32_t)x, (float32_t)y);
+
+            TEST_ASSERT_TRUE(expected == lib_interpolation_table2d(&binary, (float32_t)x, (float32_t)y));
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f, expected, lib_interpolation_table2d(&uniform, (float32_t)x, (float32_t)y));
+        }
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_linear_and_binary_search_match_reference_exactly);
+    RUN_TEST(test_nan_saturates_right_for_every_search);
+    RUN_TEST(test_uniform_grid_matches_reference);
+    RUN_TEST(test_table2d_hits_grid_points_and_blends_between_them);
+    RUN_TEST(test_table2d_saturates_outside_the_grid);
+    RUN_TEST(test_table2d_searches_agree);
+    return UNITY_END();
+}
@@ -135,6 +135,17 @@ static void display_end(void)
 }
 
 
+/**
+ * common_displayStatic
+ * @brief labels shared on all screens, cached with each page's static display list
+ */
+static void common_displayStatic(void)
+{
+    render_InfoDotLabels(commonInfoDots, INFO_DOT_COUNT);
+    render_InfoTextLabels(commonInfoTexts, INFO_TEXT_COUNT);
+}
+
+
 /**
  * common_display
  *
@@ -15,6 +15,9 @@
 // other includes
 #include "Utility.h"
 
+// includes for data access
+#include "Screen.h"
+
 /******************************************************************************
  *                               M A C R O S
  ******************************************************************************/
@@ -35,12 +38,25 @@
  *                     P R I V A T E  F U N C T I O N S
  ******************************************************************************/
 
+/**
+ * diag_displayStatic
+ * @brief part of the diagnostics display that doesn't change while it is shown
+ */
+static void diag_displayStatic(void)
+{
+    EVE_cmd_dl_burst(DL_COLOR_RGB | WHITE);
+    EVE_cmd_text_burst(160U, 110U, 21U, EVE_OPT_CENTER, "FPS");
+    EVE_cmd_text_burst(320U, 110U, 21U, EVE_OPT_CENTER, "SPI B/frame");
+}
+
 /**
  * diag_display
  *
  */
 static void diag_display(void)
 {
-    // TODO
+    EVE_cmd_dl_burst(DL_COLOR_RGB | WHITE);
+    EVE_cmd_number_burst(160U, 140U, 29U, EVE_OPT_CENTER, SCR.fps);
+    EVE_cmd_number_burst(320U, 140U, 29U, EVE_OPT_CENTER, SCR.cmdBytesPerFrame);
 }
 
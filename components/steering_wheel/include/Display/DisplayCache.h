@@ -0,0 +1,45 @@
+/**
+ * @file DisplayCache.h
+ * @brief Static display-list snippets kept in EVE RAM_G and replayed with CMD_APPEND
+ */
+
+#pragma once
+
+/******************************************************************************
+ *                             I N C L U D E S
+ ******************************************************************************/
+
+#include "Types.h"
+
+
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+#define DISPLAY_CACHE_SLOT_COUNT    3U         // one slot per screen page
+#define DISPLAY_CACHE_SLOT_SIZE     2048UL     // [bytes] 512 display-list commands per slot
+#define DISPLAY_CACHE_BASE          0xF0000UL  // top 64 kB of the 1 MB RAM_G, clear of bitmaps loaded from the bottom
+#define DISPLAY_CACHE_END           0x100000UL // end of the 1 MB RAM_G
+
+
+/******************************************************************************
+ *                             T Y P E D E F S
+ ******************************************************************************/
+
+typedef enum
+{
+    DISPLAY_CACHE_EMPTY = 0U,
+    DISPLAY_CACHE_VALID,
+    DISPLAY_CACHE_TOO_LARGE,    // the snippet doesn't fit its slot, render it every frame instead
+    DISPLAY_CACHE_STALLED,      // the co-processor didn't finish building the snippet, the EVE needs a reinit
+} DisplayCacheState_E;
+
+
+/******************************************************************************
+ *                       P U B L I C  F U N C T I O N S
+ ******************************************************************************/
+
+void                DisplayCache_invalidate(void);
+DisplayCacheState_E DisplayCache_getState(uint8_t slot);
+DisplayCacheState_E DisplayCache_build(uint8_t slot, void (*renderStatic)(void));
+bool                DisplayCache_append_burst(uint8_t slot);
@@ -126,7 +126,11 @@ typedef struct s_InfoText
  ******************************************************************************/
 
 void render_InfoDot(InfoDot_S dot);
+void render_InfoDotLabel(InfoDot_S dot);
 void render_InfoDots(InfoDot_S dots[], uint8_t count);
+void render_InfoDotLabels(InfoDot_S dots[], uint8_t count);
 
 void render_InfoText(InfoText_S dot);
+void render_InfoTextLabel(InfoText_S dot);
 void render_InfoTexts(InfoText_S dots[], uint8_t count);
+void render_InfoTextLabels(InfoText_S dots[], uint8_t count);
@@ -35,6 +35,15 @@
  *                     P R I V A T E  F U N C T I O N S
  ******************************************************************************/
 
+/**
+ * launch_displayStatic
+ * @brief part of the launch control display that doesn't change while it is shown
+ */
+static void launch_displayStatic(void)
+{
+    // TODO
+}
+
 /**
  * launch_display
  *
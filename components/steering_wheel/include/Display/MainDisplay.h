@@ -96,6 +96,16 @@ static ValuePill_S valuePills[VALUE_PILL_COUNT] =
  *                     P R I V A T E  F U N C T I O N S
  ******************************************************************************/
 
+/**
+ * main_displayStatic
+ * @brief part of the main display that doesn't change while it is shown
+ */
+static void main_displayStatic(void)
+{
+    EVE_cmd_romfont_burst(10U, 33U);    // load a bigger font
+    render_ValuePillLabels(valuePills, VALUE_PILL_COUNT);
+}
+
 /**
  * main_display
  *
@@ -103,16 +113,8 @@ static ValuePill_S valuePills[VALUE_PILL_COUNT] =
 static void main_display(void)
 {
     // these will become CANRX macros eventually
-    static uint8_t  currGear    = 0;
-    static uint16_t currRPM     = 0;
-
-    static bool     fontsLoaded = false;
-
-    if (!fontsLoaded)
-    {
-        EVE_cmd_romfont_burst(10U, 33U);    // load a bigger font
-        fontsLoaded = true;
-    }
+    static uint8_t  currGear = 0;
+    static uint16_t currRPM  = 0;
 
     char gear[7][2] = { "?", "N", "1", "2", "3", "4", "5" };
 
@@ -28,6 +28,7 @@
             .label     = l,                                  \
             .bgColor   = 0U,                                 \
             .fgColor   = 0U,                                 \
+            .labelColor = WHITE,                             \
             .value     = 0U,                                 \
             .precision = p,                                  \
             .unit      = u,                                  \
@@ -63,4 +64,6 @@ typedef struct s_ValuePill
  ******************************************************************************/
 
 void render_ValuePill(ValuePill_S pill);
+void render_ValuePillLabel(ValuePill_S pill);
 void render_ValuePills(ValuePill_S pills[], uint8_t count);
+void render_ValuePillLabels(ValuePill_S pills[], uint8_t count);
@@ -50,6 +50,8 @@ typedef struct
     uint8_t          brightness;
     ScrState_E       state;
     bool             heartbeat;
+    uint8_t          fps;                 // frames rendered in the last second
+    uint16_t         cmdBytesPerFrame;    // co-processor command bytes streamed over SPI for the last frame
 } SCR_S;
 
 // ***************************************************************************//
@@ -0,0 +1,176 @@
+/**
+ * @file DisplayCache.c
+ * @brief Static display-list snippets kept in EVE RAM_G and replayed with CMD_APPEND
+ *
+ * The co-processor expands a page's static commands (labels, layout, fonts)
+ * into the display list once. That display list is then copied into a RAM_G
+ * slot, and each frame appends it with a single CMD_APPEND instead of streaming
+ * every command over SPI again.
+ */
+
+
+/******************************************************************************
+ *                             I N C L U D E S
+ ******************************************************************************/
+
+#include "Display/DisplayCache.h"    // module header include
+
+#include "Display/DisplayImports.h"
+
+#include <string.h>
+
+
+/******************************************************************************
+ *                              D E F I N E S
+ ******************************************************************************/
+
+#define COPROCESSOR_BUSY_POLLS    10000U    // each poll is an SPI read of a few us, so give up after tens of ms
+
+_Static_assert((DISPLAY_CACHE_BASE + (DISPLAY_CACHE_SLOT_COUNT * DISPLAY_CACHE_SLOT_SIZE)) <= DISPLAY_CACHE_END, "display cache slots overrun RAM_G");
+
+
+/******************************************************************************
+ *                             T Y P E D E F S
+ ******************************************************************************/
+
+typedef struct
+{
+    DisplayCacheState_E state;
+    uint16_t            size;    // [bytes] of display list in the slot
+} displayCacheSlot_S;
+
+
+/******************************************************************************
+ *                         P R I V A T E  V A R S
+ ******************************************************************************/
+
+static displayCacheSlot_S slots[DISPLAY_CACHE_SLOT_COUNT];
+
+
+/******************************************************************************
+ *                     P R I V A T E  F U N C T I O N S
+ ******************************************************************************/
+
+/**
+ * slotAddress
+ * @param slot cache slot
+ * @return RAM_G address of the slot
+ */
+static uint32_t slotAddress(uint8_t slot)
+{
+    return EVE_RAM_G + DISPLAY_CACHE_BASE + ((uint32_t)slot * DISPLAY_CACHE_SLOT_SIZE);
+}
+
+/**
+ * waitForCoprocessor
+ * @brief block until the co-processor has executed everything in its FIFO, or give up
+ * @return whether the co-processor finished within COPROCESSOR_BUSY_POLLS polls
+ */
+static bool waitForCoprocessor(void)
+{
+    for (uint16_t poll = 0U; poll < COPROCESSOR_BUSY_POLLS; poll++)
+    {
+        if (EVE_busy() == 0U)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/******************************************************************************
+ *                       P U B L I C  F U N C T I O N S
+ ******************************************************************************/
+
+/**
+ * DisplayCache_invalidate
+ * @brief forget every cached snippet, e.g. after the EVE was (re)initialized and RAM_G was lost
+ */
+void DisplayCache_invalidate(void)
+{
+    memset(&slots, 0x00, sizeof(slots));
+}
+
+/**
+ * DisplayCache_getState
+ * @param slot cache slot
+ * @return state of the slot
+ */
+DisplayCacheState_E DisplayCache_getState(uint8_t slot)
+{
+    return (slot < DISPLAY_CACHE_SLOT_COUNT) ? slots[slot].state : DISPLAY_CACHE_TOO_LARGE;
+}
+
+/**
+ * DisplayCache_build
+ * @brief render the static part of a page into a scratch display list and keep it in RAM_G.
+ *        Blocks on the co-processor, so only call it when a page is first shown.
+ *        If the co-processor stalls, the slot is left DISPLAY_CACHE_STALLED until the next invalidate.
+ *        The scratch display list is never swapped in, so nothing of it is visible.
+ * @param slot cache slot to fill
+ * @param renderStatic renders the static commands using the burst functions
+ * @return resulting state of the slot
+ */
+DisplayCacheState_E DisplayCache_build(uint8_t slot, void (*renderStatic)(void))
+{
+    if (slot >= DISPLAY_CACHE_SLOT_COUNT)
+    {
+        return DISPLAY_CACHE_TOO_LARGE;
+    }
+
+    EVE_start_cmd_burst();
+    EVE_cmd_dl_burst(CMD_DLSTART);
+    renderStatic();
+    EVE_end_cmd_burst();
+
+    if (!waitForCoprocessor())
+    {
+        slots[slot].state = DISPLAY_CACHE_STALLED;
+        slots[slot].size  = 0U;
+        return DISPLAY_CACHE_STALLED;
+    }
+
+    const uint16_t size = EVE_memRead16(REG_CMD_DL);
+
+    if (size > DISPLAY_CACHE_SLOT_SIZE)
+    {
+        slots[slot].state = DISPLAY_CACHE_TOO_LARGE;
+        slots[slot].size  = 0U;
+    }
+    else
+    {
+        EVE_cmd_memcpy(slotAddress(slot), EVE_RAM_DL, size);
+
+        if (waitForCoprocessor())
+        {
+            slots[slot].state = DISPLAY_CACHE_VALID;
+            slots[slot].size  = size;
+        }
+        else
+        {
+            slots[slot].state = DISPLAY_CACHE_STALLED;
+            slots[slot].size  = 0U;
+        }
+    }
+
+    return slots[slot].state;
+}
+
+/**
+ * DisplayCache_append_burst
+ * @brief append a cached snippet to the display list being built, within a command burst
+ * @param slot cache slot
+ * @return whether the slot was valid and appended
+ */
+bool DisplayCache_append_burst(uint8_t slot)
+{
+    if (DisplayCache_getState(slot) != DISPLAY_CACHE_VALID)
+    {
+        return false;
+    }
+
+    EVE_cmd_append_burst(slotAddress(slot), slots[slot].size);
+    return true;
+}
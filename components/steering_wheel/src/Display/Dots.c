@@ -17,21 +17,25 @@
 
 
 /******************************************************************************
- *                       P U B L I C  F U N C T I O N S
+ *                     P R I V A T E  F U N C T I O N S
  ******************************************************************************/
 
-void render_InfoDot(InfoDot_S dot)
+/**
+ * render_label
+ * @brief draw a label next to the point it describes
+ * @param x horizontal position of the described point
+ * @param y vertical position of the described point
+ * @param relPos where the label goes relative to the point
+ * @param color label color
+ * @param fontSize label font
+ * @param text label text
+ */
+static void render_label(uint16_t x, uint16_t y, InfoRelPos_E relPos, Color_t color, uint16_t fontSize, const char* text)
 {
-    EVE_cmd_dl_burst(DL_COLOR_RGB | dot.dot.color);
-    EVE_cmd_dl_burst(DL_BEGIN | EVE_POINTS);
-    EVE_cmd_dl_burst(POINT_SIZE(dot.dot.size));
-    EVE_cmd_dl_burst(VERTEX2F(dot.dot.coords.x * 16U, dot.dot.coords.y * 16U));
-    EVE_cmd_dl_burst(DL_END);
-
     int8_t hOffset;
     int8_t vOffset;
 
-    switch (dot.label.relPos)
+    switch (relPos)
     {
         case INFO_REL_POS_ABOVE:
             hOffset = 0;
@@ -59,12 +63,41 @@ void render_InfoDot(InfoDot_S dot)
             break;
     }
 
-    EVE_cmd_dl_burst(DL_COLOR_RGB | dot.label.color);
-    EVE_cmd_text_burst(dot.dot.coords.x + hOffset,
-                       dot.dot.coords.y + vOffset,
-                       dot.label.fontSize,
+    EVE_cmd_dl_burst(DL_COLOR_RGB | color);
+    EVE_cmd_text_burst(x + hOffset,
+                       y + vOffset,
+                       fontSize,
                        EVE_OPT_CENTER,
-                       dot.label.text);
+                       text);
+}
+
+
+/******************************************************************************
+ *                       P U B L I C  F U N C T I O N S
+ ******************************************************************************/
+
+/**
+ * render_InfoDot
+ * @brief draw the dot itself, its label is drawn by render_InfoDotLabel
+ * @param dot dot to draw
+ */
+void render_InfoDot(InfoDot_S dot)
+{
+    EVE_cmd_dl_burst(DL_COLOR_RGB | dot.dot.color);
+    EVE_cmd_dl_burst(DL_BEGIN | EVE_POINTS);
+    EVE_cmd_dl_burst(POINT_SIZE(dot.dot.size));
+    EVE_cmd_dl_burst(VERTEX2F(dot.dot.coords.x * 16U, dot.dot.coords.y * 16U));
+    EVE_cmd_dl_burst(DL_END);
+}
+
+/**
+ * render_InfoDotLabel
+ * @brief draw the label of a dot, which doesn't change while a page is shown
+ * @param dot dot to label
+ */
+void render_InfoDotLabel(InfoDot_S dot)
+{
+    render_label(dot.dot.coords.x, dot.dot.coords.y, dot.label.relPos, dot.label.color, dot.label.fontSize, dot.label.text);
 }
 
 /**
@@ -80,9 +113,23 @@ void render_InfoDots(InfoDot_S dots[], uint8_t count)
     }
 }
 
+/**
+ * render_InfoDotLabels
+ * @param dots dots to label
+ * @param count number of dots
+ */
+void render_InfoDotLabels(InfoDot_S dots[], uint8_t count)
+{
+    for (uint8_t ui = 0U; ui < count; ui++)
+    {
+        render_InfoDotLabel(dots[ui]);
+    }
+}
+
 /**
  * render_InfoText
- * @param dot TODO
+ * @brief draw the status text, its label is drawn by render_InfoTextLabel
+ * @param dot status text to draw
  */
 void render_InfoText(InfoText_S dot)
 {
@@ -92,44 +139,16 @@ void render_InfoText(InfoText_S dot)
                        dot.status.fontSize,
                        EVE_OPT_CENTER,
                        dot.status.text);
+}
 
-    int8_t hOffset;
-    int8_t vOffset;
-
-    switch (dot.label.relPos)
-    {
-        case INFO_REL_POS_ABOVE:
-            hOffset = 0;
-            vOffset = -20;
-            break;
-
-        case INFO_REL_POS_BELOW:
-            hOffset = 0;
-            vOffset = 20;
-            break;
-
-        case INFO_REL_POS_LEFT:
-            hOffset = -20;
-            vOffset = 0;
-            break;
-
-        case INFO_REL_POS_RIGHT:
-            hOffset = 20;
-            vOffset = 0;
-            break;
-
-        default:
-            hOffset = 0;
-            vOffset = 0;
-            break;
-    }
-
-    EVE_cmd_dl_burst(DL_COLOR_RGB | dot.label.color);
-    EVE_cmd_text_burst(dot.status.coords.x + hOffset,
-                       dot.status.coords.y + vOffset,
-                       dot.label.fontSize,
-                       EVE_OPT_CENTER,
-                       dot.label.text);
+/**
+ * render_InfoTextLabel
+ * @brief draw the label of a status text, which doesn't change while a page is shown
+ * @param dot status text to label
+ */
+void render_InfoTextLabel(InfoText_S dot)
+{
+    render_label(dot.status.coords.x, dot.status.coords.y, dot.label.relPos, dot.label.color, dot.label.fontSize, dot.label.text);
 }
 
 /**
@@ -144,3 +163,16 @@ void render_InfoTexts(InfoText_S dots[], uint8_t count)
         render_InfoText(dots[ui]);
     }
 }
+
+/**
+ * render_InfoTextLabels
+ * @param dots status texts to label
+ * @param count number of dots
+ */
+void render_InfoTextLabels(InfoText_S dots[], uint8_t count)
+{
+    for (uint8_t ui = 0U; ui < count; ui++)
+    {
+        render_InfoTextLabel(dots[ui]);
+    }
+}
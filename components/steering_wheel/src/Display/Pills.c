@@ -25,6 +25,7 @@
 
 /**
  * render_InfoPill
+ * @brief draw the pill and its value, its label is drawn by render_ValuePillLabel
  * @param pill TODO
  */
 void render_ValuePill(ValuePill_S pill)
@@ -55,8 +56,15 @@ void render_ValuePill(ValuePill_S pill)
                        21U,
                        EVE_OPT_CENTER,
                        pillText);
+}
 
-    // write label above pill
+/**
+ * render_ValuePillLabel
+ * @brief write the label above a pill, which doesn't change while a page is shown
+ * @param pill pill to label
+ */
+void render_ValuePillLabel(ValuePill_S pill)
+{
     EVE_cmd_dl_burst(DL_COLOR_RGB | pill.labelColor);
     EVE_cmd_text_burst(pill.coords.x,
                        pill.coords.y - (pill.height / 2U) - 8U,
@@ -77,3 +85,16 @@ void render_ValuePills(ValuePill_S pills[], uint8_t len)
         render_ValuePill(pills[ui]);
     }
 }
+
+/**
+ * render_ValuePillLabels
+ * @param pills pills to label
+ * @param len number of pills
+ */
+void render_ValuePillLabels(ValuePill_S pills[], uint8_t len)
+{
+    for (uint8_t ui = 0U; ui < len; ui++)
+    {
+        render_ValuePillLabel(pills[ui]);
+    }
+}
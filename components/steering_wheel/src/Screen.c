@@ -21,6 +21,7 @@
 // display includes
 #include "Display/CommonDisplay.h"
 #include "Display/DiagDisplay.h"
+#include "Display/DisplayCache.h"
 #include "Display/LaunchDisplay.h"
 #include "Display/MainDisplay.h"
 
@@ -31,6 +32,7 @@
 
 #define BRIGHTNESS_MAX    0x78
 #define MAX_RETRIES       3
+#define CMD_FIFO_MASK     0xFFFU    // the co-processor FIFO is 4 kB, its pointers wrap
 
 
 /******************************************************************************
@@ -45,6 +47,9 @@ typedef struct
     uint16_t   errorCount;
 
     ScrPages_E page;
+    uint16_t   cmdWrite;    // co-processor FIFO write pointer after the last frame
+    uint8_t    frames;      // frames rendered since the fps was last updated
+    uint8_t    fpsTicks;    // 10Hz ticks since the fps was last updated
 } scr_S;
 
 typedef ScrState_E (*stateFn_t)(void);
@@ -89,10 +94,40 @@ static void      (*pageFunctions[SCR_PAGE_COUNT])(void) = {
     [SCR_PAGE_DIAG]           = &diag_display,
 };
 
+static void      (*staticPageFunctions[SCR_PAGE_COUNT])(void) = {
+    [SCR_PAGE_MAIN]           = &main_displayStatic,
+    [SCR_PAGE_LAUNCH_CONTROL] = &launch_displayStatic,
+    [SCR_PAGE_DIAG]           = &diag_displayStatic,
+};
+
+_Static_assert(SCR_PAGE_COUNT <= DISPLAY_CACHE_SLOT_COUNT, "every page caches its static display list in the slot of its index");
+
 /******************************************************************************
  *                     P R I V A T E  F U N C T I O N S
  ******************************************************************************/
 
+/**
+ * display_static
+ * @brief elements of the current page that don't change while it is shown
+ */
+static void display_static(void)
+{
+    common_displayStatic();
+    if (staticPageFunctions[scr.page] != NULL)
+    {
+        staticPageFunctions[scr.page]();
+    }
+}
+
+/**
+ * readCmdWrite
+ * @return the co-processor FIFO write pointer
+ */
+static uint16_t readCmdWrite(void)
+{
+    return EVE_memRead16(REG_CMD_WRITE) & CMD_FIFO_MASK;
+}
+
 /**
  * process_running
  * @return TODO
@@ -105,7 +140,22 @@ static ScrState_E process_running(void)
     {
         timer = 0;
 
+        // the first time a page is shown, keep its static elements in RAM_G
+        if (DisplayCache_getState(scr.page) == DISPLAY_CACHE_EMPTY)
+        {
+            if (DisplayCache_build(scr.page, &display_static) == DISPLAY_CACHE_STALLED)
+            {
+                // a hung co-processor won't take a frame either, reinit the EVE
+                return SCR_STATE_ERROR;
+            }
+            scr.cmdWrite = readCmdWrite();
+        }
+
         display_start();    // start the display generation
+        if (!DisplayCache_append_burst(scr.page))
+        {
+            display_static();
+        }
         common_display();   // common display elements shared on all screens
         // display the current page
         if (pageFunctions[scr.page] != NULL)
@@ -113,6 +163,11 @@ static ScrState_E process_running(void)
             pageFunctions[scr.page]();
         }
         display_end();    // end the display generation and tell the screen to show it
+
+        const uint16_t cmdWrite = readCmdWrite();
+        SCR.cmdBytesPerFrame    = (cmdWrite - scr.cmdWrite) & CMD_FIFO_MASK;
+        scr.cmdWrite            = cmdWrite;
+        scr.frames++;
     }
 
     return SCR_STATE_RUNNING;
@@ -146,6 +201,7 @@ static ScrState_E process_unavailable(void)
         SCR.initStatus = EVE_INIT_SUCCESS;
         SCR.brightness = 0x60;    // default value for brightness until a request comes in from elsewhere to change it
         EVE_memWrite8(REG_PWM_DUTY, SCR.brightness);
+        DisplayCache_invalidate();
         nextState      = SCR_STATE_RUNNING;
     }
     // startup failed
@@ -193,25 +249,23 @@ static ScrState_E process_error(void)
  */
 static ScrState_E process_retry(void)
 {
-    ScrState_E nextState;
+    // if retries fail to get the screen working,
+    // go to unavailable
+    ScrState_E nextState = SCR_STATE_UNAVAILABLE;
 
     while (scr.retryCount < MAX_RETRIES)
     {
+        scr.retryCount++;
         if (EVE_init(&scr.chipId) == EVE_INIT_SUCCESS)
         {
             SCR.initStatus = EVE_INIT_SUCCESS;
             nextState      = SCR_STATE_RUNNING;
             scr.retryCount = 0;
+            DisplayCache_invalidate();    // RAM_G doesn't survive a reinit
             break;
         }
     }
 
-    // if retries fail to get the screen working,
-    // go to unavailable
-    if (SCR.initStatus != EVE_INIT_SUCCESS)
-    {
-        nextState = SCR_STATE_UNAVAILABLE;
-    }
     return nextState;
 }
 
@@ -242,6 +296,7 @@ static void Screen_init(void)
     // initialize structs
     memset(&scr, 0x00, sizeof(scr));
     memset(&SCR, 0x00, sizeof(SCR));
+    DisplayCache_invalidate();
 }
 
 
@@ -256,6 +311,13 @@ static void Screen10Hz_PRD(void)
         updateBrightness_10Hz();
     }
 
+    if (++scr.fpsTicks >= 10U)
+    {
+        SCR.fps      = scr.frames;
+        scr.frames   = 0U;
+        scr.fpsTicks = 0U;
+    }
+
     SCR.heartbeat = !SCR.heartbeat;
 }
 
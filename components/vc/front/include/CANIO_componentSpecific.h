@@ -129,6 +129,8 @@
 #define set_gpsUartFeCount(m, b, n, s)                     set(m, b, n, s, app_gps_getUartErrorFeCount())
 #define set_gpsUartNeCount(m, b, n, s)                     set(m, b, n, s, app_gps_getUartErrorNeCount())
 #define set_gpsUartPeCount(m, b, n, s)                     set(m, b, n, s, app_gps_getUartErrorPeCount())
+#define set_gpsRxBytesPerSecond(m, b, n, s)                set(m, b, n, s, app_gps_getRxBytesPerSecond())
+#define set_gpsDroppedSentences(m, b, n, s)                set(m, b, n, s, app_gps_getDroppedSentences())
 #define set_gpsPairUtcMs(m, b, n, s)                       set(m, b, n, s, app_gps_getPairmsgRef()->utcMs)
 #define set_gpsPairDrStage(m, b, n, s)                     set(m, b, n, s, app_gps_getPairmsgRef()->drStage)
 #define set_gpsPairDynamicStatus(m, b, n, s)               set(m, b, n, s, app_gps_getPairmsgRef()->dynamicStatus)
@@ -21,6 +21,7 @@
 extern ADC_HandleTypeDef  hadc1;
 extern ADC_HandleTypeDef  hadc2;
 extern DMA_HandleTypeDef  hdma_adc1;
+extern DMA_HandleTypeDef  hdma_uart3rx;
 extern TIM_HandleTypeDef  htim[HW_TIM_PORT_COUNT];
 extern TIM_HandleTypeDef  htim_tick;
 extern CAN_HandleTypeDef  hcan[CAN_BUS_COUNT];
@@ -94,6 +95,14 @@ void DMA1_Channel1_IRQHandler(void)
     HAL_DMA_IRQHandler(&hdma_adc1);
 }
 
+/**
+ * @brief This function handles DMA1 channel3 global interrupt.
+ */
+void DMA1_Channel3_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_uart3rx);
+}
+
 void ADC1_2_IRQHandler(void)
 {
     HAL_ADC_IRQHandler(&hadc1);
@@ -165,5 +174,5 @@ void CAN2_RX1_IRQHandler(void)
 
 void USART3_IRQHandler(void)
 {
-    HAL_UART_IRQHandler(&huart[HW_UART_PORT_GPS]);
+    HW_UART_IRQHandler(HW_UART_PORT_GPS);
 }
@@ -72,6 +72,9 @@ void HAL_UART_MspInit(UART_HandleTypeDef* huart)
 
         __HAL_LINKDMA(huart, hdmarx, hdma_uart3rx);
 
+        // Same priority as the UART so that idle-line and DMA transfer events never preempt each other
+        HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, DMA_IRQ_PRIO, 0U);
+        HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
         HAL_NVIC_SetPriority(USART3_IRQn, DMA_IRQ_PRIO, 0U);
         HAL_NVIC_EnableIRQ(USART3_IRQn);
     }
@@ -82,15 +85,8 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart)
     if (huart->Instance == USART3)
     {
         app_gps_recordUartError(huart->ErrorCode);
-        uint8_t  * rxBuf = huart->pRxBuffPtr;
-        uint16_t rxLen   = huart->RxXferSize;
 
-        (void)HAL_UART_DMAStop(huart);
+        (void)HW_UART_restartDMARXIdle(HW_UART_PORT_GPS);
         app_gps_resetBuffers();
-
-        if ((rxBuf != NULL) && (rxLen > 0U))
-        {
-            (void)HAL_UART_Receive_DMA(huart, rxBuf, rxLen);
-        }
     }
 }
@@ -27,6 +27,7 @@
 #include "Yamcan.h"
 
 #include <math.h>
+#include <stdatomic.h>
 
 /******************************************************************************
  *                              D E F I N E S
@@ -42,6 +43,9 @@
 #define MAX_TORQUE_NM_PER_S              500
 #define MAX_LAUNCH_NM_PER_S              1000
 #define PRELOAD_NM_PER_S                 100
+#define FAST_LOOP_HZ                     1000.0f
+#define FAST_LOOP_DT_S                   (1.0f / FAST_LOOP_HZ) // the fast loop runs off the RTOS tick, so its period is fixed
+#define RATE_LIMIT_STEP(nm_per_s)        (((float32_t)(nm_per_s)) / FAST_LOOP_HZ)
 #define GEAR_RATIO                       4.6f
 
 #define TORQUE_CHANGE_DELAY              250
@@ -94,20 +98,41 @@
  *                             T Y P E D E F S
  ******************************************************************************/
 
+/**
+ * @brief Everything the 1kHz fast loop needs from the 100Hz state machines.
+ *        The 100Hz task fills the buffer that isn't published and then publishes it.
+ *        The 1kHz task preempts the 100Hz task but is never preempted by it, so the
+ *        fast loop always copies a complete buffer without taking a lock.
+ */
+typedef struct
+{
+    torque_state_E                state;
+    torque_gear_E                 gear;
+    torque_launchControlState_E   launchControlState;
+    torque_tractionControlState_E tractionControlState;
+    bool                          bppcOk;
+    bool                          isRegenerating;
+    bool                          limitToTireModel;
+    uint8_t                       rateLimitResets;     // incremented whenever the torque rate limit must restart from 0
+    float32_t                     torqueRequestMax;    // [Nm] pit and reverse limits applied
+    float32_t                     torquePreload;
+    float32_t                     slipTarget;
+    float32_t                     kp;
+    float32_t                     ki;
+    float32_t                     kd;
+    float32_t                     kLeak;
+    float32_t                     iLim;
+    float32_t                     yLim;
+} torque_fastInputs_S;
+
 static struct
 {
     torque_state_E                state;
     torque_gear_E                 gear;
     torque_raceMode_E             race_mode;
-    float32_t                     torque;
-    float32_t                     regenTorque;
     float32_t                     torquePreload;
-    float32_t                     torqueDriverInput;
     float32_t                     torque_request_max;
     float32_t                     slip_request;
-    lib_rateLimit_linear_S        torqueRateLimit;
-    lib_rateLimit_linear_S        launchRateLimit;
-    lib_rateLimit_linear_S        preloadRateLimit;
 
     bool                          gear_change_active;
     bool                          torque_control_request_active;
@@ -132,7 +157,17 @@ static struct
     float32_t                     launch75mStartOdometerKm;
     float32_t                     launch75mTime;
 
-    uint32_t                      lastTimeampMS;
+    torque_fastInputs_S           fastInputs[2U];
+    volatile uint8_t              fastInputsPublished;
+
+    // owned by the 1kHz fast loop
+    uint8_t                       rateLimitResets;
+    float32_t                     torque;
+    float32_t                     regenTorque;
+    float32_t                     torqueDriverInput;
+    lib_rateLimit_linear_S        torqueRateLimit;
+    lib_rateLimit_linear_S        launchRateLimit;
+    lib_rateLimit_linear_S        preloadRateLimit;
     float32_t                     slipRear;
     float32_t                     torqueCorrection;
     float32_t                     torqueReduction;
@@ -628,22 +663,22 @@ static void evaluate_launch_control(float32_t accelerator_position, float32_t br
     launch_control_75m_update();
 }
 
-static float32_t calc_traction_control_reduction(float32_t target_slip, float32_t actual_slip, float32_t dt)
+static void reset_traction_control_pid(float32_t kp, float32_t ki, float32_t kd)
 {
-    const nvm_tcPid_S* pid = tc_getActivePidConst();
-    const float32_t  tLeak = TC_PID_CONV_THOU_F32(pid->tLeakMs);
-    const float32_t  kLeak = (tLeak > 0.0f) ? (1.0f / tLeak) : 0.0f;
-    const float32_t  iLim  = SATURATE(TC_MIN, TC_PID_CONV_PERCENT_F32(pid->percentILim), 1.0f);
-    const float32_t  yLim  = SATURATE(TC_MIN, TC_PID_CONV_PERCENT_F32(pid->percentMaxTcLimit), 1.0f);
+    lib_pid_init(&torque_data.tractionControlPID, 0.0f, 0.0f, kp, ki, kd);
+    lib_pid_util_lpf_dTermSetCutoff(&torque_data.tractionControlPID, TC_DTERM_LPF_CUTOFF_FREQ);
+}
 
-    lib_pid_util_ileak(&torque_data.tractionControlPID, kLeak, dt);
-    torque_data.tractionControlPID.kp = TC_PID_CONV_THOU_F32(pid->thousandthKp);
-    torque_data.tractionControlPID.ki = TC_PID_CONV_THOU_F32(pid->thousandthKi);
-    torque_data.tractionControlPID.kd = TC_PID_CONV_THOU_F32(-pid->thousandthKd);
-    lib_pi_typeb_calc(&torque_data.tractionControlPID, target_slip, actual_slip, dt);
-    lib_pid_util_ilim(&torque_data.tractionControlPID, TC_MIN, iLim);
+static float32_t calc_traction_control_reduction(const torque_fastInputs_S* inputs, float32_t actual_slip, float32_t dt)
+{
+    lib_pid_util_ileak(&torque_data.tractionControlPID, inputs->kLeak, dt);
+    torque_data.tractionControlPID.kp = inputs->kp;
+    torque_data.tractionControlPID.ki = inputs->ki;
+    torque_data.tractionControlPID.kd = inputs->kd;
+    lib_pi_typeb_calc(&torque_data.tractionControlPID, inputs->slipTarget, actual_slip, dt);
+    lib_pid_util_ilim(&torque_data.tractionControlPID, TC_MIN, inputs->iLim);
     lib_pid_util_lpf_dTerm(&torque_data.tractionControlPID, dt);
-    lib_pid_typeb_sum(&torque_data.tractionControlPID, TC_MIN, yLim);
+    lib_pid_typeb_sum(&torque_data.tractionControlPID, TC_MIN, inputs->yLim);
 
     if (!isfinite(torque_data.tractionControlPID.y))
     {
@@ -653,16 +688,8 @@ static float32_t calc_traction_control_reduction(float32_t target_slip, float32_
     return torque_data.tractionControlPID.y;
 }
 
-static float32_t evaluate_traction_control(void)
+static torque_tractionControlState_E evaluate_traction_control_state(void)
 {
-    const uint32_t  timestamp = HW_TIM_getTimeMS();
-    const float32_t dt        = ((float32_t)(timestamp - torque_data.lastTimeampMS)) / 1000.0f;
-
-    torque_data.lastTimeampMS = timestamp;
-
-    const float32_t               rawSlip                    = app_vehicleSpeed_getAxleSlip(AXLE_REAR);
-    float32_t                     slip                       = isfinite(rawSlip) ? rawSlip : 0.0f;
-    float32_t                     multiplier                 = 0.0f;
     torque_tractionControlState_E nextState                  = TC_STATE_ERROR;
 
 #if FEATURE_IS_ENABLED(FEATURE_TRACTION_CONTROL)
@@ -681,25 +708,64 @@ static float32_t evaluate_traction_control(void)
         nextState = TC_STATE_INACTIVE;
     }
 
-    torque_data.tractionControlState = nextState;
+    return nextState;
+}
+
+static float32_t evaluate_traction_control(const torque_fastInputs_S* inputs)
+{
+    const float32_t rawSlip    = app_vehicleSpeed_sampleAxleSlip(AXLE_REAR);
+    const float32_t slip       = isfinite(rawSlip) ? rawSlip : 0.0f;
+    float32_t       multiplier = 0.0f;
 
-    if (torque_data.tractionControlState == TC_STATE_ACTIVE)
+    if (inputs->tractionControlState == TC_STATE_ACTIVE)
     {
-        multiplier = calc_traction_control_reduction(torque_data.slip_request, slip, dt);
+        multiplier = calc_traction_control_reduction(inputs, slip, FAST_LOOP_DT_S);
     }
     else
     {
-        const nvm_tcPid_S* pid = tc_getActivePidConst();
-        lib_pid_init(&torque_data.tractionControlPID, 0.0f, 0.0f,
-                     TC_PID_CONV_THOU_F32(pid->thousandthKp),
-                     TC_PID_CONV_THOU_F32(pid->thousandthKi),
-                     TC_PID_CONV_THOU_F32(-pid->thousandthKd));
+        reset_traction_control_pid(inputs->kp, inputs->ki, inputs->kd);
     }
 
     torque_data.slipRear = slip;
     return multiplier;
 }
 
+/**
+ * @brief Hand the state machines' latest outputs to the fast loop
+ * @param torque_request_max Torque at full pedal with the pit and reverse limits applied
+ * @param bppc_ok Whether the brake pedal plausibility check passes
+ * @param reset_rate_limit Whether the torque rate limit must restart from 0
+ */
+static void publish_fast_inputs(float32_t torque_request_max, bool bppc_ok, bool reset_rate_limit)
+{
+    const uint8_t        published = torque_data.fastInputsPublished;
+    torque_fastInputs_S* inputs    = &torque_data.fastInputs[published ^ 1U];
+    const nvm_tcPid_S*   pid       = tc_getActivePidConst();
+    const float32_t      tLeak     = TC_PID_CONV_THOU_F32(pid->tLeakMs);
+
+    inputs->state                = torque_data.state;
+    inputs->gear                 = torque_data.gear;
+    inputs->launchControlState   = torque_data.launchControlState;
+    inputs->tractionControlState = torque_data.tractionControlState;
+    inputs->bppcOk               = bppc_ok;
+    inputs->isRegenerating       = torque_data.isRegenerating;
+    inputs->limitToTireModel     = FLAG_get(tcParamState_data.params, PARAMSTATE_TC_TIRE_MODEL_LIMIT);
+    inputs->rateLimitResets      = (uint8_t)(torque_data.fastInputs[published].rateLimitResets + (reset_rate_limit ? 1U : 0U));
+    inputs->torqueRequestMax     = torque_request_max;
+    inputs->torquePreload        = torque_data.torquePreload;
+    inputs->slipTarget           = torque_data.slip_request;
+    inputs->kp                   = TC_PID_CONV_THOU_F32(pid->thousandthKp);
+    inputs->ki                   = TC_PID_CONV_THOU_F32(pid->thousandthKi);
+    inputs->kd                   = TC_PID_CONV_THOU_F32(-pid->thousandthKd);
+    inputs->kLeak                = (tLeak > 0.0f) ? (1.0f / tLeak) : 0.0f;
+    inputs->iLim                 = SATURATE(TC_MIN, TC_PID_CONV_PERCENT_F32(pid->percentILim), 1.0f);
+    inputs->yLim                 = SATURATE(TC_MIN, TC_PID_CONV_PERCENT_F32(pid->percentMaxTcLimit), 1.0f);
+
+    // the buffer must be complete before the fast loop can see it
+    atomic_signal_fence(memory_order_release);
+    torque_data.fastInputsPublished = (uint8_t)(published ^ 1U);
+}
+
 static void evaluateRegenEnabled(float32_t accelPosition, float32_t brakePosition)
 {
     bool                regenAllowed = false;
@@ -1362,20 +1428,18 @@ static void torque_init(void)
 
     torque_data.slip_request                  = TC_TARGET_SLIP;
     torque_data.torqueRateLimit.y_n           = 0.0f;
-    torque_data.torqueRateLimit.maxStepDelta  = MAX_TORQUE_NM_PER_S / 100;
+    torque_data.torqueRateLimit.maxStepDelta  = RATE_LIMIT_STEP(MAX_TORQUE_NM_PER_S);
     torque_data.launchRateLimit.y_n           = 0.0f;
-    torque_data.launchRateLimit.maxStepDelta  = MAX_LAUNCH_NM_PER_S / 100;
+    torque_data.launchRateLimit.maxStepDelta  = RATE_LIMIT_STEP(MAX_LAUNCH_NM_PER_S);
     torque_data.preloadRateLimit.y_n          = 0.0f;
-    torque_data.preloadRateLimit.maxStepDelta = PRELOAD_NM_PER_S / 100;
+    torque_data.preloadRateLimit.maxStepDelta = RATE_LIMIT_STEP(PRELOAD_NM_PER_S);
 
     torque_data.torquePreload                 = LC_PRELOAD_TORQUE_INIT;
 
-    const nvm_tcPid_S* pid = tc_getActivePidConst();
-    lib_pid_init(&torque_data.tractionControlPID, 0.0f, 0.0f,
-                 TC_PID_CONV_THOU_F32(pid->thousandthKp),
-                 TC_PID_CONV_THOU_F32(pid->thousandthKi),
-                 TC_PID_CONV_THOU_F32(-pid->thousandthKd));
-    lib_pid_util_lpf_dTermSetCutoff(&torque_data.tractionControlPID, TC_DTERM_LPF_CUTOFF_FREQ);
+    publish_fast_inputs(torque_data.torque_request_max, false, false);
+
+    const torque_fastInputs_S* inputs = &torque_data.fastInputs[torque_data.fastInputsPublished];
+    reset_traction_control_pid(inputs->kp, inputs->ki, inputs->kd);
 }
 
 static void torque_periodic_100Hz(void)
@@ -1394,22 +1458,36 @@ static void torque_periodic_100Hz(void)
 
     evaluate_launch_control(accelerator_position, brake_position, bppc_ok);
     evaluateRegenEnabled(accelerator_position, brake_position);
-    torque_data.torqueReduction = evaluate_traction_control();
+    torque_data.tractionControlState = evaluate_traction_control_state();
 
     float32_t torque_request_max = evaluate_torque_max();
-    torque_request_max          = (torque_data.race_mode != RACEMODE_ENABLED) ? DEFAULT_TORQUE_PITS : torque_request_max;
-    torque_request_max          = (torque_data.gear != GEAR_F) ? DEFAULT_TORQUE_LIMIT_REVERSE : torque_request_max;
+    torque_request_max = (torque_data.race_mode != RACEMODE_ENABLED) ? DEFAULT_TORQUE_PITS : torque_request_max;
+    torque_request_max = (torque_data.gear != GEAR_F) ? DEFAULT_TORQUE_LIMIT_REVERSE : torque_request_max;
+
+    publish_fast_inputs(torque_request_max, bppc_ok, gear_change || mode_change || !bppc_ok);
+}
 
-    if (gear_change || mode_change || !bppc_ok)
+/**
+ * @brief Traction control and torque rate limiting, on fresh pedal, wheel speed and
+ *        acceleration data. Runs against the state machines last published at 100Hz
+ */
+static void torque_periodic_1kHz(void)
+{
+    const torque_fastInputs_S inputs = torque_data.fastInputs[torque_data.fastInputsPublished];
+
+    if (inputs.rateLimitResets != torque_data.rateLimitResets)
     {
+        torque_data.rateLimitResets     = inputs.rateLimitResets;
         torque_data.torqueRateLimit.y_n = 0.0f;
     }
 
-    float32_t       torque      = (bppc_ok) ? accelerator_position * torque_request_max : 0.0f;
+    torque_data.torqueReduction = evaluate_traction_control(&inputs);
+
+    float32_t       torque      = (inputs.bppcOk) ? apps_getPedalPosition() * inputs.torqueRequestMax : 0.0f;
     const float32_t maxVdTorque = ((vd_getMaxLonTireForce(WHEEL_RL) + vd_getMaxLonTireForce(WHEEL_RR)) * TIRE_RADIUS_M) / GEAR_RATIO;
     torque_data.maxVdTorque = maxVdTorque;
 #if FEATURE_IS_ENABLED(FEATURE_LIMIT_LON_TIRE_ACCEL)
-    if (FLAG_get(tcParamState_data.params, PARAMSTATE_TC_TIRE_MODEL_LIMIT))
+    if (inputs.limitToTireModel)
     {
         torque = SATURATE(-maxVdTorque, torque, maxVdTorque);
     }
@@ -1424,8 +1502,8 @@ static void torque_periodic_100Hz(void)
     torque_data.torqueCorrection  = torque_data.torqueReduction * torque;
     const float32_t torqueOutput = torque - torque_data.torqueCorrection;
 
-    if ((torque_data.launchControlState == LC_STATE_HOLDING) ||
-        (torque_data.launchControlState == LC_STATE_SETTLING)
+    if ((inputs.launchControlState == LC_STATE_HOLDING) ||
+        (inputs.launchControlState == LC_STATE_SETTLING)
         )
     {
         torque                           = 0.0f;
@@ -1433,24 +1511,24 @@ static void torque_periodic_100Hz(void)
         torque_data.launchRateLimit.y_n  = 0.0f;
         torque_data.preloadRateLimit.y_n = 0.0f;
     }
-    else if (torque_data.launchControlState == LC_STATE_PRELOAD)
+    else if (inputs.launchControlState == LC_STATE_PRELOAD)
     {
-        torque                          = lib_rateLimit_linear_update(&torque_data.preloadRateLimit, torque_data.torquePreload);
+        torque                          = lib_rateLimit_linear_update(&torque_data.preloadRateLimit, inputs.torquePreload);
         torque_data.launchRateLimit.y_n = torque;
     }
-    else if (torque_data.launchControlState == LC_STATE_LAUNCH)
+    else if (inputs.launchControlState == LC_STATE_LAUNCH)
     {
         torque                          = lib_rateLimit_linear_update(&torque_data.launchRateLimit, torqueOutput);
         torque_data.torqueRateLimit.y_n = torque;
     }
     else
     {
-        torque = !torque_data.isRegenerating ? torqueOutput : -torque_data.regenTorque;
+        torque = !inputs.isRegenerating ? torqueOutput : -torque_data.regenTorque;
         torque = lib_rateLimit_linear_update(&torque_data.torqueRateLimit, torque);
     }
 
-    const float32_t minTorque = (torque_data.gear == GEAR_F) ? -REGEN_MAX_TORQUE_N : ABSOLUTE_MIN_TORQUE;
-    torque_data.torque = (torque_data.state == TORQUE_ACTIVE) ? SATURATE(minTorque, torque, ABSOLUTE_MAX_TORQUE) : 0.0f;
+    const float32_t minTorque = (inputs.gear == GEAR_F) ? -REGEN_MAX_TORQUE_N : ABSOLUTE_MIN_TORQUE;
+    torque_data.torque = (inputs.state == TORQUE_ACTIVE) ? SATURATE(minTorque, torque, ABSOLUTE_MAX_TORQUE) : 0.0f;
 }
 
 /******************************************************************************
@@ -1459,5 +1537,6 @@ static void torque_periodic_100Hz(void)
 
 const ModuleDesc_S torque_desc = {
     .moduleInit        = &torque_init,
+    .periodic1kHz_CLK  = &torque_periodic_1kHz,
     .periodic100Hz_CLK = &torque_periodic_100Hz,
 };
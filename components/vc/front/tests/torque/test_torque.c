@@ -9,7 +9,7 @@
 #include <math.h>
 #include <string.h>
 
-static uint32_t                 stubTimeMs;
+static uint64_t                 stubTimeUs;
 static float32_t                stubAcceleratorPosition;
 static float32_t                stubBrakePosition;
 static bppc_state_E             stubBppcState;
@@ -36,10 +36,20 @@ static void setDefaultCustomPid(void)
     tcPid_data.maxTorqueNm       = 130U;
 }
 
+static void run1kHz(void)
+{
+    stubTimeUs += 1000U;
+    torque_desc.periodic1kHz_CLK();
+}
+
 static void run100Hz(void)
 {
-    stubTimeMs += 10U;
     torque_desc.periodic100Hz_CLK();
+
+    for (uint8_t i = 0U; i < 10U; i++)
+    {
+        run1kHz();
+    }
 }
 
 static void enterRaceMode(void)
@@ -64,7 +74,7 @@ static void enableTractionControl(void)
 
 void setUp(void)
 {
-    stubTimeMs              = 0U;
+    stubTimeUs              = 0U;
     stubAcceleratorPosition = 1.0f;
     stubBrakePosition       = 0.0f;
     stubBppcState           = BPPC_OK;
@@ -117,7 +127,7 @@ CANRX_rawMessage_S* CANRX_get_rawMessage(CAN_bus_E bus, CAN_message_E message)
 
 uint32_t HW_TIM_getTimeMS(void)
 {
-    return stubTimeMs;
+    return (uint32_t)(stubTimeUs / 1000U);
 }
 
 bool lib_nvm_requestWrite(lib_nvm_entryId_E entryId)
@@ -146,7 +156,7 @@ float32_t app_vehicleSpeed_getOdometer(void)
     return 0.0f;
 }
 
-float32_t app_vehicleSpeed_getAxleSlip(axle_E axle)
+float32_t app_vehicleSpeed_sampleAxleSlip(axle_E axle)
 {
     (void)axle;
     return stubRearAxleSlip;
@@ -295,6 +305,47 @@ void test_corrupt_integral_limit_cannot_reduce_more_than_all_torque(void)
     TEST_ASSERT_LESS_OR_EQUAL_FLOAT(1.0f, torque_getTorqueReduction());
 }
 
+void test_torque_rate_limit_steps_every_millisecond(void)
+{
+    torque_desc.periodic100Hz_CLK();
+
+    run1kHz();
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.5f, torque_getTorqueRequest());
+
+    for (uint8_t i = 0U; i < 9U; i++)
+    {
+        run1kHz();
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 5.0f, torque_getTorqueRequest());
+}
+
+void test_traction_control_responds_to_slip_step_within_one_millisecond(void)
+{
+    enableTractionControl();
+    run100Hz();
+    TEST_ASSERT_EQUAL(TC_STATE_ACTIVE, torque_getTractionControlState());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, torque_getTorqueReduction());
+
+    stubRearAxleSlip = 100.0f;
+    run1kHz();
+
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.70f, torque_getTorqueReduction());
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.0f, torque_getTorqueRequestCorrection());
+}
+
+void test_fast_loop_acts_on_traction_control_request_once_published(void)
+{
+    enableTractionControl();
+    stubRearAxleSlip = 100.0f;
+
+    run1kHz();
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, torque_getTorqueReduction());
+
+    torque_desc.periodic100Hz_CLK();
+    run1kHz();
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.70f, torque_getTorqueReduction());
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -306,5 +357,8 @@ int main(void)
     RUN_TEST(test_corrupt_pid_max_limit_cannot_reduce_more_than_all_torque);
     RUN_TEST(test_zero_integral_leak_time_does_not_poison_reduction);
     RUN_TEST(test_corrupt_integral_limit_cannot_reduce_more_than_all_torque);
+    RUN_TEST(test_torque_rate_limit_steps_every_millisecond);
+    RUN_TEST(test_traction_control_responds_to_slip_step_within_one_millisecond);
+    RUN_TEST(test_fast_loop_acts_on_traction_control_request_once_published);
     return UNITY_END();
 }
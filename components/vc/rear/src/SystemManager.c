@@ -114,5 +114,8 @@ static void SYS1Hz_PRD()
     drv_outputAD_toggleDigitalState(DRV_OUTPUTAD_DIGITAL_LED);
 }
 const ModuleDesc_S sys_desc = {
-    .periodic1Hz_CLK = &SYS1Hz_PRD,
+    .periodic_CLK = &SYS1Hz_PRD,
+    .periodMs     = 1000U,
+    .phaseMs      = MODULE_PHASE_AUTO,
+    .wcetUs       = 10U,
 };
@@ -10,6 +10,8 @@
 // Firmware Includes
 #include "HW_tim.h"
 
+#include "lib_edgeSpeed.h"
+
 /******************************************************************************
  *                              D E F I N E S
  ******************************************************************************/
@@ -21,10 +23,7 @@
 #define TICK_PER_REV             16U
 #define UPDATE_PER_REV           8U
 #define WHEELSPEED_TIMEOUT_MS    500U
-
-#define NUM_TIM_SAMPLES          2U
-#define CURRENT_SAMPLE           (NUM_TIM_SAMPLES - 1U)
-#define LAST_SAMPLE              (NUM_TIM_SAMPLES - 2U)
+#define WHEELSPEED_WINDOW_MS     5U     // count edges over this long at high speed
 
 /******************************************************************************
  *                         P R I V A T E  V A R S
@@ -33,10 +32,38 @@
 TIM_HandleTypeDef htim[HW_TIM_PORT_COUNT];
 typedef struct
 {
-    uint64_t lastSample[HW_TIM_CHANNEL_WS_CNT][NUM_TIM_SAMPLES];
+    lib_edgeSpeed_ring_S edges[HW_TIM_CHANNEL_WS_CNT];
 } wheelSpeed_data_S;
 
-static wheelSpeed_data_S wheelSpeed;
+static wheelSpeed_data_S            wheelSpeed;
+
+static const lib_edgeSpeed_config_S wheelSpeedConfig = {
+    .windowTicks    = MS_TO_BASETICK(WHEELSPEED_WINDOW_MS),
+    .timeoutTicks   = MS_TO_BASETICK(WHEELSPEED_TIMEOUT_MS),
+    .ticksPerSecond = SEC_TO_BASETICK(1U),
+    .maxIntervals   = UPDATE_PER_REV,    // at most a revolution, which averages out tooth spacing
+};
+
+/******************************************************************************
+ *                     P R I V A T E  F U N C T I O N S
+ ******************************************************************************/
+
+/**
+ * @brief  Record the edge latched by an input capture channel. The timer runs at the
+ *         base tick rate, so the captured counter value dates the edge without the
+ *         interrupt latency
+ *
+ * @param tim TIM peripheral
+ * @param timChannel Channel that captured the edge
+ * @param channel Wheel speed channel to record into
+ */
+static void recordCapture(TIM_HandleTypeDef* tim, uint32_t timChannel, HW_TIM_channelFreq_E channel)
+{
+    const uint64_t now            = HW_TIM_getBaseTick();
+    const uint16_t ticksSinceEdge = (uint16_t)(__HAL_TIM_GET_COUNTER(tim) - HAL_TIM_ReadCapturedValue(tim, timChannel));
+
+    lib_edgeSpeed_push(&wheelSpeed.edges[channel], now - ticksSinceEdge);
+}
 
 /******************************************************************************
  *                       P U B L I C  F U N C T I O N S
@@ -53,6 +80,11 @@ HW_StatusTypeDef_E HW_TIM_init(void)
     TIM_IC_InitTypeDef     sConfigIC          = { 0 };
     uint32_t               uwTimclock         = 0;
 
+    for (uint8_t i = 0U; i < HW_TIM_CHANNEL_WS_CNT; i++)
+    {
+        lib_edgeSpeed_reset(&wheelSpeed.edges[i]);
+    }
+
     __HAL_RCC_TIM4_CLK_ENABLE();
 
     uwTimclock                                          = HAL_RCC_GetPCLK2Freq();
@@ -120,19 +152,11 @@ void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef* tim)
     switch (tim->Channel)
     {
         case HAL_TIM_ACTIVE_CHANNEL_3:
-            for (uint8_t i = 1; i < NUM_TIM_SAMPLES; i++)
-            {
-                wheelSpeed.lastSample[HW_TIM_CHANNEL_WS_R][i - 1U] = wheelSpeed.lastSample[HW_TIM_CHANNEL_WS_R][i];
-            }
-            wheelSpeed.lastSample[HW_TIM_CHANNEL_WS_R][CURRENT_SAMPLE] = HW_TIM_getBaseTick();
+            recordCapture(tim, TIM_CHANNEL_3, HW_TIM_CHANNEL_WS_R);
             break;
 
         case HAL_TIM_ACTIVE_CHANNEL_4:
-            for (uint8_t i = 1; i < NUM_TIM_SAMPLES; i++)
-            {
-                wheelSpeed.lastSample[HW_TIM_CHANNEL_WS_L][i - 1U] = wheelSpeed.lastSample[HW_TIM_CHANNEL_WS_L][i];
-            }
-            wheelSpeed.lastSample[HW_TIM_CHANNEL_WS_L][CURRENT_SAMPLE] = HW_TIM_getBaseTick();
+            recordCapture(tim, TIM_CHANNEL_4, HW_TIM_CHANNEL_WS_L);
             break;
 
         default:
@@ -140,14 +164,18 @@ void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef* tim)
     }
 }
 
+/**
+ * @brief  Wheel revolutions per second, measured from the captured edges as of now.
+ *         Cheap enough to call from any task at any rate
+ *
+ * @param channel Wheel speed channel
+ */
 float32_t HW_TIM_getFreq(HW_TIM_channelFreq_E channel)
 {
-    return (wheelSpeed.lastSample[channel][CURRENT_SAMPLE] > (HW_TIM_getBaseTick() - MS_TO_BASETICK(WHEELSPEED_TIMEOUT_MS))) ?
-           (((float32_t)(SEC_TO_BASETICK(1U) / (UPDATE_PER_REV))) / (float32_t)(wheelSpeed.lastSample[channel][CURRENT_SAMPLE] - wheelSpeed.lastSample[channel][LAST_SAMPLE])) :
-           0.0f;
+    return lib_edgeSpeed_getEdgeRate(&wheelSpeed.edges[channel], &wheelSpeedConfig, HW_TIM_getBaseTick()) / (float32_t)UPDATE_PER_REV;
 }
 
 uint64_t HW_TIM_getLastCaptureBaseTick(HW_TIM_channelFreq_E channel)
 {
-    return wheelSpeed.lastSample[channel][CURRENT_SAMPLE];
+    return lib_edgeSpeed_getLastEdge(&wheelSpeed.edges[channel]);
 }
@@ -75,7 +75,7 @@ static void brakeTemp_init(void)
     lib_interpolation_init(&brakeTemp_map, 0.0f);
 }
 
-static void brakeTemp_periodic_10Hz(void)
+static void brakeTemp_periodic_100ms(void)
 {
     brakeTemp.data[BRAKETEMP_LEFT].voltage      = drv_inputAD_getAnalogVoltage(DRV_INPUTAD_ANALOG_L_BR_TEMP);
     brakeTemp.data[BRAKETEMP_RIGHT].voltage     = drv_inputAD_getAnalogVoltage(DRV_INPUTAD_ANALOG_R_BR_TEMP);
@@ -88,7 +88,10 @@ static void brakeTemp_periodic_10Hz(void)
  ******************************************************************************/
 
 const ModuleDesc_S brakeTemp_desc = {
-    .moduleInit       = &brakeTemp_init,
-    .periodic10Hz_CLK = &brakeTemp_periodic_10Hz,
+    .moduleInit   = &brakeTemp_init,
+    .periodic_CLK = &brakeTemp_periodic_100ms,
+    .periodMs     = 100U,
+    .phaseMs      = MODULE_PHASE_AUTO,
+    .wcetUs       = 20U,
 };
 
@@ -3,10 +3,11 @@ use std::fs::OpenOptions;
 use std::fs::{create_dir_all, metadata, read_dir, remove_file, rename};
 use std::io::BufWriter;
 use std::io::Write;
-use std::os::fd::{AsRawFd, OwnedFd};
+use std::os::fd::{AsRawFd, FromRawFd, OwnedFd};
 use std::path::{Path, PathBuf};
+use std::sync::Arc;
 use std::sync::mpsc::{Receiver, RecvTimeoutError, Sender, channel};
-use std::thread;
+use std::thread::{self, JoinHandle};
 use std::time::{Duration, Instant, SystemTime};
 
 use bytes::Bytes;
@@ -16,17 +17,30 @@ use flate2::Compression;
 use flate2::write::GzEncoder;
 use influxdb2::Client as InfluxClient;
 use influxdb2::ClientBuilder as InfluxClientBuilder;
-use libc::{POLLIN, poll, pollfd};
+use libc::{
+    EPOLL_CLOEXEC, EPOLL_CTL_ADD, EPOLLIN, epoll_create1, epoll_ctl, epoll_event, epoll_wait,
+};
 use tar::Builder;
 use tokio::runtime::{Builder as TokioRuntimeBuilder, Runtime};
 
+use crate::alloc_stats;
+use crate::binlog::{BINLOG_EXTENSION, BinLogWriter, BinRecord, CHUNK_MAX_FRAMES, Chunk};
+use crate::ring::{RingReader, RingRecord, RingRecv, RingWriter};
 use crate::{
-    Bus, BusBinding, Event, Filters, ForwardRoute, NetworkBus, ProcessedEvent, bus_descriptor,
-    configure_yamcan_iface, format_processed_event, format_processed_event_line_protocol,
-    forward_route_for_pair, forward_routes_from_bus, open_can_socket, process_event, recv_event,
-    send_can_frame, yamcan_init,
+    Bus, BusBinding, CAN_BATCH_SIZE, Event, Filters, ForwardRoute, NetworkBus, ProcessedEvent,
+    RecvBatch, SendBatch, bus_descriptor, configure_yamcan_iface, forward_route_for_pair,
+    forward_routes_from_bus, open_can_socket, process_event, write_processed_event,
+    write_processed_event_line_protocol, yamcan_init,
 };
 
+const EPOLL_MAX_EVENTS: usize = 8;
+/// About 2.5 MiB of raw frames; several seconds of a saturated bus.
+const FRAME_RING_CAPACITY: usize = 1 << 16;
+const INGEST_TICK_MS: i32 = 100;
+const LOG_SINK_BATCH_BYTES: usize = 64 * 1024;
+const LOG_SINK_BATCH_MAX_AGE: Duration = Duration::from_millis(100);
+const BINLOG_CHUNK_MAX_AGE: Duration = Duration::from_secs(1);
+
 #[derive(Parser, Debug)]
 #[command(
     name = "can-bridge",
@@ -66,6 +80,11 @@ pub struct Args {
     #[arg(long = "log-size", default_value_t = 250000)]
     log_size: u64,
 
+    /// Log raw frames in the binary `.canb` format instead of line protocol.
+    /// Only the ID filter applies; frames are decoded when the log is ingested.
+    #[arg(long = "log-binary", default_value_t = false)]
+    log_binary: bool,
+
     #[arg(long = "log-to-influx", default_value_t = false)]
     log_to_influx: bool,
 
@@ -119,118 +138,468 @@ struct InfluxLogConfig {
     recovery: Option<LogConfig>,
 }
 
+struct BinaryLog {
+    opened_at: Instant,
+    current_size: u64,
+    writer: BinLogWriter<BufWriter<File>>,
+    path: PathBuf,
+}
+
 enum LogBackend {
     File(LogConfig),
+    Binary(LogConfig),
     Influx(InfluxLogConfig),
 }
 
-trait EventSink {
+/// A consumer of the frame ring. Each sink runs on its own thread and formats
+/// only what it needs from the shared raw records.
+trait EventSink: Send {
+    /// Runs on the sink thread before the first frame.
     fn initialize(&mut self) {}
-    fn handle(&mut self, event: &ProcessedEvent);
+    /// Every frame that passes the ID filter, before decoding.
+    fn handle_raw(&mut self, _binding: &BusBinding<Bus>, _event: &Event) {}
+    fn handle(&mut self, _event: &ProcessedEvent) {}
+    /// Called whenever the sink has drained the ring, and at least every
+    /// `INGEST_TICK_MS` while it is busy.
+    fn tick(&mut self) {}
+    /// Longest the sink thread sleeps on an empty ring before ticking.
+    fn wait_timeout(&self) -> Duration {
+        Duration::from_millis(INGEST_TICK_MS as u64)
+    }
+    /// Sinks that only consume raw frames return false so that their thread
+    /// never decodes.
+    fn wants_processed(&self) -> bool {
+        true
+    }
+    /// Runs on the sink thread once the ring is closed and drained.
+    fn finish(&mut self) {}
 }
 
 struct StdoutSink {
     json: bool,
+    line: String,
 }
 
 impl EventSink for StdoutSink {
     fn handle(&mut self, event: &ProcessedEvent) {
-        println!("{}", format_processed_event(event, self.json));
+        self.line.clear();
+        write_processed_event(&mut self.line, event, self.json);
+        self.line.push('\n');
+        let _ = std::io::stdout().lock().write_all(self.line.as_bytes());
     }
 }
 
-struct LogSink {
-    tx: Sender<String>,
+/// Formats line-protocol records into a batch buffer and appends the batch
+/// to the rolling log once it is large or old enough.
+struct FileLogSink {
+    manager: LogManager,
+    batch: String,
+    batch_started: Instant,
 }
 
-impl LogSink {
-    fn new(backend: LogBackend) -> std::io::Result<Self> {
-        let (tx, rx) = channel();
-        thread::Builder::new()
-            .name("can-log-writer".into())
-            .spawn(move || run_log_worker(backend, rx))?;
-        Ok(Self { tx })
+impl FileLogSink {
+    fn new(cfg: LogConfig) -> Self {
+        Self {
+            manager: LogManager::new(Some(cfg)),
+            batch: String::with_capacity(LOG_SINK_BATCH_BYTES + 512),
+            batch_started: Instant::now(),
+        }
+    }
+
+    fn flush(&mut self) {
+        if self.batch.is_empty() {
+            return;
+        }
+        self.manager.write_lines(&self.batch);
+        self.batch.clear();
     }
 }
 
-impl EventSink for LogSink {
+impl EventSink for FileLogSink {
+    fn initialize(&mut self) {
+        self.manager.recover_uncompressed_logs();
+    }
+
     fn handle(&mut self, event: &ProcessedEvent) {
-        let line = format_processed_event_line_protocol(event);
-        if let Err(e) = self.tx.send(line) {
-            eprintln!("log: writer thread stopped; failed to enqueue line-protocol record: {e}");
+        if self.batch.is_empty() {
+            self.batch_started = Instant::now();
+        }
+        write_processed_event_line_protocol(&mut self.batch, event);
+        self.batch.push('\n');
+        if self.batch.len() >= LOG_SINK_BATCH_BYTES {
+            self.flush();
+        }
+    }
+
+    fn tick(&mut self) {
+        if !self.batch.is_empty() && self.batch_started.elapsed() >= LOG_SINK_BATCH_MAX_AGE {
+            self.flush();
+        }
+    }
+
+    fn finish(&mut self) {
+        self.flush();
+    }
+}
+
+struct InfluxLogSink {
+    recovery: Option<LogConfig>,
+    writer: DirectInfluxLogWriter,
+    line: String,
+}
+
+impl EventSink for InfluxLogSink {
+    fn initialize(&mut self) {
+        if let Some(recovery) = self.recovery.take() {
+            LogManager::new(Some(recovery)).recover_uncompressed_logs();
+        }
+    }
+
+    fn handle(&mut self, event: &ProcessedEvent) {
+        self.line.clear();
+        write_processed_event_line_protocol(&mut self.line, event);
+        self.writer.push_line(&self.line);
+    }
+
+    fn tick(&mut self) {
+        if self.writer.flush_due() {
+            self.writer.flush();
+        }
+    }
+
+    fn wait_timeout(&self) -> Duration {
+        self.writer.wait_timeout()
+    }
+
+    fn finish(&mut self) {
+        self.writer.finish();
+    }
+}
+
+/// Collects raw frames into chunks and writes each full chunk to the rolling
+/// binary log. The chunk is reused so that steady-state logging does not
+/// allocate.
+struct BinaryLogSink {
+    manager: BinaryLogManager,
+    chunk: Chunk,
+    chunk_started: Instant,
+}
+
+impl BinaryLogSink {
+    fn new(cfg: LogConfig) -> Self {
+        Self {
+            manager: BinaryLogManager { cfg, log: None },
+            chunk: Chunk::with_capacity(CHUNK_MAX_FRAMES),
+            chunk_started: Instant::now(),
+        }
+    }
+
+    fn flush(&mut self) {
+        if self.chunk.is_empty() {
+            return;
+        }
+        self.manager.write_chunk(&self.chunk);
+        self.chunk.clear();
+    }
+}
+
+impl EventSink for BinaryLogSink {
+    fn initialize(&mut self) {
+        LogManager::new(Some(self.manager.cfg.clone())).recover_uncompressed_logs();
+    }
+
+    fn handle_raw(&mut self, binding: &BusBinding<Bus>, event: &Event) {
+        let ts_ns = match event.ts_opt {
+            Some((sec, nsec)) => sec
+                .saturating_mul(1_000_000_000)
+                .saturating_add(nsec as u64),
+            None => now_unix_nanos() as u64,
+        };
+        if !self.chunk.accepts(ts_ns) {
+            self.flush();
+        }
+        if self.chunk.is_empty() {
+            self.chunk_started = Instant::now();
+        }
+        let Some(bus) = self.chunk.bus_index(&binding.iface, binding.bus.as_str()) else {
+            return;
+        };
+        self.chunk.push(BinRecord {
+            ts_ns,
+            bus,
+            frame: event.frame,
+        });
+    }
+
+    fn tick(&mut self) {
+        if !self.chunk.is_empty() && self.chunk_started.elapsed() >= BINLOG_CHUNK_MAX_AGE {
+            self.flush();
         }
     }
+
+    fn wants_processed(&self) -> bool {
+        false
+    }
+
+    fn finish(&mut self) {
+        self.flush();
+        self.manager.close_current();
+    }
 }
 
+fn build_log_sink(backend: LogBackend) -> Box<dyn EventSink> {
+    match backend {
+        LogBackend::File(cfg) => Box::new(FileLogSink::new(cfg)),
+        LogBackend::Binary(cfg) => Box::new(BinaryLogSink::new(cfg)),
+        LogBackend::Influx(cfg) => {
+            let disk_spool_tx = cfg.recovery.clone().and_then(spawn_disk_spool_worker);
+            match DirectInfluxLogWriter::new(&cfg, disk_spool_tx) {
+                Ok(writer) => Box::new(InfluxLogSink {
+                    recovery: cfg.recovery,
+                    writer,
+                    line: String::with_capacity(512),
+                }),
+                Err(e) => {
+                    eprintln!(
+                        "log: failed to initialize direct Influx writer; falling back to disk: {e}"
+                    );
+                    match cfg.recovery {
+                        Some(fallback) => Box::new(FileLogSink::new(fallback)),
+                        None => {
+                            eprintln!(
+                                "log: no log-dir configured; direct Influx fallback is unavailable"
+                            );
+                            Box::new(NullSink)
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+struct NullSink;
+
+impl EventSink for NullSink {
+    fn wants_processed(&self) -> bool {
+        false
+    }
+}
+
+fn spawn_sink(
+    mut reader: RingReader,
+    bindings: Arc<[BusBinding<Bus>]>,
+    filters: Filters,
+    sink: Box<dyn EventSink>,
+) -> std::io::Result<JoinHandle<()>> {
+    thread::Builder::new()
+        .name(format!("can-sink-{}", reader.name()))
+        .spawn(move || run_sink(&mut reader, &bindings, &filters, sink))
+}
+
+fn run_sink(
+    reader: &mut RingReader,
+    bindings: &[BusBinding<Bus>],
+    filters: &Filters,
+    mut sink: Box<dyn EventSink>,
+) {
+    let tick_interval = Duration::from_millis(INGEST_TICK_MS as u64);
+    let wants_processed = sink.wants_processed();
+    let mut last_tick = Instant::now();
+    let mut last_report = Instant::now();
+    let mut frames = 0u64;
+    let mut frame_allocations = 0u64;
+
+    sink.initialize();
+    loop {
+        match reader.try_recv() {
+            RingRecv::Record(record) => {
+                let Some(binding) = bindings.get(record.source as usize) else {
+                    continue;
+                };
+                let allocations_before = alloc_stats::thread_allocations();
+                let event = Event {
+                    frame: record.frame,
+                    ts_opt: record.ts_opt,
+                };
+                sink.handle_raw(binding, &event);
+                if wants_processed {
+                    if let Some(processed) = process_event(binding, filters, event) {
+                        sink.handle(&processed);
+                    }
+                }
+                frame_allocations += alloc_stats::thread_allocations() - allocations_before;
+                frames += 1;
+
+                if frames % 256 == 0 && last_tick.elapsed() >= tick_interval {
+                    sink.tick();
+                    last_tick = Instant::now();
+                }
+            }
+            RingRecv::Empty => {
+                sink.tick();
+                last_tick = Instant::now();
+                reader.wait(sink.wait_timeout());
+            }
+            RingRecv::Closed => break,
+        }
+
+        if last_report.elapsed() >= Duration::from_secs(60) {
+            if frames > 0 && alloc_stats::total_allocations() > 0 {
+                println!(
+                    "[alloc:{}] {:.3} heap allocations/frame over {} frames",
+                    reader.name(),
+                    frame_allocations as f64 / frames as f64,
+                    frames
+                );
+            }
+            frames = 0;
+            frame_allocations = 0;
+            last_report = Instant::now();
+        }
+    }
+    sink.finish();
+}
+
+struct BandwidthCounter {
+    binding: BusBinding<Bus>,
+    bits: u64,
+}
+
+/// Runs on the ingest thread: counts bandwidth, applies the ID filter and
+/// publishes each frame once to the ring shared by all sinks.
 struct EventProcessor {
     filters: Filters,
-    bandwidth_bits: std::collections::HashMap<String, u64>,
+    bandwidth: Vec<BandwidthCounter>,
     last_bandwidth_report: Instant,
-    sinks: Vec<Box<dyn EventSink>>,
+    ring: RingWriter,
+    sink_threads: Vec<JoinHandle<()>>,
+    frames: u64,
+    frame_allocations: u64,
 }
 
 impl EventProcessor {
-    fn new(filters: Filters, quiet: bool, json: bool, log_backend: Option<LogBackend>) -> Self {
-        let mut sinks: Vec<Box<dyn EventSink>> = Vec::new();
+    /// `bindings` lists every bus the ingest loop reads, indexed by
+    /// `IngestSource::source`.
+    fn new(
+        bindings: Vec<BusBinding<Bus>>,
+        filters: Filters,
+        quiet: bool,
+        json: bool,
+        log_backend: Option<LogBackend>,
+    ) -> Self {
+        let mut sinks: Vec<(&'static str, Box<dyn EventSink>)> = Vec::new();
         if !quiet {
-            sinks.push(Box::new(StdoutSink { json }));
+            sinks.push((
+                "stdout",
+                Box::new(StdoutSink {
+                    json,
+                    line: String::with_capacity(512),
+                }),
+            ));
         }
         if let Some(backend) = log_backend {
-            match LogSink::new(backend) {
-                Ok(sink) => sinks.push(Box::new(sink)),
-                Err(e) => eprintln!("log: failed to start writer thread: {e}"),
+            sinks.push(("log", build_log_sink(backend)));
+        }
+
+        let mut ring = RingWriter::with_capacity(FRAME_RING_CAPACITY);
+        let shared_bindings: Arc<[BusBinding<Bus>]> = bindings.iter().cloned().collect();
+        let mut sink_threads = Vec::new();
+        for (name, sink) in sinks {
+            let reader = ring.subscribe(name);
+            match spawn_sink(reader, shared_bindings.clone(), filters.clone(), sink) {
+                Ok(handle) => sink_threads.push(handle),
+                Err(e) => eprintln!("[bridge] failed to start {name} sink thread: {e}"),
             }
         }
 
         Self {
             filters,
-            bandwidth_bits: std::collections::HashMap::new(),
+            bandwidth: bindings
+                .into_iter()
+                .map(|binding| BandwidthCounter { binding, bits: 0 })
+                .collect(),
             last_bandwidth_report: Instant::now(),
-            sinks,
-        }
-    }
-
-    fn initialize(&mut self) {
-        for sink in &mut self.sinks {
-            sink.initialize();
+            ring,
+            sink_threads,
+            frames: 0,
+            frame_allocations: 0,
         }
     }
 
     fn tick(&mut self) {
+        self.ring.notify();
+
         let elapsed = self.last_bandwidth_report.elapsed();
         if elapsed < Duration::from_secs(60) {
             return;
         }
 
-        for (label, bits) in self.bandwidth_bits.drain() {
+        for counter in &mut self.bandwidth {
+            if counter.bits == 0 {
+                continue;
+            }
             println!(
-                "[{}] {:.3} bits/s over {:?}",
-                label,
-                bits as f64 / elapsed.as_secs_f64(),
+                "[{}:{}] {:.3} bits/s over {:?}",
+                counter.binding.iface,
+                counter.binding.bus.as_str(),
+                counter.bits as f64 / elapsed.as_secs_f64(),
                 elapsed
             );
+            counter.bits = 0;
         }
+        for stats in self.ring.reader_stats() {
+            println!(
+                "[sink:{}] lag={} dropped={} ring={}",
+                stats.name,
+                stats.lag,
+                stats.dropped,
+                self.ring.capacity()
+            );
+        }
+        if self.frames > 0 && alloc_stats::total_allocations() > 0 {
+            println!(
+                "[alloc:ingest] {:.3} heap allocations/frame over {} frames",
+                self.frame_allocations as f64 / self.frames as f64,
+                self.frames
+            );
+        }
+        self.frames = 0;
+        self.frame_allocations = 0;
         self.last_bandwidth_report = Instant::now();
     }
 
-    fn handle_event(&mut self, binding: &BusBinding<Bus>, event: Event) {
-        let (_, bit_length) = crate::frame_id_and_bit_length(&event.frame);
-        let bandwidth_key = format!("{}:{}", binding.iface, binding.bus.as_str());
-        if let Some(processed) = process_event(binding, &self.filters, event) {
-            self.bandwidth_bits
-                .entry(bandwidth_key)
-                .and_modify(|bits| *bits = bits.saturating_add(processed.bit_length as u64))
-                .or_insert(processed.bit_length as u64);
-            for sink in &mut self.sinks {
-                sink.handle(&processed);
-            }
+    fn handle_event(&mut self, source: u8, event: Event) {
+        let allocations_before = alloc_stats::thread_allocations();
+        self.process_frame(source, event);
+        self.frames += 1;
+        self.frame_allocations += alloc_stats::thread_allocations() - allocations_before;
+    }
+
+    fn process_frame(&mut self, source: u8, event: Event) {
+        let (id_masked, bit_length) = crate::frame_id_and_bit_length(&event.frame);
+        if let Some(counter) = self.bandwidth.get_mut(source as usize) {
+            counter.bits = counter.bits.saturating_add(bit_length as u64);
+        }
+        if self.sink_threads.is_empty() || !self.filters.match_id(id_masked) {
             return;
         }
 
-        self.bandwidth_bits
-            .entry(bandwidth_key)
-            .and_modify(|bits| *bits = bits.saturating_add(bit_length as u64))
-            .or_insert(bit_length as u64);
+        self.ring.push(&RingRecord {
+            source,
+            frame: event.frame,
+            ts_opt: event.ts_opt,
+        });
+    }
+}
+
+impl Drop for EventProcessor {
+    /// Close the ring and let every sink drain it and flush.
+    fn drop(&mut self) {
+        self.ring.close();
+        for handle in self.sink_threads.drain(..) {
+            let _ = handle.join();
+        }
     }
 }
 
@@ -282,7 +651,8 @@ impl LogManager {
         }
     }
 
-    fn write_line(&mut self, line: &str) {
+    /// Append newline-terminated records.
+    fn write_lines(&mut self, body: &str) {
         let Some(cfg) = self.cfg.clone() else {
             return;
         };
@@ -292,11 +662,11 @@ impl LogManager {
         }
 
         if let Some(log) = self.global_log.as_mut() {
-            if let Err(e) = writeln!(log.writer, "{line}") {
+            if let Err(e) = log.writer.write_all(body.as_bytes()) {
                 eprintln!("log: write failed for single log: {e}");
                 self.global_log = None;
             } else {
-                log.current_size = log.current_size.saturating_add((line.len() + 1) as u64);
+                log.current_size = log.current_size.saturating_add(body.len() as u64);
             }
         }
     }
@@ -335,21 +705,99 @@ impl LogManager {
     }
 }
 
-fn run_log_worker(backend: LogBackend, rx: Receiver<String>) {
-    match backend {
-        LogBackend::File(cfg) => run_file_log_worker(cfg, rx),
-        LogBackend::Influx(cfg) => run_influx_log_worker(cfg, rx),
-    }
+struct BinaryLogManager {
+    cfg: LogConfig,
+    log: Option<BinaryLog>,
 }
 
-fn run_file_log_worker(cfg: LogConfig, rx: Receiver<String>) {
-    let mut manager = LogManager::new(Some(cfg));
-    manager.recover_uncompressed_logs();
-    while let Ok(line) = rx.recv() {
-        manager.write_line(&line);
+impl BinaryLogManager {
+    fn write_chunk(&mut self, chunk: &Chunk) {
+        if self.ensure_log_ready().is_err() {
+            return;
+        }
+
+        if let Some(log) = self.log.as_mut() {
+            match log.writer.write_chunk(chunk) {
+                Ok(bytes) => log.current_size = log.current_size.saturating_add(bytes as u64),
+                Err(e) => {
+                    eprintln!("log: binary write failed: {e}");
+                    self.close_current();
+                }
+            }
+        }
+    }
+
+    fn ensure_log_ready(&mut self) -> Result<(), ()> {
+        let need_open = match self.log.as_ref() {
+            None => {
+                println!("log: creating new binary log...");
+                true
+            }
+            Some(log) => {
+                let elapsed = log.opened_at.elapsed();
+                let roll = log.current_size >= self.cfg.max_bytes || elapsed >= self.cfg.max_age;
+                if roll {
+                    println!(
+                        "log: rolling binary log '{}' after {:.1}s, {} bytes",
+                        log.path.display(),
+                        elapsed.as_secs_f64(),
+                        log.current_size
+                    );
+                }
+                roll
+            }
+        };
+
+        if !need_open {
+            return Ok(());
+        }
+
+        self.close_current();
+        self.log = match open_binary_log(&self.cfg) {
+            Ok(log) => Some(log),
+            Err(e) => {
+                eprintln!("log: failed to open binary log: {e}");
+                return Err(());
+            }
+        };
+        Ok(())
+    }
+
+    /// Write the chunk index and hand the file to the compressor.
+    fn close_current(&mut self) {
+        let Some(log) = self.log.take() else {
+            return;
+        };
+        if let Err(e) = log.writer.finish() {
+            eprintln!(
+                "log: failed to finish binary log '{}': {e}",
+                log.path.display()
+            );
+        }
+        spawn_compression(log.path, self.cfg.clone());
     }
 }
 
+fn open_binary_log(cfg: &LogConfig) -> std::io::Result<BinaryLog> {
+    create_dir_all(&cfg.tmp)?;
+    let stamp = Local::now().format("%Y-%m-%d_%H%M%S");
+    let path = cfg
+        .tmp
+        .join(format!("{}-{stamp}.{BINLOG_EXTENSION}", cfg.label));
+    let file = OpenOptions::new()
+        .write(true)
+        .create_new(true)
+        .open(&path)?;
+    eprintln!("log: opening file {:?}", path);
+    let writer = BinLogWriter::new(BufWriter::new(file))?;
+    Ok(BinaryLog {
+        opened_at: Instant::now(),
+        current_size: 0,
+        writer,
+        path,
+    })
+}
+
 struct DirectInfluxLogWriter {
     rt: Runtime,
     client: InfluxClient,
@@ -416,7 +864,7 @@ impl DirectInfluxLogWriter {
         })
     }
 
-    fn push_line(&mut self, line: String) {
+    fn push_line(&mut self, line: &str) {
         let next_len = line.len().saturating_add(1);
         if self.count > 0
             && (self.count >= self.batch_size
@@ -437,6 +885,7 @@ impl DirectInfluxLogWriter {
     fn flush(&mut self) {
         if self.count == 0 {
             self.retry_failed_buffer();
+            self.last_flush = Instant::now();
             return;
         }
 
@@ -473,7 +922,7 @@ impl DirectInfluxLogWriter {
         }
     }
 
-    fn recv_timeout(&self) -> Duration {
+    fn wait_timeout(&self) -> Duration {
         if self.count == 0 {
             return Duration::from_secs(1);
         }
@@ -486,8 +935,15 @@ impl DirectInfluxLogWriter {
         }
     }
 
-    fn should_flush_for_age(&self) -> bool {
-        self.count > 0 && self.last_flush.elapsed() >= self.flush_interval
+    /// Pending records have waited a flush interval, or failed batches are
+    /// due another retry.
+    fn flush_due(&self) -> bool {
+        let elapsed = self.last_flush.elapsed();
+        if self.count == 0 {
+            self.failed_count > 0 && elapsed >= Duration::from_secs(1)
+        } else {
+            elapsed >= self.flush_interval
+        }
     }
 
     fn write_batch(&mut self, body: Bytes, count: usize) -> bool {
@@ -593,43 +1049,6 @@ impl DirectInfluxLogWriter {
     }
 }
 
-fn run_influx_log_worker(cfg: InfluxLogConfig, rx: Receiver<String>) {
-    if let Some(recovery) = cfg.recovery.clone() {
-        LogManager::new(Some(recovery)).recover_uncompressed_logs();
-    }
-    let disk_spool_tx = cfg.recovery.clone().and_then(spawn_disk_spool_worker);
-
-    let mut writer = match DirectInfluxLogWriter::new(&cfg, disk_spool_tx) {
-        Ok(writer) => writer,
-        Err(e) => {
-            eprintln!("log: failed to initialize direct Influx writer; falling back to disk: {e}");
-            if let Some(fallback) = cfg.recovery {
-                run_file_log_worker(fallback, rx);
-            } else {
-                eprintln!("log: no log-dir configured; direct Influx fallback is unavailable");
-            }
-            return;
-        }
-    };
-
-    loop {
-        match rx.recv_timeout(writer.recv_timeout()) {
-            Ok(line) => {
-                writer.push_line(line);
-                for queued_line in rx.try_iter() {
-                    writer.push_line(queued_line);
-                }
-                if writer.should_flush_for_age() {
-                    writer.flush();
-                }
-            }
-            Err(RecvTimeoutError::Timeout) => writer.flush(),
-            Err(RecvTimeoutError::Disconnected) => break,
-        }
-    }
-    writer.finish();
-}
-
 fn spawn_disk_spool_worker(cfg: LogConfig) -> Option<Sender<DiskSpoolBatch>> {
     let (tx, rx) = channel();
     match thread::Builder::new()
@@ -879,12 +1298,16 @@ pub fn run(bus: Bus) -> Result<(), Box<dyn std::error::Error>> {
     print_filter_summary(&filters);
 
     let mut processor = EventProcessor::new(
+        ingest_bindings(
+            &binding,
+            routes.first().copied(),
+            args.forward_iface.as_deref(),
+        ),
         filters,
         args.quiet,
         args.json,
         build_log_backend(&args, binding.bus.as_str())?,
     );
-    processor.initialize();
 
     println!(
         "[bridge] listening on {}:{}",
@@ -926,66 +1349,36 @@ pub fn run(bus: Bus) -> Result<(), Box<dyn std::error::Error>> {
                 }
             };
 
-        loop {
-            match wait_for_ready_fds(
-                &physical_fd,
-                forwarding
-                    .as_ref()
-                    .and_then(|ctx| ctx.incoming.as_ref())
-                    .map(|ep| &ep.fd),
-            ) {
-                Ok((physical_ready, incoming_ready)) => {
-                    if physical_ready {
-                        match recv_event(&physical_fd, &binding.iface) {
-                            Ok(event) => {
-                                if let Some(ctx) = forwarding.as_ref() {
-                                    if let Some(outgoing) = ctx.outgoing.as_ref() {
-                                        forward_on_route(outgoing, &event);
-                                    }
-                                }
-                                processor.handle_event(&binding, event);
-                            }
-                            Err(e) => {
-                                eprintln!("[bridge] receive error on {}: {e}", binding.iface);
-                                break;
-                            }
-                        }
-                    }
-
-                    if incoming_ready {
-                        let Some(ctx) = forwarding.as_ref() else {
-                            continue;
-                        };
-                        let Some(incoming) = ctx.incoming.as_ref() else {
-                            continue;
-                        };
-                        match recv_event(&incoming.fd, &incoming.binding.iface) {
-                            Ok(event) => {
-                                forward_frame_on_route(
-                                    incoming.route,
-                                    &binding.iface,
-                                    &physical_fd,
-                                    &event,
-                                );
-                                processor.handle_event(&incoming.binding, event);
-                            }
-                            Err(e) => {
-                                eprintln!(
-                                    "[bridge] receive error on {}: {e}",
-                                    incoming.binding.iface
-                                );
-                                break;
-                            }
-                        }
-                    }
+        let mut sources = vec![IngestSource {
+            source: 0,
+            binding: binding.clone(),
+            fd: &physical_fd,
+            forward: forwarding
+                .as_ref()
+                .and_then(|ctx| ctx.outgoing.as_ref())
+                .map(|outgoing| ForwardTarget {
+                    route: outgoing.route,
+                    iface: outgoing.binding.iface.as_str(),
+                    fd: &outgoing.fd,
+                    batch: SendBatch::with_capacity(CAN_BATCH_SIZE),
+                }),
+        }];
+        if let Some(incoming) = forwarding.as_ref().and_then(|ctx| ctx.incoming.as_ref()) {
+            sources.push(IngestSource {
+                source: 1,
+                binding: incoming.binding.clone(),
+                fd: &incoming.fd,
+                forward: Some(ForwardTarget {
+                    route: incoming.route,
+                    iface: binding.iface.as_str(),
+                    fd: &physical_fd,
+                    batch: SendBatch::with_capacity(CAN_BATCH_SIZE),
+                }),
+            });
+        }
 
-                    processor.tick();
-                }
-                Err(e) => {
-                    eprintln!("[bridge] poll error: {e}");
-                    break;
-                }
-            }
+        if let Err(e) = run_ingest_loop(&mut sources, &mut processor) {
+            eprintln!("[bridge] {e}");
         }
 
         thread::sleep(Duration::from_secs(1));
@@ -1009,6 +1402,16 @@ fn build_log_backend(
     args: &Args,
     bus_label: &str,
 ) -> Result<Option<LogBackend>, Box<dyn std::error::Error>> {
+    if args.log_binary && args.log_to_influx {
+        return Err(std::io::Error::new(
+            std::io::ErrorKind::InvalidInput,
+            "--log-binary cannot be combined with --log-to-influx",
+        )
+        .into());
+    }
+    if args.log_binary {
+        return Ok(build_file_log_config(args, bus_label).map(LogBackend::Binary));
+    }
     if !args.log_to_influx {
         return Ok(build_file_log_config(args, bus_label).map(LogBackend::File));
     }
@@ -1107,58 +1510,193 @@ fn open_forwarding_context(
     }
 }
 
-fn wait_for_ready_fds(
-    primary_fd: &OwnedFd,
-    incoming_fd: Option<&OwnedFd>,
-) -> std::io::Result<(bool, bool)> {
-    let mut fds = vec![pollfd {
-        fd: primary_fd.as_raw_fd(),
-        events: POLLIN,
-        revents: 0,
-    }];
-    if let Some(fd) = incoming_fd {
-        fds.push(pollfd {
-            fd: fd.as_raw_fd(),
-            events: POLLIN,
-            revents: 0,
-        });
+/// The bus bindings `run` can read from: the physical bus, then the return
+/// route from the forward interface when one is configured. Sink threads are
+/// started once with this list, so it must match the sources opened by
+/// `open_forwarding_context`.
+fn ingest_bindings(
+    binding: &BusBinding<Bus>,
+    route: Option<ForwardRoute<Bus>>,
+    forward_iface: Option<&str>,
+) -> Vec<BusBinding<Bus>> {
+    let mut bindings = vec![binding.clone()];
+    if let (Some(route), Some(forward_iface)) = (route, forward_iface) {
+        if let Some(incoming_route) = forward_route_for_pair(route.dest_bus, binding.bus) {
+            bindings.push(BusBinding {
+                iface: forward_iface.to_string(),
+                bus: incoming_route.source_bus,
+            });
+        }
+    }
+    bindings
+}
+
+/// A socket drained by the ingest loop, with the route its frames are
+/// forwarded on.
+struct IngestSource<'a> {
+    /// Index into the bindings the processor was created with.
+    source: u8,
+    binding: BusBinding<Bus>,
+    fd: &'a OwnedFd,
+    forward: Option<ForwardTarget<'a>>,
+}
+
+struct ForwardTarget<'a> {
+    route: ForwardRoute<Bus>,
+    iface: &'a str,
+    fd: &'a OwnedFd,
+    batch: SendBatch,
+}
+
+struct Epoll {
+    fd: OwnedFd,
+}
+
+impl Epoll {
+    fn new() -> std::io::Result<Self> {
+        let fd = unsafe { epoll_create1(EPOLL_CLOEXEC) };
+        if fd < 0 {
+            return Err(std::io::Error::last_os_error());
+        }
+        Ok(Self {
+            fd: unsafe { OwnedFd::from_raw_fd(fd) },
+        })
+    }
+
+    fn add(&self, fd: &OwnedFd, token: u64) -> std::io::Result<()> {
+        let mut event = epoll_event {
+            events: EPOLLIN as u32,
+            u64: token,
+        };
+        let rc = unsafe {
+            epoll_ctl(
+                self.fd.as_raw_fd(),
+                EPOLL_CTL_ADD,
+                fd.as_raw_fd(),
+                &mut event,
+            )
+        };
+        if rc != 0 {
+            return Err(std::io::Error::last_os_error());
+        }
+        Ok(())
+    }
+
+    fn wait(&self, events: &mut [epoll_event], timeout_ms: i32) -> std::io::Result<usize> {
+        let rc = unsafe {
+            epoll_wait(
+                self.fd.as_raw_fd(),
+                events.as_mut_ptr(),
+                events.len() as i32,
+                timeout_ms,
+            )
+        };
+        if rc < 0 {
+            let err = std::io::Error::last_os_error();
+            if err.kind() == std::io::ErrorKind::Interrupted {
+                return Ok(0);
+            }
+            return Err(err);
+        }
+        Ok(rc as usize)
     }
+}
 
-    let rc = unsafe { poll(fds.as_mut_ptr(), fds.len() as _, -1) };
-    if rc < 0 {
-        return Err(std::io::Error::last_os_error());
+/// Drain every ready socket with `recvmmsg`, forward each batch with
+/// `sendmmsg`, then hand the frames to the processor. Returns when a socket
+/// fails so that the caller can reopen them.
+fn run_ingest_loop(
+    sources: &mut [IngestSource<'_>],
+    processor: &mut EventProcessor,
+) -> std::io::Result<()> {
+    let epoll = Epoll::new()?;
+    for (token, source) in sources.iter().enumerate() {
+        epoll.add(source.fd, token as u64)?;
     }
 
-    let primary_ready = (fds[0].revents & POLLIN) != 0;
-    let incoming_ready = fds.get(1).is_some_and(|fd| (fd.revents & POLLIN) != 0);
-    Ok((primary_ready, incoming_ready))
+    let mut rx = RecvBatch::with_capacity(CAN_BATCH_SIZE);
+    let mut ready = [epoll_event { events: 0, u64: 0 }; EPOLL_MAX_EVENTS];
+
+    loop {
+        let count = epoll
+            .wait(&mut ready, INGEST_TICK_MS)
+            .map_err(|e| std::io::Error::new(e.kind(), format!("epoll error: {e}")))?;
+
+        for ready_event in &ready[..count] {
+            let token = ready_event.u64 as usize;
+            let Some(source) = sources.get_mut(token) else {
+                continue;
+            };
+            drain_source(source, &mut rx, processor).map_err(|e| {
+                std::io::Error::new(
+                    e.kind(),
+                    format!("receive error on {}: {e}", source.binding.iface),
+                )
+            })?;
+        }
+
+        processor.tick();
+    }
 }
 
-fn forward_on_route(endpoint: &RouteEndpoint, event: &Event) {
-    forward_frame_on_route(endpoint.route, &endpoint.binding.iface, &endpoint.fd, event);
+fn drain_source(
+    source: &mut IngestSource<'_>,
+    rx: &mut RecvBatch,
+    processor: &mut EventProcessor,
+) -> std::io::Result<()> {
+    loop {
+        let received = rx.recv(source.fd)?;
+        if received == 0 {
+            return Ok(());
+        }
+
+        // Forward first so that bridged frames are not delayed by decoding
+        if let Some(target) = source.forward.as_mut() {
+            for event in rx.events() {
+                queue_forward(target, &source.binding.iface, &event);
+            }
+            flush_forward(target, &source.binding.iface);
+        }
+
+        for event in rx.events() {
+            processor.handle_event(source.source, event);
+        }
+
+        if received < rx.capacity() {
+            return Ok(());
+        }
+    }
 }
 
-fn forward_frame_on_route(
-    route: ForwardRoute<Bus>,
-    dest_iface: &str,
-    dest_fd: &OwnedFd,
-    event: &Event,
-) {
+fn queue_forward(target: &mut ForwardTarget<'_>, source_iface: &str, event: &Event) {
     let (id_masked, _) = crate::frame_id_and_bit_length(&event.frame);
-    if !route.forwards_id(id_masked) {
+    if !target.route.forwards_id(id_masked) {
         return;
     }
-    if let Err(e) = send_can_frame(dest_fd, &event.frame) {
-        let message_name = route
+    if target.batch.is_full() {
+        flush_forward(target, source_iface);
+    }
+    target.batch.push(&event.frame);
+}
+
+fn flush_forward(target: &mut ForwardTarget<'_>, source_iface: &str) {
+    if target.batch.is_empty() {
+        return;
+    }
+    let id_masked = target.batch.first_id().unwrap_or_default();
+    if let Err((dropped, e)) = target.batch.flush(target.fd) {
+        let message_name = target
+            .route
             .forwarded_message_for_id(id_masked)
             .map(|message| message.name)
             .unwrap_or("unknown");
         eprintln!(
-            "[forward] failed {}:{} -> {}:{} for {} (0x{:X}): {e}",
-            event.iface,
-            route.source_bus.as_str(),
-            dest_iface,
-            route.dest_bus.as_str(),
+            "[forward] failed {}:{} -> {}:{} dropping {} frame(s) from {} (0x{:X}): {e}",
+            source_iface,
+            target.route.source_bus.as_str(),
+            target.iface,
+            target.route.dest_bus.as_str(),
+            dropped,
             message_name,
             id_masked
         );
@@ -1268,14 +1806,16 @@ fn spawn_compression(path: PathBuf, cfg: LogConfig) {
 
 fn compress_and_remove(orig_path: &Path, dest_folder: &Path) -> std::io::Result<PathBuf> {
     let mut gz_path = orig_path.to_path_buf();
-    let archive_extension = match orig_path.extension().and_then(|ext| ext.to_str()) {
-        Some("lp") => "lp.tar.gz",
-        _ => "log.tar.gz",
+    let (archive_extension, level) = match orig_path.extension().and_then(|ext| ext.to_str()) {
+        Some("lp") => ("lp.tar.gz", Compression::default()),
+        // Chunks are already deflated
+        Some(BINLOG_EXTENSION) => ("canb.tar.gz", Compression::none()),
+        _ => ("log.tar.gz", Compression::default()),
     };
     gz_path.set_extension(archive_extension);
 
     let tar_gz = File::create(&gz_path)?;
-    let enc = GzEncoder::new(tar_gz, Compression::default());
+    let enc = GzEncoder::new(tar_gz, level);
     let mut tar = Builder::new(enc);
     tar.append_path_with_name(orig_path, orig_path.file_name().unwrap())?;
     let enc = tar.into_inner()?;
@@ -1298,7 +1838,7 @@ fn find_uncompressed_logs(dir: &Path) -> std::io::Result<Vec<PathBuf>> {
         let path = entry.path();
         if path
             .extension()
-            .is_some_and(|ext| ext == "log" || ext == "lp")
+            .is_some_and(|ext| ext == "log" || ext == "lp" || ext == BINLOG_EXTENSION)
         {
             ret.push(path);
         }
@@ -0,0 +1,690 @@
+//! Binary columnar CAN log (`.canb`).
+//!
+//! A log is a 16 byte file header followed by chunks of up to
+//! [`CHUNK_MAX_FRAMES`] raw frames and, once the log is closed cleanly, a
+//! chunk index. All integers are little endian.
+//!
+//! ```text
+//! header  "CANBLOG\0" version:u16 header_len:u16 reserved:u32
+//! chunk   "CHNK" frames:u32 base_ts_ns:u64 payload_len:u32 raw_len:u32
+//!         bus_count:u8 compression:u8 reserved:u16
+//!         bus_count * (iface_len:u8 iface bus_len:u8 bus)
+//!         payload (deflate of the columns below)
+//! columns ts_delta_ns:u32[n] can_id:u32[n] bus:u8[n] dlc:u8[n] data:[u8; 8][n]
+//! index   "CIDX" chunks:u32 chunks * (offset:u64 base_ts_ns:u64 frames:u32)
+//!         index_offset:u64 "CEND"
+//! ```
+//!
+//! Timestamps are stored as the delta to the previous frame in the chunk, so a
+//! chunk is closed early when time goes backwards or a gap does not fit in 32
+//! bits. Logs that were not closed (power loss) have no index and are read by
+//! scanning chunks until the end of the file.
+
+use std::io::{self, Read, Write};
+
+use flate2::{Compress, Compression, Decompress, FlushCompress, FlushDecompress, Status};
+use yamcan_generated::GeneratedNetwork;
+use yamcan_generated::yamcan::NetworkDecoder;
+
+use crate::{Bus, CanFrame, NetworkBus};
+
+pub const BINLOG_EXTENSION: &str = "canb";
+pub const CHUNK_MAX_FRAMES: usize = 4_096;
+
+const FILE_MAGIC: &[u8; 8] = b"CANBLOG\0";
+const FILE_VERSION: u16 = 1;
+const FILE_HEADER_LEN: u16 = 16;
+const CHUNK_MAGIC: &[u8; 4] = b"CHNK";
+const INDEX_MAGIC: &[u8; 4] = b"CIDX";
+const END_MAGIC: &[u8; 4] = b"CEND";
+const CHUNK_HEADER_LEN: usize = 28;
+const COMPRESSION_NONE: u8 = 0;
+const COMPRESSION_DEFLATE: u8 = 1;
+
+/// Serialized size of one frame across all columns.
+pub const RECORD_LEN: usize = 4 + 4 + 1 + 1 + 8;
+
+#[derive(Clone, Copy, Debug)]
+pub struct BinRecord {
+    pub ts_ns: u64,
+    pub bus: u8,
+    pub frame: CanFrame,
+}
+
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct BusEntry {
+    pub iface: String,
+    pub bus: String,
+}
+
+#[derive(Clone, Copy, Debug)]
+pub struct IndexEntry {
+    pub offset: u64,
+    pub base_ts_ns: u64,
+    pub frames: u32,
+}
+
+/// A chunk of frames with the bus table its records index into.
+///
+/// Clearing a chunk keeps the bus table and the record capacity so that a
+/// recycled chunk can be refilled without allocating.
+#[derive(Debug, Default)]
+pub struct Chunk {
+    pub buses: Vec<BusEntry>,
+    pub records: Vec<BinRecord>,
+}
+
+impl Chunk {
+    pub fn with_capacity(frames: usize) -> Self {
+        Self {
+            buses: Vec::new(),
+            records: Vec::with_capacity(frames),
+        }
+    }
+
+    pub fn len(&self) -> usize {
+        self.records.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.records.is_empty()
+    }
+
+    pub fn clear(&mut self) {
+        self.records.clear();
+    }
+
+    pub fn first_ts_ns(&self) -> Option<u64> {
+        self.records.first().map(|record| record.ts_ns)
+    }
+
+    /// Index of `iface`/`bus` in the bus table, adding it when missing.
+    pub fn bus_index(&mut self, iface: &str, bus: &str) -> Option<u8> {
+        if let Some(index) = self
+            .buses
+            .iter()
+            .position(|entry| entry.iface == iface && entry.bus == bus)
+        {
+            return Some(index as u8);
+        }
+        if self.buses.len() >= u8::MAX as usize || iface.len() > 255 || bus.len() > 255 {
+            return None;
+        }
+        self.buses.push(BusEntry {
+            iface: iface.to_string(),
+            bus: bus.to_string(),
+        });
+        Some((self.buses.len() - 1) as u8)
+    }
+
+    /// Whether `ts_ns` can follow the last record in this chunk.
+    pub fn accepts(&self, ts_ns: u64) -> bool {
+        if self.records.len() >= CHUNK_MAX_FRAMES {
+            return false;
+        }
+        match self.records.last() {
+            Some(last) => ts_ns >= last.ts_ns && ts_ns - last.ts_ns <= u32::MAX as u64,
+            None => true,
+        }
+    }
+
+    /// Append a record; returns false when the chunk must be flushed first.
+    pub fn push(&mut self, record: BinRecord) -> bool {
+        if !self.accepts(record.ts_ns) {
+            return false;
+        }
+        self.records.push(record);
+        true
+    }
+}
+
+/// Map a bus name stored in a log back to the generated network bus.
+pub fn bus_from_name(name: &str) -> Option<Bus> {
+    GeneratedNetwork::buses()
+        .iter()
+        .map(|desc| desc.name)
+        .find(|bus| bus.as_str() == name)
+}
+
+pub struct BinLogWriter<W: Write> {
+    inner: W,
+    offset: u64,
+    index: Vec<IndexEntry>,
+    compress: Compress,
+    raw: Vec<u8>,
+    payload: Vec<u8>,
+}
+
+impl<W: Write> BinLogWriter<W> {
+    pub fn new(mut inner: W) -> io::Result<Self> {
+        let mut header = [0u8; FILE_HEADER_LEN as usize];
+        header[..8].copy_from_slice(FILE_MAGIC);
+        header[8..10].copy_from_slice(&FILE_VERSION.to_le_bytes());
+        header[10..12].copy_from_slice(&FILE_HEADER_LEN.to_le_bytes());
+        inner.write_all(&header)?;
+        Ok(Self {
+            inner,
+            offset: FILE_HEADER_LEN as u64,
+            index: Vec::new(),
+            compress: Compress::new(Compression::fast(), false),
+            raw: Vec::with_capacity(CHUNK_MAX_FRAMES * RECORD_LEN),
+            payload: Vec::with_capacity(CHUNK_MAX_FRAMES * RECORD_LEN),
+        })
+    }
+
+    /// Encode and write one chunk. Returns the number of bytes written.
+    pub fn write_chunk(&mut self, chunk: &Chunk) -> io::Result<usize> {
+        let Some(base_ts_ns) = chunk.first_ts_ns() else {
+            return Ok(0);
+        };
+        encode_columns(chunk, &mut self.raw);
+        let compression = self.deflate()?;
+        let payload = match compression {
+            COMPRESSION_DEFLATE => &self.payload,
+            _ => &self.raw,
+        };
+
+        let mut header = [0u8; CHUNK_HEADER_LEN];
+        header[0..4].copy_from_slice(CHUNK_MAGIC);
+        header[4..8].copy_from_slice(&(chunk.len() as u32).to_le_bytes());
+        header[8..16].copy_from_slice(&base_ts_ns.to_le_bytes());
+        header[16..20].copy_from_slice(&(payload.len() as u32).to_le_bytes());
+        header[20..24].copy_from_slice(&(self.raw.len() as u32).to_le_bytes());
+        header[24] = chunk.buses.len() as u8;
+        header[25] = compression;
+        self.inner.write_all(&header)?;
+
+        let mut written = CHUNK_HEADER_LEN;
+        for entry in &chunk.buses {
+            self.inner.write_all(&[entry.iface.len() as u8])?;
+            self.inner.write_all(entry.iface.as_bytes())?;
+            self.inner.write_all(&[entry.bus.len() as u8])?;
+            self.inner.write_all(entry.bus.as_bytes())?;
+            written += 2 + entry.iface.len() + entry.bus.len();
+        }
+        self.inner.write_all(payload)?;
+        written += payload.len();
+
+        self.index.push(IndexEntry {
+            offset: self.offset,
+            base_ts_ns,
+            frames: chunk.len() as u32,
+        });
+        self.offset += written as u64;
+        Ok(written)
+    }
+
+    /// Write the chunk index and return the inner writer.
+    pub fn finish(mut self) -> io::Result<W> {
+        let index_offset = self.offset;
+        self.inner.write_all(INDEX_MAGIC)?;
+        self.inner
+            .write_all(&(self.index.len() as u32).to_le_bytes())?;
+        for entry in &self.index {
+            self.inner.write_all(&entry.offset.to_le_bytes())?;
+            self.inner.write_all(&entry.base_ts_ns.to_le_bytes())?;
+            self.inner.write_all(&entry.frames.to_le_bytes())?;
+        }
+        self.inner.write_all(&index_offset.to_le_bytes())?;
+        self.inner.write_all(END_MAGIC)?;
+        self.inner.flush()?;
+        Ok(self.inner)
+    }
+
+    pub fn get_mut(&mut self) -> &mut W {
+        &mut self.inner
+    }
+
+    /// Deflate `raw` into `payload`, falling back to storing it as-is when
+    /// it does not shrink.
+    fn deflate(&mut self) -> io::Result<u8> {
+        self.compress.reset();
+        self.payload.clear();
+        self.payload.reserve(self.raw.len() + 64);
+        loop {
+            let consumed = self.compress.total_in() as usize;
+            let status = self
+                .compress
+                .compress_vec(
+                    &self.raw[consumed..],
+                    &mut self.payload,
+                    FlushCompress::Finish,
+                )
+                .map_err(io::Error::other)?;
+            if status == Status::StreamEnd {
+                break;
+            }
+            if self.payload.len() >= self.raw.len() {
+                return Ok(COMPRESSION_NONE);
+            }
+            self.payload.reserve(self.raw.len() / 4 + 64);
+        }
+        if self.payload.len() >= self.raw.len() {
+            return Ok(COMPRESSION_NONE);
+        }
+        Ok(COMPRESSION_DEFLATE)
+    }
+}
+
+fn encode_columns(chunk: &Chunk, raw: &mut Vec<u8>) {
+    raw.clear();
+    let mut prev_ts = chunk.first_ts_ns().unwrap_or_default();
+    for record in &chunk.records {
+        let delta = record.ts_ns.saturating_sub(prev_ts).min(u32::MAX as u64) as u32;
+        raw.extend_from_slice(&delta.to_le_bytes());
+        prev_ts = record.ts_ns;
+    }
+    for record in &chunk.records {
+        raw.extend_from_slice(&record.frame.can_id.to_le_bytes());
+    }
+    raw.extend(chunk.records.iter().map(|record| record.bus));
+    raw.extend(chunk.records.iter().map(|record| record.frame.can_dlc));
+    for record in &chunk.records {
+        raw.extend_from_slice(&record.frame.data);
+    }
+}
+
+fn decode_columns(raw: &[u8], frames: usize, base_ts_ns: u64, out: &mut Vec<BinRecord>) {
+    out.clear();
+    let (ts_col, rest) = raw.split_at(frames * 4);
+    let (id_col, rest) = rest.split_at(frames * 4);
+    let (bus_col, rest) = rest.split_at(frames);
+    let (dlc_col, data_col) = rest.split_at(frames);
+
+    let mut ts_ns = base_ts_ns;
+    for i in 0..frames {
+        let delta = u32::from_le_bytes(ts_col[i * 4..i * 4 + 4].try_into().unwrap());
+        ts_ns += delta as u64;
+        let mut data = [0u8; 8];
+        data.copy_from_slice(&data_col[i * 8..i * 8 + 8]);
+        out.push(BinRecord {
+            ts_ns,
+            bus: bus_col[i],
+            frame: CanFrame {
+                can_id: u32::from_le_bytes(id_col[i * 4..i * 4 + 4].try_into().unwrap()),
+                can_dlc: dlc_col[i],
+                data,
+            },
+        });
+    }
+}
+
+pub struct BinLogReader<R: Read> {
+    inner: R,
+    decompress: Decompress,
+    payload: Vec<u8>,
+    raw: Vec<u8>,
+    done: bool,
+}
+
+impl<R: Read> BinLogReader<R> {
+    pub fn new(mut inner: R) -> io::Result<Self> {
+        let mut header = [0u8; FILE_HEADER_LEN as usize];
+        inner.read_exact(&mut header)?;
+        if &header[..8] != FILE_MAGIC {
+            return Err(invalid_data("not a binary CAN log"));
+        }
+        let version = u16::from_le_bytes([header[8], header[9]]);
+        if version != FILE_VERSION {
+            return Err(invalid_data(&format!(
+                "unsupported binary CAN log version {version}"
+            )));
+        }
+        let header_len = u16::from_le_bytes([header[10], header[11]]) as usize;
+        if header_len > FILE_HEADER_LEN as usize {
+            io::copy(
+                &mut (&mut inner).take((header_len - FILE_HEADER_LEN as usize) as u64),
+                &mut io::sink(),
+            )?;
+        }
+        Ok(Self {
+            inner,
+            decompress: Decompress::new(false),
+            payload: Vec::with_capacity(CHUNK_MAX_FRAMES * RECORD_LEN),
+            raw: Vec::with_capacity(CHUNK_MAX_FRAMES * RECORD_LEN),
+            done: false,
+        })
+    }
+
+    /// Read the next chunk into `chunk`. Returns false at the index or at
+    /// the end of a log that was not closed.
+    pub fn next_chunk(&mut self, chunk: &mut Chunk) -> io::Result<bool> {
+        chunk.clear();
+        if self.done {
+            return Ok(false);
+        }
+
+        let mut header = [0u8; CHUNK_HEADER_LEN];
+        let read = read_full(&mut self.inner, &mut header[..4])?;
+        if read == 0 || &header[..4] == INDEX_MAGIC {
+            self.done = true;
+            return Ok(false);
+        }
+        if read < 4 || &header[..4] != CHUNK_MAGIC {
+            return Err(invalid_data("bad chunk header"));
+        }
+        self.inner.read_exact(&mut header[4..])?;
+
+        let frames = u32::from_le_bytes(header[4..8].try_into().unwrap()) as usize;
+        let base_ts_ns = u64::from_le_bytes(header[8..16].try_into().unwrap());
+        let payload_len = u32::from_le_bytes(header[16..20].try_into().unwrap()) as usize;
+        let raw_len = u32::from_le_bytes(header[20..24].try_into().unwrap()) as usize;
+        let bus_count = header[24] as usize;
+        let compression = header[25];
+        if raw_len != frames * RECORD_LEN {
+            return Err(invalid_data("chunk length does not match frame count"));
+        }
+
+        chunk.buses.clear();
+        for _ in 0..bus_count {
+            let iface = read_short_string(&mut self.inner)?;
+            let bus = read_short_string(&mut self.inner)?;
+            chunk.buses.push(BusEntry { iface, bus });
+        }
+
+        self.payload.resize(payload_len, 0);
+        self.inner.read_exact(&mut self.payload)?;
+        match compression {
+            COMPRESSION_NONE if payload_len == raw_len => {
+                std::mem::swap(&mut self.payload, &mut self.raw);
+            }
+            COMPRESSION_DEFLATE => {
+                self.decompress.reset(false);
+                self.raw.clear();
+                self.raw.reserve(raw_len);
+                let status = self
+                    .decompress
+                    .decompress_vec(&self.payload, &mut self.raw, FlushDecompress::Finish)
+                    .map_err(io::Error::other)?;
+                if status != Status::StreamEnd || self.raw.len() != raw_len {
+                    return Err(invalid_data("corrupt chunk payload"));
+                }
+            }
+            _ => return Err(invalid_data("unknown chunk compression")),
+        }
+
+        decode_columns(&self.raw, frames, base_ts_ns, &mut chunk.records);
+        Ok(true)
+    }
+}
+
+fn read_full<R: Read>(reader: &mut R, buf: &mut [u8]) -> io::Result<usize> {
+    let mut read = 0;
+    while read < buf.len() {
+        match reader.read(&mut buf[read..]) {
+            Ok(0) => break,
+            Ok(n) => read += n,
+            Err(e) if e.kind() == io::ErrorKind::Interrupted => {}
+            Err(e) => return Err(e),
+        }
+    }
+    Ok(read)
+}
+
+fn read_short_string<R: Read>(reader: &mut R) -> io::Result<String> {
+    let mut len = [0u8; 1];
+    reader.read_exact(&mut len)?;
+    let mut bytes = vec![0u8; len[0] as usize];
+    reader.read_exact(&mut bytes)?;
+    String::from_utf8(bytes).map_err(|_| invalid_data("bus name is not UTF-8"))
+}
+
+fn invalid_data(msg: &str) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidData, msg.to_string())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn record(ts_ns: u64, bus: u8, seed: u64) -> BinRecord {
+        BinRecord {
+            ts_ns,
+            bus,
+            frame: CanFrame {
+                can_id: seed as u32 & 0x1FFF_FFFF,
+                can_dlc: (seed % 9) as u8,
+                data: seed.wrapping_mul(0x9E37_79B9_7F4A_7C15).to_le_bytes(),
+            },
+        }
+    }
+
+    fn chunk_of(records: &[BinRecord]) -> Chunk {
+        let mut chunk = Chunk::with_capacity(records.len());
+        chunk.bus_index("can0", "veh").unwrap();
+        chunk.bus_index("can1", "body").unwrap();
+        for record in records {
+            assert!(chunk.push(*record));
+        }
+        chunk
+    }
+
+    /// Fill chunks the way the logger does, flushing whenever a record is refused.
+    fn write_log(records: &[BinRecord], finish: bool) -> Vec<u8> {
+        let mut out = Vec::new();
+        let mut writer = BinLogWriter::new(&mut out).unwrap();
+        let mut chunk = chunk_of(&[]);
+        for record in records {
+            if !chunk.push(*record) {
+                writer.write_chunk(&chunk).unwrap();
+                chunk.clear();
+                assert!(chunk.push(*record));
+            }
+        }
+        writer.write_chunk(&chunk).unwrap();
+        if finish {
+            writer.finish().unwrap();
+        }
+        out
+    }
+
+    fn read_chunks(bytes: &[u8]) -> Vec<Vec<BinRecord>> {
+        let mut reader = BinLogReader::new(bytes).unwrap();
+        let mut chunk = Chunk::default();
+        let mut chunks = Vec::new();
+        while reader.next_chunk(&mut chunk).unwrap() {
+            assert_eq!(
+                chunk.buses,
+                chunk_of(&[]).buses,
+                "bus table of chunk {}",
+                chunks.len()
+            );
+            chunks.push(chunk.records.clone());
+        }
+        chunks
+    }
+
+    fn assert_same(expected: &[BinRecord], actual: &[BinRecord]) {
+        assert_eq!(expected.len(), actual.len());
+        for (i, (e, a)) in expected.iter().zip(actual).enumerate() {
+            assert_eq!(
+                (
+                    e.ts_ns,
+                    e.bus,
+                    e.frame.can_id,
+                    e.frame.can_dlc,
+                    e.frame.data
+                ),
+                (
+                    a.ts_ns,
+                    a.bus,
+                    a.frame.can_id,
+                    a.frame.can_dlc,
+                    a.frame.data
+                ),
+                "record {i}"
+            );
+        }
+    }
+
+    /// Offsets, base timestamps and frame counts from the index at the end of a log.
+    fn read_index(bytes: &[u8]) -> Vec<(u64, u64, u32)> {
+        let (body, tail) = bytes.split_at(bytes.len() - 12);
+        assert_eq!(&tail[8..], END_MAGIC);
+        let offset = u64::from_le_bytes(tail[..8].try_into().unwrap()) as usize;
+        let index = &body[offset..];
+        assert_eq!(&index[..4], INDEX_MAGIC);
+        let count = u32::from_le_bytes(index[4..8].try_into().unwrap()) as usize;
+        assert_eq!(index.len(), 8 + count * 20);
+        index[8..]
+            .chunks_exact(20)
+            .map(|entry| {
+                (
+                    u64::from_le_bytes(entry[..8].try_into().unwrap()),
+                    u64::from_le_bytes(entry[8..16].try_into().unwrap()),
+                    u32::from_le_bytes(entry[16..].try_into().unwrap()),
+                )
+            })
+            .collect()
+    }
+
+    fn compression_of_chunk_at(bytes: &[u8], offset: usize) -> u8 {
+        assert_eq!(&bytes[offset..offset + 4], CHUNK_MAGIC);
+        bytes[offset + 25]
+    }
+
+    #[test]
+    fn repetitive_frames_round_trip_deflated() {
+        let records: Vec<_> = (0..1000)
+            .map(|i| record(1_000_000 + i * 1_000, (i % 2) as u8, i % 4))
+            .collect();
+        let bytes = write_log(&records, true);
+
+        assert_eq!(
+            compression_of_chunk_at(&bytes, FILE_HEADER_LEN as usize),
+            COMPRESSION_DEFLATE
+        );
+        assert!(bytes.len() < records.len() * RECORD_LEN / 4);
+        let chunks = read_chunks(&bytes);
+        assert_eq!(chunks.len(), 1);
+        assert_same(&records, &chunks[0]);
+    }
+
+    #[test]
+    fn incompressible_frames_round_trip_stored() {
+        let mut state = 0x2545_F491_4F6C_DD1Du64;
+        let mut next = || {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            state
+        };
+        // every column random so deflate can't shrink the chunk
+        let mut ts_ns = 0u64;
+        let records: Vec<_> = (0..200)
+            .map(|_| {
+                let bits = next();
+                ts_ns += bits >> 32;
+                BinRecord {
+                    ts_ns,
+                    bus: (bits >> 8) as u8,
+                    frame: CanFrame {
+                        can_id: next() as u32,
+                        can_dlc: bits as u8,
+                        data: next().to_le_bytes(),
+                    },
+                }
+            })
+            .collect();
+        let bytes = write_log(&records, true);
+
+        assert_eq!(
+            compression_of_chunk_at(&bytes, FILE_HEADER_LEN as usize),
+            COMPRESSION_NONE
+        );
+        let chunks = read_chunks(&bytes);
+        assert_eq!(chunks.len(), 1);
+        assert_same(&records, &chunks[0]);
+    }
+
+    #[test]
+    fn chunks_split_on_backwards_time_large_gaps_and_size() {
+        let gap = u32::MAX as u64 + 1;
+        let mut records = vec![
+            record(5_000, 0, 1),
+            record(6_000, 1, 2),
+            // time went backwards
+            record(4_000, 0, 3),
+            // exactly the largest delta a chunk holds
+            record(4_000 + u32::MAX as u64, 1, 4),
+            // one past it
+            record(4_000 + u32::MAX as u64 + gap, 0, 5),
+        ];
+        let base = records.last().unwrap().ts_ns;
+        records.extend((0..CHUNK_MAX_FRAMES as u64 + 1).map(|i| record(base + 1 + i, 1, i)));
+
+        let bytes = write_log(&records, true);
+        let chunks = read_chunks(&bytes);
+
+        let lengths: Vec<_> = chunks.iter().map(Vec::len).collect();
+        assert_eq!(lengths, [2, 2, CHUNK_MAX_FRAMES, 2]);
+        assert_same(&records, &chunks.concat());
+
+        let index = read_index(&bytes);
+        let bases: Vec<_> = index.iter().map(|&(_, base_ts_ns, _)| base_ts_ns).collect();
+        let frames: Vec<_> = index
+            .iter()
+            .map(|&(_, _, frames)| frames as usize)
+            .collect();
+        assert_eq!(
+            bases,
+            [5_000, 4_000, base, records[5 + CHUNK_MAX_FRAMES - 1].ts_ns]
+        );
+        assert_eq!(frames, lengths);
+        for &(offset, _, _) in &index {
+            assert_eq!(&bytes[offset as usize..offset as usize + 4], CHUNK_MAGIC);
+        }
+    }
+
+    #[test]
+    fn log_without_an_index_reads_to_the_end() {
+        let records: Vec<_> = (0..10).map(|i| record(i * 10, 0, i)).collect();
+        let mut split = records.clone();
+        split.insert(5, record(0, 1, 99));
+
+        let closed = write_log(&split, true);
+        let unclosed = write_log(&split, false);
+
+        assert!(unclosed.len() < closed.len());
+        assert_eq!(&closed[unclosed.len()..unclosed.len() + 4], INDEX_MAGIC);
+        let chunks = read_chunks(&unclosed);
+        assert_eq!(chunks.len(), 2);
+        assert_same(&split, &chunks.concat());
+    }
+
+    #[test]
+    fn truncated_last_chunk_returns_earlier_chunks_then_an_error() {
+        let records: Vec<_> = (0..30)
+            .map(|i| record(if i == 10 || i == 20 { 0 } else { i * 10 }, 0, i))
+            .collect();
+        let bytes = write_log(&records, false);
+        let last_chunk = read_index(&write_log(&records, true))[2].0 as usize;
+
+        // cut inside the magic, the header, the bus table and the payload
+        for cut in [
+            last_chunk + 2,
+            last_chunk + 10,
+            last_chunk + 30,
+            bytes.len() - 1,
+        ] {
+            let mut reader = BinLogReader::new(&bytes[..cut]).unwrap();
+            let mut chunk = Chunk::default();
+
+            assert!(reader.next_chunk(&mut chunk).unwrap());
+            assert_same(&records[..10], &chunk.records);
+            assert!(reader.next_chunk(&mut chunk).unwrap());
+            assert_same(&records[10..20], &chunk.records);
+            assert!(reader.next_chunk(&mut chunk).is_err(), "cut at {cut}");
+        }
+    }
+
+    #[test]
+    fn rejects_files_that_are_not_logs() {
+        assert!(BinLogReader::new(&b"CANBLOG"[..]).is_err());
+        assert!(BinLogReader::new(&[0u8; 16][..]).is_err());
+
+        let mut bytes = write_log(&[record(0, 0, 0)], true);
+        bytes[8] = 2;
+        assert!(BinLogReader::new(&bytes[..]).is_err());
+    }
+}
@@ -1,3 +1,4 @@
+use std::cell::OnceCell;
 use std::error::Error;
 use std::ffi::CString;
 use std::fmt::Write as FmtWrite;
@@ -7,15 +8,18 @@ use std::os::fd::{AsRawFd, FromRawFd, OwnedFd};
 use std::ptr;
 
 use libc::{
-    AF_CAN, CAN_EFF_FLAG, CAN_EFF_MASK, CAN_ERR_FLAG, CAN_RAW, CAN_RTR_FLAG, CAN_SFF_MASK, EINTR,
-    SCM_TIMESTAMPING, SO_TIMESTAMPING, SOCK_RAW, SOF_TIMESTAMPING_RAW_HARDWARE,
-    SOF_TIMESTAMPING_RX_HARDWARE, SOF_TIMESTAMPING_RX_SOFTWARE, SOF_TIMESTAMPING_SOFTWARE,
-    SOL_SOCKET, bind, c_long, c_void, can_frame, cmsghdr, if_nametoindex, iovec, msghdr, recvmsg,
-    sa_family_t, sockaddr, sockaddr_can, socket, socklen_t, timespec, write,
+    AF_CAN, CAN_EFF_FLAG, CAN_EFF_MASK, CAN_ERR_FLAG, CAN_RAW, CAN_RTR_FLAG, CAN_SFF_MASK, EAGAIN,
+    EINTR, EWOULDBLOCK, MSG_DONTWAIT, SCM_TIMESTAMPING, SO_TIMESTAMPING, SOCK_RAW,
+    SOF_TIMESTAMPING_RAW_HARDWARE, SOF_TIMESTAMPING_RX_HARDWARE, SOF_TIMESTAMPING_RX_SOFTWARE,
+    SOF_TIMESTAMPING_SOFTWARE, SOL_SOCKET, bind, c_long, c_uint, c_void, can_frame, cmsghdr,
+    if_nametoindex, iovec, mmsghdr, msghdr, recvmmsg, recvmsg, sa_family_t, sendmmsg, sockaddr,
+    sockaddr_can, socket, socklen_t, timespec, write,
 };
-use serde_json::{Map, Value, json};
 
+pub mod alloc_stats;
 pub mod app;
+pub mod binlog;
+pub mod ring;
 
 pub use yamcan_generated::{
     Bus, BusBinding, BusDescriptor, BusInterfaceType, CanFrame, DecodedMessage, ForwardRoute,
@@ -24,24 +28,31 @@ pub use yamcan_generated::{
 };
 pub use yamcan_generated::{configure_iface as configure_yamcan_iface, init_static as yamcan_init};
 
-#[derive(Clone, Debug)]
+/// Number of frames moved per `recvmmsg`/`sendmmsg` call.
+pub const CAN_BATCH_SIZE: usize = 64;
+
+/// Control buffer per received frame; large enough for `SCM_TIMESTAMPING`.
+const CMSG_BUFFER_LEN: usize = 256;
+
+#[derive(Clone, Copy, Debug)]
 pub struct Event {
-    pub iface: String,
     pub frame: CanFrame,
     pub ts_opt: Option<(u64, u32)>,
 }
 
+/// A frame that passed the filters. Decoding is deferred until a sink asks
+/// for it, so sinks that only need the raw frame never pay for it.
 #[derive(Clone, Debug)]
-pub struct ProcessedEvent {
-    pub binding: BusBinding<Bus>,
+pub struct ProcessedEvent<'a> {
+    pub binding: &'a BusBinding<Bus>,
     pub frame: CanFrame,
     pub ts_opt: Option<(u64, u32)>,
     pub id_masked: u32,
     pub bit_length: u32,
-    pub decoded: Option<DecodedMessage>,
+    decoded: OnceCell<Option<DecodedMessage>>,
 }
 
-impl ProcessedEvent {
+impl ProcessedEvent<'_> {
     pub fn iface(&self) -> &str {
         &self.binding.iface
     }
@@ -49,6 +60,23 @@ impl ProcessedEvent {
     pub fn bus_name(&self) -> &'static str {
         self.binding.bus.as_str()
     }
+
+    /// The decoded message, decoded on first use and shared by later sinks.
+    pub fn decoded(&self) -> Option<&DecodedMessage> {
+        self.decoded
+            .get_or_init(|| {
+                yamcan_generated::maybe_decode(
+                    Some(self.binding),
+                    &self.frame,
+                    self.id_masked,
+                    true,
+                    true,
+                    &[],
+                    &[],
+                )
+            })
+            .as_ref()
+    }
 }
 
 #[derive(Clone)]
@@ -128,18 +156,20 @@ fn parse_u32_id(tok: &str) -> Result<u32, Box<dyn Error>> {
     }
 }
 
-pub fn process_event(
-    binding: &BusBinding<Bus>,
+pub fn process_event<'a>(
+    binding: &'a BusBinding<Bus>,
     filters: &Filters,
     event: Event,
-) -> Option<ProcessedEvent> {
+) -> Option<ProcessedEvent<'a>> {
     let (id_masked, bit_length) = frame_id_and_bit_length(&event.frame);
     if !filters.match_id(id_masked) {
         return None;
     }
 
-    let decoded = if filters.has_decode_filters() {
-        Some(yamcan_generated::maybe_decode(
+    let decoded = OnceCell::new();
+    if filters.has_decode_filters() {
+        // The filters need the decoded message to decide, so decode now
+        let _ = decoded.set(Some(yamcan_generated::maybe_decode(
             Some(binding),
             &event.frame,
             id_masked,
@@ -147,13 +177,11 @@ pub fn process_event(
             false,
             &filters.msg_filters,
             &filters.sig_filters,
-        )?)
-    } else {
-        yamcan_generated::maybe_decode(Some(binding), &event.frame, id_masked, true, true, &[], &[])
-    };
+        )?));
+    }
 
     Some(ProcessedEvent {
-        binding: binding.clone(),
+        binding,
         frame: event.frame,
         ts_opt: event.ts_opt,
         id_masked,
@@ -163,137 +191,225 @@ pub fn process_event(
 }
 
 pub fn format_processed_event(event: &ProcessedEvent, json: bool) -> String {
+    let mut out = String::with_capacity(256);
+    write_processed_event(&mut out, event, json);
+    out
+}
+
+/// Append the stdout representation of `event` to `out`.
+pub fn write_processed_event(out: &mut String, event: &ProcessedEvent, json: bool) {
+    if json {
+        write_processed_event_json(out, event);
+    } else {
+        write_processed_event_text(out, event);
+    }
+}
+
+fn write_processed_event_text(out: &mut String, event: &ProcessedEvent) {
     let f = &event.frame;
     let is_eff = (f.can_id & CAN_EFF_FLAG) != 0;
     let is_rtr = (f.can_id & CAN_RTR_FLAG) != 0;
     let is_err = (f.can_id & CAN_ERR_FLAG) != 0;
 
-    let id_str = if is_eff {
-        format!("{:08X}", event.id_masked)
+    out.push('[');
+    match event.ts_opt {
+        Some((s, ns)) => {
+            push_integer(out, s);
+            out.push('.');
+            push_integer(out, ns / 1_000);
+        }
+        None => out.push('-'),
+    }
+    out.push_str("] ");
+    out.push_str(event.iface());
+    out.push(':');
+    out.push_str(event.bus_name());
+    out.push_str(" ID=");
+    if is_eff {
+        let _ = write!(out, "{:08X}", event.id_masked);
     } else {
-        format!("{:03X}", event.id_masked)
-    };
-
-    let mut flags = String::new();
+        let _ = write!(out, "{:03X}", event.id_masked);
+    }
     if is_eff {
-        flags.push_str(" EXT");
+        out.push_str(" EXT");
     }
     if is_rtr {
-        flags.push_str(" RTR");
+        out.push_str(" RTR");
     }
     if is_err {
-        flags.push_str(" ERR");
-    }
-
-    let ts_str = event
-        .ts_opt
-        .map(|(s, ns)| format!("{}.{}", s, ns / 1_000))
-        .unwrap_or_else(|| "-".to_string());
-
-    if !json {
-        if is_rtr {
-            return format!(
-                "[{}] {}:{} ID={}{flags} DLC={}",
-                ts_str,
-                event.iface(),
-                event.bus_name(),
-                id_str,
-                f.can_dlc
-            );
+        out.push_str(" ERR");
+    }
+    out.push_str(" DLC=");
+    push_integer(out, f.can_dlc);
+    if is_rtr {
+        return;
+    }
+
+    out.push_str(" DATA=");
+    for (i, byte) in f.data[..(f.can_dlc as usize).min(8)].iter().enumerate() {
+        if i > 0 {
+            out.push(' ');
         }
+        push_hex_byte(out, *byte);
+    }
+
+    if let Some(decoded) = event.decoded() {
+        out.push('\n');
+        write_decoded_pretty(out, decoded);
+    }
+}
 
-        let bytes = &f.data[..(f.can_dlc as usize).min(8)];
-        let payload = bytes
-            .iter()
-            .map(|b| format!("{:02X}", b))
-            .collect::<Vec<_>>()
-            .join(" ");
-
-        if let Some(decoded) = &event.decoded {
-            if let Some(dec_str) = decoded_to_pretty(decoded, true) {
-                return format!(
-                    "[{}] {}:{} ID={}{flags} DLC={} DATA={}\n{}",
-                    ts_str,
-                    event.iface(),
-                    event.bus_name(),
-                    id_str,
-                    f.can_dlc,
-                    payload,
-                    dec_str
-                );
+fn write_decoded_pretty(out: &mut String, decoded: &DecodedMessage) {
+    out.push_str(&decoded.message_name);
+    if decoded.members.is_empty() {
+        return;
+    }
+
+    out.push_str(":\n");
+    for measurement in &decoded.members {
+        let _ = write!(out, "  {}={}", measurement.name, measurement.value);
+        match (measurement.label.as_deref(), measurement.unit.as_deref()) {
+            (Some(label), Some(unit)) if !unit.is_empty() => {
+                let _ = write!(out, " ({label}) {unit}");
+            }
+            (Some(label), _) => {
+                let _ = write!(out, " ({label})");
             }
+            (None, Some(unit)) if !unit.is_empty() => {
+                out.push(' ');
+                out.push_str(unit);
+            }
+            _ => {}
         }
-
-        return format!(
-            "[{}] {}:{} ID={}{flags} DLC={} DATA={}",
-            ts_str,
-            event.iface(),
-            event.bus_name(),
-            id_str,
-            f.can_dlc,
-            payload
-        );
+        out.push('\n');
     }
+}
 
+/// JSON record with keys in sorted order and `serde_json` number formatting,
+/// written straight into `out`.
+fn write_processed_event_json(out: &mut String, event: &ProcessedEvent) {
+    let f = &event.frame;
+    let is_eff = (f.can_id & CAN_EFF_FLAG) != 0;
+    let is_rtr = (f.can_id & CAN_RTR_FLAG) != 0;
+    let is_err = (f.can_id & CAN_ERR_FLAG) != 0;
+    let decoded = event.decoded();
+
+    out.push_str("{\"bus\":{\"iface\":");
+    push_json_string(out, event.iface());
+    out.push_str(",\"name\":");
+    push_json_string(out, event.bus_name());
+    out.push_str("},\"data\":[");
+    if !is_rtr {
+        for (i, byte) in f.data[..(f.can_dlc as usize).min(8)].iter().enumerate() {
+            if i > 0 {
+                out.push(',');
+            }
+            out.push('"');
+            push_hex_byte(out, *byte);
+            out.push('"');
+        }
+    }
+    out.push_str("],\"dlc\":");
+    push_integer(out, f.can_dlc);
+    out.push_str(",\"id\":{\"err\":");
+    out.push_str(if is_err { "true" } else { "false" });
+    out.push_str(",\"ext\":");
+    out.push_str(if is_eff { "true" } else { "false" });
+    out.push_str(",\"rtr\":");
+    out.push_str(if is_rtr { "true" } else { "false" });
+    out.push_str(",\"val\":");
+    push_integer(out, event.id_masked);
+    out.push_str("},\"meas\":{");
+    if let Some(decoded) = decoded {
+        write_measurements_json(out, decoded);
+    }
+    out.push_str("},\"msg\":");
+    match decoded {
+        Some(decoded) => push_json_string(out, &decoded.message_name),
+        None => out.push_str("null"),
+    }
+    out.push_str(",\"time\":");
     let (sec, nsec) = event.ts_opt.unwrap_or_default();
-    let data_vec = if is_rtr {
-        Vec::<String>::new()
-    } else {
-        let bytes = &f.data[..(f.can_dlc as usize).min(8)];
-        bytes
-            .iter()
-            .map(|b| format!("{:02X}", b))
-            .collect::<Vec<_>>()
-    };
+    push_json_float(out, sec as f64 + (nsec as f64 / 1e9));
+    out.push('}');
+}
 
-    let (msg_name, measurements) = if let Some(decoded) = &event.decoded {
-        (
-            Some(decoded.message_name.clone()),
-            Value::Object(decoded_to_measurements_map(decoded)),
-        )
-    } else {
-        (None, Value::Object(Map::new()))
-    };
+/// Measurements keyed by signal name in sorted order, the last duplicate
+/// winning, as a JSON map would. Messages carry few signals, so a selection
+/// pass per key avoids sorting into a scratch buffer.
+fn write_measurements_json(out: &mut String, decoded: &DecodedMessage) {
+    let mut prev: Option<&str> = None;
+    let mut first = true;
+    loop {
+        let mut next: Option<&SignalMeasurement> = None;
+        for measurement in &decoded.members {
+            let name = measurement.name.as_str();
+            if prev.is_some_and(|prev| name <= prev) {
+                continue;
+            }
+            if next.is_none_or(|next| name <= next.name.as_str()) {
+                next = Some(measurement);
+            }
+        }
+        let Some(measurement) = next else {
+            return;
+        };
+        prev = Some(measurement.name.as_str());
 
-    json!({
-        "msg": msg_name,
-        "bus": {
-            "iface": event.iface(),
-            "name": event.bus_name(),
-        },
-        "time": Value::from(sec as f64 + (nsec as f64 / 1e9)),
-        "id": {
-            "val": event.id_masked,
-            "ext": is_eff,
-            "rtr": is_rtr,
-            "err": is_err,
-        },
-        "dlc": f.can_dlc,
-        "data": data_vec,
-        "meas": measurements,
-    })
-    .to_string()
+        if !first {
+            out.push(',');
+        }
+        first = false;
+        push_json_string(out, &measurement.name);
+        out.push(':');
+
+        let unit = measurement.unit.as_deref().filter(|unit| !unit.is_empty());
+        if measurement.label.is_none() && unit.is_none() {
+            push_json_float(out, measurement.value);
+            continue;
+        }
+        out.push('{');
+        if let Some(label) = measurement.label.as_deref() {
+            out.push_str("\"label\":");
+            push_json_string(out, label);
+            out.push(',');
+        }
+        if let Some(unit) = unit {
+            out.push_str("\"unit\":");
+            push_json_string(out, unit);
+            out.push(',');
+        }
+        out.push_str("\"value\":");
+        push_json_float(out, measurement.value);
+        out.push('}');
+    }
 }
 
 pub fn format_processed_event_line_protocol(event: &ProcessedEvent) -> String {
+    let mut out = String::with_capacity(192);
+    write_processed_event_line_protocol(&mut out, event);
+    out
+}
+
+/// Append one line-protocol record for `event` to `out`, without the
+/// trailing newline.
+pub fn write_processed_event_line_protocol(out: &mut String, event: &ProcessedEvent) {
     let f = &event.frame;
     let is_eff = (f.can_id & CAN_EFF_FLAG) != 0;
     let is_rtr = (f.can_id & CAN_RTR_FLAG) != 0;
     let is_err = (f.can_id & CAN_ERR_FLAG) != 0;
-    let measurement = event
-        .decoded
-        .as_ref()
+    let decoded = event.decoded();
+    let measurement = decoded
         .map(|decoded| decoded.message_name.as_str())
         .unwrap_or("veh_msg");
-    let mut out = String::with_capacity(192);
 
-    append_line_key(&mut out, measurement);
+    append_line_key(out, measurement);
     out.push_str(",iface=");
-    append_line_key(&mut out, event.iface());
+    append_line_key(out, event.iface());
     out.push_str(",bus_name=");
-    append_line_key(&mut out, event.bus_name());
+    append_line_key(out, event.bus_name());
     out.push_str(",can_id=");
-    let _ = write!(out, "{}", event.id_masked);
+    push_integer(out, event.id_masked);
     out.push_str(",id_err=");
     out.push(if is_err { '1' } else { '0' });
     out.push_str(",id_ext=");
@@ -303,17 +419,18 @@ pub fn format_processed_event_line_protocol(event: &ProcessedEvent) -> String {
 
     out.push(' ');
     out.push_str("dlc=");
-    let _ = write!(out, "{}", f.can_dlc);
+    push_integer(out, f.can_dlc);
 
-    if let Some(decoded) = &event.decoded {
+    if let Some(decoded) = decoded {
+        let mut float = ryu::Buffer::new();
         for measurement in &decoded.members {
             if !measurement.value.is_finite() {
                 continue;
             }
             out.push(',');
-            append_line_key(&mut out, &measurement.name);
+            append_line_key(out, &measurement.name);
             out.push('=');
-            let _ = write!(out, "{}", measurement.value);
+            out.push_str(float.format_finite(measurement.value));
         }
     }
 
@@ -321,8 +438,8 @@ pub fn format_processed_event_line_protocol(event: &ProcessedEvent) -> String {
     let timestamp = sec
         .saturating_mul(1_000_000_000)
         .saturating_add(nsec as u64);
-    let _ = write!(out, " {timestamp}");
-    out
+    out.push(' ');
+    push_integer(out, timestamp);
 }
 
 fn append_line_key(out: &mut String, value: &str) {
@@ -337,57 +454,43 @@ fn append_line_key(out: &mut String, value: &str) {
     }
 }
 
-fn decoded_to_pretty(decoded: &DecodedMessage, allow_empty: bool) -> Option<String> {
-    if decoded.members.is_empty() {
-        return if allow_empty {
-            Some(decoded.message_name.clone())
-        } else {
-            None
-        };
-    }
+fn push_integer<I: itoa::Integer>(out: &mut String, value: I) {
+    out.push_str(itoa::Buffer::new().format(value));
+}
 
-    let mut parts = String::new();
-    for measurement in &decoded.members {
-        let suffix = match (measurement.label.as_deref(), measurement.unit.as_deref()) {
-            (Some(label), Some(unit)) if !unit.is_empty() => format!(" ({label}) {unit}"),
-            (Some(label), _) => format!(" ({label})"),
-            (None, Some(unit)) if !unit.is_empty() => format!(" {unit}"),
-            _ => String::new(),
-        };
-        parts.push_str(&format!(
-            "  {}={}{}\n",
-            measurement.name, measurement.value, suffix
-        ));
+fn push_json_float(out: &mut String, value: f64) {
+    if value.is_finite() {
+        out.push_str(ryu::Buffer::new().format_finite(value));
+    } else {
+        out.push_str("null");
     }
+}
 
-    Some(format!("{}:\n{}", decoded.message_name, parts))
+fn push_hex_byte(out: &mut String, byte: u8) {
+    const HEX: &[u8; 16] = b"0123456789ABCDEF";
+    out.push(HEX[(byte >> 4) as usize] as char);
+    out.push(HEX[(byte & 0xF) as usize] as char);
 }
 
-fn decoded_to_measurements_map(decoded: &DecodedMessage) -> Map<String, Value> {
-    let mut map = Map::new();
-    for measurement in &decoded.members {
-        if measurement.label.is_some()
-            || measurement
-                .unit
-                .as_deref()
-                .is_some_and(|unit| !unit.is_empty())
-        {
-            let mut obj = Map::new();
-            obj.insert("value".into(), Value::from(measurement.value));
-            if let Some(unit) = measurement.unit.as_deref() {
-                if !unit.is_empty() {
-                    obj.insert("unit".into(), Value::from(unit));
-                }
-            }
-            if let Some(label) = measurement.label.as_deref() {
-                obj.insert("label".into(), Value::from(label));
+fn push_json_string(out: &mut String, value: &str) {
+    out.push('"');
+    for ch in value.chars() {
+        match ch {
+            '"' => out.push_str("\\\""),
+            '\\' => out.push_str("\\\\"),
+            '\n' => out.push_str("\\n"),
+            '\r' => out.push_str("\\r"),
+            '\t' => out.push_str("\\t"),
+            '\u{8}' => out.push_str("\\b"),
+            '\u{c}' => out.push_str("\\f"),
+            ch if (ch as u32) < 0x20 => {
+                out.push_str("\\u00");
+                push_hex_byte(out, ch as u8);
             }
-            map.insert(measurement.name.clone(), Value::Object(obj));
-            continue;
+            ch => out.push(ch),
         }
-        map.insert(measurement.name.clone(), Value::from(measurement.value));
     }
-    map
+    out.push('"');
 }
 
 pub fn frame_id_and_bit_length(frame: &CanFrame) -> (u32, u32) {
@@ -403,7 +506,7 @@ pub fn frame_id_and_bit_length(frame: &CanFrame) -> (u32, u32) {
     (id_masked, bit_length)
 }
 
-pub fn recv_event(fd: &OwnedFd, iface: &str) -> io::Result<Event> {
+pub fn recv_event(fd: &OwnedFd) -> io::Result<Event> {
     let mut frame: can_frame = unsafe { zeroed() };
     let mut name: sockaddr_can = unsafe { zeroed() };
     let mut iov = iovec {
@@ -436,11 +539,204 @@ pub fn recv_event(fd: &OwnedFd, iface: &str) -> io::Result<Event> {
             can_dlc: frame.can_dlc,
             data: frame.data,
         };
-        return Ok(Event {
-            iface: iface.to_string(),
-            frame,
-            ts_opt,
-        });
+        return Ok(Event { frame, ts_opt });
+    }
+}
+
+/// Reusable receive buffers for draining a CAN socket with `recvmmsg`.
+///
+/// Frames, iovecs and timestamp control buffers are allocated once and reused
+/// for every call, so steady-state ingest does not allocate.
+pub struct RecvBatch {
+    frames: Vec<can_frame>,
+    iovs: Vec<iovec>,
+    cmsgs: Vec<[u8; CMSG_BUFFER_LEN]>,
+    hdrs: Vec<mmsghdr>,
+    len: usize,
+}
+
+impl RecvBatch {
+    pub fn with_capacity(capacity: usize) -> Self {
+        let capacity = capacity.max(1);
+        Self {
+            frames: vec![unsafe { zeroed() }; capacity],
+            iovs: vec![unsafe { zeroed() }; capacity],
+            cmsgs: vec![[0u8; CMSG_BUFFER_LEN]; capacity],
+            hdrs: vec![unsafe { zeroed() }; capacity],
+            len: 0,
+        }
+    }
+
+    pub fn capacity(&self) -> usize {
+        self.frames.len()
+    }
+
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Receive up to `capacity()` frames without blocking.
+    ///
+    /// Returns the number of frames received, which is zero when the socket
+    /// has no pending frames.
+    pub fn recv(&mut self, fd: &OwnedFd) -> io::Result<usize> {
+        self.len = 0;
+        for i in 0..self.capacity() {
+            self.iovs[i] = iovec {
+                iov_base: (&mut self.frames[i] as *mut can_frame) as *mut c_void,
+                iov_len: size_of::<can_frame>(),
+            };
+            let hdr = &mut self.hdrs[i];
+            hdr.msg_len = 0;
+            hdr.msg_hdr = unsafe { zeroed() };
+            hdr.msg_hdr.msg_iov = &mut self.iovs[i] as *mut iovec;
+            hdr.msg_hdr.msg_iovlen = 1;
+            hdr.msg_hdr.msg_control = self.cmsgs[i].as_mut_ptr() as *mut c_void;
+            hdr.msg_hdr.msg_controllen = CMSG_BUFFER_LEN as _;
+        }
+
+        loop {
+            let n = unsafe {
+                recvmmsg(
+                    fd.as_raw_fd(),
+                    self.hdrs.as_mut_ptr(),
+                    self.capacity() as c_uint,
+                    MSG_DONTWAIT,
+                    ptr::null_mut(),
+                )
+            };
+            if n < 0 {
+                let err = io::Error::last_os_error();
+                match err.raw_os_error() {
+                    Some(EINTR) => continue,
+                    Some(code) if code == EAGAIN || code == EWOULDBLOCK => return Ok(0),
+                    _ => return Err(err),
+                }
+            }
+            self.len = n as usize;
+            return Ok(self.len);
+        }
+    }
+
+    pub fn event(&self, index: usize) -> Event {
+        let raw = &self.frames[index];
+        Event {
+            frame: CanFrame {
+                can_id: raw.can_id,
+                can_dlc: raw.can_dlc,
+                data: raw.data,
+            },
+            ts_opt: parse_timestamp_from_cmsgs(&self.hdrs[index].msg_hdr),
+        }
+    }
+
+    pub fn events(&self) -> impl Iterator<Item = Event> + '_ {
+        (0..self.len).map(|index| self.event(index))
+    }
+}
+
+/// Reusable transmit buffers for writing queued CAN frames with `sendmmsg`.
+pub struct SendBatch {
+    frames: Vec<can_frame>,
+    iovs: Vec<iovec>,
+    hdrs: Vec<mmsghdr>,
+    len: usize,
+}
+
+impl SendBatch {
+    pub fn with_capacity(capacity: usize) -> Self {
+        let capacity = capacity.max(1);
+        Self {
+            frames: vec![unsafe { zeroed() }; capacity],
+            iovs: vec![unsafe { zeroed() }; capacity],
+            hdrs: vec![unsafe { zeroed() }; capacity],
+            len: 0,
+        }
+    }
+
+    pub fn capacity(&self) -> usize {
+        self.frames.len()
+    }
+
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    pub fn is_full(&self) -> bool {
+        self.len == self.capacity()
+    }
+
+    /// Queue a frame; returns false when the batch is full and must be flushed.
+    pub fn push(&mut self, frame: &CanFrame) -> bool {
+        if self.is_full() {
+            return false;
+        }
+        let raw = &mut self.frames[self.len];
+        *raw = unsafe { zeroed() };
+        raw.can_id = frame.can_id;
+        raw.can_dlc = frame.can_dlc;
+        raw.data = frame.data;
+        self.len += 1;
+        true
+    }
+
+    /// Id of the first queued frame, used to report a failed flush.
+    pub fn first_id(&self) -> Option<u32> {
+        self.frames[..self.len].first().map(|frame| {
+            if (frame.can_id & CAN_EFF_FLAG) != 0 {
+                frame.can_id & CAN_EFF_MASK
+            } else {
+                frame.can_id & CAN_SFF_MASK
+            }
+        })
+    }
+
+    /// Write every queued frame and empty the batch.
+    ///
+    /// On error the unsent frames are dropped and their count is returned
+    /// with the error.
+    pub fn flush(&mut self, fd: &OwnedFd) -> Result<usize, (usize, io::Error)> {
+        for i in 0..self.len {
+            self.iovs[i] = iovec {
+                iov_base: (&mut self.frames[i] as *mut can_frame) as *mut c_void,
+                iov_len: size_of::<can_frame>(),
+            };
+            let hdr = &mut self.hdrs[i];
+            hdr.msg_len = 0;
+            hdr.msg_hdr = unsafe { zeroed() };
+            hdr.msg_hdr.msg_iov = &mut self.iovs[i] as *mut iovec;
+            hdr.msg_hdr.msg_iovlen = 1;
+        }
+
+        let total = std::mem::take(&mut self.len);
+        let mut sent = 0usize;
+        while sent < total {
+            let n = unsafe {
+                sendmmsg(
+                    fd.as_raw_fd(),
+                    self.hdrs[sent..].as_mut_ptr(),
+                    (total - sent) as c_uint,
+                    0,
+                )
+            };
+            if n < 0 {
+                let err = io::Error::last_os_error();
+                if err.raw_os_error() == Some(EINTR) {
+                    continue;
+                }
+                return Err((total - sent, err));
+            }
+            sent += n as usize;
+        }
+        Ok(sent)
     }
 }
 
@@ -0,0 +1,157 @@
+//! Ingest throughput benchmark for can-bridge on a virtual CAN interface.
+//!
+//! A sender thread floods the interface while the main thread drains it with
+//! either one blocking `recvmsg` per frame (`single`) or, like the ingest
+//! loop, by waiting for the socket to become readable and draining it with
+//! `recvmmsg` batches (`batched`). Receive rate, receiver CPU usage and CPU
+//! time per frame are printed at the end.
+//!
+//!   sudo ip link add dev vcan0 type vcan && sudo ip link set vcan0 up
+//!   can-bridge-bench vcan0 --mode batched --secs 5
+
+use std::os::fd::{AsRawFd, OwnedFd};
+use std::sync::Arc;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::thread;
+use std::time::{Duration, Instant};
+
+use can_bridge::{CAN_BATCH_SIZE, CanFrame, RecvBatch, SendBatch, open_can_socket, recv_event};
+use clap::{Parser, ValueEnum};
+use libc::{EINTR, POLLIN, RUSAGE_THREAD, getrusage, poll, pollfd, rusage, timeval};
+
+/// Upper bound on one wait so the run ends on time when traffic stops.
+const POLL_TIMEOUT_MS: i32 = 100;
+
+#[derive(Clone, Copy, Debug, ValueEnum)]
+enum Mode {
+    Single,
+    Batched,
+}
+
+#[derive(Parser, Debug)]
+#[command(
+    name = "can-bridge-bench",
+    about = "Measure can-bridge ingest throughput and CPU usage on a vcan interface."
+)]
+struct Args {
+    #[arg(value_name = "IFACE", default_value = "vcan0")]
+    iface: String,
+
+    #[arg(long, value_enum, default_value_t = Mode::Batched)]
+    mode: Mode,
+
+    #[arg(long, default_value_t = 5)]
+    secs: u64,
+}
+
+fn thread_cpu_time() -> Duration {
+    let mut usage: rusage = unsafe { std::mem::zeroed() };
+    unsafe { getrusage(RUSAGE_THREAD, &mut usage) };
+    let to_duration =
+        |tv: timeval| Duration::new(tv.tv_sec as u64, (tv.tv_usec as u32).saturating_mul(1_000));
+    to_duration(usage.ru_utime) + to_duration(usage.ru_stime)
+}
+
+/// Block until `fd` has frames to read or the poll times out.
+fn wait_readable(fd: &OwnedFd) -> std::io::Result<()> {
+    let mut pfd = pollfd {
+        fd: fd.as_raw_fd(),
+        events: POLLIN,
+        revents: 0,
+    };
+    let rc = unsafe { poll(&mut pfd, 1, POLL_TIMEOUT_MS) };
+    if rc < 0 {
+        let err = std::io::Error::last_os_error();
+        if err.raw_os_error() != Some(EINTR) {
+            return Err(err);
+        }
+    }
+    Ok(())
+}
+
+fn run_sender(iface: String, stop: Arc<AtomicBool>) -> std::io::Result<u64> {
+    let fd = open_can_socket(&iface)?;
+    let mut batch = SendBatch::with_capacity(CAN_BATCH_SIZE);
+    let mut sent = 0u64;
+    let mut counter = 0u32;
+
+    while !stop.load(Ordering::Relaxed) {
+        while !batch.is_full() {
+            let frame = CanFrame {
+                can_id: 0x100 + (counter & 0xFF),
+                can_dlc: 8,
+                data: (counter as u64).to_le_bytes(),
+            };
+            batch.push(&frame);
+            counter = counter.wrapping_add(1);
+        }
+        match batch.flush(&fd) {
+            Ok(n) => sent += n as u64,
+            // vcan drops when the receive queue is full; keep going
+            Err((_, e)) if e.raw_os_error() == Some(libc::ENOBUFS) => {
+                thread::yield_now();
+            }
+            Err((_, e)) => return Err(e),
+        }
+    }
+
+    Ok(sent)
+}
+
+fn main() -> Result<(), Box<dyn std::error::Error>> {
+    let args = Args::parse();
+    let rx_fd = open_can_socket(&args.iface)?;
+    let stop = Arc::new(AtomicBool::new(false));
+
+    let sender = {
+        let iface = args.iface.clone();
+        let stop = stop.clone();
+        thread::spawn(move || run_sender(iface, stop))
+    };
+
+    let mut received = 0u64;
+    let mut batch = RecvBatch::with_capacity(CAN_BATCH_SIZE);
+    let duration = Duration::from_secs(args.secs.max(1));
+    let cpu_start = thread_cpu_time();
+    let start = Instant::now();
+
+    while start.elapsed() < duration {
+        match args.mode {
+            Mode::Single => {
+                recv_event(&rx_fd)?;
+                received += 1;
+            }
+            Mode::Batched => {
+                wait_readable(&rx_fd)?;
+                // drain the way the ingest loop does: until a short batch
+                loop {
+                    let n = batch.recv(&rx_fd)?;
+                    received += n as u64;
+                    if n < batch.capacity() {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    let elapsed = start.elapsed();
+    let cpu = thread_cpu_time() - cpu_start;
+    stop.store(true, Ordering::Relaxed);
+    let sent = sender.join().map_err(|_| "sender thread panicked")??;
+
+    let secs = elapsed.as_secs_f64();
+    println!(
+        "mode={:?} iface={} frames={} sent={} elapsed={:.2}s rate={:.0} frames/s cpu={:.1}% cpu_per_frame={:.0}ns",
+        args.mode,
+        args.iface,
+        received,
+        sent,
+        secs,
+        received as f64 / secs,
+        100.0 * cpu.as_secs_f64() / secs,
+        cpu.as_nanos() as f64 / received.max(1) as f64,
+    );
+
+    Ok(())
+}
@@ -1,6 +1,10 @@
 use can_bridge::Bus;
+use can_bridge::alloc_stats::CountingAllocator;
 use can_bridge::app;
 
+#[global_allocator]
+static ALLOCATOR: CountingAllocator = CountingAllocator;
+
 fn main() -> Result<(), Box<dyn std::error::Error>> {
     app::run(Bus::Veh)
 }
@@ -0,0 +1,503 @@
+//! Bounded single-producer broadcast ring of raw CAN frames.
+//!
+//! The ingest thread publishes each frame once; every sink reads the same
+//! slots through its own cursor and formats what it needs on its own thread.
+//! The producer never waits for a sink. A sink that falls more than the ring
+//! capacity behind loses the overwritten frames and counts them as dropped,
+//! so memory stays bounded however long a sink stalls.
+//!
+//! Slots are seqlocks over plain atomic words, so readers never take a lock
+//! and a torn read is detected rather than observed.
+
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering, fence};
+use std::sync::{Arc, OnceLock};
+use std::thread::{self, Thread};
+use std::time::Duration;
+
+use crate::CanFrame;
+
+const SLOT_WORDS: usize = 4;
+const HAS_TIMESTAMP: u64 = 1 << 48;
+
+/// One frame as stored in the ring. `source` indexes the bus bindings the
+/// ring was created for.
+#[derive(Clone, Copy, Debug)]
+pub struct RingRecord {
+    pub source: u8,
+    pub frame: CanFrame,
+    pub ts_opt: Option<(u64, u32)>,
+}
+
+impl RingRecord {
+    fn pack(&self) -> [u64; SLOT_WORDS] {
+        let (sec, nsec, has_ts) = match self.ts_opt {
+            Some((sec, nsec)) => (sec, nsec as u64, HAS_TIMESTAMP),
+            None => (0, 0, 0),
+        };
+        [
+            self.frame.can_id as u64
+                | (self.frame.can_dlc as u64) << 32
+                | (self.source as u64) << 40
+                | has_ts,
+            u64::from_le_bytes(self.frame.data),
+            sec,
+            nsec,
+        ]
+    }
+
+    fn unpack(words: [u64; SLOT_WORDS]) -> Self {
+        Self {
+            source: (words[0] >> 40) as u8,
+            frame: CanFrame {
+                can_id: words[0] as u32,
+                can_dlc: (words[0] >> 32) as u8,
+                data: words[1].to_le_bytes(),
+            },
+            ts_opt: (words[0] & HAS_TIMESTAMP != 0).then_some((words[2], words[3] as u32)),
+        }
+    }
+}
+
+#[derive(Default)]
+struct Slot {
+    /// `2 * position + 1` while the slot is being written, `2 * position + 2`
+    /// once the record for `position` is complete.
+    seq: AtomicU64,
+    words: [AtomicU64; SLOT_WORDS],
+}
+
+struct Shared {
+    slots: Box<[Slot]>,
+    mask: u64,
+    /// Position of the next record to be written.
+    head: AtomicU64,
+    closed: AtomicBool,
+}
+
+/// Per-reader state visible to the producer for wake-ups and reporting.
+struct ReaderState {
+    name: &'static str,
+    cursor: AtomicU64,
+    dropped: AtomicU64,
+    sleeping: AtomicBool,
+    thread: OnceLock<Thread>,
+}
+
+/// Backpressure snapshot for one reader.
+#[derive(Clone, Copy, Debug)]
+pub struct ReaderStats {
+    pub name: &'static str,
+    /// Records published but not yet consumed.
+    pub lag: u64,
+    /// Records overwritten before the reader got to them.
+    pub dropped: u64,
+}
+
+/// The producer side, owned by the ingest thread. Dropping it closes the ring
+/// and lets readers drain what is left.
+pub struct RingWriter {
+    shared: Arc<Shared>,
+    readers: Vec<Arc<ReaderState>>,
+}
+
+pub enum RingRecv {
+    Record(RingRecord),
+    Empty,
+    Closed,
+}
+
+pub struct RingReader {
+    shared: Arc<Shared>,
+    state: Arc<ReaderState>,
+    cursor: u64,
+}
+
+impl RingWriter {
+    /// `capacity` is rounded up to a power of two.
+    pub fn with_capacity(capacity: usize) -> Self {
+        let capacity = capacity.max(2).next_power_of_two();
+        let slots = (0..capacity).map(|_| Slot::default()).collect();
+        Self {
+            shared: Arc::new(Shared {
+                slots,
+                mask: capacity as u64 - 1,
+                head: AtomicU64::new(0),
+                closed: AtomicBool::new(false),
+            }),
+            readers: Vec::new(),
+        }
+    }
+
+    pub fn capacity(&self) -> usize {
+        self.shared.slots.len()
+    }
+
+    /// Add a reader that starts at the next published record.
+    pub fn subscribe(&mut self, name: &'static str) -> RingReader {
+        let cursor = self.shared.head.load(Ordering::Relaxed);
+        let state = Arc::new(ReaderState {
+            name,
+            cursor: AtomicU64::new(cursor),
+            dropped: AtomicU64::new(0),
+            sleeping: AtomicBool::new(false),
+            thread: OnceLock::new(),
+        });
+        self.readers.push(state.clone());
+        RingReader {
+            shared: self.shared.clone(),
+            state,
+            cursor,
+        }
+    }
+
+    pub fn push(&mut self, record: &RingRecord) {
+        let position = self.shared.head.load(Ordering::Relaxed);
+        let slot = &self.shared.slots[(position & self.shared.mask) as usize];
+        slot.seq.store(2 * position + 1, Ordering::Relaxed);
+        fence(Ordering::Release);
+        for (word, value) in slot.words.iter().zip(record.pack()) {
+            word.store(value, Ordering::Relaxed);
+        }
+        slot.seq.store(2 * position + 2, Ordering::Release);
+        self.shared.head.store(position + 1, Ordering::Release);
+    }
+
+    /// Wake readers that went to sleep on an empty ring. Called once per
+    /// ingest batch rather than per frame.
+    pub fn notify(&self) {
+        // Pairs with the fence in `RingReader::wait`
+        fence(Ordering::SeqCst);
+        for reader in &self.readers {
+            if reader.sleeping.load(Ordering::Relaxed) {
+                if let Some(thread) = reader.thread.get() {
+                    thread.unpark();
+                }
+            }
+        }
+    }
+
+    /// Stop accepting records; readers see `Closed` once they have drained.
+    pub fn close(&self) {
+        self.shared.closed.store(true, Ordering::Release);
+        self.notify();
+    }
+
+    pub fn reader_stats(&self) -> impl Iterator<Item = ReaderStats> + '_ {
+        let head = self.shared.head.load(Ordering::Relaxed);
+        self.readers.iter().map(move |reader| ReaderStats {
+            name: reader.name,
+            lag: head.saturating_sub(reader.cursor.load(Ordering::Relaxed)),
+            dropped: reader.dropped.load(Ordering::Relaxed),
+        })
+    }
+}
+
+impl Drop for RingWriter {
+    fn drop(&mut self) {
+        self.close();
+    }
+}
+
+impl RingReader {
+    pub fn name(&self) -> &'static str {
+        self.state.name
+    }
+
+    pub fn try_recv(&mut self) -> RingRecv {
+        loop {
+            let head = self.shared.head.load(Ordering::Acquire);
+            if self.cursor == head {
+                if self.shared.closed.load(Ordering::Acquire)
+                    && self.shared.head.load(Ordering::Acquire) == head
+                {
+                    return RingRecv::Closed;
+                }
+                return RingRecv::Empty;
+            }
+
+            let slot = &self.shared.slots[(self.cursor & self.shared.mask) as usize];
+            let expected = 2 * self.cursor + 2;
+            let before = slot.seq.load(Ordering::Acquire);
+            let mut words = [0u64; SLOT_WORDS];
+            for (value, word) in words.iter_mut().zip(&slot.words) {
+                *value = word.load(Ordering::Relaxed);
+            }
+            fence(Ordering::Acquire);
+            let after = slot.seq.load(Ordering::Relaxed);
+
+            if before == expected && after == expected {
+                self.advance(self.cursor + 1);
+                return RingRecv::Record(RingRecord::unpack(words));
+            }
+
+            // Overwritten by a later lap: skip to the oldest record still held
+            let oldest = self
+                .shared
+                .head
+                .load(Ordering::Acquire)
+                .saturating_sub(self.shared.slots.len() as u64);
+            let resume = oldest.max(self.cursor + 1);
+            self.state
+                .dropped
+                .fetch_add(resume - self.cursor, Ordering::Relaxed);
+            self.advance(resume);
+        }
+    }
+
+    /// Sleep until the producer publishes, the ring closes, or `timeout`
+    /// passes. Returns immediately if records are already waiting.
+    pub fn wait(&self, timeout: Duration) {
+        let _ = self.state.thread.set(thread::current());
+        self.state.sleeping.store(true, Ordering::Relaxed);
+        // Pairs with the fence in `RingWriter::notify`
+        fence(Ordering::SeqCst);
+        if self.shared.head.load(Ordering::Relaxed) == self.cursor
+            && !self.shared.closed.load(Ordering::Relaxed)
+        {
+            thread::park_timeout(timeout);
+        }
+        self.state.sleeping.store(false, Ordering::Relaxed);
+    }
+
+    fn advance(&mut self, cursor: u64) {
+        self.cursor = cursor;
+        self.state.cursor.store(cursor, Ordering::Relaxed);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Every field is derived from `position` so a record mixing two writes
+    /// is caught by `position_of`.
+    fn record(position: u64) -> RingRecord {
+        RingRecord {
+            source: (position % 3) as u8,
+            frame: CanFrame {
+                can_id: (position as u32) & 0x1FFF_FFFF,
+                can_dlc: (position % 9) as u8,
+                data: position.to_le_bytes(),
+            },
+            ts_opt: (position % 2 == 0).then_some((position, (position as u32) ^ 0x5555_5555)),
+        }
+    }
+
+    fn position_of(record: &RingRecord) -> u64 {
+        let position = u64::from_le_bytes(record.frame.data);
+        assert_eq!(
+            record.pack(),
+            self::record(position).pack(),
+            "torn record at {position}"
+        );
+        position
+    }
+
+    fn recv(reader: &mut RingReader) -> Option<u64> {
+        match reader.try_recv() {
+            RingRecv::Record(record) => Some(position_of(&record)),
+            RingRecv::Empty => None,
+            RingRecv::Closed => panic!("ring closed early"),
+        }
+    }
+
+    #[test]
+    fn capacity_rounds_up_to_a_power_of_two() {
+        assert_eq!(RingWriter::with_capacity(0).capacity(), 2);
+        assert_eq!(RingWriter::with_capacity(5).capacity(), 8);
+        assert_eq!(RingWriter::with_capacity(64).capacity(), 64);
+    }
+
+    #[test]
+    fn every_reader_gets_every_record_in_order() {
+        let mut writer = RingWriter::with_capacity(8);
+        let mut readers = [
+            writer.subscribe("a"),
+            writer.subscribe("b"),
+            writer.subscribe("c"),
+        ];
+
+        for position in 0..5 {
+            writer.push(&record(position));
+        }
+
+        // readers drain independently, so interleave them
+        for position in 0..5 {
+            for reader in &mut readers {
+                assert_eq!(recv(reader), Some(position));
+            }
+        }
+        for reader in &mut readers {
+            assert_eq!(recv(reader), None);
+        }
+        for stats in writer.reader_stats() {
+            assert_eq!((stats.lag, stats.dropped), (0, 0), "{}", stats.name);
+        }
+    }
+
+    #[test]
+    fn late_subscriber_starts_at_the_next_record() {
+        let mut writer = RingWriter::with_capacity(8);
+        writer.push(&record(0));
+        let mut reader = writer.subscribe("late");
+        writer.push(&record(1));
+
+        assert_eq!(recv(&mut reader), Some(1));
+        assert_eq!(recv(&mut reader), None);
+    }
+
+    #[test]
+    fn lapped_reader_skips_to_the_oldest_record_and_counts_the_rest() {
+        let mut writer = RingWriter::with_capacity(4);
+        let mut slow = writer.subscribe("slow");
+        let mut fast = writer.subscribe("fast");
+
+        for position in 0..10 {
+            writer.push(&record(position));
+            assert_eq!(recv(&mut fast), Some(position));
+        }
+        assert_eq!(
+            writer
+                .reader_stats()
+                .find(|s| s.name == "slow")
+                .unwrap()
+                .lag,
+            10
+        );
+
+        // positions 0..6 were overwritten, 6..10 are still held
+        for position in 6..10 {
+            assert_eq!(recv(&mut slow), Some(position));
+        }
+        assert_eq!(recv(&mut slow), None);
+
+        let stats: Vec<_> = writer.reader_stats().collect();
+        assert_eq!(
+            (stats[0].name, stats[0].lag, stats[0].dropped),
+            ("slow", 0, 6)
+        );
+        assert_eq!(
+            (stats[1].name, stats[1].lag, stats[1].dropped),
+            ("fast", 0, 0)
+        );
+
+        // a second lap after catching up counts only the new losses
+        for position in 10..15 {
+            writer.push(&record(position));
+        }
+        assert_eq!(recv(&mut slow), Some(11));
+        assert_eq!(writer.reader_stats().next().unwrap().dropped, 7);
+    }
+
+    #[test]
+    fn reader_drains_then_sees_closed_after_the_writer_drops() {
+        let mut writer = RingWriter::with_capacity(8);
+        let mut reader = writer.subscribe("drain");
+        for position in 0..3 {
+            writer.push(&record(position));
+        }
+        drop(writer);
+
+        for position in 0..3 {
+            assert_eq!(recv(&mut reader), Some(position));
+        }
+        assert!(matches!(reader.try_recv(), RingRecv::Closed));
+        assert!(matches!(reader.try_recv(), RingRecv::Closed));
+    }
+
+    #[test]
+    fn wait_returns_when_the_writer_closes() {
+        let mut writer = RingWriter::with_capacity(8);
+        let mut reader = writer.subscribe("sleeper");
+
+        let handle = thread::spawn(move || {
+            loop {
+                match reader.try_recv() {
+                    RingRecv::Closed => return,
+                    RingRecv::Empty => reader.wait(Duration::from_secs(10)),
+                    RingRecv::Record(_) => {}
+                }
+            }
+        });
+        thread::sleep(Duration::from_millis(20));
+        drop(writer);
+
+        // without the wake-up this would take the full park timeout
+        let start = std::time::Instant::now();
+        handle.join().unwrap();
+        assert!(start.elapsed() < Duration::from_secs(5));
+    }
+
+    #[test]
+    fn slot_caught_mid_overwrite_is_skipped_not_returned() {
+        let mut writer = RingWriter::with_capacity(4);
+        let mut reader = writer.subscribe("reader");
+        for position in 0..4 {
+            writer.push(&record(position));
+        }
+
+        // the writer has started on position 4 in slot 0 and written one word
+        let slot = &writer.shared.slots[0];
+        slot.seq.store(2 * 4 + 1, Ordering::Relaxed);
+        slot.words[0].store(record(4).pack()[0], Ordering::Relaxed);
+        writer.shared.head.store(4, Ordering::Relaxed);
+
+        assert_eq!(recv(&mut reader), Some(1));
+        assert_eq!(reader.state.dropped.load(Ordering::Relaxed), 1);
+    }
+
+    /// Only races for real on a multi-core machine; on one core it still
+    /// checks ordering and the drop accounting under preemption.
+    #[test]
+    fn concurrent_readers_never_see_a_torn_record() {
+        const RECORDS: u64 = 2_000_000;
+
+        // a tiny ring keeps the writer overwriting the slots the readers are in
+        let mut writer = RingWriter::with_capacity(4);
+        let readers: Vec<_> = ["r0", "r1", "r2"]
+            .iter()
+            .map(|name| writer.subscribe(name))
+            .collect();
+
+        let handles: Vec<_> = readers
+            .into_iter()
+            .map(|mut reader| {
+                thread::spawn(move || {
+                    let mut received = 0u64;
+                    let mut next = 0u64;
+                    loop {
+                        match reader.try_recv() {
+                            RingRecv::Record(record) => {
+                                let position = position_of(&record);
+                                assert!(position >= next, "{position} after {next}");
+                                next = position + 1;
+                                received += 1;
+                            }
+                            RingRecv::Empty => reader.wait(Duration::from_millis(1)),
+                            RingRecv::Closed => {
+                                return (received, reader.state.dropped.load(Ordering::Relaxed));
+                            }
+                        }
+                    }
+                })
+            })
+            .collect();
+
+        for position in 0..RECORDS {
+            writer.push(&record(position));
+            if position % 32 == 0 {
+                writer.notify();
+            }
+        }
+        drop(writer);
+
+        let mut total_dropped = 0;
+        for handle in handles {
+            let (received, dropped) = handle.join().unwrap();
+            assert_eq!(received + dropped, RECORDS);
+            total_dropped += dropped;
+        }
+        // readers were lapped, so reads raced the writer
+        assert!(total_dropped > 0);
+    }
+}
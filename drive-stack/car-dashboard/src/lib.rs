@@ -4,11 +4,10 @@ use std::collections::{BTreeMap, BTreeSet};
 use std::convert::Infallible;
 use std::ffi::CString;
 use std::fs;
-use std::io::{self, BufRead, BufReader, BufWriter, Write};
+use std::io;
 use std::mem::{size_of, zeroed};
 use std::os::fd::{AsRawFd, FromRawFd, OwnedFd};
 use std::path::{Path, PathBuf};
-use std::process::{Command, Stdio};
 use std::sync::Arc;
 use std::thread;
 use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
@@ -23,13 +22,13 @@ use conUDS::modules::uds::{
 };
 use conUDS::FlashStatus;
 use conUDS::SupportedResetTypes;
-use futures::StreamExt;
+use futures::{SinkExt, StreamExt};
 use libc::{
     bind, c_void, can_frame, if_nametoindex, iovec, msghdr, recvmsg, sa_family_t, sockaddr,
-    sockaddr_can, socket, socklen_t, AF_CAN, CAN_EFF_FLAG, CAN_EFF_MASK, CAN_ERR_FLAG, CAN_RAW,
-    CAN_RTR_FLAG, CAN_SFF_MASK, EINTR, SOCK_RAW, SOF_TIMESTAMPING_RAW_HARDWARE,
+    sockaddr_can, socket, socklen_t, timeval, AF_CAN, CAN_EFF_FLAG, CAN_EFF_MASK, CAN_ERR_FLAG,
+    CAN_RAW, CAN_RTR_FLAG, CAN_SFF_MASK, EINTR, SOCK_RAW, SOF_TIMESTAMPING_RAW_HARDWARE,
     SOF_TIMESTAMPING_RX_HARDWARE, SOF_TIMESTAMPING_RX_SOFTWARE, SOF_TIMESTAMPING_SOFTWARE,
-    SOL_SOCKET, SO_TIMESTAMPING,
+    SOL_SOCKET, SO_RCVTIMEO, SO_TIMESTAMPING,
 };
 use log::{debug, info, warn};
 use net_detec::{Client as MdnsClient, DiscoveryFilter};
@@ -41,8 +40,17 @@ use warp::sse::Event;
 use warp::Buf;
 use warp::{Filter, Reply};
 
+mod signal_store;
+mod signal_stream;
 mod views;
 
+use signal_store::{
+    SignalStore, DEFAULT_HISTORY_POINTS, DEFAULT_SIGNAL_HISTORY_MB, MAX_HISTORY_POINTS,
+};
+use signal_stream::{
+    signal_window_ms, RawSignalBatch, RawSignalSample, SignalDecimator, SignalHistory,
+    SignalRegistry, SignalSubscription, SIGNAL_BATCH_INTERVAL, SIGNAL_RESUME_WINDOW,
+};
 use yamcan_dashboard as yamcan;
 use yamcan_dashboard::NetworkBus;
 
@@ -53,6 +61,7 @@ const DEFAULT_NOTES_INFLUX_ORG: &str = "CFR";
 const DEFAULT_NOTES_INFLUX_BUCKET: &str = "CarNotes";
 const DEFAULT_OFFLINE_TIMEOUT_SECS: u64 = 3;
 const DEFAULT_SWEEP_INTERVAL_MS: u64 = 250;
+const UPDATE_COALESCE_INTERVAL: Duration = Duration::from_millis(50);
 const OTA_AGENT_DISCOVERY_TIMEOUT_SECS: u64 = 2;
 const OTA_AGENT_SERVICE_NAME: &str = "_ota-agent._tcp.local.";
 const SUPPORTED_CONTROLLERS: &[&str] = &[
@@ -66,7 +75,9 @@ const DEFAULT_MAP_TILE_SOURCE_ID: &str = OPENSTREETMAP_MAP_TILE_SOURCE_ID;
 const DEFAULT_MAP_TILE_TEMPLATE: &str = OPENSTREETMAP_MAP_TILE_TEMPLATE;
 const MAP_TILE_USER_AGENT: &str = "cfr-car-dashboard/0.1 offline-map-cache";
 const MAX_MAP_ZOOM: u8 = 19;
-const SIGNAL_BROADCAST_QUEUE_CAPACITY: usize = 8;
+const SIGNAL_BROADCAST_QUEUE_CAPACITY: usize = 64;
+const SIGNAL_HISTORY_DEFAULT_SPAN_MS: u64 = 5 * 60 * 1000;
+const SIGNAL_HISTORY_REPORT_INTERVAL: Duration = Duration::from_secs(60);
 const DEFAULT_NOTES_LIMIT: usize = 50;
 const MAX_NOTES_LIMIT: usize = 200;
 const MAX_NOTE_TEXT_BYTES: usize = 32 * 1024;
@@ -143,11 +154,9 @@ pub struct Opts {
     #[arg(long, default_value = DEFAULT_MAP_STORE_DIR)]
     pub map_store_dir: String,
 
-    #[arg(long, hide = true, default_value_t = false)]
-    pub veh_worker: bool,
-
-    #[arg(long, hide = true, default_value_t = false)]
-    pub body_worker: bool,
+    /// Memory for the in-process signal history; 0 disables it.
+    #[arg(long, default_value_t = DEFAULT_SIGNAL_HISTORY_MB)]
+    pub signal_history_mb: usize,
 }
 
 #[derive(Debug, Deserialize)]
@@ -300,6 +309,7 @@ pub enum SignalPlotKind {
 #[derive(Debug, Clone, Serialize, PartialEq, Eq)]
 pub struct SignalManifestEntry {
     pub id: String,
+    pub handle: u32,
     pub bus: String,
     pub message_name: String,
     pub message_id: u32,
@@ -313,27 +323,21 @@ pub struct SignalManifestResponse {
     pub signals: Vec<SignalManifestEntry>,
 }
 
-#[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
-pub struct SignalSample {
-    pub signal_id: String,
-    pub signal_name: String,
-    pub value: f64,
-    pub label: Option<String>,
-    pub unit: Option<String>,
-}
-
-#[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
-pub struct SignalSampleEvent {
-    pub timestamp_ms: u64,
-    pub bus: String,
-    pub message_name: String,
-    pub message_id: u32,
-    pub samples: Vec<SignalSample>,
+#[derive(Debug, Clone, Serialize)]
+pub struct SignalHistorySeries {
+    pub id: String,
+    #[serde(skip_serializing_if = "BTreeMap::is_empty")]
+    pub labels: BTreeMap<i32, String>,
+    /// `[timestamp_ms, value]` pairs; `null` values were not finite.
+    pub points: Vec<(u64, Option<f32>)>,
 }
 
-#[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
-pub struct SignalSampleBatch {
-    pub events: Vec<SignalSampleEvent>,
+#[derive(Debug, Clone, Serialize)]
+pub struct SignalHistoryResponse {
+    pub from_ms: u64,
+    pub to_ms: u64,
+    pub oldest_ms: Option<u64>,
+    pub signals: Vec<SignalHistorySeries>,
 }
 
 #[derive(Debug, Clone)]
@@ -349,7 +353,7 @@ struct FlashUpload {
     display_name: String,
 }
 
-#[derive(Debug, Clone, Serialize, Deserialize)]
+#[derive(Debug, Clone)]
 struct NormalizedUpdate {
     controller: String,
     seen_at_ms: u64,
@@ -357,10 +361,45 @@ struct NormalizedUpdate {
     critical_signals: Option<Vec<LiveSignal>>,
 }
 
+impl NormalizedUpdate {
+    /// Fold a later update for the same controller into this one, with the
+    /// same result as applying both in order.
+    fn absorb(&mut self, newer: NormalizedUpdate) {
+        self.seen_at_ms = newer.seen_at_ms;
+        if newer.active_faults.is_some() {
+            self.active_faults = newer.active_faults;
+        }
+        if newer.critical_signals.is_some() {
+            self.critical_signals = newer.critical_signals;
+        }
+    }
+}
+
 #[derive(Debug, Clone, Default, Deserialize)]
 struct SignalEventQuery {
     #[serde(default)]
     signals: String,
+    #[serde(default)]
+    rate_hz: Option<f64>,
+    /// `seq` of the last frame a reconnecting client received.
+    #[serde(default)]
+    resume: Option<u64>,
+}
+
+#[derive(Debug, Clone, Default, Deserialize)]
+struct SignalHistoryQuery {
+    #[serde(default)]
+    signals: String,
+    #[serde(default)]
+    from_ms: Option<u64>,
+    #[serde(default)]
+    to_ms: Option<u64>,
+    /// Range length ending at `to_ms` when `from_ms` is not given, so that
+    /// clients need not agree with the car's clock.
+    #[serde(default)]
+    span_ms: Option<u64>,
+    #[serde(default)]
+    points: Option<usize>,
 }
 
 #[derive(Debug, Clone, Default, Deserialize)]
@@ -637,12 +676,57 @@ struct ControllerRuntime {
     last_seen_ms: Option<u64>,
     faults: Vec<ActiveFault>,
     critical_signals: Vec<LiveSignal>,
+    /// Serialized `ControllerStatus` and the `online` it was rendered with;
+    /// cleared by every update.
+    status_json: Option<(bool, Arc<str>)>,
 }
 
 #[derive(Debug)]
 struct DashboardStore {
     controllers: BTreeMap<String, ControllerRuntime>,
     offline_timeout: Duration,
+    snapshot_json: Arc<SnapshotJson>,
+    published_json: Arc<SnapshotJson>,
+}
+
+/// A serialized `DashboardSnapshot`, kept per controller as well so that a
+/// client watching some controllers is served by concatenation.
+#[derive(Debug, Default)]
+struct SnapshotJson {
+    controllers: Vec<(String, Arc<str>)>,
+    full: String,
+}
+
+impl SnapshotJson {
+    fn new(controllers: Vec<(String, Arc<str>)>) -> Self {
+        let full = join_snapshot_json(controllers.iter().map(|(_, json)| &**json));
+        Self { controllers, full }
+    }
+
+    fn filtered(&self, controller_names: Option<&BTreeSet<String>>) -> String {
+        let Some(controller_names) = controller_names else {
+            return self.full.clone();
+        };
+        join_snapshot_json(
+            self.controllers
+                .iter()
+                .filter(|(name, _)| controller_names.contains(name))
+                .map(|(_, json)| &**json),
+        )
+    }
+}
+
+/// `{"controllers":[...]}` exactly as serde_json writes `DashboardSnapshot`.
+fn join_snapshot_json<'a>(controllers: impl Iterator<Item = &'a str>) -> String {
+    let mut json = String::from("{\"controllers\":[");
+    for (index, controller) in controllers.enumerate() {
+        if index > 0 {
+            json.push(',');
+        }
+        json.push_str(controller);
+    }
+    json.push_str("]}");
+    json
 }
 
 #[derive(Debug)]
@@ -711,13 +795,15 @@ struct AppState {
     capabilities: Arc<BTreeMap<String, ControllerCapability>>,
     uds_workers: Arc<BTreeMap<String, UdsWorkerHandle>>,
     signal_manifest: Arc<SignalManifestResponse>,
+    signal_registry: Arc<SignalRegistry>,
     veh_iface: Arc<String>,
     body_iface: Arc<Option<String>>,
-    state_events: broadcast::Sender<String>,
+    state_events: broadcast::Sender<Arc<SnapshotJson>>,
     job_events: broadcast::Sender<String>,
-    signal_events: broadcast::Sender<Arc<SignalSampleBatch>>,
+    signal_events: broadcast::Sender<Arc<RawSignalBatch>>,
+    signal_history: Arc<SignalHistory>,
+    signal_store: Arc<std::sync::Mutex<SignalStore>>,
     notes_events: broadcast::Sender<String>,
-    last_state_payload: Arc<Mutex<String>>,
     last_jobs_payload: Arc<Mutex<String>>,
     jobs: Arc<RwLock<JobStore>>,
     tester_present: Arc<Mutex<BTreeMap<String, TesterPresentHandle>>>,
@@ -739,6 +825,7 @@ impl DashboardStore {
                         last_seen_ms: None,
                         faults: Vec::new(),
                         critical_signals: Vec::new(),
+                        status_json: None,
                     },
                 )
             })
@@ -747,6 +834,8 @@ impl DashboardStore {
         Self {
             controllers,
             offline_timeout,
+            snapshot_json: Arc::new(SnapshotJson::default()),
+            published_json: Arc::new(SnapshotJson::default()),
         }
     }
 
@@ -757,6 +846,7 @@ impl DashboardStore {
 
         controller.last_seen_at = Some(now);
         controller.last_seen_ms = Some(update.seen_at_ms);
+        controller.status_json = None;
 
         if let Some(active_faults) = update.active_faults {
             controller.faults = active_faults;
@@ -768,23 +858,77 @@ impl DashboardStore {
     }
 
     fn snapshot(&self, now: Instant) -> DashboardSnapshot {
-        let mut controllers = Vec::with_capacity(self.controllers.len());
-        for controller in self.controllers.values() {
+        let controllers = self
+            .controllers
+            .values()
+            .map(|controller| controller.status(self.is_online(controller, now)))
+            .collect();
+        DashboardSnapshot { controllers }
+    }
+
+    fn is_online(&self, controller: &ControllerRuntime, now: Instant) -> bool {
+        controller
+            .last_seen_at
+            .map(|seen| now.duration_since(seen) < self.offline_timeout)
+            .unwrap_or(false)
+    }
+
+    /// The serialized snapshot, re-rendering only controllers that were
+    /// updated or went on- or offline since the last call.
+    fn snapshot_json(&mut self, now: Instant) -> Result<Arc<SnapshotJson>> {
+        let offline_timeout = self.offline_timeout;
+        let mut changed = self.snapshot_json.controllers.len() != self.controllers.len();
+        for controller in self.controllers.values_mut() {
             let online = controller
                 .last_seen_at
-                .map(|seen| now.duration_since(seen) < self.offline_timeout)
+                .map(|seen| now.duration_since(seen) < offline_timeout)
                 .unwrap_or(false);
+            if matches!(&controller.status_json, Some((rendered, _)) if *rendered == online) {
+                continue;
+            }
+            let json: Arc<str> = serde_json::to_string(&controller.status(online))
+                .context("serializing controller status")?
+                .into();
+            changed |= controller
+                .status_json
+                .as_ref()
+                .map_or(true, |(_, previous)| *previous != json);
+            controller.status_json = Some((online, json));
+        }
+        if changed {
+            self.snapshot_json = Arc::new(SnapshotJson::new(
+                self.controllers
+                    .values()
+                    .filter_map(|controller| {
+                        let (_, json) = controller.status_json.as_ref()?;
+                        Some((controller.name.clone(), Arc::clone(json)))
+                    })
+                    .collect(),
+            ));
+        }
+        Ok(Arc::clone(&self.snapshot_json))
+    }
 
-            controllers.push(ControllerStatus {
-                name: controller.name.clone(),
-                online,
-                last_seen_ms: controller.last_seen_ms,
-                faults: controller.faults.clone(),
-                critical_signals: controller.critical_signals.clone(),
-            });
+    /// The serialized snapshot if it changed since the last one returned here.
+    fn unpublished_snapshot_json(&mut self, now: Instant) -> Result<Option<Arc<SnapshotJson>>> {
+        let snapshot = self.snapshot_json(now)?;
+        if Arc::ptr_eq(&snapshot, &self.published_json) {
+            return Ok(None);
         }
+        self.published_json = Arc::clone(&snapshot);
+        Ok(Some(snapshot))
+    }
+}
 
-        DashboardSnapshot { controllers }
+impl ControllerRuntime {
+    fn status(&self, online: bool) -> ControllerStatus {
+        ControllerStatus {
+            name: self.name.clone(),
+            online,
+            last_seen_ms: self.last_seen_ms,
+            faults: self.faults.clone(),
+            critical_signals: self.critical_signals.clone(),
+        }
     }
 }
 
@@ -920,11 +1064,8 @@ impl AppState {
         &self,
         controller_names: &BTreeSet<String>,
     ) -> Result<String> {
-        let mut snapshot = self.snapshot().await;
-        snapshot
-            .controllers
-            .retain(|controller| controller_names.contains(&controller.name));
-        serde_json::to_string(&snapshot).context("serializing controller dashboard snapshot")
+        let snapshot = self.store.write().await.snapshot_json(Instant::now())?;
+        Ok(snapshot.filtered(Some(controller_names)))
     }
 
     fn signal_manifest_json(&self) -> Result<String> {
@@ -932,8 +1073,8 @@ impl AppState {
     }
 
     async fn snapshot_json(&self) -> Result<String> {
-        let snapshot = self.snapshot().await;
-        serde_json::to_string(&snapshot).context("serializing dashboard snapshot")
+        let snapshot = self.store.write().await.snapshot_json(Instant::now())?;
+        Ok(snapshot.full.clone())
     }
 
     async fn jobs_snapshot(&self) -> JobsSnapshot {
@@ -946,11 +1087,13 @@ impl AppState {
     }
 
     async fn publish_state_if_changed(&self) -> Result<()> {
-        let payload = self.snapshot_json().await?;
-        let mut last_payload = self.last_state_payload.lock().await;
-        if *last_payload != payload {
-            *last_payload = payload.clone();
-            let _ = self.state_events.send(payload);
+        let snapshot = self
+            .store
+            .write()
+            .await
+            .unpublished_snapshot_json(Instant::now())?;
+        if let Some(snapshot) = snapshot {
+            let _ = self.state_events.send(snapshot);
         }
         Ok(())
     }
@@ -1205,13 +1348,6 @@ impl InfluxNotesClient {
 }
 
 pub async fn run(opts: Opts) -> Result<()> {
-    if opts.veh_worker {
-        return run_veh_worker(&opts);
-    }
-    if opts.body_worker {
-        return run_body_worker(&opts);
-    }
-
     info!(
         "initializing dashboard with uds_manifest='{}', routine_manifest='{}', deploy_targets_manifest='{}', ota_agent_service_name='{}', veh_iface='{}', body_iface='{}', map_store_dir='{}', port={}",
         opts.uds_manifest,
@@ -1229,7 +1365,15 @@ pub async fn run(opts: Opts) -> Result<()> {
         &opts.deploy_targets_manifest,
         &opts.veh_iface,
     )?);
-    let signal_manifest = Arc::new(build_signal_manifest());
+    let signal_registry = Arc::new(SignalRegistry::new(
+        yamcan::signal_descriptors(),
+        yamcan::enum_value_descriptors(),
+    ));
+    let signal_manifest = Arc::new(build_signal_manifest(&signal_registry));
+    let signal_store = Arc::new(std::sync::Mutex::new(SignalStore::new(
+        signal_registry.len(),
+        opts.signal_history_mb.saturating_mul(1024 * 1024),
+    )));
     let controller_names = tracked_controller_names();
     let uds_workers = Arc::new(
         capabilities
@@ -1298,13 +1442,15 @@ pub async fn run(opts: Opts) -> Result<()> {
         capabilities,
         uds_workers,
         signal_manifest,
+        signal_registry,
         veh_iface: Arc::new(opts.veh_iface.clone()),
         body_iface: Arc::new(opts.body_iface.clone()),
         state_events,
         job_events,
         signal_events,
+        signal_history: Arc::new(SignalHistory::new()),
+        signal_store,
         notes_events,
-        last_state_payload: Arc::new(Mutex::new(String::new())),
         last_jobs_payload: Arc::new(Mutex::new(String::new())),
         jobs,
         tester_present: Arc::new(Mutex::new(BTreeMap::new())),
@@ -1317,15 +1463,15 @@ pub async fn run(opts: Opts) -> Result<()> {
     state.publish_state_if_changed().await?;
     state.publish_jobs_if_changed().await?;
 
-    let (updates_tx, mut updates_rx) = mpsc::unbounded_channel::<NormalizedUpdate>();
+    let (updates_tx, mut updates_rx) = mpsc::unbounded_channel::<Vec<NormalizedUpdate>>();
 
     let state_for_updates = state.clone();
     tokio::spawn(async move {
         info!("dashboard update task started");
-        while let Some(update) = updates_rx.recv().await {
+        while let Some(updates) = updates_rx.recv().await {
             let now = Instant::now();
-            {
-                let mut store = state_for_updates.store.write().await;
+            let mut store = state_for_updates.store.write().await;
+            for update in updates {
                 store.apply_update(update, now);
             }
         }
@@ -1346,6 +1492,9 @@ pub async fn run(opts: Opts) -> Result<()> {
     });
 
     let signal_events_for_worker = state.signal_events.clone();
+    let signal_history_for_worker = Arc::clone(&state.signal_history);
+    let signal_store_for_worker = Arc::clone(&state.signal_store);
+    let signal_registry_for_worker = Arc::clone(&state.signal_registry);
     let state_filter = warp::any().map(move || state.clone());
 
     let home = warp::path::end()
@@ -1402,6 +1551,12 @@ pub async fn run(opts: Opts) -> Result<()> {
         .and(state_filter.clone())
         .and_then(handle_signal_manifest);
 
+    let signal_history_query = warp::path!("api" / "signals" / "history")
+        .and(warp::get())
+        .and(warp::query::<SignalHistoryQuery>())
+        .and(state_filter.clone())
+        .map(handle_signal_history);
+
     let list_notes = warp::path!("api" / "notes")
         .and(warp::get())
         .and(warp::query::<NotesQuery>())
@@ -1553,15 +1708,28 @@ pub async fn run(opts: Opts) -> Result<()> {
         .and(warp::query::<SignalEventQuery>())
         .and(state_filter.clone())
         .map(|query: SignalEventQuery, state: AppState| {
-            let selected_ids = query
-                .signals
-                .split(',')
-                .filter(|value| !value.is_empty())
-                .map(str::to_string)
-                .collect::<BTreeSet<_>>();
-            signal_events_reply(state, selected_ids)
+            let subscription = state
+                .signal_registry
+                .subscribe(query.signals.split(',').filter(|value| !value.is_empty()));
+            signal_events_reply(state, subscription, signal_window_ms(query.rate_hz))
         });
 
+    let signal_socket = warp::path("signal-socket")
+        .and(warp::ws())
+        .and(warp::query::<SignalEventQuery>())
+        .and(state_filter.clone())
+        .map(
+            |ws: warp::ws::Ws, query: SignalEventQuery, state: AppState| {
+                let subscription = state
+                    .signal_registry
+                    .subscribe(query.signals.split(',').filter(|value| !value.is_empty()));
+                let window_ms = signal_window_ms(query.rate_hz);
+                ws.on_upgrade(move |socket| {
+                    run_signal_socket(socket, state, subscription, window_ms, query.resume)
+                })
+            },
+        );
+
     let clock = warp::path!("api" / "clock")
         .and(warp::get())
         .map(handle_clock);
@@ -1638,11 +1806,9 @@ pub async fn run(opts: Opts) -> Result<()> {
                     async move {
                         loop {
                             match rx.recv().await {
-                                Ok(payload) => {
-                                    let payload = filter_dashboard_snapshot_json(
-                                        &payload,
-                                        controller_filter.as_ref().as_ref(),
-                                    );
+                                Ok(snapshot) => {
+                                    let payload =
+                                        snapshot.filtered(controller_filter.as_ref().as_ref());
                                     return Some((
                                         Ok::<Event, Infallible>(
                                             Event::default().event("state").data(payload),
@@ -1754,6 +1920,7 @@ pub async fn run(opts: Opts) -> Result<()> {
         .or(controller)
         .or(database)
         .or(signal_manifest)
+        .or(signal_history_query)
         .or(list_notes)
         .or(create_note)
         .or(notes_events)
@@ -1781,12 +1948,13 @@ pub async fn run(opts: Opts) -> Result<()> {
         .or(tester_present_state)
         .or(controller_jobs)
         .or(signal_events_with_query)
+        .or(signal_socket)
         .or(clock)
         .or(events)
         .or(health);
     let addr = ([0, 0, 0, 0], opts.port);
     info!(
-        "starting HTTP server on http://0.0.0.0:{} with routes '/', '/signals', '/gps', '/hv-pack', '/sicko-mode', '/notes', '/database', '/controllers/:name', '/api/signals/manifest', '/api/notes', '/notes-events', '/api/maps/views', '/api/maps/debug', '/api/maps/views/:id', '/api/maps/views/plan', '/api/maps/views/commit', '/api/maps/tiles/:z/:x/:y', '/api/clock', '/assets/uPlot.iife.min.js', '/assets/uPlot.min.css', '/assets/signal-cache-worker.js', '/assets/sicko-mode-subway-surfers.gif', '/api/controllers/:name/current-session', '/api/controllers/:name/session', '/api/controllers/:name/routines/:routine/:action', '/api/controllers/:name/reset', '/api/controllers/:name/flash', '/api/controllers/:name/recover', '/api/controllers/:name/tester-present', '/api/controllers/:name/tester-present/request', '/api/controllers/:name/jobs', '/events', '/signal-events', '/healthz'",
+        "starting HTTP server on http://0.0.0.0:{} with routes '/', '/signals', '/gps', '/hv-pack', '/sicko-mode', '/notes', '/database', '/controllers/:name', '/api/signals/manifest', '/api/signals/history', '/api/notes', '/notes-events', '/api/maps/views', '/api/maps/debug', '/api/maps/views/:id', '/api/maps/views/plan', '/api/maps/views/commit', '/api/maps/tiles/:z/:x/:y', '/api/clock', '/assets/uPlot.iife.min.js', '/assets/uPlot.min.css', '/assets/signal-cache-worker.js', '/assets/sicko-mode-subway-surfers.gif', '/api/controllers/:name/current-session', '/api/controllers/:name/session', '/api/controllers/:name/routines/:routine/:action', '/api/controllers/:name/reset', '/api/controllers/:name/flash', '/api/controllers/:name/recover', '/api/controllers/:name/tester-present', '/api/controllers/:name/tester-present/request', '/api/controllers/:name/jobs', '/events', '/signal-events', '/signal-socket', '/healthz'",
         opts.port
     );
     let (_, server) = warp::serve(routes)
@@ -1804,7 +1972,10 @@ pub async fn run(opts: Opts) -> Result<()> {
     spawn_signal_broadcast_worker(
         opts.veh_iface.clone(),
         yamcan::Bus::Veh,
+        signal_registry_for_worker,
         signal_events_for_worker,
+        signal_history_for_worker,
+        signal_store_for_worker,
     );
 
     server.await;
@@ -2093,6 +2264,56 @@ async fn handle_signal_manifest(state: AppState) -> Result<warp::reply::Response
     .into_response())
 }
 
+/// Recent samples of the requested signals from the in-process store,
+/// downsampled to at most `points` per signal. Defaults to the last five
+/// minutes up to now.
+fn handle_signal_history(query: SignalHistoryQuery, state: AppState) -> warp::reply::Response {
+    let to_ms = query.to_ms.unwrap_or_else(now_ms);
+    let from_ms = query.from_ms.unwrap_or_else(|| {
+        to_ms.saturating_sub(query.span_ms.unwrap_or(SIGNAL_HISTORY_DEFAULT_SPAN_MS))
+    });
+    let max_points = query
+        .points
+        .unwrap_or(DEFAULT_HISTORY_POINTS)
+        .clamp(2, MAX_HISTORY_POINTS);
+    let store = state
+        .signal_store
+        .lock()
+        .unwrap_or_else(|error| error.into_inner());
+    let signals = query
+        .signals
+        .split(',')
+        .filter_map(|id| {
+            let handle = state.signal_registry.handle_for_id(id)?;
+            let points = store
+                .query(handle, from_ms, to_ms, max_points)
+                .into_iter()
+                .map(|(t, v)| (t, v.is_finite().then_some(v)))
+                .collect();
+            let labels = state
+                .signal_registry
+                .labels(handle)
+                .into_iter()
+                .flatten()
+                .map(|(&raw, &label)| (raw, label.to_string()))
+                .collect();
+            Some(SignalHistorySeries {
+                id: id.to_string(),
+                labels,
+                points,
+            })
+        })
+        .collect();
+    let response = SignalHistoryResponse {
+        from_ms,
+        to_ms,
+        oldest_ms: store.oldest_ms(),
+        signals,
+    };
+    drop(store);
+    warp::reply::json(&response).into_response()
+}
+
 fn handle_clock() -> warp::reply::Response {
     warp::reply::with_status(
         warp::reply::json(&ClockResponse {
@@ -5114,23 +5335,6 @@ fn parse_controller_filter(value: Option<String>) -> Option<BTreeSet<String>> {
     (!controllers.is_empty()).then_some(controllers)
 }
 
-fn filter_dashboard_snapshot_json(
-    payload: &str,
-    controller_names: Option<&BTreeSet<String>>,
-) -> String {
-    let Some(controller_names) = controller_names else {
-        return payload.to_string();
-    };
-
-    let Ok(mut snapshot) = serde_json::from_str::<DashboardSnapshot>(payload) else {
-        return payload.to_string();
-    };
-    snapshot
-        .controllers
-        .retain(|controller| controller_names.contains(&controller.name));
-    serde_json::to_string(&snapshot).unwrap_or_else(|_| payload.to_string())
-}
-
 async fn ota_agent_error_message(status: HttpStatusCode, response: reqwest::Response) -> String {
     match response.text().await {
         Ok(body) => match serde_json::from_str::<OtaAgentErrorReply>(&body) {
@@ -5145,225 +5349,236 @@ async fn ota_agent_error_message(status: HttpStatusCode, response: reqwest::Resp
     }
 }
 
-fn signal_events_reply(state: AppState, selected_ids: BTreeSet<String>) -> impl Reply {
+/// JSON counterpart of `run_signal_socket` for command-line captures:
+/// `signal-sample` events of `[handle, timestamp_ms, value]` points, after a
+/// `signal-subscription` event mapping handles to signal IDs and enum labels.
+fn signal_events_reply(
+    state: AppState,
+    subscription: SignalSubscription,
+    window_ms: u64,
+) -> impl Reply {
     info!(
-        "signal SSE client connected with {} requested signal(s); shared stream subscribers will become {}",
-        selected_ids.len(),
+        "signal SSE client connected with {} subscribed signal(s) at {window_ms} ms windows; shared stream subscribers will become {}",
+        subscription.handles().len(),
         state.signal_events.receiver_count() + 1
     );
-    let selected_ids = Arc::new(selected_ids);
-    let stream = futures::stream::unfold(
-        (state.signal_events.subscribe(), selected_ids),
-        |(mut rx, selected_ids)| async move {
+    let description = Event::default()
+        .event("signal-subscription")
+        .data(subscription.describe_json(window_ms, false));
+    let decimator = SignalDecimator::new(subscription.handles(), state.signal_registry.len());
+    let mut window = tokio::time::interval(Duration::from_millis(window_ms));
+    window.set_missed_tick_behavior(tokio::time::MissedTickBehavior::Delay);
+
+    let samples = futures::stream::unfold(
+        (
+            state.signal_events.subscribe(),
+            decimator,
+            window,
+            subscription,
+        ),
+        |(mut rx, mut decimator, mut window, subscription)| async move {
             loop {
-                let events = match rx.recv().await {
-                    Ok(batch) => filter_signal_sample_events(batch.as_ref(), &selected_ids),
-                    Err(broadcast::error::RecvError::Lagged(skipped)) => {
-                        warn!("signal SSE client lagged behind by {skipped} batch(es)");
-                        continue;
-                    }
-                    Err(broadcast::error::RecvError::Closed) => {
-                        return None;
+                tokio::select! {
+                    received = rx.recv() => match received {
+                        Ok(batch) => decimator.push_batch(&batch),
+                        Err(broadcast::error::RecvError::Lagged(skipped)) => {
+                            warn!("signal SSE client lagged behind by {skipped} batch(es)");
+                        }
+                        Err(broadcast::error::RecvError::Closed) => return None,
+                    },
+                    _ = window.tick() => {
+                        let Some(payload) = decimator.flush_json() else {
+                            continue;
+                        };
+                        let event = Event::default().event("signal-sample").data(payload);
+                        return Some((
+                            Ok::<Event, Infallible>(event),
+                            (rx, decimator, window, subscription),
+                        ));
                     }
-                };
-
-                if events.is_empty() {
-                    continue;
                 }
-
-                let payload = serde_json::to_string(&SignalSampleBatch { events })
-                    .unwrap_or_else(|_| "{\"events\":[]}".to_string());
-                return Some((
-                    Ok::<Event, Infallible>(Event::default().event("signal-sample").data(payload)),
-                    (rx, selected_ids),
-                ));
             }
         },
     );
+    let stream =
+        futures::stream::once(async move { Ok::<Event, Infallible>(description) }).chain(samples);
 
     warp::sse::reply(warp::sse::keep_alive().stream(stream))
 }
 
-fn filter_signal_sample_events(
-    batch: &SignalSampleBatch,
-    selected_ids: &BTreeSet<String>,
-) -> Vec<SignalSampleEvent> {
-    if selected_ids.is_empty() {
-        return batch.events.clone();
-    }
-
-    batch
-        .events
-        .iter()
-        .filter_map(|event| {
-            let samples = event
-                .samples
-                .iter()
-                .filter(|sample| selected_ids.contains(&sample.signal_id))
-                .cloned()
-                .collect::<Vec<_>>();
-            if samples.is_empty() {
-                return None;
-            }
-            Some(SignalSampleEvent {
-                timestamp_ms: event.timestamp_ms,
-                bus: event.bus.clone(),
-                message_name: event.message_name.clone(),
-                message_id: event.message_id,
-                samples,
-            })
-        })
-        .collect()
-}
-
-fn spawn_veh_worker(
-    iface: String,
-    _tracked_controllers: Arc<BTreeSet<String>>,
-    updates_tx: mpsc::UnboundedSender<NormalizedUpdate>,
+/// Streams one client's subscribed signals, reduced to min/max/last per
+/// window, as binary frames (see `SIGNAL_WIRE_VERSION`). The first message is
+/// a JSON text frame mapping the handles used by every later frame to signal
+/// IDs and enum labels. A client that reconnects with `resume` set to the
+/// last `seq` it saw is replayed what it missed, if that is still held.
+async fn run_signal_socket(
+    socket: warp::ws::WebSocket,
+    state: AppState,
+    subscription: SignalSubscription,
+    window_ms: u64,
+    resume: Option<u64>,
 ) {
-    thread::spawn(move || {
-        info!("spawning vehicle CAN worker supervisor for iface='{iface}'");
-        loop {
-            let exe = match std::env::current_exe() {
-                Ok(exe) => exe,
-                Err(e) => {
-                    warn!("failed to resolve dashboard executable for worker: {e}");
-                    thread::sleep(Duration::from_secs(1));
-                    continue;
-                }
-            };
-            let mut child = match Command::new(exe)
-                .arg("--veh-worker")
-                .arg("--veh-iface")
-                .arg(&iface)
-                .stdout(Stdio::piped())
-                .stderr(Stdio::inherit())
-                .spawn()
-            {
-                Ok(child) => child,
-                Err(e) => {
-                    warn!("failed to spawn vehicle worker for {iface}: {e}");
-                    thread::sleep(Duration::from_secs(1));
-                    continue;
-                }
-            };
-
-            info!("vehicle worker started for iface='{iface}'");
-            let Some(stdout) = child.stdout.take() else {
-                warn!("vehicle worker stdout unavailable for iface='{iface}'");
-                let _ = child.kill();
-                thread::sleep(Duration::from_secs(1));
-                continue;
-            };
+    info!(
+        "signal socket client connected with {} subscribed signal(s) at {window_ms} ms windows; shared stream subscribers will become {}",
+        subscription.handles().len(),
+        state.signal_events.receiver_count() + 1
+    );
+    // Subscribe before reading the history so no batch falls between the two
+    let mut rx = state.signal_events.subscribe();
+    let mut decimator = SignalDecimator::new(subscription.handles(), state.signal_registry.len());
+    let replay = resume.and_then(|seq| state.signal_history.since(seq));
+    let mut last_seq = replay.as_ref().and(resume).unwrap_or(0);
+    let (mut sink, mut incoming) = socket.split();
+
+    let description = subscription.describe_json(window_ms, replay.is_some());
+    if sink
+        .send(warp::ws::Message::text(description))
+        .await
+        .is_err()
+    {
+        linger_signal_subscription(subscription);
+        return;
+    }
+    for batch in replay.into_iter().flatten() {
+        decimator.push_batch(&batch);
+        last_seq = batch.seq;
+    }
 
-            let reader = BufReader::new(stdout);
-            for line in reader.lines() {
-                let line = match line {
-                    Ok(line) => line,
-                    Err(e) => {
-                        warn!("failed reading vehicle worker output for {iface}: {e}");
-                        break;
+    let mut window = tokio::time::interval(Duration::from_millis(window_ms));
+    window.set_missed_tick_behavior(tokio::time::MissedTickBehavior::Delay);
+    loop {
+        tokio::select! {
+            received = rx.recv() => match received {
+                Ok(batch) => {
+                    if batch.seq > last_seq {
+                        decimator.push_batch(&batch);
+                        last_seq = batch.seq;
                     }
-                };
-                if line.trim().is_empty() {
-                    continue;
                 }
-                let update: NormalizedUpdate = match serde_json::from_str(&line) {
-                    Ok(update) => update,
-                    Err(e) => {
-                        warn!("failed parsing vehicle worker update for {iface}: {e}");
-                        continue;
+                Err(broadcast::error::RecvError::Lagged(skipped)) => {
+                    let backfill = state.signal_history.since(last_seq);
+                    if backfill.is_none() {
+                        warn!("signal socket client lagged behind by {skipped} batch(es)");
+                    }
+                    for batch in backfill.into_iter().flatten() {
+                        decimator.push_batch(&batch);
+                        last_seq = batch.seq;
                     }
+                }
+                Err(broadcast::error::RecvError::Closed) => break,
+            },
+            _ = window.tick() => {
+                let Some(frame) = decimator.flush_binary(last_seq) else {
+                    continue;
                 };
-                if updates_tx.send(update).is_err() {
-                    warn!("vehicle update channel closed; stopping worker supervisor");
-                    let _ = child.kill();
-                    return;
+                if sink.send(warp::ws::Message::binary(frame)).await.is_err() {
+                    break;
                 }
             }
-
-            match child.wait() {
-                Ok(status) => warn!("vehicle worker exited for {iface} with status {status}"),
-                Err(e) => warn!("failed waiting for vehicle worker on {iface}: {e}"),
-            }
-            thread::sleep(Duration::from_secs(1));
+            message = incoming.next() => match message {
+                Some(Ok(message)) if !message.is_close() => {}
+                _ => break,
+            },
         }
+    }
+    debug!("signal socket client disconnected at seq {last_seq}");
+    linger_signal_subscription(subscription);
+}
+
+/// Keep decoding a disconnected client's signals for the resume window so
+/// that a quick reconnect finds its samples in the history.
+fn linger_signal_subscription(subscription: SignalSubscription) {
+    tokio::spawn(async move {
+        tokio::time::sleep(SIGNAL_RESUME_WINDOW).await;
+        drop(subscription);
     });
 }
 
-fn spawn_body_worker(
+/// Decodes controller status messages on a dedicated thread and hands them
+/// to the dashboard update task, coalesced per controller over
+/// `UPDATE_COALESCE_INTERVAL`. Restarts the decoder if the socket fails.
+fn spawn_veh_worker(
     iface: String,
-    _tracked_controllers: Arc<BTreeSet<String>>,
-    updates_tx: mpsc::UnboundedSender<NormalizedUpdate>,
+    tracked_controllers: Arc<BTreeSet<String>>,
+    updates_tx: mpsc::UnboundedSender<Vec<NormalizedUpdate>>,
 ) {
     thread::spawn(move || {
-        info!("spawning body CAN worker supervisor for iface='{iface}'");
+        info!("starting vehicle CAN decoder for iface='{iface}'");
         loop {
-            let exe = match std::env::current_exe() {
-                Ok(exe) => exe,
-                Err(e) => {
-                    warn!("failed to resolve dashboard executable for worker: {e}");
-                    thread::sleep(Duration::from_secs(1));
-                    continue;
-                }
-            };
-            let mut child = match Command::new(exe)
-                .arg("--body-worker")
-                .arg("--body-iface")
-                .arg(&iface)
-                .stdout(Stdio::piped())
-                .stderr(Stdio::inherit())
-                .spawn()
-            {
-                Ok(child) => child,
-                Err(e) => {
-                    warn!("failed to spawn body worker for {iface}: {e}");
-                    thread::sleep(Duration::from_secs(1));
-                    continue;
-                }
-            };
-
-            info!("body worker started for iface='{iface}'");
-            let Some(stdout) = child.stdout.take() else {
-                warn!("body worker stdout unavailable for iface='{iface}'");
-                let _ = child.kill();
-                thread::sleep(Duration::from_secs(1));
-                continue;
-            };
+            if let Err(error) = run_veh_decoder(&iface, &tracked_controllers, &updates_tx) {
+                warn!("vehicle CAN decoder for {iface} failed: {error:#}");
+            }
+            if updates_tx.is_closed() {
+                warn!("vehicle update channel closed; stopping decoder");
+                return;
+            }
+            thread::sleep(Duration::from_secs(1));
+        }
+    });
+}
 
-            let reader = BufReader::new(stdout);
-            for line in reader.lines() {
-                let line = match line {
-                    Ok(line) => line,
-                    Err(e) => {
-                        warn!("failed reading body worker output for {iface}: {e}");
-                        break;
+fn run_veh_decoder(
+    iface: &str,
+    tracked_controllers: &BTreeSet<String>,
+    updates_tx: &mpsc::UnboundedSender<Vec<NormalizedUpdate>>,
+) -> Result<()> {
+    let iface_map = [(iface, yamcan::Bus::Veh)];
+    let binding = yamcan::configure_iface(iface, &iface_map)
+        .map_err(|e| anyhow::anyhow!("failed to configure veh decoder for {iface}: {e}"))?;
+    let socket = open_raw_can_socket(iface).with_context(|| format!("failed to open {iface}"))?;
+    // Wake up on a quiet bus so that coalesced updates are not held back
+    set_socket_recv_timeout(&socket, UPDATE_COALESCE_INTERVAL)
+        .with_context(|| format!("failed to set receive timeout on {iface}"))?;
+    info!("listening on {iface} for vehicle dashboard updates");
+
+    // Messages of untracked controllers are decoded once, then skipped by ID
+    let mut ignored_ids = BTreeSet::new();
+    let mut pending: BTreeMap<String, NormalizedUpdate> = BTreeMap::new();
+    let mut window_started = Instant::now();
+    loop {
+        match recv_veh_frame(&socket) {
+            Ok((frame, id)) if !ignored_ids.contains(&id) => {
+                match decode_veh_frame(&binding, frame, id, tracked_controllers) {
+                    VehFrameUpdate::Update(update) => {
+                        if pending.is_empty() {
+                            window_started = Instant::now();
+                        }
+                        match pending.get_mut(&update.controller) {
+                            Some(existing) => existing.absorb(update),
+                            None => {
+                                pending.insert(update.controller.clone(), update);
+                            }
+                        }
                     }
-                };
-                if line.trim().is_empty() {
-                    continue;
-                }
-                let update: NormalizedUpdate = match serde_json::from_str(&line) {
-                    Ok(update) => update,
-                    Err(e) => {
-                        warn!("failed parsing body worker update for {iface}: {e}");
-                        continue;
+                    VehFrameUpdate::Untracked => {
+                        ignored_ids.insert(id);
                     }
-                };
-                if updates_tx.send(update).is_err() {
-                    warn!("body update channel closed; stopping worker supervisor");
-                    let _ = child.kill();
-                    return;
+                    VehFrameUpdate::None => {}
                 }
             }
+            Ok(_) => {}
+            Err(error)
+                if matches!(
+                    error.kind(),
+                    io::ErrorKind::WouldBlock | io::ErrorKind::TimedOut
+                ) => {}
+            Err(error) => return Err(error).with_context(|| format!("read error on {iface}")),
+        }
 
-            match child.wait() {
-                Ok(status) => warn!("body worker exited for {iface} with status {status}"),
-                Err(e) => warn!("failed waiting for body worker on {iface}: {e}"),
+        if !pending.is_empty() && window_started.elapsed() >= UPDATE_COALESCE_INTERVAL {
+            let updates = std::mem::take(&mut pending).into_values().collect();
+            if updates_tx.send(updates).is_err() {
+                return Ok(());
             }
-            thread::sleep(Duration::from_secs(1));
         }
-    });
+    }
+}
+
+enum VehFrameUpdate {
+    Update(NormalizedUpdate),
+    /// A message that no tracked controller sends.
+    Untracked,
+    None,
 }
 
 fn decode_veh_frame(
@@ -5371,8 +5586,14 @@ fn decode_veh_frame(
     frame: yamcan::CanFrame,
     id: u32,
     tracked_controllers: &BTreeSet<String>,
-) -> Option<NormalizedUpdate> {
-    let decoded = yamcan::maybe_decode(Some(binding), &frame, id, true, true, &[], &[])?;
+) -> VehFrameUpdate {
+    let Some(decoded) = yamcan::maybe_decode(Some(binding), &frame, id, true, true, &[], &[])
+    else {
+        return VehFrameUpdate::None;
+    };
+    if controller_key_for_message_name(&decoded.message_name, tracked_controllers).is_none() {
+        return VehFrameUpdate::Untracked;
+    }
     let seen_at_ms = now_ms();
     let members = decoded
         .members
@@ -5384,54 +5605,15 @@ fn decode_veh_frame(
             label: member.label,
         })
         .collect::<Vec<_>>();
-    normalize_update(
+    match normalize_update(
         &decoded.bus_name,
         decoded.message_name,
         members,
         tracked_controllers,
         seen_at_ms,
-    )
-}
-
-fn run_veh_worker(opts: &Opts) -> Result<()> {
-    let iface = opts.veh_iface.clone();
-    let iface_map = [(iface.as_str(), yamcan::Bus::Veh)];
-    let binding = yamcan::configure_iface(&iface, &iface_map)
-        .map_err(|e| anyhow::anyhow!("failed to configure veh decoder for {iface}: {e}"))?;
-    run_can_worker(&iface, "vehicle", &binding)
-}
-
-fn run_body_worker(opts: &Opts) -> Result<()> {
-    let iface = opts.body_iface.as_deref().unwrap_or("unknown");
-    Err(anyhow::anyhow!(
-        "body CAN worker is no longer supported (requested iface: {iface})"
-    ))
-}
-
-fn run_can_worker(
-    iface: &str,
-    bus_label: &str,
-    binding: &yamcan::BusBinding<yamcan::Bus>,
-) -> Result<()> {
-    let tracked_controllers = SUPPORTED_CONTROLLERS
-        .iter()
-        .map(|controller| controller.to_string())
-        .collect::<BTreeSet<_>>();
-    let socket = open_raw_can_socket(iface).with_context(|| format!("failed to open {iface}"))?;
-
-    info!("listening on {iface} for {bus_label} dashboard updates");
-    let stdout = io::stdout();
-    let mut writer = BufWriter::new(stdout.lock());
-
-    loop {
-        let (frame, id) =
-            recv_veh_frame(&socket).with_context(|| format!("read error on {iface}"))?;
-        let Some(update) = decode_veh_frame(binding, frame, id, &tracked_controllers) else {
-            continue;
-        };
-        serde_json::to_writer(&mut writer, &update).context("serializing worker update")?;
-        writer.write_all(b"\n").context("writing worker newline")?;
-        writer.flush().context("flushing worker update")?;
+    ) {
+        Some(update) => VehFrameUpdate::Update(update),
+        None => VehFrameUpdate::None,
     }
 }
 
@@ -5465,11 +5647,12 @@ fn normalize_update(
     })
 }
 
-fn build_signal_manifest() -> SignalManifestResponse {
-    let mut signals = yamcan::signal_descriptors()
-        .iter()
-        .map(|descriptor| SignalManifestEntry {
+fn build_signal_manifest(registry: &SignalRegistry) -> SignalManifestResponse {
+    let signals = registry
+        .descriptors()
+        .map(|(handle, descriptor)| SignalManifestEntry {
             id: descriptor.fqid.to_string(),
+            handle,
             bus: descriptor.bus.as_str().to_string(),
             message_name: descriptor.message_name.to_string(),
             message_id: descriptor.message_id,
@@ -5478,12 +5661,6 @@ fn build_signal_manifest() -> SignalManifestResponse {
             kind: map_signal_kind(descriptor.kind),
         })
         .collect::<Vec<_>>();
-    signals.sort_by(|a, b| {
-        a.bus
-            .cmp(&b.bus)
-            .then_with(|| a.message_name.cmp(&b.message_name))
-            .then_with(|| a.signal_name.cmp(&b.signal_name))
-    });
     SignalManifestResponse { signals }
 }
 
@@ -5495,40 +5672,13 @@ fn map_signal_kind(kind: yamcan::SignalKind) -> SignalPlotKind {
     }
 }
 
-fn sample_event_from_members(
-    bus_name: &str,
-    message_name: &str,
-    message_id: u32,
-    members: &[PlainMeasurement],
-    timestamp_ms: u64,
-) -> Option<SignalSampleEvent> {
-    let samples = members
-        .iter()
-        .map(|member| SignalSample {
-            signal_id: format!("{bus_name}/{message_name}/{}", member.name),
-            signal_name: member.name.clone(),
-            value: member.value,
-            label: member.label.clone(),
-            unit: member.unit.clone(),
-        })
-        .collect::<Vec<_>>();
-    if samples.is_empty() {
-        return None;
-    }
-
-    Some(SignalSampleEvent {
-        timestamp_ms,
-        bus: bus_name.to_string(),
-        message_name: message_name.to_string(),
-        message_id,
-        samples,
-    })
-}
-
 fn spawn_signal_broadcast_worker(
     iface: String,
     bus: yamcan::Bus,
-    signal_events: broadcast::Sender<Arc<SignalSampleBatch>>,
+    registry: Arc<SignalRegistry>,
+    signal_events: broadcast::Sender<Arc<RawSignalBatch>>,
+    signal_history: Arc<SignalHistory>,
+    signal_store: Arc<std::sync::Mutex<SignalStore>>,
 ) {
     thread::spawn(move || {
         info!("shared signal stream worker starting for iface='{iface}'");
@@ -5547,54 +5697,109 @@ fn spawn_signal_broadcast_worker(
                 return;
             }
         };
+        // Wake up on a quiet bus so that a partial batch is not held back
+        if let Err(error) = set_socket_recv_timeout(&socket, SIGNAL_BATCH_INTERVAL) {
+            warn!("failed to set signal stream receive timeout for {iface}: {error}");
+        }
+
+        // Seeded from the clock so that sequence numbers from before a
+        // restart are never mistaken for current ones when a client resumes
+        let mut seq = now_ms();
+        // With the history store on, every frame is decoded; otherwise only
+        // those with a subscribed signal
+        let store_all = signal_store
+            .lock()
+            .map(|store| store.is_enabled())
+            .unwrap_or(false);
+        let mut pending = Vec::new();
+        let mut stored = Vec::new();
+        let mut batch_started = Instant::now();
+        let mut last_report = Instant::now();
         loop {
-            let (frame, id) = match recv_veh_frame(&socket) {
-                Ok(frame) => frame,
+            match recv_veh_frame(&socket) {
+                Ok((frame, id)) => {
+                    if pending.is_empty() && stored.is_empty() {
+                        batch_started = Instant::now();
+                    }
+                    let timestamp_ms = now_ms();
+                    registry.decode_frame(
+                        &binding,
+                        &frame,
+                        id,
+                        store_all,
+                        |handle, value, subscribed| {
+                            let sample = RawSignalSample {
+                                handle,
+                                timestamp_ms,
+                                value,
+                            };
+                            if store_all {
+                                stored.push(sample);
+                            }
+                            if subscribed {
+                                pending.push(sample);
+                            }
+                        },
+                    );
+                }
+                Err(error)
+                    if matches!(
+                        error.kind(),
+                        io::ErrorKind::WouldBlock | io::ErrorKind::TimedOut
+                    ) => {}
                 Err(error) => {
                     warn!("signal stream read error on {iface}: {error}");
                     return;
                 }
-            };
-            if signal_events.receiver_count() == 0 {
-                continue;
             }
-            let Some(event) = decode_signal_frame(&binding, frame, id) else {
-                continue;
-            };
-            if signal_events.receiver_count() == 0 {
+
+            if batch_started.elapsed() < SIGNAL_BATCH_INTERVAL {
                 continue;
             }
-            let _ = signal_events.send(Arc::new(SignalSampleBatch {
-                events: vec![event],
-            }));
+            if !stored.is_empty() {
+                let mut store = signal_store
+                    .lock()
+                    .unwrap_or_else(|error| error.into_inner());
+                store.extend(&stored);
+                stored.clear();
+                if last_report.elapsed() >= SIGNAL_HISTORY_REPORT_INTERVAL {
+                    last_report = Instant::now();
+                    debug!(
+                        "signal store holds {} KiB since {:?}",
+                        store.memory_bytes() / 1024,
+                        store.oldest_ms()
+                    );
+                }
+            }
+            if !pending.is_empty() {
+                let samples = std::mem::replace(&mut pending, Vec::with_capacity(pending.len()));
+                seq += 1;
+                let batch = Arc::new(RawSignalBatch { seq, samples });
+                signal_history.push(Arc::clone(&batch));
+                let _ = signal_events.send(batch);
+            }
         }
     });
 }
 
-fn decode_signal_frame(
-    binding: &yamcan::BusBinding<yamcan::Bus>,
-    frame: yamcan::CanFrame,
-    id: u32,
-) -> Option<SignalSampleEvent> {
-    let decoded = yamcan::maybe_decode(Some(binding), &frame, id, true, true, &[], &[])?;
-    let members = decoded
-        .members
-        .into_iter()
-        .map(|member| PlainMeasurement {
-            name: member.name,
-            value: member.value,
-            unit: member.unit,
-            label: member.label,
-        })
-        .collect::<Vec<_>>();
-    let event = sample_event_from_members(
-        &decoded.bus_name,
-        &decoded.message_name,
-        decoded.message_id,
-        &members,
-        now_ms(),
-    )?;
-    Some(event)
+fn set_socket_recv_timeout(fd: &OwnedFd, timeout: Duration) -> io::Result<()> {
+    let tv = timeval {
+        tv_sec: timeout.as_secs() as _,
+        tv_usec: timeout.subsec_micros() as _,
+    };
+    let rc = unsafe {
+        libc::setsockopt(
+            fd.as_raw_fd(),
+            SOL_SOCKET,
+            SO_RCVTIMEO,
+            &tv as *const _ as *const c_void,
+            size_of::<timeval>() as socklen_t,
+        )
+    };
+    if rc != 0 {
+        return Err(io::Error::last_os_error());
+    }
+    Ok(())
 }
 
 fn open_raw_can_socket(iface: &str) -> io::Result<OwnedFd> {
@@ -5994,6 +6199,61 @@ mod tests {
         assert!(snapshot.controllers[0].faults.is_empty());
     }
 
+    #[test]
+    fn coalesced_update_keeps_latest_of_each_field() {
+        let mut update = NormalizedUpdate {
+            controller: "vcfront".to_string(),
+            seen_at_ms: 100,
+            active_faults: Some(Vec::new()),
+            critical_signals: None,
+        };
+        update.absorb(NormalizedUpdate {
+            controller: "vcfront".to_string(),
+            seen_at_ms: 200,
+            active_faults: None,
+            critical_signals: Some(Vec::new()),
+        });
+
+        assert_eq!(update.seen_at_ms, 200);
+        assert_eq!(update.active_faults, Some(Vec::new()));
+        assert_eq!(update.critical_signals, Some(Vec::new()));
+    }
+
+    #[test]
+    fn cached_snapshot_json_matches_serialized_snapshot() {
+        let names = ["bms".to_string(), "vcfront".to_string()];
+        let mut store = DashboardStore::new(&names, Duration::from_secs(3));
+        let base = Instant::now();
+        let first = store.unpublished_snapshot_json(base).unwrap().unwrap();
+        assert_eq!(
+            first.full,
+            serde_json::to_string(&store.snapshot(base)).unwrap()
+        );
+        assert!(store.unpublished_snapshot_json(base).unwrap().is_none());
+
+        store.apply_update(
+            NormalizedUpdate {
+                controller: "vcfront".to_string(),
+                seen_at_ms: 100,
+                active_faults: None,
+                critical_signals: None,
+            },
+            base,
+        );
+        for now in [base, base + Duration::from_secs(4)] {
+            let json = store.unpublished_snapshot_json(now).unwrap().unwrap();
+            let mut snapshot = store.snapshot(now);
+            assert_eq!(json.full, serde_json::to_string(&snapshot).unwrap());
+
+            let filter = BTreeSet::from(["vcfront".to_string()]);
+            snapshot.controllers.retain(|c| filter.contains(&c.name));
+            assert_eq!(
+                json.filtered(Some(&filter)),
+                serde_json::to_string(&snapshot).unwrap()
+            );
+        }
+    }
+
     #[test]
     fn default_session_options_include_safety_diagnostic() {
         let sessions = default_session_options();
@@ -6031,4 +6291,144 @@ mod tests {
             "abc-_.~%3D%3D".to_string()
         );
     }
+
+    #[test]
+    fn signal_decimator_keeps_window_extremes_in_time_order() {
+        let mut decimator = SignalDecimator::new(&[1, 2], 3);
+        assert!(decimator.flush_binary(7).is_none());
+
+        for (timestamp_ms, value) in [(1_001, 5.0), (1_002, 9.0), (1_003, 1.0), (1_004, 4.0)] {
+            decimator.push(&RawSignalSample {
+                handle: 1,
+                timestamp_ms,
+                value,
+            });
+        }
+        decimator.push(&RawSignalSample {
+            handle: 0,
+            timestamp_ms: 1_000,
+            value: 3.0,
+        });
+        decimator.push(&RawSignalSample {
+            handle: 2,
+            timestamp_ms: 1_001,
+            value: f64::NAN,
+        });
+
+        let frame = decimator.flush_binary(7).expect("frame");
+        assert_eq!(frame.len(), 24 + 4 * 8);
+        assert_eq!(frame[0], 1);
+        assert_eq!(u32::from_le_bytes(frame[4..8].try_into().unwrap()), 4);
+        assert_eq!(u64::from_le_bytes(frame[8..16].try_into().unwrap()), 7);
+        assert_eq!(u64::from_le_bytes(frame[16..24].try_into().unwrap()), 1_001);
+        let records = frame[24..]
+            .chunks_exact(8)
+            .map(|record| {
+                (
+                    u16::from_le_bytes([record[0], record[1]]),
+                    u16::from_le_bytes([record[2], record[3]]),
+                    f32::from_le_bytes(record[4..8].try_into().unwrap()),
+                )
+            })
+            .collect::<Vec<_>>();
+        assert_eq!(records[..3], [(1, 1, 9.0), (1, 2, 1.0), (1, 3, 4.0)]);
+        assert_eq!(records[3].0, 2);
+        assert!(records[3].2.is_nan());
+        assert!(decimator.flush_binary(8).is_none());
+    }
+
+    #[test]
+    fn signal_decimator_writes_json_points_for_captures() {
+        let mut decimator = SignalDecimator::new(&[4], 5);
+        decimator.push(&RawSignalSample {
+            handle: 4,
+            timestamp_ms: 10,
+            value: 2.5,
+        });
+        decimator.push(&RawSignalSample {
+            handle: 4,
+            timestamp_ms: 11,
+            value: f64::INFINITY,
+        });
+
+        assert_eq!(
+            decimator.flush_json(),
+            Some("{\"points\":[[4,10,2.5],[4,11,null]]}")
+        );
+    }
+
+    #[test]
+    fn signal_store_recycles_oldest_blocks_and_downsamples_ranges() {
+        let mut store = SignalStore::new(2, 64 * 1024);
+        for t in 0..100_000u64 {
+            store.push(&RawSignalSample {
+                handle: (t % 2) as u32,
+                timestamp_ms: t,
+                value: t as f64,
+            });
+        }
+        assert!(store.memory_bytes() <= 64 * 1024);
+        let oldest_ms = store.oldest_ms().expect("samples");
+        assert!(oldest_ms > 0);
+
+        let raw = store.query(1, 0, u64::MAX, MAX_HISTORY_POINTS);
+        assert_eq!(raw.last(), Some(&(99_999, 99_999.0)));
+        assert!(raw.windows(2).all(|pair| pair[0].0 < pair[1].0));
+
+        let downsampled = store.query(1, oldest_ms, 99_999, 20);
+        assert!(downsampled.len() <= 20);
+        assert_eq!(downsampled.last(), Some(&(99_999, 99_999.0)));
+        assert!(store.query(1, 200_000, 300_000, 20).is_empty());
+    }
+
+    #[test]
+    fn signal_store_keeps_the_newest_block_of_a_slow_signal() {
+        let mut store = SignalStore::new(2, 64 * 1024);
+        store.push(&RawSignalSample {
+            handle: 0,
+            timestamp_ms: 0,
+            value: 1.0,
+        });
+        for t in 1..100_000u64 {
+            store.push(&RawSignalSample {
+                handle: 1,
+                timestamp_ms: t,
+                value: t as f64,
+            });
+        }
+        assert!(store.memory_bytes() <= 64 * 1024);
+        assert_eq!(
+            store.query(0, 0, u64::MAX, MAX_HISTORY_POINTS),
+            vec![(0, 1.0)]
+        );
+        assert_eq!(store.oldest_ms(), Some(0));
+
+        // once the slow signal has a newer block, its older one can go
+        store.push(&RawSignalSample {
+            handle: 0,
+            timestamp_ms: 100_000,
+            value: 2.0,
+        });
+        for t in 100_001..200_000u64 {
+            store.push(&RawSignalSample {
+                handle: 1,
+                timestamp_ms: t,
+                value: t as f64,
+            });
+        }
+        assert_eq!(
+            store.query(0, 0, u64::MAX, MAX_HISTORY_POINTS),
+            vec![(100_000, 2.0)]
+        );
+        let fast = store.query(1, 0, u64::MAX, MAX_HISTORY_POINTS);
+        assert_eq!(fast.last(), Some(&(199_999, 199_999.0)));
+    }
+
+    #[test]
+    fn signal_window_is_clamped() {
+        assert_eq!(signal_window_ms(None), 40);
+        assert_eq!(signal_window_ms(Some(1_000.0)), 20);
+        assert_eq!(signal_window_ms(Some(0.1)), 1_000);
+        assert_eq!(signal_window_ms(Some(f64::NAN)), 40);
+    }
 }
@@ -0,0 +1,233 @@
+use std::collections::VecDeque;
+
+use crate::signal_stream::{RawSignalSample, SignalHandle};
+
+pub const DEFAULT_SIGNAL_HISTORY_MB: usize = 64;
+pub const DEFAULT_HISTORY_POINTS: usize = 1_000;
+pub const MAX_HISTORY_POINTS: usize = 10_000;
+const BLOCK_SAMPLES: usize = 512;
+const BLOCK_BYTES: usize = std::mem::size_of::<Block>()
+    + BLOCK_SAMPLES * (std::mem::size_of::<u16>() + std::mem::size_of::<f32>());
+
+/// Up to `BLOCK_SAMPLES` consecutive samples of one signal. Timestamps are
+/// stored as the delta from the previous sample, so a gap that does not fit
+/// in a `u16` (or a clock step backwards) starts a new block.
+struct Block {
+    signal: SignalHandle,
+    first_ms: u64,
+    last_ms: u64,
+    len: usize,
+    deltas: Box<[u16]>,
+    values: Box<[f32]>,
+}
+
+impl Block {
+    fn new(signal: SignalHandle, timestamp_ms: u64) -> Self {
+        Self {
+            signal,
+            first_ms: timestamp_ms,
+            last_ms: timestamp_ms,
+            len: 0,
+            deltas: vec![0; BLOCK_SAMPLES].into_boxed_slice(),
+            values: vec![0.0; BLOCK_SAMPLES].into_boxed_slice(),
+        }
+    }
+
+    fn reset(&mut self, signal: SignalHandle, timestamp_ms: u64) {
+        self.signal = signal;
+        self.first_ms = timestamp_ms;
+        self.last_ms = timestamp_ms;
+        self.len = 0;
+    }
+
+    fn try_push(&mut self, timestamp_ms: u64, value: f32) -> bool {
+        if self.len == BLOCK_SAMPLES || timestamp_ms < self.last_ms {
+            return false;
+        }
+        let Ok(delta) = u16::try_from(timestamp_ms - self.last_ms) else {
+            return false;
+        };
+        self.deltas[self.len] = delta;
+        self.values[self.len] = value;
+        self.len += 1;
+        self.last_ms = timestamp_ms;
+        true
+    }
+
+    fn samples(&self) -> impl Iterator<Item = (u64, f32)> + '_ {
+        let mut timestamp_ms = self.first_ms;
+        self.deltas[..self.len]
+            .iter()
+            .zip(&self.values[..self.len])
+            .map(move |(&delta, &value)| {
+                timestamp_ms += delta as u64;
+                (timestamp_ms, value)
+            })
+    }
+}
+
+#[derive(Clone, Copy)]
+struct Extreme {
+    t: u64,
+    v: f32,
+}
+
+/// Fixed-memory history of every decoded signal, so that a plot can show the
+/// recent past without a round-trip to InfluxDB.
+///
+/// Blocks are allocated on demand up to the memory budget. Once the budget is
+/// used up, the block whose newest sample is the oldest is recycled, so every
+/// signal keeps roughly the same time span regardless of its rate. A signal's
+/// newest block is only recycled when no signal has an older one to give up,
+/// so a slow signal keeps its latest samples next to fast ones.
+pub struct SignalStore {
+    blocks: Vec<Block>,
+    max_blocks: usize,
+    /// Block indices of each signal, oldest first.
+    by_signal: Vec<VecDeque<u32>>,
+}
+
+impl SignalStore {
+    pub fn new(signal_count: usize, budget_bytes: usize) -> Self {
+        Self {
+            blocks: Vec::new(),
+            max_blocks: budget_bytes / BLOCK_BYTES,
+            by_signal: vec![VecDeque::new(); signal_count],
+        }
+    }
+
+    pub fn is_enabled(&self) -> bool {
+        self.max_blocks > 0
+    }
+
+    pub fn memory_bytes(&self) -> usize {
+        self.blocks.len() * BLOCK_BYTES
+    }
+
+    /// Timestamp of the oldest sample still held, if any.
+    pub fn oldest_ms(&self) -> Option<u64> {
+        self.by_signal
+            .iter()
+            .filter_map(|blocks| blocks.front())
+            .map(|&block| self.blocks[block as usize].first_ms)
+            .min()
+    }
+
+    pub fn extend(&mut self, samples: &[RawSignalSample]) {
+        for sample in samples {
+            self.push(sample);
+        }
+    }
+
+    pub fn push(&mut self, sample: &RawSignalSample) {
+        let Some(blocks) = self.by_signal.get(sample.handle as usize) else {
+            return;
+        };
+        if !self.is_enabled() {
+            return;
+        }
+        let value = sample.value as f32;
+        if let Some(&block) = blocks.back() {
+            if self.blocks[block as usize].try_push(sample.timestamp_ms, value) {
+                return;
+            }
+        }
+        let block = self.allocate(sample.handle, sample.timestamp_ms);
+        self.blocks[block as usize].try_push(sample.timestamp_ms, value);
+    }
+
+    fn allocate(&mut self, signal: SignalHandle, timestamp_ms: u64) -> u32 {
+        let block = if self.blocks.len() < self.max_blocks {
+            self.blocks.push(Block::new(signal, timestamp_ms));
+            (self.blocks.len() - 1) as u32
+        } else {
+            let block = self.eviction_candidate();
+            let owner = self.blocks[block as usize].signal;
+            let evicted = self.by_signal[owner as usize].pop_front();
+            debug_assert_eq!(evicted, Some(block));
+            self.blocks[block as usize].reset(signal, timestamp_ms);
+            block
+        };
+        self.by_signal[signal as usize].push_back(block);
+        block
+    }
+
+    /// The oldest block of the signal whose oldest block ended first, passing
+    /// over signals that have a single block while any signal has more.
+    fn eviction_candidate(&self) -> u32 {
+        self.by_signal
+            .iter()
+            .filter_map(|blocks| Some((blocks.len() == 1, *blocks.front()?)))
+            .min_by_key(|&(only, block)| (only, self.blocks[block as usize].last_ms))
+            .map(|(_, block)| block)
+            .expect("store has blocks")
+    }
+
+    /// Samples of `handle` in `[from_ms, to_ms]`. If there are more than
+    /// `max_points`, the range is split into `max_points / 2` buckets and each
+    /// contributes its minimum and maximum in time order, so peaks survive.
+    /// Non-finite values are returned as NaN when not downsampled and are
+    /// skipped otherwise.
+    pub fn query(
+        &self,
+        handle: SignalHandle,
+        from_ms: u64,
+        to_ms: u64,
+        max_points: usize,
+    ) -> Vec<(u64, f32)> {
+        let Some(blocks) = self.by_signal.get(handle as usize) else {
+            return Vec::new();
+        };
+        if from_ms > to_ms {
+            return Vec::new();
+        }
+        let in_range = || {
+            blocks
+                .iter()
+                .map(|&block| &self.blocks[block as usize])
+                .filter(move |block| block.last_ms >= from_ms && block.first_ms <= to_ms)
+                .flat_map(Block::samples)
+                .filter(move |&(t, _)| t >= from_ms && t <= to_ms)
+        };
+
+        let count = in_range().count();
+        if count <= max_points {
+            return in_range()
+                .map(|(t, v)| (t, if v.is_finite() { v } else { f32::NAN }))
+                .collect();
+        }
+
+        let bucket_count = (max_points / 2).max(1) as u64;
+        let width = ((to_ms - from_ms) / bucket_count + 1).max(1);
+        let mut buckets: Vec<Option<(Extreme, Extreme)>> = vec![None; bucket_count as usize];
+        for (t, v) in in_range().filter(|(_, v)| v.is_finite()) {
+            let index = (((t - from_ms) / width) as usize).min(buckets.len() - 1);
+            let point = Extreme { t, v };
+            match &mut buckets[index] {
+                Some((min, max)) => {
+                    if v < min.v {
+                        *min = point;
+                    }
+                    if v > max.v {
+                        *max = point;
+                    }
+                }
+                bucket => *bucket = Some((point, point)),
+            }
+        }
+
+        let mut points = Vec::with_capacity(buckets.len() * 2);
+        for (min, max) in buckets.into_iter().flatten() {
+            let (first, second) = if min.t <= max.t {
+                (min, max)
+            } else {
+                (max, min)
+            };
+            points.push((first.t, first.v));
+            if second.t != first.t || second.v != first.v {
+                points.push((second.t, second.v));
+            }
+        }
+        points
+    }
+}
@@ -0,0 +1,499 @@
+use std::collections::{BTreeMap, VecDeque};
+use std::fmt::Write as _;
+use std::sync::atomic::{AtomicU32, Ordering};
+use std::sync::Arc;
+use std::time::Duration;
+
+use serde::Serialize;
+use yamcan_dashboard as yamcan;
+use yamcan_dashboard::NetworkBus;
+
+/// Index of a signal in the manifest; stable for the life of the process.
+pub type SignalHandle = u32;
+
+/// How long the CAN worker coalesces decoded samples before broadcasting.
+pub const SIGNAL_BATCH_INTERVAL: Duration = Duration::from_millis(20);
+/// How far back a reconnecting client can resume from.
+pub const SIGNAL_RESUME_WINDOW: Duration = Duration::from_secs(5);
+pub const DEFAULT_SIGNAL_RATE_HZ: f64 = 25.0;
+const MIN_SIGNAL_WINDOW_MS: u64 = 20;
+const MAX_SIGNAL_WINDOW_MS: u64 = 1_000;
+const NO_SLOT: u32 = u32::MAX;
+
+/// Binary sample frames start with a header of
+/// `[version: u8][0: u8; 3][count: u32][seq: u64][base_ms: u64]` followed by
+/// `count` records of `[handle: u16][delta_ms: u16][value: f32]`, all
+/// little-endian. `seq` is the last raw batch folded into the frame and is
+/// what a client passes back to resume; non-finite values are sent as NaN.
+pub const SIGNAL_WIRE_VERSION: u8 = 1;
+const SIGNAL_WIRE_HEADER_LEN: usize = 24;
+const SIGNAL_WIRE_RECORD_LEN: usize = 8;
+const MAX_WIRE_HANDLE: SignalHandle = u16::MAX as SignalHandle;
+
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct RawSignalSample {
+    pub handle: SignalHandle,
+    pub timestamp_ms: u64,
+    pub value: f64,
+}
+
+/// Samples of every subscribed signal decoded during one batch interval.
+#[derive(Debug, Clone, Default)]
+pub struct RawSignalBatch {
+    /// Increases by one per batch; see `SignalHistory`.
+    pub seq: u64,
+    pub samples: Vec<RawSignalSample>,
+}
+
+/// The most recent raw batches, kept so that a client that reconnects within
+/// `SIGNAL_RESUME_WINDOW` gets the samples it missed instead of a gap.
+pub struct SignalHistory {
+    batches: std::sync::Mutex<VecDeque<Arc<RawSignalBatch>>>,
+    capacity: usize,
+}
+
+impl Default for SignalHistory {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl SignalHistory {
+    pub fn new() -> Self {
+        let capacity =
+            (SIGNAL_RESUME_WINDOW.as_millis() / SIGNAL_BATCH_INTERVAL.as_millis()) as usize;
+        Self {
+            batches: std::sync::Mutex::new(VecDeque::with_capacity(capacity)),
+            capacity,
+        }
+    }
+
+    pub fn push(&self, batch: Arc<RawSignalBatch>) {
+        let mut batches = self
+            .batches
+            .lock()
+            .unwrap_or_else(|error| error.into_inner());
+        if batches.len() == self.capacity {
+            batches.pop_front();
+        }
+        batches.push_back(batch);
+    }
+
+    /// Batches after `seq`, or `None` if some of them are no longer held.
+    pub fn since(&self, seq: u64) -> Option<Vec<Arc<RawSignalBatch>>> {
+        let batches = self
+            .batches
+            .lock()
+            .unwrap_or_else(|error| error.into_inner());
+        let oldest = batches.front().map(|batch| batch.seq);
+        let newest = batches.back().map(|batch| batch.seq);
+        match (oldest, newest) {
+            (Some(oldest), Some(newest)) if seq + 1 >= oldest && seq <= newest => Some(
+                batches
+                    .iter()
+                    .filter(|batch| batch.seq > seq)
+                    .cloned()
+                    .collect(),
+            ),
+            _ => None,
+        }
+    }
+}
+
+struct SignalInfo {
+    descriptor: &'static yamcan::SignalDescriptor<yamcan::Bus>,
+    message: usize,
+    labels: BTreeMap<i32, &'static str>,
+}
+
+/// Interned signal handles plus reference counts of what browsers are
+/// subscribed to, so the CAN worker only decodes messages someone watches.
+pub struct SignalRegistry {
+    signals: Vec<SignalInfo>,
+    by_id: BTreeMap<&'static str, SignalHandle>,
+    messages: BTreeMap<(&'static str, u32), usize>,
+    message_signals: Vec<Vec<(&'static str, SignalHandle)>>,
+    signal_refs: Vec<AtomicU32>,
+    message_refs: Vec<AtomicU32>,
+}
+
+impl SignalRegistry {
+    pub fn new(
+        descriptors: &'static [yamcan::SignalDescriptor<yamcan::Bus>],
+        enum_values: &'static [yamcan::EnumValueDescriptor],
+    ) -> Self {
+        let mut sorted = descriptors.iter().collect::<Vec<_>>();
+        sorted.sort_by(|a, b| {
+            a.bus
+                .as_str()
+                .cmp(b.bus.as_str())
+                .then_with(|| a.message_name.cmp(b.message_name))
+                .then_with(|| a.signal_name.cmp(b.signal_name))
+        });
+
+        let mut signals = Vec::with_capacity(sorted.len());
+        let mut by_id = BTreeMap::new();
+        let mut messages = BTreeMap::new();
+        let mut message_signals: Vec<Vec<(&'static str, SignalHandle)>> = Vec::new();
+        for descriptor in sorted {
+            let handle = signals.len() as SignalHandle;
+            let message = *messages
+                .entry((descriptor.bus.as_str(), descriptor.message_id))
+                .or_insert_with(|| {
+                    message_signals.push(Vec::new());
+                    message_signals.len() - 1
+                });
+            message_signals[message].push((descriptor.signal_name, handle));
+            by_id.insert(descriptor.fqid, handle);
+            let labels = descriptor
+                .enum_name
+                .map(|enum_name| {
+                    enum_values
+                        .iter()
+                        .filter(|value| value.enum_name == enum_name)
+                        .map(|value| (value.raw, value.label))
+                        .collect()
+                })
+                .unwrap_or_default();
+            signals.push(SignalInfo {
+                descriptor,
+                message,
+                labels,
+            });
+        }
+
+        Self {
+            signal_refs: signals.iter().map(|_| AtomicU32::new(0)).collect(),
+            message_refs: message_signals.iter().map(|_| AtomicU32::new(0)).collect(),
+            signals,
+            by_id,
+            messages,
+            message_signals,
+        }
+    }
+
+    pub fn len(&self) -> usize {
+        self.signals.len()
+    }
+
+    /// Descriptors in handle order.
+    pub fn descriptors(
+        &self,
+    ) -> impl Iterator<Item = (SignalHandle, &'static yamcan::SignalDescriptor<yamcan::Bus>)> + '_
+    {
+        self.signals
+            .iter()
+            .enumerate()
+            .map(|(handle, info)| (handle as SignalHandle, info.descriptor))
+    }
+
+    pub fn handle_for_id(&self, id: &str) -> Option<SignalHandle> {
+        self.by_id.get(id).copied()
+    }
+
+    pub fn subscribe<'a>(
+        self: &Arc<Self>,
+        ids: impl IntoIterator<Item = &'a str>,
+    ) -> SignalSubscription {
+        let mut handles = ids
+            .into_iter()
+            .filter_map(|id| self.handle_for_id(id))
+            .filter(|&handle| handle <= MAX_WIRE_HANDLE)
+            .collect::<Vec<_>>();
+        handles.sort_unstable();
+        handles.dedup();
+        for &handle in &handles {
+            self.signal_refs[handle as usize].fetch_add(1, Ordering::Relaxed);
+            let message = self.signals[handle as usize].message;
+            self.message_refs[message].fetch_add(1, Ordering::Relaxed);
+        }
+        SignalSubscription {
+            registry: Arc::clone(self),
+            handles,
+        }
+    }
+
+    pub fn labels(&self, handle: SignalHandle) -> Option<&BTreeMap<i32, &'static str>> {
+        self.signals.get(handle as usize).map(|info| &info.labels)
+    }
+
+    /// Decode one frame and call `on_sample(handle, value, subscribed)` for
+    /// each of its signals. Unless `all` is set, a frame none of whose
+    /// signals is subscribed is skipped without being decoded.
+    pub fn decode_frame(
+        &self,
+        binding: &yamcan::BusBinding<yamcan::Bus>,
+        frame: &yamcan::CanFrame,
+        id: u32,
+        all: bool,
+        mut on_sample: impl FnMut(SignalHandle, f64, bool),
+    ) {
+        let Some(&message) = self.messages.get(&(binding.bus.as_str(), id)) else {
+            return;
+        };
+        if !all && self.message_refs[message].load(Ordering::Relaxed) == 0 {
+            return;
+        }
+        let Some(decoded) = yamcan::maybe_decode(Some(binding), frame, id, true, true, &[], &[])
+        else {
+            return;
+        };
+        for member in &decoded.members {
+            let Some(&(_, handle)) = self.message_signals[message]
+                .iter()
+                .find(|(name, _)| *name == member.name)
+            else {
+                continue;
+            };
+            let subscribed = self.signal_refs[handle as usize].load(Ordering::Relaxed) > 0;
+            on_sample(handle, member.value, subscribed);
+        }
+    }
+}
+
+#[derive(Serialize)]
+struct SubscribedSignal<'a> {
+    id: &'a str,
+    handle: SignalHandle,
+    #[serde(skip_serializing_if = "BTreeMap::is_empty")]
+    labels: &'a BTreeMap<i32, &'static str>,
+}
+
+#[derive(Serialize)]
+struct SubscriptionDescription<'a> {
+    version: u8,
+    window_ms: u64,
+    resumed: bool,
+    signals: Vec<SubscribedSignal<'a>>,
+}
+
+/// One client's set of signals; releases its references when dropped.
+pub struct SignalSubscription {
+    registry: Arc<SignalRegistry>,
+    handles: Vec<SignalHandle>,
+}
+
+impl SignalSubscription {
+    pub fn handles(&self) -> &[SignalHandle] {
+        &self.handles
+    }
+
+    /// Handle table sent to the client before any samples, so that sample
+    /// records can carry handles instead of signal IDs and labels. `resumed`
+    /// tells a reconnecting client whether the stream continues without a gap.
+    pub fn describe_json(&self, window_ms: u64, resumed: bool) -> String {
+        let description = SubscriptionDescription {
+            version: SIGNAL_WIRE_VERSION,
+            window_ms,
+            resumed,
+            signals: self
+                .handles
+                .iter()
+                .map(|&handle| {
+                    let info = &self.registry.signals[handle as usize];
+                    SubscribedSignal {
+                        id: info.descriptor.fqid,
+                        handle,
+                        labels: &info.labels,
+                    }
+                })
+                .collect(),
+        };
+        serde_json::to_string(&description).unwrap_or_else(|_| "{\"signals\":[]}".to_string())
+    }
+}
+
+impl Drop for SignalSubscription {
+    fn drop(&mut self) {
+        for &handle in &self.handles {
+            self.registry.signal_refs[handle as usize].fetch_sub(1, Ordering::Relaxed);
+            let message = self.registry.signals[handle as usize].message;
+            self.registry.message_refs[message].fetch_sub(1, Ordering::Relaxed);
+        }
+    }
+}
+
+/// Clamp a requested per-signal update rate to a decimation window.
+pub fn signal_window_ms(rate_hz: Option<f64>) -> u64 {
+    let rate_hz = rate_hz
+        .filter(|rate| rate.is_finite() && *rate > 0.0)
+        .unwrap_or(DEFAULT_SIGNAL_RATE_HZ);
+    ((1_000.0 / rate_hz) as u64).clamp(MIN_SIGNAL_WINDOW_MS, MAX_SIGNAL_WINDOW_MS)
+}
+
+#[derive(Debug, Clone, Copy)]
+struct Point {
+    t: u64,
+    v: f64,
+}
+
+#[derive(Debug, Clone, Copy, Default)]
+struct Bucket {
+    count: u32,
+    min: Option<Point>,
+    max: Option<Point>,
+    last: Option<Point>,
+}
+
+impl Bucket {
+    fn push(&mut self, point: Point) {
+        self.count += 1;
+        self.last = Some(point);
+        if point.v.is_nan() {
+            return;
+        }
+        if self.min.is_none_or(|min| point.v < min.v) {
+            self.min = Some(point);
+        }
+        if self.max.is_none_or(|max| point.v > max.v) {
+            self.max = Some(point);
+        }
+    }
+
+    /// The extremes and the final sample of the window in time order, so
+    /// that peaks survive decimation.
+    fn points(&self) -> impl Iterator<Item = Point> {
+        let mut points = [self.min, self.max, self.last];
+        points.sort_by_key(|point| point.map(|point| point.t));
+        let mut previous: Option<Point> = None;
+        points.into_iter().flatten().filter(move |point| {
+            let duplicate = previous.is_some_and(|prev| {
+                prev.t == point.t && (prev.v == point.v || (prev.v.is_nan() && point.v.is_nan()))
+            });
+            previous = Some(*point);
+            !duplicate
+        })
+    }
+}
+
+/// Per-client min/max/last reduction of the shared sample stream into one
+/// coalesced payload per window.
+pub struct SignalDecimator {
+    slot_by_handle: Vec<u32>,
+    buckets: Vec<Bucket>,
+    handles: Vec<SignalHandle>,
+    dirty: Vec<u32>,
+    points: Vec<(SignalHandle, Point)>,
+    out: Vec<u8>,
+    json: String,
+}
+
+impl SignalDecimator {
+    pub fn new(handles: &[SignalHandle], handle_count: usize) -> Self {
+        let mut slot_by_handle = vec![NO_SLOT; handle_count];
+        for (slot, &handle) in handles.iter().enumerate() {
+            if let Some(entry) = slot_by_handle.get_mut(handle as usize) {
+                *entry = slot as u32;
+            }
+        }
+        Self {
+            slot_by_handle,
+            buckets: vec![Bucket::default(); handles.len()],
+            handles: handles.to_vec(),
+            dirty: Vec::with_capacity(handles.len()),
+            points: Vec::new(),
+            out: Vec::new(),
+            json: String::new(),
+        }
+    }
+
+    pub fn push_batch(&mut self, batch: &RawSignalBatch) {
+        for sample in &batch.samples {
+            self.push(sample);
+        }
+    }
+
+    pub fn push(&mut self, sample: &RawSignalSample) {
+        let Some(&slot) = self.slot_by_handle.get(sample.handle as usize) else {
+            return;
+        };
+        if slot == NO_SLOT {
+            return;
+        }
+        let bucket = &mut self.buckets[slot as usize];
+        if bucket.count == 0 {
+            self.dirty.push(slot);
+        }
+        bucket.push(Point {
+            t: sample.timestamp_ms,
+            v: sample.value,
+        });
+    }
+
+    /// Move the reduced points of every signal that saw samples since the
+    /// last flush into `self.points`, returning false if none did.
+    fn drain(&mut self) -> bool {
+        if self.dirty.is_empty() {
+            return false;
+        }
+        self.dirty.sort_unstable();
+        self.points.clear();
+        for &slot in &self.dirty {
+            let bucket = std::mem::take(&mut self.buckets[slot as usize]);
+            let handle = self.handles[slot as usize];
+            self.points
+                .extend(bucket.points().map(|point| (handle, point)));
+        }
+        self.dirty.clear();
+        true
+    }
+
+    /// Encode the window as one binary frame tagged with `seq`, or return
+    /// `None` if no subscribed signal saw samples.
+    pub fn flush_binary(&mut self, seq: u64) -> Option<&[u8]> {
+        if !self.drain() {
+            return None;
+        }
+        let base_ms = self
+            .points
+            .iter()
+            .map(|(_, point)| point.t)
+            .min()
+            .unwrap_or(0);
+        self.out.clear();
+        self.out
+            .reserve(SIGNAL_WIRE_HEADER_LEN + self.points.len() * SIGNAL_WIRE_RECORD_LEN);
+        self.out.push(SIGNAL_WIRE_VERSION);
+        self.out.extend_from_slice(&[0; 3]);
+        self.out
+            .extend_from_slice(&(self.points.len() as u32).to_le_bytes());
+        self.out.extend_from_slice(&seq.to_le_bytes());
+        self.out.extend_from_slice(&base_ms.to_le_bytes());
+        for &(handle, point) in &self.points {
+            let delta_ms = (point.t - base_ms).min(u16::MAX as u64) as u16;
+            let value = if point.v.is_finite() {
+                point.v as f32
+            } else {
+                f32::NAN
+            };
+            self.out.extend_from_slice(&(handle as u16).to_le_bytes());
+            self.out.extend_from_slice(&delta_ms.to_le_bytes());
+            self.out.extend_from_slice(&value.to_le_bytes());
+        }
+        Some(&self.out)
+    }
+    /// `{"points":[[handle,timestamp_ms,value],...]}` for the window, with
+    /// non-finite values as `null`, or `None` if no subscribed signal saw
+    /// samples.
+    pub fn flush_json(&mut self) -> Option<&str> {
+        if !self.drain() {
+            return None;
+        }
+        self.json.clear();
+        self.json.push_str("{\"points\":[");
+        for (index, &(handle, point)) in self.points.iter().enumerate() {
+            if index > 0 {
+                self.json.push(',');
+            }
+            let _ = write!(self.json, "[{handle},{},", point.t);
+            if point.v.is_finite() {
+                let _ = write!(self.json, "{}", point.v);
+            } else {
+                self.json.push_str("null");
+            }
+            self.json.push(']');
+        }
+        self.json.push_str("]}");
+        Some(&self.json)
+    }
+}
@@ -1,29 +1,125 @@
 const MAX_CACHE_MS = 30 * 60 * 1000;
+const RECONNECT_DELAY_MS = 1000;
+
+// Binary sample frames from `/signal-socket`: a 24-byte header
+// [version u8][pad u8 x3][count u32][seq u64][base_ms u64] followed by
+// `count` records of [handle u16][delta_ms u16][value f32], little-endian.
+const SIGNAL_WIRE_VERSION = 1;
+const SIGNAL_WIRE_HEADER_BYTES = 24;
+const SIGNAL_WIRE_RECORD_BYTES = 8;
 
 const clients = new Map();
 
+// Time/value columns for one signal. Old points are trimmed by advancing
+// `start`; the arrays are compacted or grown only when the end is reached.
+class SignalSeries {
+  constructor() {
+    this.t = new Float64Array(256);
+    this.v = new Float32Array(256);
+    this.start = 0;
+    this.end = 0;
+  }
+
+  push(t, v) {
+    if (this.end === this.t.length) {
+      this.reserve();
+    }
+    this.t[this.end] = t;
+    this.v[this.end] = v;
+    this.end += 1;
+  }
+
+  reserve() {
+    const length = this.end - this.start;
+    const capacity = length * 2 > this.t.length ? this.t.length * 2 : this.t.length;
+    const t = new Float64Array(capacity);
+    const v = new Float32Array(capacity);
+    t.set(this.t.subarray(this.start, this.end));
+    v.set(this.v.subarray(this.start, this.end));
+    this.t = t;
+    this.v = v;
+    this.start = 0;
+    this.end = length;
+  }
+
+  trim(cutoff) {
+    while (this.start < this.end && this.t[this.start] < cutoff) {
+      this.start += 1;
+    }
+  }
+
+  points(labels) {
+    const points = [];
+    for (let index = this.start; index < this.end; index += 1) {
+      points.push(signalPoint(labels, this.t[index], this.v[index]));
+    }
+    return points;
+  }
+}
+
 function ensureClient(clientId) {
   if (!clients.has(clientId)) {
     clients.set(clientId, {
       ports: new Set(),
       subscriptions: new Set(),
       history: new Map(),
-      eventSource: null,
+      labels: new Map(),
+      socket: null,
+      lastSeq: null,
       paused: false,
     });
   }
   return clients.get(clientId);
 }
 
-function trimPoints(points) {
-  const cutoff = Date.now() - MAX_CACHE_MS;
-  let trimCount = 0;
-  while (trimCount < points.length && points[trimCount].t < cutoff) {
-    trimCount += 1;
+// Maps the handles in binary sample frames to signal IDs and enum labels.
+function signalHandleTable(description) {
+  const handles = new Map();
+  for (const signal of description.signals || []) {
+    handles.set(signal.handle, { signalId: signal.id, labels: signal.labels || {} });
   }
-  if (trimCount > 0) {
-    points.splice(0, trimCount);
+  return handles;
+}
+
+function signalPoint(labels, t, v) {
+  if (Number.isNaN(v)) {
+    return { t, v: null, label: null };
   }
+  return { t, v, label: labels[v] || null };
+}
+
+// Calls `onPoint(signal, t, v)` for every record of a known handle and
+// returns the frame's resume sequence number, or null for a frame that
+// cannot be decoded.
+function decodeSignalFrame(buffer, handles, onPoint) {
+  if (buffer.byteLength < SIGNAL_WIRE_HEADER_BYTES) {
+    return null;
+  }
+  const view = new DataView(buffer);
+  if (view.getUint8(0) !== SIGNAL_WIRE_VERSION) {
+    return null;
+  }
+  const count = Math.min(
+    view.getUint32(4, true),
+    Math.floor((buffer.byteLength - SIGNAL_WIRE_HEADER_BYTES) / SIGNAL_WIRE_RECORD_BYTES),
+  );
+  const seq = view.getBigUint64(8, true);
+  const baseMs = Number(view.getBigUint64(16, true));
+  for (let index = 0; index < count; index += 1) {
+    const offset = SIGNAL_WIRE_HEADER_BYTES + index * SIGNAL_WIRE_RECORD_BYTES;
+    const signal = handles.get(view.getUint16(offset, true));
+    if (!signal) {
+      continue;
+    }
+    onPoint(signal, baseMs + view.getUint16(offset + 2, true), view.getFloat32(offset + 4, true));
+  }
+  return seq;
+}
+
+function signalSocketUrl(signals, resumeSeq) {
+  const protocol = self.location.protocol === "https:" ? "wss:" : "ws:";
+  const resume = resumeSeq === null ? "" : `&resume=${resumeSeq}`;
+  return `${protocol}//${self.location.host}/signal-socket?signals=${encodeURIComponent(signals)}${resume}`;
 }
 
 function postToClient(clientId, message) {
@@ -39,67 +135,73 @@ function postToClient(clientId, message) {
   });
 }
 
-function updateStream(clientId) {
-  const client = ensureClient(clientId);
-  if (client.eventSource) {
-    client.eventSource.close();
-    client.eventSource = null;
+function closeStream(client) {
+  if (client.socket) {
+    client.socket.onclose = null;
+    client.socket.close();
+    client.socket = null;
   }
+}
+
+// Opens the stream for the client's current selection. `resumeSeq` is only
+// passed when reconnecting with an unchanged selection, so the server can
+// replay the frames missed in between.
+function updateStream(clientId, resumeSeq = null) {
+  const client = ensureClient(clientId);
+  closeStream(client);
+  client.lastSeq = resumeSeq;
 
   if (client.paused || client.subscriptions.size === 0) {
     return;
   }
 
   const signals = Array.from(client.subscriptions).sort().join(",");
-  const source = new EventSource(`/signal-events?signals=${encodeURIComponent(signals)}`);
-  source.addEventListener("signal-sample", (event) => {
-    let payload = null;
-    try {
-      payload = JSON.parse(event.data);
-    } catch (_error) {
+  const socket = new WebSocket(signalSocketUrl(signals, resumeSeq));
+  socket.binaryType = "arraybuffer";
+  let handles = new Map();
+  socket.onmessage = (event) => {
+    if (typeof event.data === "string") {
+      try {
+        handles = signalHandleTable(JSON.parse(event.data));
+      } catch (_error) {
+        handles = new Map();
+      }
+      for (const signal of handles.values()) {
+        client.labels.set(signal.signalId, signal.labels);
+      }
       return;
     }
-    const filteredEvents = [];
-    for (const signalEvent of payload.events || []) {
-      const filteredSamples = [];
-      for (const sample of signalEvent.samples || []) {
-        if (!client.subscriptions.has(sample.signal_id)) {
-          continue;
-        }
-        const points = client.history.get(sample.signal_id) || [];
-        points.push({
-          t: signalEvent.timestamp_ms,
-          v: sample.value,
-          label: sample.label || null,
-        });
-        trimPoints(points);
-        client.history.set(sample.signal_id, points);
-        filteredSamples.push(sample);
+    const cutoff = Date.now() - MAX_CACHE_MS;
+    const points = [];
+    const seq = decodeSignalFrame(event.data, handles, (signal, t, v) => {
+      if (!client.subscriptions.has(signal.signalId)) {
+        return;
       }
-      if (filteredSamples.length) {
-        filteredEvents.push({
-          ...signalEvent,
-          samples: filteredSamples,
-        });
+      let series = client.history.get(signal.signalId);
+      if (!series) {
+        series = new SignalSeries();
+        client.history.set(signal.signalId, series);
       }
+      series.push(t, v);
+      series.trim(cutoff);
+      points.push({ signalId: signal.signalId, ...signalPoint(signal.labels, t, v) });
+    });
+    if (seq !== null) {
+      client.lastSeq = seq;
     }
-    if (filteredEvents.length) {
-      postToClient(clientId, { type: "signal-batch", payload: { events: filteredEvents } });
+    if (points.length) {
+      postToClient(clientId, { type: "signal-batch", payload: { points } });
     }
-  });
-  source.onerror = () => {
-    try {
-      source.close();
-    } catch (_error) {
-    }
-    client.eventSource = null;
+  };
+  socket.onclose = () => {
+    client.socket = null;
     setTimeout(() => {
-      if (clients.has(clientId)) {
-        updateStream(clientId);
+      if (clients.has(clientId) && !client.socket) {
+        updateStream(clientId, client.lastSeq);
       }
-    }, 1000);
+    }, RECONNECT_DELAY_MS);
   };
-  client.eventSource = source;
+  client.socket = socket;
 }
 
 function snapshotForClient(clientId, signalIds) {
@@ -108,10 +210,13 @@ function snapshotForClient(clientId, signalIds) {
     ? signalIds
     : Array.from(client.subscriptions);
   return {
-    signals: selected.map((signalId) => ({
-      signalId,
-      points: (client.history.get(signalId) || []).slice(),
-    })),
+    signals: selected.map((signalId) => {
+      const series = client.history.get(signalId);
+      return {
+        signalId,
+        points: series ? series.points(client.labels.get(signalId) || {}) : [],
+      };
+    }),
   };
 }
 
@@ -154,9 +259,8 @@ onconnect = (connectEvent) => {
 
     if (data.type === "disconnect") {
       client.ports.delete(port);
-      if (client.ports.size === 0 && client.eventSource) {
-        client.eventSource.close();
-        client.eventSource = null;
+      if (client.ports.size === 0) {
+        closeStream(client);
       }
     }
   };
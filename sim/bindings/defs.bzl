@@ -87,7 +87,10 @@ _RIG_RUNTIME_MODULE_SRCS = {
     "system": ["//sim/bindings/firmware/runtime:system.c"],
     "time": ["//sim/bindings/firmware/runtime:time.c"],
     "timer": ["//sim/bindings/firmware/timer:timer.c"],
-    "timer_capture": ["//sim/bindings/firmware/timer:timer_capture.c"],
+    "timer_capture": [
+        "//sim/bindings/firmware/timer:timer_capture.c",
+        "//components/shared/code:libs/lib_edgeSpeed.c",
+    ],
     "uart": ["//sim/bindings/firmware/uart:uart.c"],
 }
 
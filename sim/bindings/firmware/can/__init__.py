@@ -2,6 +2,7 @@ from .can import (
     CanBusDescriptor,
     CanEnumNamespace,
     CanEvent,
+    CanFrameBatch,
     CanInterface,
     CanMessageDescriptor,
     CanPacket,
@@ -20,6 +21,7 @@ __all__ = [
     "CanBusDescriptor",
     "CanEnumNamespace",
     "CanEvent",
+    "CanFrameBatch",
     "CanInterface",
     "CanMessageDescriptor",
     "CanPacket",
@@ -1,5 +1,6 @@
 #include "can.h"
 
+#include "runtime.h"
 #include "runtime_state.h"
 
 #include "CAN/CAN.h"
@@ -33,6 +34,7 @@ HW_StatusTypeDef_E HW_CAN_sendMsgOnPeripheral(CAN_bus_E bus, CAN_TxMessage_T msg
     packet.data[5] = msg.data.u8[5];
     packet.data[6] = msg.data.u8[6];
     packet.data[7] = msg.data.u8[7];
+    rig_runtime_mark_activity();
     return rig_runtime_can_push_tx((uint8_t)bus, &packet) ? HW_OK : HW_ERROR;
 }
 
@@ -44,6 +46,7 @@ void HW_CAN_activateFifoNotifications(CAN_bus_E bus, CAN_RxFifo_E rxFifo)
 
 void rig_runtime_can_notify_rx(uint8_t bus)
 {
+    rig_runtime_mark_activity();
 #if FEATURE_IS_ENABLED(FEATURE_CANRX_SWI)
     CANRX_notify((CAN_bus_E)bus, CAN_RX_FIFO_0);
 #else
@@ -284,6 +284,29 @@ class RoutedCanEvent:
     event: CanEvent
 
 
+class CanRecordRing(ctypes.Structure):
+    """Location of a source bus's record ring inside the cluster runtime."""
+
+    _fields_ = [
+        ("frames", ctypes.c_void_p),
+        ("capacity", ctypes.c_uint32),
+        ("written", ctypes.c_uint64),
+    ]
+
+
+@dataclass(frozen=True)
+class CanFrameBatch:
+    """Frames a node sent on one bus after a cursor.
+
+    ``cursor`` continues the read on the next call. ``dropped`` counts the
+    frames that were overwritten in the ring before they could be read.
+    """
+
+    events: tuple[CanEvent, ...]
+    cursor: int
+    dropped: int = 0
+
+
 @dataclass
 class PeriodicCanMessage:
     message: CanMessageDescriptor
@@ -456,10 +479,10 @@ class CanInterface:
         if cluster is not None and node_name is not None:
             return cluster.comm.can.latest_bus_event(node_name, bus_descriptor)
 
-        latest = None
-        while self.tx_count(bus_descriptor):
-            latest = self.recv(bus_descriptor)
-        return latest
+        events = self._model._can_recv_events(
+            bus_descriptor, self.tx_count(bus_descriptor)
+        )
+        return events[-1] if events else None
 
     def latest(
         self,
@@ -499,6 +522,36 @@ class CanInterface:
             return None
         return getattr(decoded, signal)
 
+    def trace_signal(
+        self,
+        recorder,
+        message: str | CanMessageDescriptor,
+        signal: str,
+        *,
+        bus: int | str | CanBusDescriptor | None = None,
+        name: str | None = None,
+    ) -> None:
+        """Record ``signal`` of this node's latest ``message`` on ``recorder``.
+
+        Samples read NaN until the message has been sent.
+        """
+        descriptor = self._tx_message_descriptor(message, bus=bus)
+        descriptor.signal(signal)
+        cluster = self._model._cluster_rig
+        node_name = self._model._cluster_node_name
+        if cluster is None or node_name is None:
+            raise RuntimeError("CAN signal traces require a clustered model")
+        recorder.add_channel(
+            name or f"{node_name}.{descriptor.name}.{signal}",
+            cluster.runtime.add_trace_can_signal(
+                node_name,
+                descriptor.bus,
+                descriptor.id,
+                signal,
+                decoder=self._model._function_address(self._model._decode_can_signal),
+            ),
+        )
+
     def run_until_signal_eq(
         self,
         message: str | CanMessageDescriptor,
@@ -1,8 +1,11 @@
+use std::cell::UnsafeCell;
 use std::collections::{HashMap, VecDeque};
 use std::ffi::{CStr, CString};
+use std::mem::MaybeUninit;
 use std::os::raw::c_char;
 use std::ptr;
 use std::sync::Arc;
+use std::sync::atomic::{AtomicU8, AtomicU32, Ordering};
 use std::sync::{LazyLock, Mutex};
 
 use super::algorithms;
@@ -15,6 +18,7 @@ use super::interfaces::{InterfaceCaller, InterfaceDataflow, InterfaceEndpoint, I
 use super::registry::{InterfaceRoute, RuntimeInterfaces};
 use super::runtime::RigRuntime;
 use super::scheduler;
+use super::trace::TraceSource;
 
 pub(super) type ClusterCanTxCountFn = unsafe extern "C" fn(u8) -> u32;
 pub(super) type ClusterCanRecvEventsFn = unsafe extern "C" fn(u8, *mut CanEvent, u32) -> u32;
@@ -669,9 +673,69 @@ impl InterfaceEndpoint for CanEndpoint {
     }
 }
 
+/// Frames of each source bus the cluster keeps for observation.
+pub const CAN_RECORD_CAPACITY: usize = 4096;
+
+/// Recent frames of one source bus in a fixed ring, plus the latest frame of
+/// every message ID however long ago it was sent.
 struct CanRecordStream {
     source_node: u32,
-    records: VecDeque<CanEvent>,
+    frames: Box<[CanEvent]>,
+    /// Frames recorded since the stream was created; the next one is written
+    /// at `written % CAN_RECORD_CAPACITY`.
+    written: u64,
+    latest: HashMap<u32, CanEvent>,
+}
+
+impl CanRecordStream {
+    fn new(source_node: u32) -> Self {
+        Self {
+            source_node,
+            frames: vec![CanEvent::default(); CAN_RECORD_CAPACITY].into_boxed_slice(),
+            written: 0,
+            latest: HashMap::new(),
+        }
+    }
+
+    fn push(&mut self, event: CanEvent) {
+        self.frames[self.written as usize % CAN_RECORD_CAPACITY] = event;
+        self.written += 1;
+        self.latest.insert(event.packet.id, event);
+    }
+
+    fn last(&self) -> Option<CanEvent> {
+        let index = self.written.checked_sub(1)?;
+        Some(self.frames[index as usize % CAN_RECORD_CAPACITY])
+    }
+}
+
+/// Read-only view of a source bus's record ring for observers such as tests.
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct CanRecordRing {
+    pub frames: *const CanEvent,
+    pub capacity: u32,
+    pub written: u64,
+}
+
+impl Default for CanRecordRing {
+    fn default() -> Self {
+        Self {
+            frames: ptr::null(),
+            capacity: 0,
+            written: 0,
+        }
+    }
+}
+
+/// A traced signal, decoded from the latest frame of its message at each sample.
+pub(super) struct CanTraceSignal {
+    pub(super) source_node: u32,
+    pub(super) bus: u8,
+    pub(super) message_id: u32,
+    pub(super) signal_name: CString,
+    /// Decoder exported by the source node, which owns the DBC.
+    pub(super) decoder: CanSignalDecoderFn,
 }
 
 /// CAN packet runtime interface: bus fanout, source-only records, and latest-message lookup.
@@ -684,6 +748,10 @@ pub(super) struct CanInterface {
     records: Vec<CanRecordStream>,
     signal_wakes: Vec<CanSignalWakeRegistration>,
     signal_wake_indexes: HashMap<CanSignalWakeKey, Vec<usize>>,
+    /// Reused by every fanout so that a batch moves without allocating.
+    fanout_events: Vec<CanEvent>,
+    fanout_packets: Vec<CanPacket>,
+    trace_signals: Vec<CanTraceSignal>,
 }
 
 impl InterfaceImplementation for CanInterface {
@@ -693,6 +761,7 @@ impl InterfaceImplementation for CanInterface {
         self.native_source_events.clear();
         self.record_indexes.clear();
         self.records.clear();
+        self.trace_signals.clear();
         self.signal_wake_indexes.clear();
         for registration in &mut self.signal_wakes {
             registration.last_timestamp_ns.fill(0);
@@ -835,10 +904,7 @@ impl CanInterface {
     fn ensure_record_stream(&mut self, source_node: u32, endpoint: CanEndpoint) -> usize {
         let key = (source_node, endpoint);
         *self.record_indexes.entry(key).or_insert_with(|| {
-            self.records.push(CanRecordStream {
-                source_node,
-                records: VecDeque::new(),
-            });
+            self.records.push(CanRecordStream::new(source_node));
             self.records.len() - 1
         })
     }
@@ -846,18 +912,27 @@ impl CanInterface {
     pub(super) fn record(&mut self, source_node: u32, bus: u8, event: CanEvent) -> Vec<DataflowEdgeKey> {
         let endpoint = CanEndpoint::new(bus);
         let stream_index = self.ensure_record_stream(source_node, endpoint);
-        self.record_at(stream_index, event)
+        let mut ready_edges = Vec::new();
+        self.record_at(stream_index, event, &mut ready_edges);
+        ready_edges
     }
 
-    pub(super) fn record_at(&mut self, stream_index: usize, event: CanEvent) -> Vec<DataflowEdgeKey> {
-        self.records[stream_index].records.push_back(event);
+    pub(super) fn record_at(
+        &mut self,
+        stream_index: usize,
+        event: CanEvent,
+        ready_edges: &mut Vec<DataflowEdgeKey>,
+    ) {
+        self.records[stream_index].push(event);
+        if self.signal_wake_indexes.is_empty() {
+            return;
+        }
         let source_node = self.records[stream_index].source_node;
-        let mut ready_edges = Vec::new();
         let Some(registration_indexes) =
             self.signal_wake_indexes
                 .get(&(source_node, event.bus, event.packet.id))
         else {
-            return ready_edges;
+            return;
         };
         for &registration_index in registration_indexes {
             let registration = &mut self.signal_wakes[registration_index];
@@ -878,7 +953,6 @@ impl CanInterface {
             registration.pending_events.push_back(event);
             ready_edges.push(registration.edge(registration_index));
         }
-        ready_edges
     }
 
     pub(super) fn register_signal_wake(
@@ -1060,9 +1134,11 @@ impl CanInterface {
                 input_pending_nodes.push(sink.sink_node);
             }
         }
+        let mut ready_edges = Vec::new();
+        self.record_at(record_index, event, &mut ready_edges);
         CanRouteResult {
             input_pending_nodes,
-            ready_edges: self.record_at(record_index, event),
+            ready_edges,
         }
     }
 
@@ -1078,64 +1154,63 @@ impl CanInterface {
             && unsafe { (group.source_tx_count)(group.endpoint.bus()) } != 0
     }
 
+    /// Drains a source bus in one batch: the frames are read straight into a
+    /// reused buffer, handed to every sink with one call each, and recorded.
     pub(super) fn route_fanout(
         &mut self,
         group_index: usize,
         mut source_online: impl FnMut(u32) -> bool,
-    ) -> Option<CanRouteResult> {
+        result: &mut CanRouteResult,
+    ) -> bool {
         let Some(group) = self.fanouts.get(group_index) else {
-            return None;
+            return false;
         };
         let source_node = group.source_node;
         let source_bus = group.endpoint.bus();
         let record_index = group.record_index;
         let source_tx_count = group.source_tx_count;
         let source_recv_events = group.source_recv_events;
-        let sink_count = group.sinks.len();
 
         if !source_online(source_node) {
-            return None;
+            return false;
         }
 
         let pending = unsafe { source_tx_count(source_bus) };
         if pending == 0 {
-            return None;
+            return false;
         }
 
-        let mut events = vec![CanEvent::default(); pending as usize];
+        let mut events = std::mem::take(&mut self.fanout_events);
+        events.resize(pending as usize, CanEvent::default());
         let count = unsafe { source_recv_events(source_bus, events.as_mut_ptr(), pending) };
-        let count = count.min(pending) as usize;
-        if count == 0 {
-            return None;
+        events.truncate(count.min(pending) as usize);
+        if events.is_empty() {
+            self.fanout_events = events;
+            return false;
         }
-        events.truncate(count);
 
-        let packets: Vec<_> = events.iter().map(|event| event.packet).collect();
-        let mut input_pending_nodes = Vec::new();
-        if !packets.is_empty() {
-            for sink_index in 0..sink_count {
-                let sink = self.fanouts[group_index].sinks[sink_index];
-                let accepted = unsafe {
-                    (sink.sink_send_many)(
-                        sink.sink_bus,
-                        packets.as_ptr(),
-                        packets.len().min(u32::MAX as usize) as u32,
-                    )
-                };
-                if accepted > 0 {
-                    input_pending_nodes.push(sink.sink_node);
-                }
+        let mut packets = std::mem::take(&mut self.fanout_packets);
+        packets.clear();
+        packets.extend(events.iter().map(|event| event.packet));
+        for sink in &self.fanouts[group_index].sinks {
+            let accepted = unsafe {
+                (sink.sink_send_many)(sink.sink_bus, packets.as_ptr(), packets.len() as u32)
+            };
+            if accepted > 0 {
+                result.input_pending_nodes.push(sink.sink_node);
             }
         }
+        self.fanout_packets = packets;
 
-        let mut ready_edges = Vec::new();
-        for event in events {
-            ready_edges.extend(self.record_at(record_index, event));
+        for &event in &events {
+            self.record_at(record_index, event, &mut result.ready_edges);
         }
-        Some(CanRouteResult {
-            input_pending_nodes,
-            ready_edges,
-        })
+        self.fanout_events = events;
+        true
+    }
+
+    pub(super) fn fanout_source_node(&self, group_index: usize) -> Option<u32> {
+        self.fanouts.get(group_index).map(|group| group.source_node)
     }
 
     pub(super) fn latest_message(
@@ -1148,12 +1223,7 @@ impl CanInterface {
             .record_indexes
             .get(&(source_node, CanEndpoint::new(bus)))
             .copied()?;
-        self.records[stream_index]
-            .records
-            .iter()
-            .rev()
-            .find(|event| event.packet.id == message_id)
-            .copied()
+        self.records[stream_index].latest.get(&message_id).copied()
     }
 
     pub(super) fn latest_bus_event(&self, source_node: u32, bus: u8) -> Option<CanEvent> {
@@ -1161,7 +1231,51 @@ impl CanInterface {
             .record_indexes
             .get(&(source_node, CanEndpoint::new(bus)))
             .copied()?;
-        self.records[stream_index].records.back().copied()
+        self.records[stream_index].last()
+    }
+
+    /// The record ring of a source bus. The pointer stays valid until the
+    /// interface is reset.
+    pub(super) fn record_ring(&self, source_node: u32, bus: u8) -> Option<CanRecordRing> {
+        let stream_index = self
+            .record_indexes
+            .get(&(source_node, CanEndpoint::new(bus)))
+            .copied()?;
+        let stream = &self.records[stream_index];
+        Some(CanRecordRing {
+            frames: stream.frames.as_ptr(),
+            capacity: CAN_RECORD_CAPACITY as u32,
+            written: stream.written,
+        })
+    }
+}
+
+impl CanInterface {
+    /// Register a traced signal and return its backend trace key.
+    pub(super) fn add_trace_signal(&mut self, signal: CanTraceSignal) -> u64 {
+        self.trace_signals.push(signal);
+        (self.trace_signals.len() - 1) as u64
+    }
+
+    /// NaN until the message has been sent or when the signal does not decode.
+    pub(super) fn sample_trace_signal(&self, key: u64) -> f64 {
+        let Some(signal) = self.trace_signals.get(key as usize) else {
+            return f64::NAN;
+        };
+        let Some(event) = self.latest_message(signal.source_node, signal.bus, signal.message_id)
+        else {
+            return f64::NAN;
+        };
+        let mut value = f64::NAN;
+        let decoded = unsafe {
+            (signal.decoder)(
+                signal.bus,
+                &event.packet as *const CanPacket,
+                signal.signal_name.as_ptr(),
+                &mut value,
+            )
+        };
+        if decoded { value } else { f64::NAN }
     }
 }
 
@@ -1255,14 +1369,21 @@ impl DataflowAlgorithmExecutor for CanSignalWakeAlgorithm {
 }
 
 fn run_can_fanout(runtime: &mut RigRuntime<FirmwareBackend>, group_index: usize) -> bool {
-    let online_nodes = runtime.online_nodes();
-    let Some(result) = runtime
+    let Some(source_node) = runtime.interfaces.can.fanout_source_node(group_index) else {
+        return false;
+    };
+    let source_online = runtime.node_online(source_node);
+    let mut result = CanRouteResult {
+        input_pending_nodes: Vec::new(),
+        ready_edges: Vec::new(),
+    };
+    if !runtime
         .interfaces
         .can
-        .route_fanout(group_index, |node| online_node(&online_nodes, node))
-    else {
+        .route_fanout(group_index, |_| source_online, &mut result)
+    {
         return false;
-    };
+    }
     for edge in result.ready_edges {
         scheduler::mark_dataflow_edge_ready(runtime, edge);
     }
@@ -1316,97 +1437,103 @@ impl DataflowAlgorithmExecutor for NativeCanSourceAlgorithm {
     }
 }
 
-fn online_node(online_nodes: &[bool], node: u32) -> bool {
-    online_nodes.get(node as usize).copied().unwrap_or(false)
-}
+/// Frames a node buffers per bus and direction, like a controller's hardware
+/// FIFO. A full ring rejects frames the way a full mailbox would.
+pub const CAN_RING_CAPACITY: usize = 512;
+/// Most buses a node's CAN network may configure.
+pub const MAX_CAN_BUSES: usize = 8;
 
-#[derive(Default)]
-struct CanRuntime {
-    rx: Vec<VecDeque<CanPacket>>,
-    tx: Vec<VecDeque<CanEvent>>,
-    network: Option<CanNetwork>,
+const _: () = assert!(CAN_RING_CAPACITY.is_power_of_two());
+
+/// Single-producer, single-consumer frame ring between a node and the runtime.
+///
+/// The firmware is the only producer of TX frames and the cluster fanout the
+/// only consumer; RX is the reverse. Each call moves a whole batch and
+/// publishes it with one atomic store, so frames cross without a lock.
+struct CanRing<T> {
+    slots: [UnsafeCell<MaybeUninit<T>>; CAN_RING_CAPACITY],
+    /// Frames consumed since the last reset; wraps with `tail`.
+    head: AtomicU32,
+    /// Frames published since the last reset.
+    tail: AtomicU32,
 }
 
-impl CanRuntime {
-    fn configure(&mut self, bus_count: u8) {
-        self.rx = vec![VecDeque::new(); bus_count as usize];
-        self.tx = vec![VecDeque::new(); bus_count as usize];
+// Slots between `head` and `tail` belong to the consumer and the rest to the
+// producer; the release/acquire pair on the indexes hands them over.
+unsafe impl<T: Copy + Send> Sync for CanRing<T> {}
+
+impl<T: Copy> CanRing<T> {
+    const fn new() -> Self {
+        Self {
+            slots: [const { UnsafeCell::new(MaybeUninit::uninit()) }; CAN_RING_CAPACITY],
+            head: AtomicU32::new(0),
+            tail: AtomicU32::new(0),
+        }
     }
 
-    fn reset(&mut self) {
-        self.rx.clear();
-        self.tx.clear();
-        self.network = None;
+    fn len(&self) -> u32 {
+        let head = self.head.load(Ordering::Acquire);
+        self.tail.load(Ordering::Acquire).wrapping_sub(head)
     }
 
-    fn bus_count(&self) -> u8 {
-        self.rx.len() as u8
+    fn clear(&self) {
+        self.head
+            .store(self.tail.load(Ordering::Acquire), Ordering::Release);
     }
 
-    fn push_rx(&mut self, bus: u8, packet: CanPacket) -> bool {
-        self.rx
-            .get_mut(bus as usize)
-            .map(|queue| queue.push_back(packet))
-            .is_some()
+    fn slot(&self, index: u32) -> *mut MaybeUninit<T> {
+        self.slots[index as usize % CAN_RING_CAPACITY].get()
     }
 
-    fn push_rx_many(&mut self, bus: u8, packets: &[CanPacket]) -> u32 {
-        let Some(queue) = self.rx.get_mut(bus as usize) else {
-            return 0;
-        };
-        let count = packets.len().min(u32::MAX as usize);
-        queue.extend(packets.iter().copied().take(count));
+    fn push_many(&self, items: &[T]) -> u32 {
+        let tail = self.tail.load(Ordering::Relaxed);
+        let used = tail.wrapping_sub(self.head.load(Ordering::Acquire));
+        let free = CAN_RING_CAPACITY - used as usize;
+        let count = items.len().min(free);
+        for (offset, item) in items[..count].iter().enumerate() {
+            unsafe { (*self.slot(tail.wrapping_add(offset as u32))).write(*item) };
+        }
+        self.tail
+            .store(tail.wrapping_add(count as u32), Ordering::Release);
         count as u32
     }
 
-    fn pop_rx(&mut self, bus: u8) -> Option<CanPacket> {
-        self.rx.get_mut(bus as usize).and_then(VecDeque::pop_front)
+    fn pop_many(&self, out: &mut [T]) -> u32 {
+        let head = self.head.load(Ordering::Relaxed);
+        let ready = self.tail.load(Ordering::Acquire).wrapping_sub(head);
+        let count = out.len().min(ready as usize);
+        for (offset, slot) in out[..count].iter_mut().enumerate() {
+            *slot = unsafe { (*self.slot(head.wrapping_add(offset as u32))).assume_init() };
+        }
+        self.head
+            .store(head.wrapping_add(count as u32), Ordering::Release);
+        count as u32
     }
+}
 
-    fn push_tx(&mut self, bus: u8, packet: CanPacket, timestamp_ns: u64) -> bool {
-        self.tx
-            .get_mut(bus as usize)
-            .map(|queue| {
-                queue.push_back(CanEvent {
-                    bus,
-                    timestamp_ns,
-                    packet,
-                })
-            })
-            .is_some()
+impl<T: Copy + Default> CanRing<T> {
+    fn pop(&self) -> Option<T> {
+        let mut item = [T::default()];
+        (self.pop_many(&mut item) == 1).then_some(item[0])
     }
+}
 
-    fn pop_tx(&mut self, bus: u8) -> Option<CanEvent> {
-        self.tx.get_mut(bus as usize).and_then(VecDeque::pop_front)
-    }
+struct CanBusRings {
+    rx: CanRing<CanPacket>,
+    tx: CanRing<CanEvent>,
+}
 
-    fn pop_tx_many(&mut self, bus: u8, out: &mut [CanEvent]) -> u32 {
-        let Some(queue) = self.tx.get_mut(bus as usize) else {
-            return 0;
-        };
-        let mut count = 0;
-        for slot in out.iter_mut() {
-            let Some(event) = queue.pop_front() else {
-                break;
-            };
-            *slot = event;
-            count += 1;
+impl CanBusRings {
+    const fn new() -> Self {
+        Self {
+            rx: CanRing::new(),
+            tx: CanRing::new(),
         }
-        count
-    }
-
-    fn rx_count(&self, bus: u8) -> u32 {
-        self.rx
-            .get(bus as usize)
-            .map(VecDeque::len)
-            .unwrap_or_default() as u32
     }
 
-    fn tx_count(&self, bus: u8) -> u32 {
-        self.tx
-            .get(bus as usize)
-            .map(VecDeque::len)
-            .unwrap_or_default() as u32
+    fn clear(&self) {
+        self.rx.clear();
+        self.tx.clear();
     }
 }
 
@@ -1481,38 +1608,45 @@ pub struct CanNetwork {
     pub encode_signal: CanEncodeSignalFn,
 }
 
-static CAN_RUNTIME: LazyLock<Mutex<CanRuntime>> =
-    LazyLock::new(|| Mutex::new(CanRuntime::default()));
+static CAN_BUSES: [CanBusRings; MAX_CAN_BUSES] = [const { CanBusRings::new() }; MAX_CAN_BUSES];
+static CAN_BUS_COUNT: AtomicU8 = AtomicU8::new(0);
+static CAN_NETWORK: Mutex<Option<CanNetwork>> = Mutex::new(None);
+
+fn bus_rings(bus: u8) -> Option<&'static CanBusRings> {
+    (bus < CAN_BUS_COUNT.load(Ordering::Acquire)).then(|| &CAN_BUSES[bus as usize])
+}
 
 pub fn configure(bus_count: u8) {
-    CAN_RUNTIME.lock().unwrap().configure(bus_count);
+    assert!(
+        bus_count as usize <= MAX_CAN_BUSES,
+        "CAN network has {bus_count} buses, at most {MAX_CAN_BUSES} are supported"
+    );
+    for rings in &CAN_BUSES {
+        rings.clear();
+    }
+    CAN_BUS_COUNT.store(bus_count, Ordering::Release);
 }
 
 pub fn configure_network(network: CanNetwork) {
-    let mut runtime = CAN_RUNTIME.lock().unwrap();
-    runtime.configure((network.bus_count)());
-    runtime.network = Some(network);
+    configure((network.bus_count)());
+    *CAN_NETWORK.lock().unwrap() = Some(network);
 }
 
 pub fn reset() {
-    CAN_RUNTIME.lock().unwrap().reset();
+    configure(0);
+    *CAN_NETWORK.lock().unwrap() = None;
 }
 
 pub fn bus_count() -> u8 {
-    CAN_RUNTIME.lock().unwrap().bus_count()
+    CAN_BUS_COUNT.load(Ordering::Acquire)
 }
 
 pub fn send(bus: u8, packet: &CanPacket) -> bool {
-    if CAN_RUNTIME.lock().unwrap().push_rx(bus, *packet) {
-        unsafe { rig_runtime_can_notify_rx(bus) };
-        true
-    } else {
-        false
-    }
+    send_many(bus, std::slice::from_ref(packet)) == 1
 }
 
 pub fn send_many(bus: u8, packets: &[CanPacket]) -> u32 {
-    let count = CAN_RUNTIME.lock().unwrap().push_rx_many(bus, packets);
+    let count = bus_rings(bus).map_or(0, |rings| rings.rx.push_many(packets));
     if count > 0 {
         unsafe { rig_runtime_can_notify_rx(bus) };
     }
@@ -1670,11 +1804,11 @@ impl DataflowAlgorithmExecutor for PeriodicCanSourceAlgorithm {
 }
 
 pub fn recv_event(bus: u8) -> Option<CanEvent> {
-    CAN_RUNTIME.lock().unwrap().pop_tx(bus)
+    bus_rings(bus).and_then(|rings| rings.tx.pop())
 }
 
 pub fn recv_events(bus: u8, out: &mut [CanEvent]) -> u32 {
-    CAN_RUNTIME.lock().unwrap().pop_tx_many(bus, out)
+    bus_rings(bus).map_or(0, |rings| rings.tx.pop_many(out))
 }
 
 pub fn recv(bus: u8) -> Option<CanPacket> {
@@ -1682,20 +1816,16 @@ pub fn recv(bus: u8) -> Option<CanPacket> {
 }
 
 pub fn rx_count(bus: u8) -> u32 {
-    CAN_RUNTIME.lock().unwrap().rx_count(bus)
+    bus_rings(bus).map_or(0, |rings| rings.rx.len())
 }
 
 pub fn tx_count(bus: u8) -> u32 {
-    CAN_RUNTIME.lock().unwrap().tx_count(bus)
+    bus_rings(bus).map_or(0, |rings| rings.tx.len())
 }
 
 fn with_network<T>(default: T, f: impl FnOnce(CanNetwork) -> T) -> T {
-    CAN_RUNTIME
-        .lock()
-        .unwrap()
-        .network
-        .map(f)
-        .unwrap_or(default)
+    let network = *CAN_NETWORK.lock().unwrap();
+    network.map(f).unwrap_or(default)
 }
 
 pub fn codegen_bus_count() -> u8 {
@@ -2154,7 +2284,7 @@ pub extern "C" fn rig_runtime_can_pop_rx(bus: u8, packet: *mut CanPacket) -> boo
         return false;
     }
 
-    match CAN_RUNTIME.lock().unwrap().pop_rx(bus) {
+    match bus_rings(bus).and_then(|rings| rings.rx.pop()) {
         Some(next) => {
             unsafe { *packet = next };
             true
@@ -2168,11 +2298,15 @@ pub extern "C" fn rig_runtime_can_push_tx(bus: u8, packet: *const CanPacket) ->
     if packet.is_null() {
         return false;
     }
-    let timestamp_ns = unsafe { rig_runtime_get_time_ns() };
-    CAN_RUNTIME
-        .lock()
-        .unwrap()
-        .push_tx(bus, unsafe { *packet }, timestamp_ns)
+    let Some(rings) = bus_rings(bus) else {
+        return false;
+    };
+    let event = CanEvent {
+        bus,
+        timestamp_ns: unsafe { rig_runtime_get_time_ns() },
+        packet: unsafe { *packet },
+    };
+    rings.tx.push_many(std::slice::from_ref(&event)) == 1
 }
 
 #[unsafe(no_mangle)]
@@ -2423,6 +2557,23 @@ pub extern "C" fn rig_cluster_latest_can_bus_event(
     true
 }
 
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_cluster_can_record_ring(
+    source_node: u32,
+    bus: u8,
+    out: *mut CanRecordRing,
+) -> bool {
+    if out.is_null() {
+        return false;
+    }
+    let ring = with_runtime(|runtime| runtime.interfaces.can_record_ring(source_node, bus));
+    let Some(ring) = ring else {
+        return false;
+    };
+    unsafe { *out = ring };
+    true
+}
+
 #[unsafe(no_mangle)]
 pub extern "C" fn rig_cluster_latest_can_signal(
     source_node: u32,
@@ -2456,6 +2607,33 @@ pub extern "C" fn rig_cluster_latest_can_signal(
     true
 }
 
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_cluster_trace_add_can_signal(
+    source_node: u32,
+    bus: u8,
+    message_id: u32,
+    signal_name: *const c_char,
+    decoder: usize,
+) -> u32 {
+    if signal_name.is_null() || decoder == 0 {
+        return u32::MAX;
+    }
+    let signal_name = unsafe { CStr::from_ptr(signal_name) }.to_owned();
+    let decoder = unsafe { std::mem::transmute::<usize, CanSignalDecoderFn>(decoder) };
+    with_runtime(|runtime| {
+        let key = runtime.interfaces.add_can_trace_signal(CanTraceSignal {
+            source_node,
+            bus,
+            message_id,
+            signal_name,
+            decoder,
+        });
+        runtime
+            .add_trace_channel(TraceSource::Backend { key })
+            .unwrap_or(u32::MAX)
+    })
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -2535,6 +2713,98 @@ mod tests {
         assert!(interface.signal_wakes[1].pending_events.is_empty());
     }
 
+    #[test]
+    fn node_rings_move_batches_and_reject_frames_when_full() {
+        configure(2);
+        let packet = |id| CanPacket::new(id, [id as u8; 8], 8);
+        let packets: Vec<_> = (0..CAN_RING_CAPACITY as u32 + 10).map(packet).collect();
+
+        assert_eq!(send_many(1, &packets), CAN_RING_CAPACITY as u32);
+        assert!(!send(1, &packet(0)));
+        assert_eq!(send_many(2, &packets), 0);
+        assert_eq!(rx_count(1), CAN_RING_CAPACITY as u32);
+
+        // Drain part of the ring so that the next batch wraps around its end.
+        let mut drained = [CanPacket::default(); 100];
+        assert_eq!(CAN_BUSES[1].rx.pop_many(&mut drained), 100);
+        assert_eq!(drained[99], packet(99));
+        assert_eq!(send_many(1, &packets[..150]), 100);
+        let mut rest = vec![CanPacket::default(); CAN_RING_CAPACITY + 1];
+        assert_eq!(
+            CAN_BUSES[1].rx.pop_many(&mut rest),
+            CAN_RING_CAPACITY as u32
+        );
+        assert_eq!(rest[0], packet(100));
+        assert_eq!(rest[CAN_RING_CAPACITY - 1], packet(99));
+        assert_eq!(rx_count(1), 0);
+
+        assert!(rig_runtime_can_push_tx(0, &packet(7)));
+        assert_eq!(tx_count(0), 1);
+        reset();
+        assert_eq!(bus_count(), 0);
+        assert_eq!(tx_count(0), 0);
+        assert!(recv_event(0).is_none());
+    }
+
+    #[test]
+    fn record_ring_keeps_recent_frames_and_the_latest_of_every_message() {
+        let mut interface = CanInterface::default();
+        let event = |timestamp_ns, id| CanEvent {
+            bus: 0,
+            timestamp_ns,
+            packet: CanPacket::new(id, [0; 8], 0),
+        };
+        interface.record(1, 0, event(1, 0x100));
+        for timestamp_ns in 2..CAN_RECORD_CAPACITY as u64 + 10 {
+            interface.record(1, 0, event(timestamp_ns, 0x200));
+        }
+
+        let ring = interface.record_ring(1, 0).unwrap();
+        assert_eq!(ring.written, CAN_RECORD_CAPACITY as u64 + 9);
+        let frames = unsafe { std::slice::from_raw_parts(ring.frames, CAN_RECORD_CAPACITY) };
+        let last = (ring.written - 1) as usize % CAN_RECORD_CAPACITY;
+        assert_eq!(frames[last].timestamp_ns, ring.written);
+        assert!(frames.iter().all(|frame| frame.packet.id == 0x200));
+        assert_eq!(interface.latest_message(1, 0, 0x100), Some(event(1, 0x100)));
+        assert_eq!(interface.latest_bus_event(1, 0), Some(frames[last]));
+        assert!(interface.record_ring(2, 0).is_none());
+    }
+
+    unsafe extern "C" fn first_byte_decode(
+        _bus: u8,
+        packet: *const CanPacket,
+        _signal_name: *const c_char,
+        value: *mut f64,
+    ) -> bool {
+        unsafe { *value = f64::from((*packet).data[0]) };
+        true
+    }
+
+    #[test]
+    fn traced_signals_decode_the_latest_frame_of_their_message() {
+        let mut interface = CanInterface::default();
+        let key = interface.add_trace_signal(CanTraceSignal {
+            source_node: 1,
+            bus: 0,
+            message_id: 0x100,
+            signal_name: CString::new("Value").unwrap(),
+            decoder: first_byte_decode,
+        });
+        assert!(interface.sample_trace_signal(key).is_nan());
+
+        for (timestamp_ns, value) in [(1, 4), (2, 9)] {
+            let event = CanEvent {
+                bus: 0,
+                timestamp_ns,
+                packet: CanPacket::new(0x100, [value, 0, 0, 0, 0, 0, 0, 0], 1),
+            };
+            interface.record(1, 0, event);
+        }
+
+        assert_eq!(interface.sample_trace_signal(key), 9.0);
+        assert!(interface.sample_trace_signal(key + 1).is_nan());
+    }
+
     unsafe extern "C" fn wait_node_run_for(_elapsed_ns: u64) {}
     unsafe extern "C" fn wait_node_reset() {}
     unsafe extern "C" fn wait_decode(
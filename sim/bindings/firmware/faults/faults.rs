@@ -13,5 +13,10 @@ macro_rules! rig_model_fault_abi {
         pub extern "C" fn rig_model_get_fault(fault: i32) -> bool {
             $crate::rig_runtime::faults::get(fault)
         }
+
+        #[unsafe(no_mangle)]
+        pub extern "C" fn rig_model_trace_fault(fault: u64) -> f64 {
+            f64::from(u8::from($crate::rig_runtime::faults::get(fault as i32)))
+        }
     };
 }
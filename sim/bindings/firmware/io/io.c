@@ -1,5 +1,6 @@
 #include "io.h"
 
+#include "runtime.h"
 #include "runtime_state.h"
 
 #include "HW.h"
@@ -15,6 +16,10 @@ void rig_runtime_set_analog_input(drv_inputAD_channelAnalog_E channel, float32_t
 {
     if (channel < DRV_INPUTAD_ANALOG_COUNT)
     {
+        if (rig_runtime_analog_inputs[channel] != voltage)
+        {
+            rig_runtime_mark_activity();
+        }
         rig_runtime_analog_inputs[channel] = voltage;
     }
 
@@ -50,6 +55,10 @@ void rig_runtime_set_digital_io(HW_GPIO_pinmux_E channel, bool state)
 {
     if (channel < HW_GPIO_COUNT)
     {
+        if (rig_runtime.gpio[channel] != state)
+        {
+            rig_runtime_mark_activity();
+        }
         rig_runtime.gpio[channel] = state;
     }
 }
@@ -73,6 +82,21 @@ void HW_ADC_unpackADCBuffer(void)
 {
 }
 
+float32_t HW_ADC_getVFromCount(uint16_t cnt)
+{
+    return ((float32_t)cnt) * (((float32_t)ADC_REF_VOLTAGE) / ((float32_t)ADC_MAX_COUNT));
+}
+
+uint16_t HW_ADC_getLatestCountFromBank2Channel(HW_adcChannels_bank2_E channel, uint8_t samples)
+{
+    (void)samples;
+
+    const float32_t volts = (channel < ADC_BANK2_CHANNEL_COUNT) ? rig_runtime.bank2[channel] : 0.0f;
+    const float32_t count = (volts * (float32_t)ADC_MAX_COUNT) / (float32_t)ADC_REF_VOLTAGE;
+
+    return (count <= 0.0f) ? 0U : (count >= (float32_t)ADC_MAX_COUNT) ? ADC_MAX_COUNT : (uint16_t)count;
+}
+
 float32_t HW_ADC_getVFromBank1Channel(HW_adcChannels_bank1_E channel)
 {
     return (channel < ADC_BANK1_CHANNEL_COUNT) ? rig_runtime.bank1[channel] : 0.0f;
@@ -40,3 +40,15 @@ pub extern "C" fn rig_model_set_digital_io(channel: i32, state: bool) {
 pub extern "C" fn rig_model_get_digital_io(channel: i32) -> bool {
     get_digital(channel)
 }
+
+/// Trace sampler for an analog input; `channel` is the trace channel context.
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_model_trace_analog_input(channel: u64) -> f64 {
+    f64::from(get_analog_input(channel as i32))
+}
+
+/// Trace sampler for a digital I/O; `channel` is the trace channel context.
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_model_trace_digital_io(channel: u64) -> f64 {
+    f64::from(u8::from(get_digital(channel as i32)))
+}
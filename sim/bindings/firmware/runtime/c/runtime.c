@@ -1,6 +1,7 @@
 #include "runtime.h"
 
 #include "runtime_state.h"
+#include "swi.h"
 
 #include "CAN/CAN.h"
 #include "lib_nvm.h"
@@ -15,11 +16,19 @@ RTOS_swiHandle_T    * CANRX_swi;
 RTOS_swiHandle_T    * CANTX_swi;
 RTOS_swiHandle_T    * NVM_swi;
 
+// only linked in by nodes built with the timer_capture runtime module
+void rig_runtime_timer_capture_reset(void) __attribute__((weak));
+
 void rig_runtime_reset(void)
 {
     memset(&rig_runtime,            0x00, sizeof(rig_runtime));
     memset(rig_runtime_swi_handles, 0x00, sizeof(rig_runtime_swi_handles));
     memset(rig_runtime_swi_count,   0x00, sizeof(rig_runtime_swi_count));
+    rig_runtime_swi_reset();
+    if (rig_runtime_timer_capture_reset != NULL)
+    {
+        rig_runtime_timer_capture_reset();
+    }
     CANRX_swi = NULL;
     CANTX_swi = NULL;
     NVM_swi   = NULL;
@@ -30,3 +39,17 @@ void rig_runtime_reset(void)
     CANTX_swi = SWI_create(RTOS_SWI_PRI_0, &CANTX_SWI);
 #endif
 }
+
+/**
+ * @brief Count an observable input or output change. The controller compares
+ *        this count around a task tick to tell whether the firmware is quiet.
+ */
+void rig_runtime_mark_activity(void)
+{
+    rig_runtime.activity++;
+}
+
+uint32_t rig_runtime_activity(void)
+{
+    return rig_runtime.activity;
+}
@@ -5,3 +5,5 @@
 void     rig_runtime_reset(void);
 void     rig_runtime_advance_time_ns(uint64_t elapsed_ns);
 uint64_t rig_runtime_get_time_ns(void);
+void     rig_runtime_mark_activity(void);
+uint32_t rig_runtime_activity(void);
@@ -14,6 +14,7 @@ typedef struct
     float32_t bank2[ADC_BANK2_CHANNEL_COUNT];
     bool      gpio[HW_GPIO_COUNT];
     uint64_t  time_ns;
+    uint32_t  activity;
 } rig_runtime_state_S;
 
 extern rig_runtime_state_S rig_runtime;
@@ -1,10 +1,77 @@
 #include "runtime_state.h"
 #include "swi.h"
 
+#include <string.h>
+
+extern uint32_t HW_getCycleCount(void);
+
+// SWIs run on the caller's stack, but only when SWIs are enabled and no SWI
+// of the same or a higher priority is already running, as the firmware's SWI
+// tasks would be scheduled. Invocations that arrive in the meantime stay
+// pending, are coalesced with later ones, and run once that is over.
+static uint32_t        pending[RTOS_SWI_PRI_COUNT];
+static int8_t          runningPriority = -1;
+static uint8_t         disabledDepth;
+static RTOS_swiStats_S stats[RTOS_SWI_STATS_COUNT];
+static uint8_t         statsCount;
+
+static void runPending(void)
+{
+    if (disabledDepth != 0U)
+    {
+        return;
+    }
+
+    for (int8_t priority = (int8_t)RTOS_SWI_PRI_COUNT - 1; priority > runningPriority; priority--)
+    {
+        if (pending[priority] == 0U)
+        {
+            continue;
+        }
+
+        uint32_t events = pending[priority];
+        pending[priority] = 0U;
+
+        const int8_t interrupted = runningPriority;
+        runningPriority = priority;
+        while (events != 0U)
+        {
+            const uint32_t    index = 31UL - u32CountLeadingZeroes(events);
+            RTOS_swiHandle_T* swi   = &rig_runtime_swi_handles[priority][index];
+            events &= ~(1UL << index);
+
+            if (swi->handler != NULL)
+            {
+                uint32_t       pendingSince = 0U;
+                const bool     served       = SWI_statsTakePending(swi->stats, &pendingSince);
+                const uint32_t start        = HW_getCycleCount();
+                swi->handler();
+                if (served)
+                {
+                    SWI_statsRan(swi->stats, pendingSince, start, HW_getCycleCount());
+                }
+            }
+        }
+        runningPriority = interrupted;
+
+        // the handlers may have invoked SWIs of any priority above the interrupted one
+        priority = (int8_t)RTOS_SWI_PRI_COUNT;
+    }
+}
+
 void RTOS_SWI_Init(void)
 {
 }
 
+void rig_runtime_swi_reset(void)
+{
+    memset(pending, 0x00, sizeof(pending));
+    memset(stats,   0x00, sizeof(stats));
+    runningPriority = -1;
+    disabledDepth   = 0U;
+    statsCount      = 0U;
+}
+
 RTOS_swiHandle_T* SWI_create(RTOS_swiPri_E priority, RTOS_swiFn_t handler)
 {
     if ((priority >= RTOS_SWI_PRI_COUNT) || (rig_runtime_swi_count[priority] >= RTOS_SWI_MAX_PER_PRI))
@@ -15,6 +82,7 @@ RTOS_swiHandle_T* SWI_create(RTOS_swiPri_E priority, RTOS_swiFn_t handler)
     const uint8_t   index    = rig_runtime_swi_count[priority]++;
     RTOS_swiHandle_T* handle = &rig_runtime_swi_handles[priority][index];
     handle->handler  = handler;
+    handle->stats    = (statsCount < RTOS_SWI_STATS_COUNT) ? &stats[statsCount++] : NULL;
     handle->priority = priority;
     handle->event    = 1UL << index;
     return handle;
@@ -22,10 +90,14 @@ RTOS_swiHandle_T* SWI_create(RTOS_swiPri_E priority, RTOS_swiFn_t handler)
 
 void SWI_invoke(RTOS_swiHandle_T* handle)
 {
-    if ((handle != NULL) && (handle->handler != NULL))
+    if ((handle == NULL) || (handle->handler == NULL))
     {
-        handle->handler();
+        return;
     }
+
+    SWI_statsInvoked(handle->stats, HW_getCycleCount());
+    pending[handle->priority] |= handle->event;
+    runPending();
 }
 
 bool SWI_invokeFromISR(RTOS_swiHandle_T* handle)
@@ -36,8 +108,33 @@ bool SWI_invokeFromISR(RTOS_swiHandle_T* handle)
 
 void SWI_disable(void)
 {
+    disabledDepth++;
 }
 
 void SWI_enable(void)
 {
+    if ((disabledDepth != 0U) && (--disabledDepth == 0U))
+    {
+        runPending();
+    }
+}
+
+const RTOS_swiStats_S* SWI_getStats(const RTOS_swiHandle_T* handle)
+{
+    return (handle != NULL) ? handle->stats : NULL;
+}
+
+void SWI_resetStats(void)
+{
+    memset(stats, 0x00, sizeof(stats));
+}
+
+const RTOS_swiStats_S* rig_runtime_swi_stats(uint8_t priority, uint8_t index)
+{
+    if ((priority >= RTOS_SWI_PRI_COUNT) || (index >= rig_runtime_swi_count[priority]))
+    {
+        return NULL;
+    }
+
+    return rig_runtime_swi_handles[priority][index].stats;
 }
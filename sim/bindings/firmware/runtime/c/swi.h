@@ -3,3 +3,6 @@
 // SWI is a firmware RTOS ABI.  Keep the simulation implementation's public
 // include local to this binding while retaining the firmware-owned contract.
 #include "FreeRTOS_SWI.h"
+
+void                   rig_runtime_swi_reset(void);
+const RTOS_swiStats_S* rig_runtime_swi_stats(uint8_t priority, uint8_t index);
@@ -4,6 +4,8 @@
 
 #include "HW_tim.h"
 
+#include <time.h>
+
 void rig_runtime_advance_time_ns(uint64_t elapsed_ns)
 {
     rig_runtime.time_ns += elapsed_ns;
@@ -28,3 +30,20 @@ uint64_t HW_TIM_getBaseTick(void)
 {
     return rig_runtime.time_ns / 1000ULL;
 }
+
+/**
+ * @brief Host nanoseconds stand in for core cycles, so profiled execution
+ *        times reflect the simulation host rather than simulated time.
+ */
+uint32_t HW_getCycleCount(void)
+{
+    struct timespec now;
+
+    timespec_get(&now, TIME_UTC);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+}
+
+uint32_t HW_getCycleFrequencyHz(void)
+{
+    return 1000000000UL;
+}
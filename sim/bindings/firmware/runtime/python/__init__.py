@@ -22,6 +22,7 @@ if TYPE_CHECKING:
         FirmwareClusterRig,
     )
     from .node import FirmwareNodeRig
+    from .profile import ModuleProfile, ModuleTask, ModuleTaskProfile, SwiPriority, SwiStats
     from .runtime import FirmwareRuntime
     from .peripheral import (
         PeripheralBinding,
@@ -39,8 +40,13 @@ _EXPORTS = {
     "FirmwareClusterRig": ("cluster", "FirmwareClusterRig"),
     "FirmwareNodeRig": ("node", "FirmwareNodeRig"),
     "FirmwareRuntime": ("runtime", "FirmwareRuntime"),
+    "ModuleProfile": ("profile", "ModuleProfile"),
+    "ModuleTask": ("profile", "ModuleTask"),
+    "ModuleTaskProfile": ("profile", "ModuleTaskProfile"),
     "PeripheralBinding": ("peripheral", "PeripheralBinding"),
     "PeripheralInterface": ("peripheral", "PeripheralInterface"),
+    "SwiPriority": ("profile", "SwiPriority"),
+    "SwiStats": ("profile", "SwiStats"),
     "peripheral_datapath": ("peripheral", "peripheral_datapath"),
     "require_peripheral_binding": ("peripheral", "require_peripheral_binding"),
 }
@@ -67,8 +73,13 @@ __all__ = [
     "FirmwareClusterRig",
     "FirmwareNodeRig",
     "FirmwareRuntime",
+    "ModuleProfile",
+    "ModuleTask",
+    "ModuleTaskProfile",
     "PeripheralBinding",
     "PeripheralInterface",
+    "SwiPriority",
+    "SwiStats",
     "peripheral_datapath",
     "require_peripheral_binding",
 ]
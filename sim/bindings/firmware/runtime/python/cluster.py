@@ -7,6 +7,7 @@ from typing import Generic, TypeVar
 from sim.bindings.firmware.can.can import (
     CanBusDescriptor,
     CanEvent,
+    CanFrameBatch,
     CanMessageDescriptor,
     RoutedCanEvent,
     can_datapath,
@@ -507,6 +508,30 @@ class ClusterCanComms:
             return event
         return None
 
+    def frames(
+        self,
+        node: str,
+        bus: int | str | CanBusDescriptor,
+        *,
+        since: int = 0,
+    ) -> CanFrameBatch:
+        """Frames ``node`` sent on ``bus`` after cursor ``since``.
+
+        The frames are read in place from the runtime's record ring and only
+        the new ones are copied out, so polling every step stays cheap.
+        """
+        bus_descriptor = self._cluster.nodes[node].can.bus(bus)
+        ring = self._cluster.runtime.can_record_ring(node, bus_descriptor.index)
+        if ring is None or ring.written <= since:
+            return CanFrameBatch((), since)
+        first = max(since, ring.written - ring.capacity)
+        frames = (CanEvent * ring.capacity).from_address(ring.frames)
+        events = tuple(
+            CanEvent.from_buffer_copy(frames[index % ring.capacity])
+            for index in range(first, ring.written)
+        )
+        return CanFrameBatch(events, ring.written, first - since)
+
     def latest_bus_event(
         self,
         node: str,
@@ -662,6 +687,12 @@ class FirmwareClusterRig(ClusterRig):
             **nodes,
         )
 
+    def set_tickless(self, enabled: bool) -> None:
+        """Select tickless or strict task execution on every firmware node."""
+        for node in self.nodes.values():
+            if hasattr(node, "set_tickless"):
+                node.set_tickless(enabled)
+
     def _create_dataroutes(self) -> ClusterDataRoutes:
         return ClusterDataRoutes(self)
 
@@ -748,6 +779,8 @@ class FirmwareClusterRig(ClusterRig):
             host=host,
             route=self._route_from_runtime,
         )
+        runtime.set_step_threads(self.configuration.step_threads)
+        runtime.set_next_event(self.configuration.next_event)
         self._populate_runtime(runtime)
         return runtime
 
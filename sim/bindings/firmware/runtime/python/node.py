@@ -29,6 +29,14 @@ from .cluster import ClusterCanComms
 from rig.datapath import DataPath, DataPathKey, datapath_key
 from rig.node_abi import ModelDataPathDescriptor
 from .peripheral import PeripheralInterface, require_peripheral_binding
+from .profile import (
+    MODULE_PHASE_AUTO,
+    ModuleProfile,
+    ModuleTask,
+    ModuleTaskProfile,
+    SwiPriority,
+    SwiStats,
+)
 from rig.dataflow import NativeRouteEndpoint
 from rig.model import ModelRig, datapath_route_id
 from rig.node_config import NodeConfig
@@ -104,10 +112,25 @@ class FirmwareNodeRig(ModelRig):
         self.elapsed_ns += duration_ns
         self._run_for(ctypes.c_uint64(duration_ns))
 
+    @property
+    def tickless(self) -> bool:
+        return bool(self._tickless())
+
+    def set_tickless(self, enabled: bool) -> None:
+        """Skip firmware task ticks while nothing observable changes.
+
+        A tick is skipped when the previous one neither saw an input change
+        nor produced CAN or GPIO output, until a task of 10 ms or longer is
+        due. The default strict execution runs every tick and is the
+        reference for bit-exact validation. The setting outlives ``reset()``.
+        """
+        self._set_tickless(ctypes.c_bool(enabled))
+
     def scheduler_callbacks(self) -> RustSchedulerCallbacks:
         return RustSchedulerCallbacks(
             run_for=self._function_address(self._run_for),
             reset=self._function_address(self._new),
+            next_wake=self._function_address(self._next_wake_ns),
         )
 
     def register_cluster_wakes(self, runtime) -> None:
@@ -302,6 +325,126 @@ class FirmwareNodeRig(ModelRig):
             )
         return bool(self._get_fault(ctypes.c_int(fault)))
 
+    def trace_analog_input(
+        self, recorder, channel: int, *, name: str | None = None
+    ) -> None:
+        """Record the voltage of an analog input on ``recorder``."""
+        self._add_trace_sampler(
+            recorder, self._trace_analog_input, channel, name, "analog_input"
+        )
+
+    def trace_digital_io(
+        self, recorder, channel: int, *, name: str | None = None
+    ) -> None:
+        """Record a digital I/O as 0.0 or 1.0 on ``recorder``."""
+        self._add_trace_sampler(
+            recorder, self._trace_digital_io, channel, name, "digital_io"
+        )
+
+    def trace_fault(self, recorder, fault: int, *, name: str | None = None) -> None:
+        """Record a local fault as 0.0 or 1.0 on ``recorder``."""
+        if self._trace_fault is None:
+            raise NotImplementedError(
+                f"{self.__class__.__name__} does not expose local fault state"
+            )
+        self._add_trace_sampler(recorder, self._trace_fault, fault, name, "fault")
+
+    def module_profile(self, task: ModuleTask, module: int) -> ModuleProfile | None:
+        """Execution time of ``module``'s callback in ``task``; None when the
+        firmware has no module with that index."""
+        self._require_module_profiles()
+        profile = ModuleProfile()
+        if not self._module_profile(
+            ctypes.c_uint32(task), ctypes.c_uint32(module), ctypes.byref(profile)
+        ):
+            return None
+        return profile
+
+    def module_profiles(self, task: ModuleTask) -> list[ModuleProfile]:
+        """Profiles of every module in execution order, including modules
+        without a callback in ``task``, whose count stays zero."""
+        profiles = []
+        while (profile := self.module_profile(task, len(profiles))) is not None:
+            profiles.append(profile)
+        return profiles
+
+    def module_task_profile(self, task: ModuleTask) -> ModuleTaskProfile:
+        self._require_module_profiles()
+        profile = ModuleTaskProfile()
+        if not self._module_task_profile(ctypes.c_uint32(task), ctypes.byref(profile)):
+            raise ValueError(f"{task!r} is not a periodic module task")
+        return profile
+
+    def reset_module_profiles(self) -> None:
+        """Start the execution-time profiles over; ``reset()`` also does."""
+        self._require_module_profiles()
+        self._reset_module_profiles()
+
+    def scheduled_module_profile(self, module: int) -> ModuleProfile | None:
+        """Execution time of ``module``'s scheduled ``periodic_CLK``; None
+        when the firmware has no module with that index."""
+        self._require_module_profiles()
+        profile = ModuleProfile()
+        if not self._module_scheduled_profile(
+            ctypes.c_uint32(module), ctypes.byref(profile)
+        ):
+            return None
+        return profile
+
+    def module_schedule_phase(self, module: int) -> int | None:
+        """Slot ``module``'s scheduled callback runs in within its period, or
+        None when the module has no scheduled callback."""
+        self._require_module_profiles()
+        phase = self._module_schedule_phase(ctypes.c_uint32(module))
+        return None if phase == MODULE_PHASE_AUTO else phase
+
+    def module_schedule_worst_slot_load_us(self) -> int:
+        """Largest sum of declared ``wcetUs`` due in any 1 ms slot."""
+        self._require_module_profiles()
+        return self._module_schedule_worst_slot_load_us()
+
+    def module_schedule_rejected(self) -> int:
+        """Modules whose ``periodic_CLK`` never runs because its ``periodMs``
+        doesn't fit the schedule's slots."""
+        self._require_module_profiles()
+        return self._module_schedule_rejected()
+
+    def swi_stats(self, priority: SwiPriority, index: int) -> SwiStats | None:
+        """Latency statistics of the ``index``th SWI created at ``priority``;
+        None when there is no such SWI or it keeps no statistics."""
+        if self._swi_stats is None:
+            raise NotImplementedError(
+                f"{self.__class__.__name__} does not run the firmware SWI shim"
+            )
+        stats = SwiStats()
+        if not self._swi_stats(
+            ctypes.c_uint32(priority), ctypes.c_uint32(index), ctypes.byref(stats)
+        ):
+            return None
+        return stats
+
+    def reset_swi_stats(self) -> None:
+        """Start the SWI statistics over; ``reset()`` also does."""
+        if self._reset_swi_stats is None:
+            raise NotImplementedError(
+                f"{self.__class__.__name__} does not run the firmware SWI shim"
+            )
+        self._reset_swi_stats()
+
+    def _require_module_profiles(self) -> None:
+        if self._module_profile is None:
+            raise NotImplementedError(
+                f"{self.__class__.__name__} does not run the firmware Module manager"
+            )
+
+    def _add_trace_sampler(
+        self, recorder, sampler, context: int, name: str | None, kind: str
+    ) -> None:
+        if name is None:
+            node_name = self._cluster_node_name or type(self).__name__
+            name = f"{node_name}.{kind}.{getattr(context, 'name', context)}"
+        recorder.add_sampler(name, self._function_address(sampler), int(context))
+
     def _can_bus_count_value(self) -> int:
         return int(self._can_bus_count())
 
@@ -481,12 +624,13 @@ class FirmwareNodeRig(ModelRig):
         )
 
     def _can_recv_message(self, message: CanMessageDescriptor) -> CanEvent | None:
-        latest = None
-        while self._can_tx_count_value(message.bus):
-            event = self._can_recv_event(message.bus)
-            if event is not None and event.packet.id == message.id:
-                latest = event
-        return latest
+        events = self._can_recv_events(
+            message.bus, self._can_tx_count_value(message.bus)
+        )
+        for event in reversed(events):
+            if event.packet.id == message.id:
+                return event
+        return None
 
     def _can_rx_count_value(self, bus: int | str | CanBusDescriptor) -> int:
         bus_index = self._coerce_can_bus(bus)
@@ -737,6 +881,12 @@ class FirmwareNodeRig(ModelRig):
     def _configure_model_abi(self) -> None:
         self._new = self._bind_symbol("rig_model_new")
         self._run_for = self._bind_symbol("rig_model_run_for", [ctypes.c_uint64])
+        self._next_wake_ns = self._bind_symbol(
+            "rig_model_next_wake_ns",
+            restype=ctypes.c_uint64,
+        )
+        self._set_tickless = self._bind_symbol("rig_model_set_tickless", [ctypes.c_bool])
+        self._tickless = self._bind_symbol("rig_model_tickless", restype=ctypes.c_bool)
         self._datapath_count = self._bind_symbol(
             "rig_model_datapath_count",
             restype=ctypes.c_uint32,
@@ -769,6 +919,54 @@ class FirmwareNodeRig(ModelRig):
             [ctypes.c_int],
             ctypes.c_bool,
         )
+        self._trace_analog_input = self._bind_symbol(
+            "rig_model_trace_analog_input",
+            [ctypes.c_uint64],
+            ctypes.c_double,
+        )
+        self._trace_digital_io = self._bind_symbol(
+            "rig_model_trace_digital_io",
+            [ctypes.c_uint64],
+            ctypes.c_double,
+        )
+        self._trace_fault = self._bind_optional_symbol(
+            "rig_model_trace_fault",
+            [ctypes.c_uint64],
+            ctypes.c_double,
+        )
+        self._module_profile = self._bind_optional_symbol(
+            "rig_model_module_profile",
+            [ctypes.c_uint32, ctypes.c_uint32, ctypes.POINTER(ModuleProfile)],
+            ctypes.c_bool,
+        )
+        self._module_task_profile = self._bind_optional_symbol(
+            "rig_model_module_task_profile",
+            [ctypes.c_uint32, ctypes.POINTER(ModuleTaskProfile)],
+            ctypes.c_bool,
+        )
+        self._reset_module_profiles = self._bind_optional_symbol(
+            "rig_model_reset_module_profiles"
+        )
+        self._module_scheduled_profile = self._bind_optional_symbol(
+            "rig_model_module_scheduled_profile",
+            [ctypes.c_uint32, ctypes.POINTER(ModuleProfile)],
+            ctypes.c_bool,
+        )
+        self._module_schedule_phase = self._bind_optional_symbol(
+            "rig_model_module_schedule_phase", [ctypes.c_uint32], ctypes.c_uint32
+        )
+        self._module_schedule_worst_slot_load_us = self._bind_optional_symbol(
+            "rig_model_module_schedule_worst_slot_load_us", [], ctypes.c_uint32
+        )
+        self._module_schedule_rejected = self._bind_optional_symbol(
+            "rig_model_module_schedule_rejected", [], ctypes.c_uint32
+        )
+        self._swi_stats = self._bind_optional_symbol(
+            "rig_model_swi_stats",
+            [ctypes.c_uint32, ctypes.c_uint32, ctypes.POINTER(SwiStats)],
+            ctypes.c_bool,
+        )
+        self._reset_swi_stats = self._bind_optional_symbol("rig_model_reset_swi_stats")
         self._can_bus_count = self._bind_symbol(
             "rig_model_can_bus_count",
             restype=ctypes.c_uint8,
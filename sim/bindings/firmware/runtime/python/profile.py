@@ -0,0 +1,106 @@
+"""Execution-time profiles kept by the firmware Module manager and SWIs."""
+
+from __future__ import annotations
+
+import ctypes
+from enum import IntEnum
+
+MODULE_PROFILE_HISTOGRAM_BINS = 14
+MODULE_PROFILE_HISTOGRAM_MIN_LOG2 = 5
+MODULE_PHASE_AUTO = 0xFFFF
+SWI_HISTOGRAM_BINS = 8
+SWI_HISTOGRAM_MIN_LOG2 = 6
+
+
+class ModuleTask(IntEnum):
+    """Periodic tasks of ``Module_taskSpeeds_E``."""
+
+    RATE_1HZ = 0
+    RATE_10HZ = 1
+    RATE_100HZ = 2
+    RATE_1KHZ = 3
+
+    @property
+    def period_ns(self) -> int:
+        return 1_000_000_000 // 10**self.value
+
+
+class ModuleProfile(ctypes.Structure):
+    """``Module_profile_S``: one module callback at one rate.
+
+    In the simulation a cycle is a host nanosecond, so these times describe
+    the firmware running on the host rather than on the target.
+    """
+
+    _fields_ = [
+        ("total_cycles", ctypes.c_uint64),
+        ("min_cycles", ctypes.c_uint32),
+        ("max_cycles", ctypes.c_uint32),
+        ("count", ctypes.c_uint32),
+        ("histogram", ctypes.c_uint16 * MODULE_PROFILE_HISTOGRAM_BINS),
+    ]
+
+    @property
+    def mean_cycles(self) -> float:
+        return self.total_cycles / self.count if self.count else 0.0
+
+    @staticmethod
+    def bin_floor_cycles(index: int) -> int:
+        """Shortest run counted in histogram bin ``index``."""
+        return 0 if index == 0 else 1 << (MODULE_PROFILE_HISTOGRAM_MIN_LOG2 + index)
+
+
+class ModuleTaskProfile(ctypes.Structure):
+    """``Module_taskProfile_S``: a whole periodic task against its period."""
+
+    _fields_ = [
+        ("budget_cycles", ctypes.c_uint32),
+        ("max_cycles", ctypes.c_uint32),
+        ("deadline_misses", ctypes.c_uint32),
+    ]
+
+
+class SwiPriority(IntEnum):
+    """``RTOS_swiPri_E``; higher priorities preempt lower ones."""
+
+    PRI_0 = 0
+    PRI_1 = 1
+    PRI_2 = 2
+
+
+class SwiStats(ctypes.Structure):
+    """``RTOS_swiStats_S``: invoke-to-run latency and run time of one SWI.
+
+    Invocations made while the SWI is already pending are coalesced into
+    its next run, so ``invocations == runs + coalesced`` once nothing is
+    pending.
+    """
+
+    _fields_ = [
+        ("invocations", ctypes.c_uint32),
+        ("coalesced", ctypes.c_uint32),
+        ("runs", ctypes.c_uint32),
+        ("max_latency_cycles", ctypes.c_uint32),
+        ("max_run_cycles", ctypes.c_uint32),
+        ("latency_histogram", ctypes.c_uint16 * SWI_HISTOGRAM_BINS),
+        ("run_histogram", ctypes.c_uint16 * SWI_HISTOGRAM_BINS),
+        ("pending_since", ctypes.c_uint32),
+        ("pending", ctypes.c_bool),
+    ]
+
+    @staticmethod
+    def bin_floor_cycles(index: int) -> int:
+        """Shortest duration counted in histogram bin ``index``."""
+        return 0 if index == 0 else 1 << (SWI_HISTOGRAM_MIN_LOG2 + index)
+
+
+__all__ = [
+    "MODULE_PHASE_AUTO",
+    "MODULE_PROFILE_HISTOGRAM_BINS",
+    "ModuleProfile",
+    "ModuleTask",
+    "ModuleTaskProfile",
+    "SWI_HISTOGRAM_BINS",
+    "SwiPriority",
+    "SwiStats",
+]
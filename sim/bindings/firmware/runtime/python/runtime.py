@@ -12,6 +12,7 @@ from collections.abc import Callable
 
 from rig.dataflow import DataflowWait
 from rig.runtime import RustClusterRuntime, RustRuntimeHost
+from sim.bindings.firmware.can.can import CanRecordRing
 
 
 class FirmwareRuntime(RustClusterRuntime):
@@ -53,6 +54,11 @@ class FirmwareRuntime(RustClusterRuntime):
             [ctypes.c_uint32, ctypes.c_uint8, ctypes.c_void_p],
             ctypes.c_bool,
         )
+        self._can_record_ring = self.bind_symbol(
+            "rig_cluster_can_record_ring",
+            [ctypes.c_uint32, ctypes.c_uint8, ctypes.c_void_p],
+            ctypes.c_bool,
+        )
         self._latest_can_signal = self.bind_symbol(
             "rig_cluster_latest_can_signal",
             [
@@ -64,6 +70,17 @@ class FirmwareRuntime(RustClusterRuntime):
             ],
             ctypes.c_bool,
         )
+        self._trace_add_can_signal = self.bind_symbol(
+            "rig_cluster_trace_add_can_signal",
+            [
+                ctypes.c_uint32,
+                ctypes.c_uint8,
+                ctypes.c_uint32,
+                ctypes.c_char_p,
+                ctypes.c_size_t,
+            ],
+            ctypes.c_uint32,
+        )
         self._begin_can_signal_wait = self.bind_symbol(
             "rig_cluster_begin_can_signal_wait",
             [ctypes.c_uint32, ctypes.c_void_p, ctypes.c_uint32, ctypes.c_size_t],
@@ -382,6 +399,24 @@ class FirmwareRuntime(RustClusterRuntime):
             )
         )
 
+    def can_record_ring(self, source_node: str, bus: int) -> CanRecordRing | None:
+        """Where the runtime keeps ``source_node``'s recent frames on ``bus``.
+
+        The ring's memory is reused after a reset, so fetch it again rather
+        than keeping the pointer across one.
+        """
+        node_index = self.node_index(source_node)
+        if node_index is None:
+            return None
+        ring = CanRecordRing()
+        if not self._can_record_ring(
+            ctypes.c_uint32(node_index),
+            ctypes.c_uint8(bus),
+            ctypes.byref(ring),
+        ):
+            return None
+        return ring
+
     def latest_can_signal(
         self,
         source_node: str,
@@ -403,6 +438,29 @@ class FirmwareRuntime(RustClusterRuntime):
             return None
         return float(value.value)
 
+    def add_trace_can_signal(
+        self,
+        source_node: str,
+        bus: int,
+        message_id: int,
+        signal_name: str,
+        *,
+        decoder: int,
+    ) -> int | None:
+        """Trace a signal of ``source_node``'s latest frame, decoded by ``decoder``."""
+        node_index = self.node_index(source_node)
+        if node_index is None:
+            return None
+        return self._trace_channel(
+            self._trace_add_can_signal(
+                ctypes.c_uint32(node_index),
+                ctypes.c_uint8(bus),
+                ctypes.c_uint32(message_id),
+                signal_name.encode(),
+                ctypes.c_size_t(decoder),
+            )
+        )
+
     def begin_can_signal_wait(
         self,
         *,
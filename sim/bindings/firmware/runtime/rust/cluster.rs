@@ -5,10 +5,11 @@ use super::dataflow::{DataflowAlgorithm, DataflowWait};
 use super::registry::{InterfaceRoute, RuntimeInterface, RuntimeInterfaces};
 use super::interfaces::{InterfaceCaller, InterfaceImplementation};
 use super::runtime::{RigBackend, RigRuntime};
-use super::node::{RigNodeResetFn, RigNodeRunForFn, RigPythonScheduledFn};
+use super::node::{RigNodeNextWakeFn, RigNodeResetFn, RigNodeRunForFn, RigPythonScheduledFn};
 use super::scheduler;
 use super::scalar::{self, ScalarCountFn, ScalarRecvManyFn, ScalarRoute, ScalarSendManyFn,
     ScalarSink, ScalarSinkSetFn, ScalarEvent};
+use super::trace::{RigTraceSampleFn, RigTraceView, TraceSource};
 
 pub type ClusterRouteFn = unsafe extern "C" fn(u64);
 #[derive(Default)]
@@ -40,6 +41,10 @@ impl RigBackend for FirmwareBackend {
         self.update_scalar_state_scale(node, route_id, value);
     }
 
+    fn sample_trace(&self, key: u64) -> f64 {
+        self.interfaces.sample_can_trace_signal(key)
+    }
+
     fn scalar_interface(&self) -> &scalar::ScalarInterface {
         &self.scalar
     }
@@ -151,6 +156,19 @@ pub extern "C" fn rig_cluster_reset() {
     CLUSTER_RUNTIME.lock().unwrap().reset();
 }
 
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_cluster_set_step_threads(threads: u32) {
+    CLUSTER_RUNTIME
+        .lock()
+        .unwrap()
+        .set_step_threads(threads as usize);
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_cluster_set_next_event(enabled: bool) {
+    CLUSTER_RUNTIME.lock().unwrap().set_next_event(enabled);
+}
+
 #[unsafe(no_mangle)]
 pub extern "C" fn rig_cluster_add_scalar_transform_algorithm(
     owner_node: u32,
@@ -190,6 +208,18 @@ pub extern "C" fn rig_cluster_add_node(run_for: usize, reset: usize, online: boo
         .add_node(run_for, reset, online)
 }
 
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_cluster_set_node_next_wake(node: u32, next_wake: usize) -> bool {
+    let Some(next_wake) = (unsafe { function_pointer::<RigNodeNextWakeFn>(next_wake) }) else {
+        return false;
+    };
+
+    CLUSTER_RUNTIME
+        .lock()
+        .unwrap()
+        .set_node_next_wake(node, next_wake)
+}
+
 #[unsafe(no_mangle)]
 pub extern "C" fn rig_cluster_add_python_node(
     scheduled: usize,
@@ -546,6 +576,52 @@ pub extern "C" fn rig_cluster_node_elapsed_ns_many(out: *mut u64, capacity: u32)
     CLUSTER_RUNTIME.lock().unwrap().node_elapsed_ns_many(out)
 }
 
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_cluster_trace_configure(period_ns: u64, capacity: u32) {
+    CLUSTER_RUNTIME
+        .lock()
+        .unwrap()
+        .configure_trace(period_ns, capacity as usize);
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_cluster_trace_add_sampler(sample: usize, context: u64) -> u32 {
+    let Some(sample) = (unsafe { function_pointer::<RigTraceSampleFn>(sample) }) else {
+        return u32::MAX;
+    };
+    CLUSTER_RUNTIME
+        .lock()
+        .unwrap()
+        .add_trace_channel(TraceSource::Sampler { sample, context })
+        .unwrap_or(u32::MAX)
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_cluster_trace_add_scalar(source_node: u32, route_id: u32) -> u32 {
+    CLUSTER_RUNTIME
+        .lock()
+        .unwrap()
+        .add_trace_channel(TraceSource::Scalar {
+            source_node,
+            route_id,
+        })
+        .unwrap_or(u32::MAX)
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_cluster_trace_clear() {
+    CLUSTER_RUNTIME.lock().unwrap().clear_trace();
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_cluster_trace_view(out: *mut RigTraceView) -> bool {
+    if out.is_null() {
+        return false;
+    }
+    unsafe { *out = CLUSTER_RUNTIME.lock().unwrap().trace_view() };
+    true
+}
+
 #[unsafe(no_mangle)]
 pub extern "C" fn rig_cluster_latest_scalar_event(
     source_node: u32,
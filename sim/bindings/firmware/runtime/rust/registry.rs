@@ -1,6 +1,6 @@
 use super::can::{CanEndpoint, CanInterface};
 pub(super) use super::can::{
-    CanEvent, CanPacket, CanSignalComparison, CanSignalDecoderFn,
+    CanEvent, CanPacket, CanRecordRing, CanSignalComparison, CanSignalDecoderFn,
 };
 pub(super) use super::can::{CanRouteResult, ClusterCanRoute};
 use super::dataflow::{DataflowAlgorithm, DataflowEdgeKey, DataflowWait};
@@ -164,6 +164,18 @@ impl RuntimeInterfaces {
         self.can.latest_bus_event(source_node, bus)
     }
 
+    pub(super) fn can_record_ring(&self, source_node: u32, bus: u8) -> Option<CanRecordRing> {
+        self.can.record_ring(source_node, bus)
+    }
+
+    pub(super) fn add_can_trace_signal(&mut self, signal: super::can::CanTraceSignal) -> u64 {
+        self.can.add_trace_signal(signal)
+    }
+
+    pub(super) fn sample_can_trace_signal(&self, key: u64) -> f64 {
+        self.can.sample_trace_signal(key)
+    }
+
     pub(super) fn latest_timer_event(
         &self, source_node: u32, interface: u16, port: i32, channel: i32,
     ) -> Option<TimerChannelEvent> {
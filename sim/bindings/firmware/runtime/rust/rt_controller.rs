@@ -1,5 +1,27 @@
+use std::sync::atomic::{AtomicBool, Ordering};
+
 unsafe extern "C" {
     fn rig_runtime_advance_time_ns(elapsed_ns: u64);
+    fn rig_runtime_activity() -> u32;
+}
+
+/// Longest time a tickless controller goes without running its tasks.
+/// Tasks with at least this period always run when due, so firmware timers
+/// are still observed at this granularity while the node is quiet.
+pub const TICKLESS_MAX_IDLE_NS: u64 = 10_000_000;
+
+static TICKLESS: AtomicBool = AtomicBool::new(false);
+
+/// Select tickless task execution for this firmware library. Survives
+/// `rig_model_new()`; strict execution, the default, runs every task tick.
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_model_set_tickless(enabled: bool) {
+    TICKLESS.store(enabled, Ordering::Relaxed);
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_model_tickless() -> bool {
+    TICKLESS.load(Ordering::Relaxed)
 }
 
 /// Firmware application metadata exported alongside the controller model.
@@ -33,6 +55,9 @@ impl AppDesc {
 /// Firmware module lifecycle callbacks consumed by the controller scheduler.
 pub type ModuleTask = unsafe extern "C" fn();
 
+/// `MODULE_PHASE_AUTO`: let the Module manager place `periodic_clk`.
+pub const MODULE_PHASE_AUTO: u16 = 0xffff;
+
 #[repr(C)]
 pub struct ModuleDesc {
     pub module_init: Option<ModuleTask>,
@@ -40,6 +65,10 @@ pub struct ModuleDesc {
     pub periodic_100hz_clk: Option<ModuleTask>,
     pub periodic_10hz_clk: Option<ModuleTask>,
     pub periodic_1hz_clk: Option<ModuleTask>,
+    pub periodic_clk: Option<ModuleTask>,
+    pub period_ms: u16,
+    pub phase_ms: u16,
+    pub wcet_us: u16,
 }
 
 impl ModuleDesc {
@@ -56,6 +85,28 @@ impl ModuleDesc {
             periodic_100hz_clk,
             periodic_10hz_clk,
             periodic_1hz_clk,
+            periodic_clk: None,
+            period_ms: 0,
+            phase_ms: MODULE_PHASE_AUTO,
+            wcet_us: 0,
+        }
+    }
+
+    /// Run `periodic_clk` every `period_ms` from the Module manager's static
+    /// schedule, at `phase_ms` or `MODULE_PHASE_AUTO`.
+    pub const fn scheduled(
+        self,
+        periodic_clk: ModuleTask,
+        period_ms: u16,
+        phase_ms: u16,
+        wcet_us: u16,
+    ) -> Self {
+        Self {
+            periodic_clk: Some(periodic_clk),
+            period_ms,
+            phase_ms,
+            wcet_us,
+            ..self
         }
     }
 }
@@ -92,6 +143,166 @@ unsafe extern "C" {
     fn Module_100Hz_TSK();
     fn Module_10Hz_TSK();
     fn Module_1Hz_TSK();
+    fn Module_schedule_TSK();
+}
+
+/// Bins in `Module_profile_S::histogram`.
+pub const MODULE_PROFILE_HISTOGRAM_BINS: usize = 14;
+
+/// Execution time of one module callback at one rate, mirroring
+/// `Module_profile_S`. Cycles are host nanoseconds in the simulation.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct ModuleProfile {
+    pub total_cycles: u64,
+    pub min_cycles: u32,
+    pub max_cycles: u32,
+    pub count: u32,
+    pub histogram: [u16; MODULE_PROFILE_HISTOGRAM_BINS],
+}
+
+/// Execution time of a whole periodic task, mirroring `Module_taskProfile_S`.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct ModuleTaskProfile {
+    pub budget_cycles: u32,
+    pub max_cycles: u32,
+    pub deadline_misses: u32,
+}
+
+unsafe extern "C" {
+    fn Module_getProfile(task: u32, module: u8) -> *const ModuleProfile;
+    fn Module_getTaskProfile(task: u32) -> *const ModuleTaskProfile;
+    fn Module_resetProfiles();
+    fn Module_getScheduledProfile(module: u8) -> *const ModuleProfile;
+    fn Module_getSchedulePhase(module: u8) -> u16;
+    fn Module_getScheduleWorstSlotLoadUs() -> u16;
+    fn Module_getScheduleRejected() -> u8;
+}
+
+/// Copy the profile of `module`'s callback in periodic `task`. False when
+/// either index is out of range.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rig_model_module_profile(
+    task: u32,
+    module: u32,
+    out: *mut ModuleProfile,
+) -> bool {
+    let Ok(module) = u8::try_from(module) else {
+        return false;
+    };
+    let profile = unsafe { Module_getProfile(task, module) };
+    if profile.is_null() || out.is_null() {
+        return false;
+    }
+    unsafe { *out = *profile };
+    true
+}
+
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rig_model_module_task_profile(
+    task: u32,
+    out: *mut ModuleTaskProfile,
+) -> bool {
+    let profile = unsafe { Module_getTaskProfile(task) };
+    if profile.is_null() || out.is_null() {
+        return false;
+    }
+    unsafe { *out = *profile };
+    true
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_model_reset_module_profiles() {
+    unsafe { Module_resetProfiles() };
+}
+
+/// Copy the profile of `module`'s scheduled callback. False when `module` is
+/// out of range.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rig_model_module_scheduled_profile(
+    module: u32,
+    out: *mut ModuleProfile,
+) -> bool {
+    let Ok(module) = u8::try_from(module) else {
+        return false;
+    };
+    let profile = unsafe { Module_getScheduledProfile(module) };
+    if profile.is_null() || out.is_null() {
+        return false;
+    }
+    unsafe { *out = *profile };
+    true
+}
+
+/// Phase of `module`'s scheduled callback, or `MODULE_PHASE_AUTO` when the
+/// module is not scheduled.
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_model_module_schedule_phase(module: u32) -> u32 {
+    match u8::try_from(module) {
+        Ok(module) => u32::from(unsafe { Module_getSchedulePhase(module) }),
+        Err(_) => u32::from(MODULE_PHASE_AUTO),
+    }
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_model_module_schedule_worst_slot_load_us() -> u32 {
+    u32::from(unsafe { Module_getScheduleWorstSlotLoadUs() })
+}
+
+/// Modules whose `periodic_CLK` was left out of the schedule because its
+/// `periodMs` doesn't fit the slots.
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_model_module_schedule_rejected() -> u32 {
+    u32::from(unsafe { Module_getScheduleRejected() })
+}
+
+/// Bins in each `RTOS_swiStats_S` histogram.
+pub const SWI_HISTOGRAM_BINS: usize = 8;
+
+/// Invoke-to-run latency and run time of one SWI, mirroring
+/// `RTOS_swiStats_S`. Cycles are host nanoseconds in the simulation.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct SwiStats {
+    pub invocations: u32,
+    pub coalesced: u32,
+    pub runs: u32,
+    pub max_latency_cycles: u32,
+    pub max_run_cycles: u32,
+    pub latency_histogram: [u16; SWI_HISTOGRAM_BINS],
+    pub run_histogram: [u16; SWI_HISTOGRAM_BINS],
+    pub pending_since: u32,
+    pub pending: bool,
+}
+
+unsafe extern "C" {
+    fn rig_runtime_swi_stats(priority: u8, index: u8) -> *const SwiStats;
+    fn SWI_resetStats();
+}
+
+/// Copy the statistics of the `index`th SWI created at `priority`. False when
+/// there is no such SWI or it keeps no statistics.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rig_model_swi_stats(
+    priority: u32,
+    index: u32,
+    out: *mut SwiStats,
+) -> bool {
+    let (Ok(priority), Ok(index)) = (u8::try_from(priority), u8::try_from(index)) else {
+        return false;
+    };
+    let stats = unsafe { rig_runtime_swi_stats(priority, index) };
+    if stats.is_null() || out.is_null() {
+        return false;
+    }
+    unsafe { *out = *stats };
+    true
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn rig_model_reset_swi_stats() {
+    unsafe { SWI_resetStats() };
 }
 
 unsafe fn embedded_module_init() {
@@ -114,11 +325,18 @@ unsafe fn embedded_module_tick_1hz() {
     unsafe { Module_1Hz_TSK() };
 }
 
-const EMBEDDED_MODULE_PERIODIC_TASKS: [PeriodicTask; 4] = [
+unsafe fn embedded_module_tick_schedule() {
+    unsafe { Module_schedule_TSK() };
+}
+
+// In priority order: the scheduled callbacks run after every fixed-rate task
+// due in the same tick, as the lowest priority firmware task does.
+const EMBEDDED_MODULE_PERIODIC_TASKS: [PeriodicTask; 5] = [
     PeriodicTask::new(1_000_000, embedded_module_tick_1khz),
     PeriodicTask::new(10_000_000, embedded_module_tick_100hz),
     PeriodicTask::new(100_000_000, embedded_module_tick_10hz),
     PeriodicTask::new(1_000_000_000, embedded_module_tick_1hz),
+    PeriodicTask::new(1_000_000, embedded_module_tick_schedule),
 ];
 
 const EMBEDDED_MODULE_CALLBACKS: TaskCallbacks = TaskCallbacks {
@@ -129,6 +347,9 @@ const EMBEDDED_MODULE_CALLBACKS: TaskCallbacks = TaskCallbacks {
 pub struct RTController {
     callbacks: TaskCallbacks,
     task_remainders_ns: [u64; MAX_PERIODIC_TASKS],
+    /// Runtime activity count after the last task tick, if that tick neither
+    /// saw new inputs nor produced outputs.
+    quiet_activity: Option<u32>,
 }
 
 impl super::model::ModelRuntime for RTController {
@@ -149,6 +370,10 @@ impl super::model::ModelRuntime for RTController {
     unsafe fn run_for_ns(&mut self, elapsed_ns: u64) {
         unsafe { <Self as Scheduler>::run_for_ns(self, elapsed_ns) };
     }
+
+    fn next_wake_ns(&self) -> u64 {
+        RTController::next_wake_ns(self)
+    }
 }
 
 impl RTController {
@@ -156,6 +381,7 @@ impl RTController {
         Self {
             callbacks,
             task_remainders_ns: [0; MAX_PERIODIC_TASKS],
+            quiet_activity: None,
         }
     }
 
@@ -167,6 +393,7 @@ impl RTController {
         super::reset::reset();
         super::can::reset();
         self.task_remainders_ns = [0; MAX_PERIODIC_TASKS];
+        self.quiet_activity = None;
     }
 
     pub fn advance_time_ns(&self, elapsed_ns: u64) {
@@ -217,6 +444,7 @@ impl RTController {
 impl Scheduler for RTController {
     unsafe fn reset(&mut self) {
         self.task_remainders_ns = [0; MAX_PERIODIC_TASKS];
+        self.quiet_activity = None;
         unsafe { (self.callbacks.init)() };
     }
 
@@ -227,6 +455,17 @@ impl Scheduler for RTController {
 
         unsafe { rig_runtime_advance_time_ns(elapsed_ns) };
 
+        // While quiet, a tick only runs when a slow task is due; the fast
+        // tasks skipped in between keep their phase.
+        let activity = unsafe { rig_runtime_activity() };
+        let run_tasks = !self.is_quiet(activity)
+            || (0..self.active_periodic_task_count()).any(|index| {
+                let period_ns = self.callbacks.periodic_tasks[index].period_ns;
+                period_ns >= TICKLESS_MAX_IDLE_NS
+                    && self.task_remainders_ns[index].saturating_add(elapsed_ns) >= period_ns
+            });
+
+        let mut ran = false;
         for index in 0..self.active_periodic_task_count() {
             let task = self.callbacks.periodic_tasks[index];
             if task.period_ns == 0 {
@@ -235,14 +474,43 @@ impl Scheduler for RTController {
             self.task_remainders_ns[index] =
                 self.task_remainders_ns[index].saturating_add(elapsed_ns);
             if self.task_remainders_ns[index] >= task.period_ns {
-                unsafe { (task.task)() };
+                if run_tasks {
+                    unsafe { (task.task)() };
+                    ran = true;
+                }
                 self.task_remainders_ns[index] %= task.period_ns;
             }
         }
+
+        if ran {
+            let after = unsafe { rig_runtime_activity() };
+            self.quiet_activity = (after == activity).then_some(after);
+        }
     }
 }
 
 impl RTController {
+    /// Nanoseconds until the next periodic task is due. Time the firmware
+    /// reads through the tick shim only matters to these tasks, so nothing
+    /// observable happens before then.
+    pub fn next_wake_ns(&self) -> u64 {
+        let quiet = self.is_quiet(unsafe { rig_runtime_activity() });
+        (0..self.active_periodic_task_count())
+            .filter_map(|index| {
+                let period_ns = self.callbacks.periodic_tasks[index].period_ns;
+                (period_ns != 0 && !(quiet && period_ns < TICKLESS_MAX_IDLE_NS))
+                    .then(|| period_ns.saturating_sub(self.task_remainders_ns[index]))
+            })
+            .min()
+            .unwrap_or(u64::MAX)
+    }
+
+    /// Whether tasks may be skipped: tickless execution is selected, the last
+    /// tick changed nothing observable, and no input has arrived since.
+    fn is_quiet(&self, activity: u32) -> bool {
+        TICKLESS.load(Ordering::Relaxed) && self.quiet_activity == Some(activity)
+    }
+
     fn active_periodic_task_count(&self) -> usize {
         self.callbacks.periodic_tasks.len().min(MAX_PERIODIC_TASKS)
     }
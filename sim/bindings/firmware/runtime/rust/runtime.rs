@@ -38,6 +38,7 @@ pub use can::{
 };
 pub use model::{NodeModel, NodeTarget};
 pub use rt_controller::{
-    AppDesc, MAX_PERIODIC_TASKS, ModuleDesc, ModuleTask, PeriodicTask, RTController, Scheduler,
+    AppDesc, MAX_PERIODIC_TASKS, MODULE_PHASE_AUTO, ModuleDesc, ModuleProfile, ModuleTask,
+    ModuleTaskProfile, PeriodicTask, RTController, Scheduler, SwiStats, TICKLESS_MAX_IDLE_NS,
     TaskCallbacks, TaskFn,
 };
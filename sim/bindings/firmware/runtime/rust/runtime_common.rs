@@ -66,6 +66,10 @@ mod scheduler {
     include!(env!("RIG_RUNTIME_RUST_SCHEDULER_RS"));
 }
 
+mod trace {
+    include!(env!("RIG_RUNTIME_RUST_TRACE_RS"));
+}
+
 pub mod cluster {
     include!(env!("RIG_RUNTIME_RUST_CLUSTER_RS"));
 }
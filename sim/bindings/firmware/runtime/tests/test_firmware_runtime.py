@@ -446,6 +446,37 @@ def test_rust_can_interface_fans_out_and_records_latest_message():
     assert latest_on_bus.packet.id == 0x123
 
 
+def test_rust_can_interface_exposes_recorded_frames_in_place():
+    runtime = FirmwareRuntime()
+    runtime.add_node("source", FakeNode())
+    runtime.add_node("sink", FakeNode())
+    source = NativeCanInterfaceHarness()
+    sink = NativeCanInterfaceHarness()
+    for index in range(3):
+        source.queue(
+            0, CanPacket.from_payload(0x100 + index, bytes([index])), timestamp_ns=index
+        )
+
+    assert runtime.add_can_route(
+        source_node="source",
+        source_bus=0,
+        source_tx_count=_function_address(source.tx_count),
+        source_recv_events=_function_address(source.recv_events),
+        sink_node="sink",
+        sink_bus=0,
+        sink_send_many=_function_address(sink.send_many),
+    )
+    runtime.run_for(1_000_000, 1_000_000)
+
+    ring = runtime.can_record_ring("source", 0)
+    assert ring is not None
+    assert ring.written == 3
+    frames = (CanEvent * ring.capacity).from_address(ring.frames)
+    assert [frames[index].packet.id for index in range(3)] == [0x100, 0x101, 0x102]
+    assert [packet.id for packet in sink.received_by_bus[0]] == [0x100, 0x101, 0x102]
+    assert runtime.can_record_ring("sink", 0) is None
+
+
 def test_rust_can_interface_records_source_only_events_without_sink():
     runtime = FirmwareRuntime()
     runtime.add_node("source", FakeNode())
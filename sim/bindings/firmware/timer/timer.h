@@ -24,6 +24,7 @@ bool     rig_runtime_timer_push_duty_input(const rig_timer_channel_event_S* even
 bool     rig_runtime_timer_latest_duty_input(int32_t port, int32_t channel, float32_t* value);
 bool     rig_runtime_timer_push_frequency_input(const rig_timer_channel_event_S* event);
 bool     rig_runtime_timer_latest_frequency_input(int32_t port, int32_t channel, float32_t* value);
+void     rig_runtime_timer_capture_reset(void);
 bool     rig_runtime_timer_push_capture_input(const rig_timer_capture_event_S* event);
 bool     rig_runtime_timer_latest_capture_input(int32_t channel, float32_t* value);
 bool     rig_runtime_timer_push_duty_output(const rig_timer_channel_event_S* event);
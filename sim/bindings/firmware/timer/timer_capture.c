@@ -1,17 +1,106 @@
 #include "timer.h"
 
+#include "runtime_state.h"
+
 #include "HW_tim.h"
+#include "lib_edgeSpeed.h"
+
+#include <string.h>
+
+// The capture input of a channel is the wheel speed in revolutions per second.
+// Edges are generated from it as simulated time advances, at the rate of the
+// wheel speed sensors, and the firmware's edge speed engine measures them just
+// like it measures the edges captured by the timer on the target. The
+// constants mirror HW_tim_vcSpecific.c.
+#define CAPTURE_CHANNEL_COUNT    4U
+#define EDGES_PER_REV            8U
+#define BASE_TICKS_PER_SEC       1000000U
+#define WINDOW_US                5000U
+#define TIMEOUT_US               500000U
+
+typedef struct
+{
+    lib_edgeSpeed_ring_S edges;
+    double               nextEdgeNs;
+    uint64_t             advancedNs;    // edges are generated up to this time
+    bool                 turning;
+} capture_channel_S;
+
+static capture_channel_S channels[CAPTURE_CHANNEL_COUNT];
+
+static const lib_edgeSpeed_config_S edgeSpeedConfig = {
+    .windowTicks    = WINDOW_US,
+    .timeoutTicks   = TIMEOUT_US,
+    .ticksPerSecond = BASE_TICKS_PER_SEC,
+    .maxIntervals   = EDGES_PER_REV,
+};
+
+void rig_runtime_timer_capture_reset(void)
+{
+    memset(channels, 0x00, sizeof(channels));
+}
+
+static capture_channel_S* advance(HW_TIM_channelFreq_E channel)
+{
+    if ((uint32_t)channel >= CAPTURE_CHANNEL_COUNT)
+    {
+        return NULL;
+    }
+
+    capture_channel_S* capture = &channels[channel];
+    const uint64_t     now     = rig_runtime.time_ns;
+    float32_t          revPerS = 0.0f;
+
+    (void)rig_runtime_timer_latest_capture_input((int32_t)channel, &revPerS);
+
+    if (revPerS <= 0.0f)
+    {
+        capture->turning = false;
+    }
+    else
+    {
+        const double periodNs = 1e9 / ((double)revPerS * (double)EDGES_PER_REV);
+
+        // the wheel started turning since the last look
+        if (!capture->turning)
+        {
+            capture->nextEdgeNs = (double)capture->advancedNs + periodNs;
+            capture->turning    = true;
+        }
+
+        // older edges would be overwritten before anyone reads them
+        const double behind = ((double)now - capture->nextEdgeNs) / periodNs;
+        if (behind > (double)LIB_EDGESPEED_RING_SIZE)
+        {
+            capture->nextEdgeNs += (double)(uint64_t)(behind - (double)LIB_EDGESPEED_RING_SIZE) * periodNs;
+        }
+
+        while (capture->nextEdgeNs <= (double)now)
+        {
+            lib_edgeSpeed_push(&capture->edges, (uint64_t)(capture->nextEdgeNs / 1000.0));
+            capture->nextEdgeNs += periodNs;
+        }
+    }
+
+    capture->advancedNs = now;
+    return capture;
+}
 
 float32_t HW_TIM_getFreq(HW_TIM_channelFreq_E channel)
 {
-    float32_t value = 0.0f;
+    const capture_channel_S* capture = advance(channel);
 
-    (void)rig_runtime_timer_latest_capture_input((int32_t)channel, &value);
-    return value;
+    if (capture == NULL)
+    {
+        return 0.0f;
+    }
+
+    return lib_edgeSpeed_getEdgeRate(&capture->edges, &edgeSpeedConfig, HW_TIM_getBaseTick()) / (float32_t)EDGES_PER_REV;
 }
 
 uint64_t HW_TIM_getLastCaptureBaseTick(HW_TIM_channelFreq_E channel)
 {
-    (void)channel;
-    return HW_TIM_getBaseTick();
+    const capture_channel_S* capture = advance(channel);
+
+    return (capture == NULL) ? 0U : lib_edgeSpeed_getLastEdge(&capture->edges);
 }
@@ -13,3 +13,23 @@ HW_StatusTypeDef_E HW_UART_stopDMA(HW_UART_port_E port)
     (void)port;
     return HW_OK;
 }
+
+HW_StatusTypeDef_E HW_UART_startDMARXIdle(HW_UART_port_E port, uint8_t* data, uint32_t size, HW_UART_rxCallback_t callback)
+{
+    (void)port;
+    (void)data;
+    (void)size;
+    (void)callback;
+    return HW_OK;
+}
+
+HW_StatusTypeDef_E HW_UART_restartDMARXIdle(HW_UART_port_E port)
+{
+    (void)port;
+    return HW_OK;
+}
+
+void HW_UART_IRQHandler(HW_UART_port_E port)
+{
+    (void)port;
+}
@@ -11,5 +11,10 @@ typedef enum
     RIG_HW_UART_PORT_UNUSED = 0U,
 } HW_UART_port_E;
 
+typedef void (*HW_UART_rxCallback_t)(uint32_t rxCount);
+
 HW_StatusTypeDef_E HW_UART_startDMARX(HW_UART_port_E port, uint32_t* data, uint32_t size);
 HW_StatusTypeDef_E HW_UART_stopDMA(HW_UART_port_E port);
+HW_StatusTypeDef_E HW_UART_startDMARXIdle(HW_UART_port_E port, uint8_t* data, uint32_t size, HW_UART_rxCallback_t callback);
+HW_StatusTypeDef_E HW_UART_restartDMARXIdle(HW_UART_port_E port);
+void               HW_UART_IRQHandler(HW_UART_port_E port);
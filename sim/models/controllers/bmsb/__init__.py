@@ -21,6 +21,7 @@ def _load_generated() -> None:
     globals()["DigitalIo"] = enums.DigitalIo
     globals()["DigitalOutput"] = enums.DigitalOutput
     globals()["Fault"] = enums.Fault
+    globals()["Module"] = enums.Module
     globals()["PrechargeContactorState"] = enums.PrechargeContactorState
     globals()["TimerChannel"] = enums.TimerChannel
     globals()["TimerPort"] = enums.TimerPort
@@ -82,6 +83,7 @@ __all__ = [
     "DigitalIo",
     "DigitalOutput",
     "Fault",
+    "Module",
     "PrechargeContactorState",
     "TimerChannel",
     "TimerPort",
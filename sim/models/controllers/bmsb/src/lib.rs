@@ -43,7 +43,7 @@ use bindings::drv_inputAD_channelDigital_E::{
 use bindings::drv_outputAD_channelDigital_E::DRV_OUTPUTAD_DIGITAL_LED;
 use rig_runtime::nvm::ControllerNvm;
 use rig_runtime::node_abi::ModelDataPathProvider;
-use rig_runtime::{AppDesc, ModuleDesc, NodeModel, NodeTarget, RTController};
+use rig_runtime::{AppDesc, MODULE_PHASE_AUTO, ModuleDesc, NodeModel, NodeTarget, RTController};
 use std::sync::Mutex;
 
 const BMSB_APP_START: u32 = 0x0800_2000;
@@ -71,7 +71,12 @@ unsafe extern "C" fn bmsb_sys_1hz() {
 }
 
 #[unsafe(no_mangle)]
-pub static SYS_desc: ModuleDesc = ModuleDesc::new(None, None, None, None, Some(bmsb_sys_1hz));
+pub static SYS_desc: ModuleDesc = ModuleDesc::new(None, None, None, None, None).scheduled(
+    bmsb_sys_1hz,
+    1000,
+    MODULE_PHASE_AUTO,
+    10,
+);
 
 struct Bmsb {
     nvm: ControllerNvm<
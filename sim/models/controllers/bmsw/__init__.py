@@ -23,7 +23,7 @@ def _load_generated() -> None:
         "bmsw_generated_enums",
         globals(),
     )
-    for name in ("AnalogInput", "DigitalInput", "DigitalIo", "Fault"):
+    for name in ("AnalogInput", "DigitalInput", "DigitalIo", "Fault", "Module"):
         globals()[name] = getattr(enums, name)
 
     class BmswModel(extend_model_class(model.BmswModel, BmswModelExtensions)):
@@ -40,7 +40,14 @@ def __getattr__(name: str):
 
         globals()["BMSW_CLUSTERS"] = BMSW_CLUSTERS
         return BMSW_CLUSTERS
-    if name in {"BmswModel", "AnalogInput", "DigitalInput", "DigitalIo", "Fault"}:
+    if name in {
+        "BmswModel",
+        "AnalogInput",
+        "DigitalInput",
+        "DigitalIo",
+        "Fault",
+        "Module",
+    }:
         _load_generated()
         return globals()[name]
     raise AttributeError(name)
@@ -57,5 +64,6 @@ __all__ = [
     "DigitalInput",
     "DigitalIo",
     "Fault",
+    "Module",
     "BMSW_CLUSTERS",
 ]
@@ -1,3 +1,4 @@
+#include "HW_cellScan.h"
 #include "LIB_Types.h"
 
 // The production BMSW cooling module references the tachometer capture
@@ -13,3 +14,18 @@ float32_t HW_TIM1_getFreqCH2(void)
 {
     return 0.0f;
 }
+
+// The cell scan burst is driven by the MCU timer and SPI DMA, which SIL doesn't
+// link. The input shim keeps stepping one cell per tick, so the scan statistics
+// reported on CAN stay at zero.
+static const HW_cellScan_stats_S cellScanStats;
+
+const HW_cellScan_stats_S* HW_cellScan_getStats(void)
+{
+    return &cellScanStats;
+}
+
+uint16_t HW_cellScan_getCellsPerSecond(void)
+{
+    return 0U;
+}
@@ -87,6 +87,7 @@ def _load_generated() -> None:
     globals()["DigitalIo"] = enums.DigitalIo
     globals()["DigitalOutput"] = enums.DigitalOutput
     globals()["DigitalStatus"] = enums.DigitalStatus
+    globals()["Module"] = enums.Module
     globals()["TimerChannel"] = enums.TimerChannel
     globals()["TimerPort"] = enums.TimerPort
 
@@ -223,6 +224,7 @@ __all__ = [
     "DigitalIo",
     "DigitalOutput",
     "DigitalStatus",
+    "Module",
     "TimerChannel",
     "TimerPort",
     "PLATFORM_VARIANTS",
@@ -41,7 +41,7 @@ use bindings::HW_GPIO_pinmux_E::{
 };
 use rig_runtime::nvm::ControllerNvm;
 use rig_runtime::node_abi::ModelDataPathProvider;
-use rig_runtime::{AppDesc, ModuleDesc, NodeModel, NodeTarget, RTController};
+use rig_runtime::{AppDesc, MODULE_PHASE_AUTO, ModuleDesc, NodeModel, NodeTarget, RTController};
 use std::sync::Mutex;
 
 const SWS_APP_START: u32 = 0x0800_2000;
@@ -89,7 +89,12 @@ unsafe extern "C" fn sws_sys_1hz() {
 }
 
 #[unsafe(no_mangle)]
-pub static sys_desc: ModuleDesc = ModuleDesc::new(None, None, None, None, Some(sws_sys_1hz));
+pub static sys_desc: ModuleDesc = ModuleDesc::new(None, None, None, None, None).scheduled(
+    sws_sys_1hz,
+    1000,
+    MODULE_PHASE_AUTO,
+    10,
+);
 
 struct Sws {
     nvm: ControllerNvm<
@@ -19,6 +19,7 @@ def _load_generated() -> None:
     globals()["DigitalIo"] = enums.DigitalIo
     globals()["DigitalOutput"] = enums.DigitalOutput
     globals()["Fault"] = enums.Fault
+    globals()["Module"] = enums.Module
     globals()["TimerChannel"] = enums.TimerChannel
     globals()["TimerPort"] = enums.TimerPort
     VcfrontPytestHelpers.AnalogInput = enums.AnalogInput
@@ -75,6 +76,7 @@ __all__ = [
     "DigitalIo",
     "DigitalOutput",
     "Fault",
+    "Module",
     "TimerChannel",
     "TimerPort",
     "VCFRONT_CLUSTERS",
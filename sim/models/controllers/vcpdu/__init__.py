@@ -21,6 +21,7 @@ def _load_generated() -> None:
     globals()["DigitalIo"] = enums.DigitalIo
     globals()["DigitalOutput"] = enums.DigitalOutput
     globals()["Fault"] = enums.Fault
+    globals()["Module"] = enums.Module
     globals()["SpiDevice"] = enums.SpiDevice
     globals()["TimerChannel"] = enums.TimerChannel
     globals()["TimerPort"] = enums.TimerPort
@@ -92,6 +93,7 @@ __all__ = [
     "DigitalIo",
     "DigitalOutput",
     "Fault",
+    "Module",
     "HsdState",
     "SpiDevice",
     "TimerChannel",
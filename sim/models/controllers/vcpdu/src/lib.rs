@@ -41,7 +41,7 @@ use bindings::drv_inputAD_channelAnalog_E::{
 use bindings::drv_outputAD_channelDigital_E::DRV_OUTPUTAD_DIGITAL_LED;
 use rig_runtime::nvm::ControllerNvm;
 use rig_runtime::node_abi::ModelDataPathProvider;
-use rig_runtime::{AppDesc, ModuleDesc, NodeModel, NodeTarget, RTController};
+use rig_runtime::{AppDesc, MODULE_PHASE_AUTO, ModuleDesc, NodeModel, NodeTarget, RTController};
 use std::sync::Mutex;
 
 const VCPDU_APP_START: u32 = 0x0800_2000;
@@ -69,7 +69,12 @@ unsafe extern "C" fn vcpdu_sys_1hz() {
 }
 
 #[unsafe(no_mangle)]
-pub static sys_desc: ModuleDesc = ModuleDesc::new(None, None, None, None, Some(vcpdu_sys_1hz));
+pub static sys_desc: ModuleDesc = ModuleDesc::new(None, None, None, None, None).scheduled(
+    vcpdu_sys_1hz,
+    1000,
+    MODULE_PHASE_AUTO,
+    10,
+);
 
 struct Vcpdu {
     nvm: ControllerNvm<
@@ -18,6 +18,7 @@ def _load_generated() -> None:
     globals()["DigitalIo"] = enums.DigitalIo
     globals()["DigitalOutput"] = enums.DigitalOutput
     globals()["Fault"] = enums.Fault
+    globals()["Module"] = enums.Module
     globals()["TimerChannel"] = enums.TimerChannel
     globals()["TimerPort"] = enums.TimerPort
 
@@ -73,6 +74,7 @@ __all__ = [
     "DigitalIo",
     "DigitalOutput",
     "Fault",
+    "Module",
     "TimerChannel",
     "TimerPort",
     "VCREAR_CLUSTERS",
@@ -38,7 +38,7 @@ mod rust_decode_generated {
 use bindings::drv_outputAD_channelDigital_E::DRV_OUTPUTAD_DIGITAL_LED;
 use rig_runtime::nvm::ControllerNvm;
 use rig_runtime::node_abi::ModelDataPathProvider;
-use rig_runtime::{AppDesc, ModuleDesc, NodeModel, NodeTarget, RTController};
+use rig_runtime::{AppDesc, MODULE_PHASE_AUTO, ModuleDesc, NodeModel, NodeTarget, RTController};
 use std::sync::Mutex;
 
 const VCREAR_APP_START: u32 = 0x0800_2000;
@@ -66,7 +66,12 @@ unsafe extern "C" fn vcrear_sys_1hz() {
 }
 
 #[unsafe(no_mangle)]
-pub static sys_desc: ModuleDesc = ModuleDesc::new(None, None, None, None, Some(vcrear_sys_1hz));
+pub static sys_desc: ModuleDesc = ModuleDesc::new(None, None, None, None, None).scheduled(
+    vcrear_sys_1hz,
+    1000,
+    MODULE_PHASE_AUTO,
+    10,
+);
 
 struct Vcrear {
     nvm: ControllerNvm<
@@ -8,24 +8,30 @@ from .catalog import ClusterCatalog
 from sim.bindings.firmware.runtime import FirmwareClusterRig
 
 
+# One rig per cluster for the whole session, shared by every fixture that
+# hands it out, since a node's firmware library can only be loaded once.
+_rigs: dict[str, FirmwareClusterRig] = {}
+
+
 def cluster_rig_fixture(
     catalog: ClusterCatalog,
     *,
     setup: Callable[[FirmwareClusterRig], None] | None = None,
+    scope: str = "function",
 ):
     cases = catalog.pytest_cases()
-    rigs: dict[str, FirmwareClusterRig] = {}
 
     @pytest.fixture(
         params=cases,
         ids=lambda cluster: cluster.name,
+        scope=scope,
     )
     def fixture(request) -> FirmwareClusterRig:
         cluster = request.param
-        rig = rigs.get(cluster.name)
+        rig = _rigs.get(cluster.name)
         if rig is None:
             rig = cluster.rig()
-            rigs[cluster.name] = rig
+            _rigs[cluster.name] = rig
         else:
             rig.reset_to_initial_topology()
         if setup is not None:
@@ -1,7 +1,59 @@
 from __future__ import annotations
 
+import hashlib
+from collections.abc import Callable
+
+from sim.models.controllers.bmsb import DigitalIo
 from sim.models.pytest import cluster_rig_fixture
 
 from .variants import VEHICLE_CLUSTERS
 
 vehicle_cluster = cluster_rig_fixture(VEHICLE_CLUSTERS)
+# The same rigs, for fixtures that build up a state once per module
+vehicle_cluster_module = cluster_rig_fixture(VEHICLE_CLUSTERS, scope="module")
+
+
+def configure_vehicle_bmsb(bmsb) -> None:
+    """Drive the BMSB safety inputs to a healthy pack with TSMS open."""
+    for input_ in (
+        DigitalIo.VPACK_DIAG,
+        DigitalIo.OK_HS,
+        DigitalIo.BMS_IMD_RESET,
+    ):
+        bmsb.set_digital_io(input_, True)
+    bmsb.set_digital_io(DigitalIo.TSMS_CHG, False)
+    bmsb.set_digital_io(DigitalIo.VPACK_DIAG, False)
+
+
+def can_trace_hash(
+    cluster,
+    configure_runtime: Callable[[object], None],
+    *,
+    duration_ms: int,
+    step_ms: float = 1,
+) -> str:
+    """Hash of every node's latest CAN frames after each 10 ms of a run.
+
+    The cluster is reset, ``configure_runtime`` is applied to its runtime and
+    TSMS is closed halfway through, so two runs that differ only in how the
+    runtime steps must produce the same hash.
+    """
+    cluster.reset_to_initial_topology()
+    configure_runtime(cluster.runtime)
+    configure_vehicle_bmsb(cluster.bmsb)
+
+    trace = hashlib.blake2b(digest_size=16)
+    for elapsed_ms in range(0, duration_ms, 10):
+        if elapsed_ms == duration_ms // 2:
+            cluster.bmsb.set_digital_io(DigitalIo.TSMS_CHG, True)
+        cluster.run_for(10, step=step_ms)
+        for name, node in cluster.nodes.items():
+            if node.can is None:
+                continue
+            for message in node.can.tx_messages:
+                event = node.can.latest_event(message)
+                if event is None:
+                    continue
+                trace.update(f"{name}:{message.name}:{event.timestamp_ns}:".encode())
+                trace.update(event.packet.payload)
+    return trace.hexdigest()
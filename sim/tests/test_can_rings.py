@@ -0,0 +1,76 @@
+import time
+
+from sim.models.controllers.bmsb import DigitalIo
+from sim.models.vehicle.fixtures import configure_vehicle_bmsb, vehicle_cluster
+
+TRACE_DURATION_MS = 500
+BENCHMARK_DURATION_MS = 2000
+
+
+def _can_sources(cluster):
+    return tuple(
+        (name, bus)
+        for name, node in cluster.nodes.items()
+        if node.can is not None
+        for bus in node.can.buses
+    )
+
+
+def _frames_sent(cluster, sources) -> int:
+    rings = (cluster.runtime.can_record_ring(name, bus.index) for name, bus in sources)
+    return sum(ring.written for ring in rings if ring is not None)
+
+
+def test_record_rings_hold_every_frame_each_node_sent(vehicle_cluster):
+    configure_vehicle_bmsb(vehicle_cluster.bmsb)
+    sources = _can_sources(vehicle_cluster)
+    cursors = dict.fromkeys(sources, 0)
+    frames = {source: [] for source in sources}
+
+    for _ in range(0, TRACE_DURATION_MS, 10):
+        vehicle_cluster.run_for(10, step=1)
+        for name, bus in sources:
+            batch = vehicle_cluster.comm.can.frames(
+                name, bus, since=cursors[(name, bus)]
+            )
+            assert batch.dropped == 0
+            cursors[(name, bus)] = batch.cursor
+            frames[(name, bus)].extend(batch.events)
+
+    assert any(frames.values())
+    for (name, bus), events in frames.items():
+        timestamps = [event.timestamp_ns for event in events]
+        assert timestamps == sorted(timestamps)
+        latest = {}
+        for event in events:
+            latest[event.packet.id] = event
+        node = vehicle_cluster.nodes[name]
+        for message in node.can.tx_messages:
+            if message.bus != bus.index or message.id not in latest:
+                continue
+            event = node.can.latest_event(message)
+            assert event is not None
+            assert event.timestamp_ns == latest[message.id].timestamp_ns
+            assert event.packet.payload == latest[message.id].packet.payload
+
+
+def test_can_frame_throughput(vehicle_cluster, capsys):
+    """Report CAN frames routed per wall second through the whole vehicle."""
+    configure_vehicle_bmsb(vehicle_cluster.bmsb)
+    sources = _can_sources(vehicle_cluster)
+    vehicle_cluster.bmsb.set_digital_io(DigitalIo.TSMS_CHG, True)
+    vehicle_cluster.run_for(100, step=1)
+
+    sent_before = _frames_sent(vehicle_cluster, sources)
+    started = time.perf_counter()
+    vehicle_cluster.run_for(BENCHMARK_DURATION_MS, step=1)
+    wall_s = time.perf_counter() - started
+    frames = _frames_sent(vehicle_cluster, sources) - sent_before
+
+    with capsys.disabled():
+        print(
+            f"\n{vehicle_cluster.name}: {len(vehicle_cluster.nodes)} nodes, "
+            f"{frames} CAN frames in {wall_s:.2f} s wall "
+            f"({frames / wall_s:.0f} frames/s)"
+        )
+    assert frames > 0
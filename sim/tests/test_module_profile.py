@@ -0,0 +1,150 @@
+from sim.bindings.firmware.runtime import FirmwareNodeRig, ModuleTask, SwiPriority
+from sim.models.controllers.vcfront import Module
+from sim.models.controllers.vcfront.fixtures import vcfront_cluster
+from sim.models.vehicle.fixtures import vehicle_cluster
+
+PROFILE_DURATION_MS = 1000
+REPORT_ROWS = 5
+# Creation order in FreeRTOSResources.c: CANRX_swi, then CANTX_swi.
+CANTX_SWI = (SwiPriority.PRI_0, 1)
+
+
+def _firmware_nodes(cluster):
+    return {
+        name: node
+        for name, node in cluster.nodes.items()
+        if isinstance(node, FirmwareNodeRig)
+    }
+
+
+def test_module_profiles_time_every_callback_run(vcfront_cluster):
+    vcfront = vcfront_cluster.vcfront
+    vcfront.reset_module_profiles()
+    vcfront_cluster.run_for(PROFILE_DURATION_MS, step=1)
+
+    assert vcfront.module_profile(ModuleTask.RATE_1KHZ, Module.UDS).count == 1000
+    assert vcfront.module_profile(ModuleTask.RATE_100HZ, Module.TORQUE).count == 100
+    assert vcfront.module_profile(ModuleTask.RATE_1KHZ, Module.TORQUE).count == 0
+    assert vcfront.module_profile(ModuleTask.RATE_1KHZ, Module.CNT) is None
+
+    for name, node in _firmware_nodes(vcfront_cluster).items():
+        for task in ModuleTask:
+            task_profile = node.module_task_profile(task)
+            assert task_profile.budget_cycles == task.period_ns, (name, task)
+            for index, profile in enumerate(node.module_profiles(task)):
+                if profile.count == 0:
+                    continue
+                where = (name, task.name, index)
+                assert profile.min_cycles <= profile.mean_cycles <= profile.max_cycles, where
+                assert sum(profile.histogram) == profile.count, where
+                assert profile.max_cycles <= task_profile.max_cycles, where
+
+    vcfront.reset_module_profiles()
+    assert vcfront.module_profile(ModuleTask.RATE_1KHZ, Module.UDS).count == 0
+
+
+def test_rolling_can_message_reports_profiled_callbacks(vcfront_cluster):
+    vcfront = vcfront_cluster.vcfront
+    vcfront_cluster.run_for(PROFILE_DURATION_MS, step=1)
+
+    def signal(name):
+        return vcfront.can.latest_signal(
+            "VCFRONT_rtosModuleProfile", f"VCFRONT_{name}", bus="veh"
+        )
+
+    task = ModuleTask(int(signal("moduleProfileTask")))
+    module = int(signal("moduleProfileModule"))
+    profile = vcfront.module_profile(task, module)
+    assert profile is not None and profile.count > 0
+    assert signal("moduleProfileMaxUs") >= signal("moduleProfileMeanUs")
+
+
+def test_static_schedule_spreads_bookkeeping_into_quiet_slots(vcfront_cluster):
+    vcfront = vcfront_cluster.vcfront
+    vcfront.reset_module_profiles()
+    vcfront_cluster.run_for(PROFILE_DURATION_MS, step=1)
+
+    phases = {
+        module: vcfront.module_schedule_phase(module)
+        for module in (Module.BRAKETEMP, Module.SYS)
+    }
+    assert None not in phases.values()
+    # Slots on a 10 ms boundary also release the 100 Hz chain.
+    assert all(phase % 10 for phase in phases.values())
+    assert len(set(phases.values())) == len(phases)
+    assert vcfront.module_schedule_phase(Module.TORQUE) is None
+    assert vcfront.module_schedule_worst_slot_load_us() == 20
+
+    assert vcfront.scheduled_module_profile(Module.BRAKETEMP).count == 10
+    assert vcfront.scheduled_module_profile(Module.SYS).count == 1
+    assert vcfront.module_profile(ModuleTask.RATE_10HZ, Module.BRAKETEMP).count == 0
+    assert vcfront.scheduled_module_profile(Module.CNT) is None
+
+
+def test_every_scheduled_callback_fits_the_schedule(vehicle_cluster):
+    for name, node in _firmware_nodes(vehicle_cluster).items():
+        assert node.module_schedule_rejected() == 0, name
+
+
+def test_swi_stats_account_for_every_invocation(vcfront_cluster):
+    vcfront = vcfront_cluster.vcfront
+    vcfront.reset_swi_stats()
+    vcfront_cluster.run_for(PROFILE_DURATION_MS, step=1)
+
+    assert vcfront.swi_stats(*CANTX_SWI).runs > 0
+    assert vcfront.swi_stats(SwiPriority.PRI_2, 0) is None
+
+    for name, node in _firmware_nodes(vcfront_cluster).items():
+        for priority in SwiPriority:
+            for index in range(2):
+                stats = node.swi_stats(priority, index)
+                if stats is None:
+                    continue
+                where = (name, priority.name, index)
+                assert stats.invocations == (
+                    stats.runs + stats.coalesced + stats.pending
+                ), where
+                assert sum(stats.latency_histogram) == stats.runs, where
+                assert sum(stats.run_histogram) == stats.runs, where
+
+    vcfront.reset_swi_stats()
+    assert vcfront.swi_stats(*CANTX_SWI).invocations == 0
+
+
+def test_module_execution_time_report(vehicle_cluster, capsys):
+    """Report the slowest module callbacks of every node on the host."""
+    vehicle_cluster.run_for(PROFILE_DURATION_MS, step=1)
+
+    rows = []
+    misses = {}
+    for name, node in _firmware_nodes(vehicle_cluster).items():
+        for task in ModuleTask:
+            misses[(name, task)] = node.module_task_profile(task).deadline_misses
+            for index, profile in enumerate(node.module_profiles(task)):
+                if profile.count:
+                    rows.append((profile.max_cycles, name, task, index, profile))
+    rows.sort(key=lambda row: row[0], reverse=True)
+
+    with capsys.disabled():
+        print(f"\n{vehicle_cluster.name}: slowest module callbacks, host ns")
+        print(f"{'node':>10} {'task':>10} {'module':>6} {'mean':>8} {'max':>8}")
+        for max_ns, name, task, index, profile in rows[:REPORT_ROWS]:
+            print(
+                f"{name:>10} {task.name:>10} {index:>6} "
+                f"{profile.mean_cycles:>8.0f} {max_ns:>8}"
+            )
+        for (name, task), count in misses.items():
+            if count:
+                print(f"{name} {task.name}: {count} deadline misses")
+        for name, node in _firmware_nodes(vehicle_cluster).items():
+            print(
+                f"{name}: worst scheduled slot load "
+                f"{node.module_schedule_worst_slot_load_us()} us"
+            )
+            stats = node.swi_stats(*CANTX_SWI)
+            if stats is not None and stats.runs:
+                print(
+                    f"{name}: CANTX SWI worst latency "
+                    f"{stats.max_latency_cycles} ns over {stats.runs} runs"
+                )
+    assert rows
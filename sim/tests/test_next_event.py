@@ -0,0 +1,57 @@
+import time
+
+from sim.models.vehicle.fixtures import (
+    can_trace_hash,
+    configure_vehicle_bmsb,
+    vehicle_cluster,
+)
+
+TRACE_DURATION_MS = 1000
+BENCHMARK_DURATION_MS = 2000
+STEPS_MS = (1, 0.1, 0.01)
+
+
+def _stepped_trace_hash(cluster, *, next_event: bool, step_ms: float) -> str:
+    return can_trace_hash(
+        cluster,
+        lambda runtime: runtime.set_next_event(next_event),
+        duration_ms=TRACE_DURATION_MS,
+        step_ms=step_ms,
+    )
+
+
+def test_next_event_replays_the_fixed_step_can_trace(vehicle_cluster):
+    try:
+        for step_ms in STEPS_MS[:2]:
+            fixed = _stepped_trace_hash(vehicle_cluster, next_event=False, step_ms=step_ms)
+            assert (
+                _stepped_trace_hash(vehicle_cluster, next_event=True, step_ms=step_ms) == fixed
+            ), f"next-event CAN trace at a {step_ms} ms step differs from fixed stepping"
+    finally:
+        vehicle_cluster.runtime.set_next_event(False)
+
+
+def test_next_event_throughput_by_step(vehicle_cluster, capsys):
+    """Report simulated seconds per wall second for fixed and next-event steps."""
+    rows = []
+    try:
+        for step_ms in STEPS_MS:
+            for next_event in (False, True):
+                vehicle_cluster.reset_to_initial_topology()
+                vehicle_cluster.runtime.set_next_event(next_event)
+                configure_vehicle_bmsb(vehicle_cluster.bmsb)
+
+                started = time.perf_counter()
+                vehicle_cluster.run_for(BENCHMARK_DURATION_MS, step=step_ms)
+                wall_s = time.perf_counter() - started
+                rows.append((step_ms, next_event, BENCHMARK_DURATION_MS / 1000 / wall_s))
+    finally:
+        vehicle_cluster.runtime.set_next_event(False)
+
+    with capsys.disabled():
+        print(f"\n{vehicle_cluster.name}: simulated s per wall s")
+        print(f"{'step ms':>7} {'mode':>10} {'sim/wall':>9}")
+        for step_ms, next_event, rate in rows:
+            mode = "next-event" if next_event else "fixed"
+            print(f"{step_ms:>7} {mode:>10} {rate:>9.2f}")
+    assert all(rate > 0 for _, _, rate in rows)
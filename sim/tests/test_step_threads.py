@@ -0,0 +1,58 @@
+import os
+import time
+
+from sim.models.vehicle.fixtures import can_trace_hash, vehicle_cluster
+
+TRACE_DURATION_MS = 1000
+BENCHMARK_DURATION_MS = 2000
+
+
+def _step_thread_counts() -> tuple[int, ...]:
+    cpus = os.cpu_count() or 1
+    return tuple(sorted({1, min(2, cpus), min(4, cpus), cpus}))
+
+
+def _threaded_trace_hash(cluster, threads: int) -> str:
+    return can_trace_hash(
+        cluster,
+        lambda runtime: runtime.set_step_threads(threads),
+        duration_ms=TRACE_DURATION_MS,
+    )
+
+
+def test_parallel_stepping_replays_the_sequential_can_trace(vehicle_cluster):
+    try:
+        sequential = _threaded_trace_hash(vehicle_cluster, 1)
+        for threads in _step_thread_counts()[1:]:
+            assert _threaded_trace_hash(vehicle_cluster, threads) == sequential, (
+                f"CAN trace with {threads} step threads differs from sequential stepping"
+            )
+    finally:
+        vehicle_cluster.runtime.set_step_threads(1)
+
+
+def test_step_thread_throughput_by_node_count(vehicle_cluster, capsys):
+    """Report simulated seconds per wall second against online node count."""
+    names = tuple(vehicle_cluster.nodes)
+    rows = []
+    try:
+        for node_count in range(1, len(names) + 1):
+            for threads in _step_thread_counts():
+                vehicle_cluster.reset_to_initial_topology()
+                vehicle_cluster.runtime.set_step_threads(threads)
+                for name in names[node_count:]:
+                    vehicle_cluster.disable_node(name)
+
+                started = time.perf_counter()
+                vehicle_cluster.run_for(BENCHMARK_DURATION_MS, step=1)
+                wall_s = time.perf_counter() - started
+                rows.append((node_count, threads, BENCHMARK_DURATION_MS / 1000 / wall_s))
+    finally:
+        vehicle_cluster.runtime.set_step_threads(1)
+
+    with capsys.disabled():
+        print(f"\n{vehicle_cluster.name}: simulated s per wall s")
+        print(f"{'nodes':>5} {'threads':>7} {'sim/wall':>9}")
+        for node_count, threads, rate in rows:
+            print(f"{node_count:>5} {threads:>7} {rate:>9.2f}")
+    assert all(rate > 0 for _, _, rate in rows)
@@ -0,0 +1,58 @@
+import time
+
+from sim.models.controllers.bmsb import DigitalIo
+from sim.models.controllers.vcpdu import VehicleState
+from sim.models.vehicle.fixtures import configure_vehicle_bmsb, vehicle_cluster
+
+ENDURANCE_DURATION_MS = 60_000
+
+
+def _set_tickless(cluster, enabled: bool) -> None:
+    cluster.set_tickless(enabled)
+    cluster.runtime.set_next_event(enabled)
+
+
+def test_tickless_vehicle_follows_the_strict_state_sequence(vehicle_cluster):
+    try:
+        _set_tickless(vehicle_cluster, True)
+        vehicle_cluster.reset_to_initial_topology()
+        assert all(
+            node.tickless
+            for node in vehicle_cluster.nodes.values()
+            if hasattr(node, "tickless")
+        )
+        configure_vehicle_bmsb(vehicle_cluster.bmsb)
+
+        vehicle_cluster.run_for(750, step=1)
+        assert vehicle_cluster.vcpdu.latest_vehicle_state() == VehicleState.ON_GLV
+
+        vehicle_cluster.bmsb.set_digital_io(DigitalIo.TSMS_CHG, True)
+        vehicle_cluster.run_for(3000, step=1)
+        assert vehicle_cluster.vcpdu.latest_vehicle_state() == VehicleState.ON_HV
+    finally:
+        _set_tickless(vehicle_cluster, False)
+
+
+def test_tickless_endurance_throughput(vehicle_cluster, capsys):
+    """Report simulated seconds per wall second of an idle ON_GLV vehicle."""
+    rows = []
+    try:
+        for tickless in (False, True):
+            _set_tickless(vehicle_cluster, tickless)
+            vehicle_cluster.reset_to_initial_topology()
+            configure_vehicle_bmsb(vehicle_cluster.bmsb)
+
+            started = time.perf_counter()
+            vehicle_cluster.run_for(ENDURANCE_DURATION_MS, step=1)
+            wall_s = time.perf_counter() - started
+            assert vehicle_cluster.vcpdu.latest_vehicle_state() == VehicleState.ON_GLV
+            rows.append((tickless, ENDURANCE_DURATION_MS / 1000 / wall_s))
+    finally:
+        _set_tickless(vehicle_cluster, False)
+
+    with capsys.disabled():
+        print(f"\n{vehicle_cluster.name}: simulated s per wall s")
+        for tickless, rate in rows:
+            mode = "tickless" if tickless else "strict"
+            print(f"{mode:>8} {rate:>9.2f}")
+    assert all(rate > 0 for _, rate in rows)
@@ -0,0 +1,44 @@
+from sim.models.controllers.bmsb import DigitalIo
+from sim.models.controllers.vcpdu import VehicleState
+from sim.models.vehicle.fixtures import configure_vehicle_bmsb, vehicle_cluster
+
+GLV_DURATION_MS = 750
+HV_TIMEOUT_MS = 3000
+
+
+def test_trace_records_the_tsms_to_hv_transition(vehicle_cluster):
+    bmsb = vehicle_cluster.bmsb
+    vcpdu = vehicle_cluster.vcpdu
+    configure_vehicle_bmsb(bmsb)
+    recorder = vehicle_cluster.record_trace(
+        1, capacity=GLV_DURATION_MS + HV_TIMEOUT_MS
+    )
+    bmsb.trace_digital_io(recorder, DigitalIo.TSMS_CHG, name="tsms")
+    vcpdu.can.trace_signal(
+        recorder,
+        "VCPDU_vehicleState",
+        "VCPDU_vehicleState",
+        bus="veh",
+        name="vehicle_state",
+    )
+
+    vehicle_cluster.run_for(GLV_DURATION_MS, step=1)
+    tsms_closed_ns = vehicle_cluster.elapsed_ns
+    bmsb.set_digital_io(DigitalIo.TSMS_CHG, True)
+    vehicle_cluster.run_for(HV_TIMEOUT_MS, step=1)
+
+    trace = recorder.trace()
+    assert trace.dropped == 0
+    assert len(trace) == GLV_DURATION_MS + HV_TIMEOUT_MS
+    trace.window(end_ns=tsms_closed_ns).assert_never_exceeds(
+        "vehicle_state", VehicleState.ON_GLV
+    )
+    trace.assert_max_latency(
+        "tsms",
+        "vehicle_state",
+        limit_ns=HV_TIMEOUT_MS * 1_000_000,
+        response_when=lambda state: state == VehicleState.ON_HV,
+    )
+    trace.window(start_ns=tsms_closed_ns).assert_settles(
+        "vehicle_state", VehicleState.ON_HV, 0, within_ns=HV_TIMEOUT_MS * 1_000_000
+    )
@@ -239,6 +239,41 @@ def test_zero_vehicle_and_wheel_speed_preserves_torque_request_in_ts_run(
     assert vcfront.latest_torque_request() > 0
 
 
+def test_wheel_speeds_follow_captured_edges_and_decay_when_they_stop(
+    vcfront_cluster,
+):
+    vcfront = vcfront_cluster.vcfront
+    rev_per_s = {TimerChannel._1: 10.0, TimerChannel._2: 15.0}
+    for channel, value in rev_per_s.items():
+        vcfront._timer_peripherals.send(
+            vcfront.timer.capture_events(channel),
+            value=value,
+        )
+    vcfront_cluster.run_for(200, step=10)
+
+    wheel_speed = vcfront.can.latest("VCFRONT_wheelSpeed", bus="veh")
+    assert wheel_speed is not None
+    assert wheel_speed.VCFRONT_wheelSpeedFL == pytest.approx(600, abs=2)
+    assert wheel_speed.VCFRONT_wheelSpeedFR == pytest.approx(900, abs=2)
+
+    for channel in rev_per_s:
+        vcfront._timer_peripherals.send(
+            vcfront.timer.capture_events(channel),
+            value=0.0,
+        )
+    vcfront_cluster.run_until(
+        lambda: (
+            (message := vcfront.can.latest("VCFRONT_wheelSpeed", bus="veh"))
+            is not None
+            and message.VCFRONT_wheelSpeedFL == 0
+            and message.VCFRONT_wheelSpeedFR == 0
+        ),
+        timeout=1000,
+        step=10,
+        message="VCFRONT wheel speeds should decay to zero once the edges stop",
+    )
+
+
 @pytest.mark.parametrize(
     "apps1_position,apps2_position",
     [
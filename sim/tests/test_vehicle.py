@@ -1,3 +1,5 @@
+from collections.abc import Iterator
+
 import pytest
 
 from sim.models.components.drivetrain import DrivetrainModel
@@ -10,19 +12,13 @@ from sim.models.controllers.bmsb import (
 from sim.models.controllers.vcpdu import SleepFollowerState, VehicleState
 from sim.models.controllers.sws import SwsRequest
 from sim.models.controllers.vcfront import VcfrontSimpleModel
+from rig import ProcessSnapshot
 from rig.model_fixtures import InputTriggeredScalarSink
-from sim.models.vehicle.fixtures import vehicle_cluster
-
-
-def _configure_vehicle_bmsb(bmsb) -> None:
-    for input_ in (
-        DigitalIo.VPACK_DIAG,
-        DigitalIo.OK_HS,
-        DigitalIo.BMS_IMD_RESET,
-    ):
-        bmsb.set_digital_io(input_, True)
-    bmsb.set_digital_io(DigitalIo.TSMS_CHG, False)
-    bmsb.set_digital_io(DigitalIo.VPACK_DIAG, False)
+from sim.models.vehicle.fixtures import (
+    configure_vehicle_bmsb,
+    vehicle_cluster,
+    vehicle_cluster_module,
+)
 
 
 def _add_vehicle_test_inputs(vehicle_cluster):
@@ -50,7 +46,7 @@ def _enter_vehicle_ts_run(vehicle_cluster):
     bmsb = vehicle_cluster.bmsb
     vcfront = vehicle_cluster.vcfront
 
-    _configure_vehicle_bmsb(bmsb)
+    configure_vehicle_bmsb(bmsb)
     sws, _ = _add_vehicle_test_inputs(vehicle_cluster)
     vehicle_cluster.run_for(750, step=10)
     assert vehicle_cluster.vcpdu.latest_vehicle_state() == VehicleState.ON_GLV
@@ -99,7 +95,7 @@ def test_vehicle_drivetrain_only_outputs_torque_in_ts_run(vehicle_cluster):
     vcpdu = vehicle_cluster.vcpdu
     vcfront = vehicle_cluster.vcfront
 
-    _configure_vehicle_bmsb(bmsb)
+    configure_vehicle_bmsb(bmsb)
     sws, torque_sink = _add_vehicle_test_inputs(vehicle_cluster)
     vehicle_cluster.run_for(750, step=10)
     assert vcpdu.latest_vehicle_state() == VehicleState.ON_GLV
@@ -159,6 +155,41 @@ def test_vehicle_drivetrain_current_reaches_every_bmsw_segment(vehicle_cluster):
     assert all(segment.current_amps > 0.0 for segment in segments)
 
 
+@pytest.fixture(scope="module")
+def ts_run_snapshot(vehicle_cluster_module) -> Iterator[ProcessSnapshot]:
+    """Snapshot of the cluster in TS_RUN, shared by the drive-mode tests."""
+    _enter_vehicle_ts_run(vehicle_cluster_module)
+    snapshot = vehicle_cluster_module.snapshot()
+    yield snapshot
+    snapshot.close()
+
+
+def _request_race_mode(vehicle_cluster, brake_position: int) -> str:
+    vehicle_cluster.vcfront.set_brake_position(brake_position)
+    vehicle_cluster.sws.assert_request(SwsRequest.RACE)
+    vehicle_cluster.run_for(750, step=10)
+    torque_manager = vehicle_cluster.vcfront.can.latest(
+        "VCFRONT_torqueManager", bus="veh"
+    )
+    assert torque_manager is not None
+    return torque_manager.VCFRONT_raceMode.name
+
+
+def _request_launch_control(vehicle_cluster, brake_position: int) -> tuple[str, str]:
+    race_mode = _request_race_mode(vehicle_cluster, 50)
+
+    vehicle_cluster.sws.clear_request(SwsRequest.RACE)
+    vehicle_cluster.run_for(750, step=10)
+    vehicle_cluster.vcfront.set_brake_position(brake_position)
+    vehicle_cluster.sws.assert_request(SwsRequest.LAUNCH_CONTROL)
+    vehicle_cluster.run_for(750, step=10)
+    torque_manager = vehicle_cluster.vcfront.can.latest(
+        "VCFRONT_torqueManager", bus="veh"
+    )
+    assert torque_manager is not None
+    return race_mode, torque_manager.VCFRONT_launchControlState.name
+
+
 @pytest.mark.parametrize(
     "brake_position,expected_race_mode",
     [
@@ -167,16 +198,10 @@ def test_vehicle_drivetrain_current_reaches_every_bmsw_segment(vehicle_cluster):
     ],
 )
 def test_vehicle_enters_race_mode_only_with_brake_pressed(
-    vehicle_cluster, brake_position, expected_race_mode
+    ts_run_snapshot, brake_position, expected_race_mode
 ):
-    sws, vcfront = _enter_vehicle_ts_run(vehicle_cluster)
-
-    vcfront.set_brake_position(brake_position)
-    sws.assert_request(SwsRequest.RACE)
-    vehicle_cluster.run_for(750, step=10)
-    torque_manager = vcfront.can.latest("VCFRONT_torqueManager", bus="veh")
-    assert torque_manager is not None
-    assert torque_manager.VCFRONT_raceMode.name == expected_race_mode
+    race_mode = ts_run_snapshot.run(_request_race_mode, brake_position)
+    assert race_mode == expected_race_mode
 
 
 @pytest.mark.parametrize(
@@ -187,22 +212,10 @@ def test_vehicle_enters_race_mode_only_with_brake_pressed(
     ],
 )
 def test_vehicle_enters_launch_control_with_race_mode_and_brake_pressed(
-    vehicle_cluster, brake_position, expected_launch_state
+    ts_run_snapshot, brake_position, expected_launch_state
 ):
-    sws, vcfront = _enter_vehicle_ts_run(vehicle_cluster)
-
-    vcfront.set_brake_position(50)
-    sws.assert_request(SwsRequest.RACE)
-    vehicle_cluster.run_for(750, step=10)
-    torque_manager = vcfront.can.latest("VCFRONT_torqueManager", bus="veh")
-    assert torque_manager is not None
-    assert torque_manager.VCFRONT_raceMode.name == "RACE"
-
-    sws.clear_request(SwsRequest.RACE)
-    vehicle_cluster.run_for(750, step=10)
-    vcfront.set_brake_position(brake_position)
-    sws.assert_request(SwsRequest.LAUNCH_CONTROL)
-    vehicle_cluster.run_for(750, step=10)
-    torque_manager = vcfront.can.latest("VCFRONT_torqueManager", bus="veh")
-    assert torque_manager is not None
-    assert torque_manager.VCFRONT_launchControlState.name == expected_launch_state
+    race_mode, launch_state = ts_run_snapshot.run(
+        _request_launch_control, brake_position
+    )
+    assert race_mode == "RACE"
+    assert launch_state == expected_launch_state
@@ -0,0 +1,299 @@
+//! Ingest and conversion for binary `.canb` CAN logs written by can-bridge.
+//!
+//! Records are decoded with the yamcan generated decoders and turned into the
+//! same line protocol can-bridge writes for `.lp` logs, so Influx sees one
+//! schema whichever format a log was recorded in.
+
+use std::fs::File;
+use std::io::{BufRead, BufReader};
+use std::path::{Path, PathBuf};
+use std::thread;
+use std::time::Instant;
+
+use anyhow::{Context, Result};
+use can_bridge::binlog::{
+    BinLogReader, BinLogWriter, BinRecord, CHUNK_MAX_FRAMES, Chunk, bus_from_name,
+};
+use can_bridge::{
+    Bus, BusBinding, CanFrame, Event, Filters, process_event, write_processed_event_line_protocol,
+};
+use flate2::Compression;
+use flate2::read::GzDecoder;
+use flate2::write::GzEncoder;
+use tar::{Archive, Builder, Header};
+use tokio::sync::mpsc;
+
+use crate::{
+    LineProtocolBatch, ParseStats, Record, batch_body_capacity, parse_line, parse_tar_gz_blocking,
+    send_line_protocol_batch, timestamp_ns, trim_line_ending,
+};
+
+const CAN_EFF_FLAG: u32 = 0x8000_0000;
+const CAN_RTR_FLAG: u32 = 0x4000_0000;
+const CAN_ERR_FLAG: u32 = 0x2000_0000;
+
+pub(crate) fn parse_binlog_tar_gz_blocking(
+    path: PathBuf,
+    tx: mpsc::Sender<LineProtocolBatch>,
+    batch_size: usize,
+    batch_bytes: usize,
+) -> Result<ParseStats> {
+    let start = Instant::now();
+    let file = File::open(&path).with_context(|| format!("open {}", path.display()))?;
+    let gz = GzDecoder::new(file);
+    let stream = BufReader::new(gz);
+    let mut archive = Archive::new(stream);
+    let mut stats = ParseStats::default();
+    let batch_size = batch_size.max(1);
+    let batch_bytes = batch_bytes.max(1);
+    let capacity = batch_body_capacity(batch_size, batch_bytes);
+    let mut body = Vec::with_capacity(capacity);
+    let mut count = 0usize;
+    let filters = Filters::from_parts(&[], &[], &[]).expect("empty filters are valid");
+    let mut chunk = Chunk::with_capacity(CHUNK_MAX_FRAMES);
+    let mut bindings: Vec<Option<BusBinding<Bus>>> = Vec::new();
+    let mut line = String::with_capacity(256);
+
+    for entry in archive
+        .entries()
+        .with_context(|| format!("reading archive {}", path.display()))?
+    {
+        let entry = entry.with_context(|| format!("reading entry in {}", path.display()))?;
+        if !entry.header().entry_type().is_file() {
+            continue;
+        }
+        stats.entry_files += 1;
+
+        let mut reader = BinLogReader::new(BufReader::new(entry))
+            .with_context(|| format!("reading binary log header in {}", path.display()))?;
+        loop {
+            match reader.next_chunk(&mut chunk) {
+                Ok(true) => {}
+                Ok(false) => break,
+                Err(e) => {
+                    // A log cut short by power loss ends in a partial chunk
+                    eprintln!("log: truncated binary log in '{}': {e}", path.display());
+                    stats.bad += 1;
+                    break;
+                }
+            }
+
+            bindings.clear();
+            bindings.extend(chunk.buses.iter().map(|entry| {
+                bus_from_name(&entry.bus).map(|bus| BusBinding {
+                    iface: entry.iface.clone(),
+                    bus,
+                })
+            }));
+
+            for record in &chunk.records {
+                stats.lines += 1;
+                let Some(binding) = bindings.get(record.bus as usize).and_then(Option::as_ref)
+                else {
+                    stats.bad += 1;
+                    continue;
+                };
+                let event = Event {
+                    frame: record.frame,
+                    ts_opt: Some((
+                        record.ts_ns / 1_000_000_000,
+                        (record.ts_ns % 1_000_000_000) as u32,
+                    )),
+                };
+                let Some(processed) = process_event(binding, &filters, event) else {
+                    continue;
+                };
+                line.clear();
+                write_processed_event_line_protocol(&mut line, &processed);
+
+                let next_len = line.len().saturating_add(1);
+                if count > 0
+                    && (count >= batch_size || body.len().saturating_add(next_len) > batch_bytes)
+                {
+                    send_line_protocol_batch(&tx, &path, &mut body, &mut count, capacity)?;
+                }
+
+                body.extend_from_slice(line.as_bytes());
+                body.push(b'\n');
+                count += 1;
+                stats.points += 1;
+
+                if count >= batch_size || body.len() >= batch_bytes {
+                    send_line_protocol_batch(&tx, &path, &mut body, &mut count, capacity)?;
+                }
+            }
+        }
+    }
+
+    send_line_protocol_batch(&tx, &path, &mut body, &mut count, capacity)?;
+    stats.elapsed = start.elapsed();
+    Ok(stats)
+}
+
+#[derive(Debug, Default)]
+pub struct ConvertStats {
+    pub entry_files: usize,
+    pub frames: usize,
+    pub bad: usize,
+}
+
+/// Convert a JSON-lines `.log.tar.gz` archive into a `.canb.tar.gz` archive
+/// with one binary log per JSON log entry.
+pub fn convert_json_tar_gz(src: &Path, dest: &Path) -> Result<ConvertStats> {
+    let file = File::open(src).with_context(|| format!("open {}", src.display()))?;
+    let mut archive = Archive::new(BufReader::new(GzDecoder::new(file)));
+    let out = File::create(dest).with_context(|| format!("create {}", dest.display()))?;
+    // Chunks are already deflated
+    let mut tar = Builder::new(GzEncoder::new(out, Compression::none()));
+    let mut stats = ConvertStats::default();
+
+    for entry in archive
+        .entries()
+        .with_context(|| format!("reading archive {}", src.display()))?
+    {
+        let entry = entry.with_context(|| format!("reading entry in {}", src.display()))?;
+        if !entry.header().entry_type().is_file() {
+            continue;
+        }
+        stats.entry_files += 1;
+        let name = entry
+            .path()
+            .ok()
+            .and_then(|p| p.file_stem().map(|s| s.to_string_lossy().into_owned()))
+            .unwrap_or_else(|| format!("entry-{}", stats.entry_files));
+
+        let mut writer = BinLogWriter::new(Vec::new())?;
+        let mut chunk = Chunk::with_capacity(CHUNK_MAX_FRAMES);
+        let mut reader = BufReader::new(entry);
+        let mut line = Vec::with_capacity(1024);
+        loop {
+            line.clear();
+            let bytes_read = reader
+                .read_until(b'\n', &mut line)
+                .with_context(|| format!("reading lines from {}", src.display()))?;
+            if bytes_read == 0 {
+                break;
+            }
+            trim_line_ending(&mut line);
+
+            let rec = match parse_line(&line) {
+                Ok(Some(rec)) => rec,
+                Ok(None) => continue,
+                Err(_) => {
+                    stats.bad += 1;
+                    continue;
+                }
+            };
+            let Some(record) = record_to_bin(&rec, &mut chunk) else {
+                stats.bad += 1;
+                continue;
+            };
+            if !chunk.push(record) {
+                writer.write_chunk(&chunk)?;
+                chunk.clear();
+                chunk.push(record);
+            }
+            stats.frames += 1;
+        }
+        writer.write_chunk(&chunk)?;
+        let bytes = writer.finish()?;
+
+        let mut header = Header::new_gnu();
+        header.set_size(bytes.len() as u64);
+        header.set_mode(0o644);
+        header.set_cksum();
+        tar.append_data(&mut header, format!("{name}.canb"), bytes.as_slice())
+            .with_context(|| format!("writing {}", dest.display()))?;
+    }
+
+    tar.into_inner()?.finish()?;
+    Ok(stats)
+}
+
+fn record_to_bin(rec: &Record, chunk: &mut Chunk) -> Option<BinRecord> {
+    let id = rec.id.as_ref()?;
+    let mut can_id = u32::try_from(id.val?).ok()?;
+    if id.ext == Some(true) {
+        can_id |= CAN_EFF_FLAG;
+    }
+    if id.rtr == Some(true) {
+        can_id |= CAN_RTR_FLAG;
+    }
+    if id.err == Some(true) {
+        can_id |= CAN_ERR_FLAG;
+    }
+
+    let mut data = [0u8; 8];
+    for (byte, hex) in data.iter_mut().zip(rec.data.iter().flatten()) {
+        *byte = u8::from_str_radix(hex, 16).ok()?;
+    }
+
+    let ts_ns = u64::try_from(rec.time.and_then(timestamp_ns)?).ok()?;
+    let (iface, bus_name) = match &rec.bus {
+        Some(bus) => (
+            bus.iface.as_deref().unwrap_or(""),
+            bus.name.as_deref().unwrap_or(""),
+        ),
+        None => ("", ""),
+    };
+
+    Some(BinRecord {
+        ts_ns,
+        bus: chunk.bus_index(iface, bus_name)?,
+        frame: CanFrame {
+            can_id,
+            can_dlc: rec.dlc.unwrap_or(0).min(8),
+            data,
+        },
+    })
+}
+
+#[derive(Debug, Default)]
+pub struct ArchiveBench {
+    pub archive_bytes: u64,
+    pub frames: usize,
+    pub points: usize,
+    pub elapsed_secs: f64,
+}
+
+impl ArchiveBench {
+    pub fn bytes_per_frame(&self) -> f64 {
+        self.archive_bytes as f64 / self.frames.max(1) as f64
+    }
+
+    pub fn frames_per_sec(&self) -> f64 {
+        self.frames as f64 / self.elapsed_secs.max(f64::EPSILON)
+    }
+}
+
+/// Parse a JSON archive and its binary conversion without writing to Influx,
+/// returning the size and ingest rate of each.
+pub fn bench_archives(json: &Path, binary: &Path) -> Result<(ArchiveBench, ArchiveBench)> {
+    let json_bench = {
+        let (tx, mut rx) = mpsc::channel(crate::PARSER_CHANNEL_CAPACITY);
+        let drain = thread::spawn(move || while rx.blocking_recv().is_some() {});
+        let stats = parse_tar_gz_blocking(json.to_path_buf(), tx)?;
+        let _ = drain.join();
+        ArchiveBench {
+            archive_bytes: std::fs::metadata(json)?.len(),
+            frames: stats.lines,
+            points: stats.points,
+            elapsed_secs: stats.elapsed.as_secs_f64(),
+        }
+    };
+
+    let binary_bench = {
+        let (tx, mut rx) = mpsc::channel::<LineProtocolBatch>(crate::LINE_BATCH_CHANNEL_CAPACITY);
+        let drain = thread::spawn(move || while rx.blocking_recv().is_some() {});
+        let stats = parse_binlog_tar_gz_blocking(binary.to_path_buf(), tx, 5_000, 4 * 1024 * 1024)?;
+        let _ = drain.join();
+        ArchiveBench {
+            archive_bytes: std::fs::metadata(binary)?.len(),
+            frames: stats.lines,
+            points: stats.points,
+            elapsed_secs: stats.elapsed.as_secs_f64(),
+        }
+    };
+
+    Ok((json_bench, binary_bench))
+}
@@ -21,7 +21,12 @@ use tar::Archive;
 use tokio::sync::mpsc;
 use tokio::task::JoinHandle;
 
-/// Ingest one `.tar.gz` (JSON-lines files inside), writing to InfluxDB.
+mod binlog;
+
+pub use binlog::{ArchiveBench, ConvertStats, bench_archives, convert_json_tar_gz};
+
+/// Ingest one `.tar.gz` (JSON-lines, line protocol or binary `.canb` files
+/// inside), writing to InfluxDB.
 const INFLIGHT_WRITES: usize = 6;
 const PARSER_CHANNEL_CAPACITY: usize = 4_096;
 const LINE_BATCH_CHANNEL_CAPACITY: usize = 8;
@@ -603,6 +608,43 @@ pub async fn ingest_line_protocol_tar_gz(
     Ok((write_stats.ok, parse_stats.bad + write_stats.bad))
 }
 
+pub async fn ingest_binlog_tar_gz(
+    client: &InfluxClient,
+    bucket: &str,
+    path: &Path,
+    batch_size: usize,
+    batch_bytes: usize,
+) -> Result<(usize, usize)> {
+    let (tx, mut rx) = mpsc::channel(LINE_BATCH_CHANNEL_CAPACITY);
+    let parser_path = path.to_path_buf();
+    let parser = tokio::task::spawn_blocking(move || {
+        binlog::parse_binlog_tar_gz_blocking(parser_path, tx, batch_size, batch_bytes)
+    });
+
+    let mut writer = WriteScheduler::new(client.clone(), bucket);
+
+    while let Some(batch) = rx.recv().await {
+        writer.push_body(batch.count, batch.body).await;
+    }
+
+    let parser_result = parser.await;
+    let write_stats = writer.finish().await;
+    let parse_stats = parser_result.context("binary archive parser task failed")??;
+    println!(
+        "log: timings '{}' format=binary untar_ms={:.3} offload_wall_ms={:.3} offload_request_ms={:.3} untar_files={} frames={} parsed_points={} write_batches={} write_bytes={}",
+        path.display(),
+        duration_ms(parse_stats.elapsed),
+        duration_ms(write_stats.wall_elapsed),
+        duration_ms(write_stats.request_elapsed),
+        parse_stats.entry_files,
+        parse_stats.lines,
+        parse_stats.points,
+        write_stats.batches,
+        write_stats.bytes,
+    );
+    Ok((write_stats.ok, parse_stats.bad + write_stats.bad))
+}
+
 async fn ingest_archive(
     client: &InfluxClient,
     bucket: &str,
@@ -616,6 +658,8 @@ async fn ingest_archive(
         .unwrap_or_default();
     if fname.ends_with(".lp.tar.gz") {
         ingest_line_protocol_tar_gz(client, bucket, path, batch_size, batch_bytes).await
+    } else if fname.ends_with(".canb.tar.gz") {
+        ingest_binlog_tar_gz(client, bucket, path, batch_size, batch_bytes).await
     } else {
         ingest_tar_gz(client, bucket, path, batch_size, batch_bytes).await
     }
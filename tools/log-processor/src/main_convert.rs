@@ -0,0 +1,72 @@
+use std::path::{Path, PathBuf};
+
+use anyhow::{Context, Result};
+use clap::{ArgAction, Parser};
+
+use log_processor::{bench_archives, convert_json_tar_gz};
+
+/// Convert JSON-lines `.log.tar.gz` CAN log archives into binary `.canb.tar.gz`
+#[derive(Debug, Parser)]
+struct Opts {
+    /// JSON-lines .log.tar.gz archives
+    #[arg(required = true)]
+    inputs: Vec<PathBuf>,
+
+    /// Directory for converted archives (defaults to next to each input)
+    #[arg(long)]
+    out_dir: Option<PathBuf>,
+
+    /// Compare bytes per frame and parse rate of each input and its conversion
+    #[arg(long, action = ArgAction::SetTrue)]
+    bench: bool,
+}
+
+fn output_path(input: &Path, out_dir: Option<&Path>) -> Result<PathBuf> {
+    let name = input
+        .file_name()
+        .and_then(|f| f.to_str())
+        .ok_or_else(|| anyhow::anyhow!("invalid input path: {}", input.display()))?;
+    let stem = name
+        .strip_suffix(".log.tar.gz")
+        .or_else(|| name.strip_suffix(".tar.gz"))
+        .unwrap_or(name);
+    let dir = out_dir
+        .map(Path::to_path_buf)
+        .or_else(|| input.parent().map(Path::to_path_buf))
+        .unwrap_or_else(|| PathBuf::from("."));
+    Ok(dir.join(format!("{stem}.canb.tar.gz")))
+}
+
+fn main() -> Result<()> {
+    let opts = Opts::parse();
+
+    for input in &opts.inputs {
+        let output = output_path(input, opts.out_dir.as_deref())?;
+        let stats = convert_json_tar_gz(input, &output)
+            .with_context(|| format!("converting {}", input.display()))?;
+        println!(
+            "Converted '{}' -> '{}' files={} frames={} bad_records={}",
+            input.display(),
+            output.display(),
+            stats.entry_files,
+            stats.frames,
+            stats.bad
+        );
+
+        if opts.bench {
+            let (json, binary) = bench_archives(input, &output)?;
+            for (label, bench) in [("json", &json), ("binary", &binary)] {
+                println!(
+                    "  {label:>6}: archive_bytes={} frames={} points={} bytes_per_frame={:.2} ingest_rate={:.0} frames/s",
+                    bench.archive_bytes,
+                    bench.frames,
+                    bench.points,
+                    bench.bytes_per_frame(),
+                    bench.frames_per_sec(),
+                );
+            }
+        }
+    }
+
+    Ok(())
+}
@@ -34,6 +34,7 @@ __all__ = [
     "RigRuntime",
     "NodeConfig",
     "PeriodicDataPathProducer",
+    "ProcessSnapshot",
     "PythonSchedulerCallbacks",
     "RunUntilTimeout",
     "RustSchedulerCallbacks",
@@ -41,6 +42,9 @@ __all__ = [
     "Scheduler",
     "SchedulerConfig",
     "SchedulerContext",
+    "SnapshotScenarioError",
+    "Trace",
+    "TraceRecorder",
     "buck_output",
     "duration_to_ns",
     "load_generated_enums",
@@ -45,8 +45,10 @@ from .scheduler import (
     RustSchedulerCallbacks,
     SchedulerContext,
 )
+from .snapshot import ProcessSnapshot, SnapshotScenarioError
 from .simple import SimpleComponent, SimpleNodeRig
 from .time import RunUntilTimeout, duration_to_ns, run_until
+from .trace import Trace, TraceRecorder
 
 
 __all__ = [
@@ -83,6 +85,7 @@ __all__ = [
     "RigRuntime",
     "NodeConfig",
     "PeriodicDataPathProducer",
+    "ProcessSnapshot",
     "PythonSchedulerCallbacks",
     "RunUntilTimeout",
     "RustSchedulerCallbacks",
@@ -90,6 +93,9 @@ __all__ = [
     "Scheduler",
     "SchedulerConfig",
     "SchedulerContext",
+    "SnapshotScenarioError",
+    "Trace",
+    "TraceRecorder",
     "buck_output",
     "duration_to_ns",
     "load_generated_enums",
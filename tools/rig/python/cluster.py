@@ -3,6 +3,7 @@
 from __future__ import annotations
 
 from dataclasses import dataclass
+from functools import partial
 from typing import Generic, TypeVar
 
 from .cluster_config import ClusterConfig
@@ -18,7 +19,9 @@ from .datapath import (
     datapath_key,
 )
 from .model import ComponentRig, ModelRig
+from .snapshot import ProcessSnapshot
 from .time import duration_to_ns, run_until
+from .trace import TraceRecorder
 
 
 NodeT = TypeVar("NodeT", bound=ModelRig)
@@ -477,6 +480,42 @@ class ClusterRig(Rig[NodeT], Generic[NodeT]):
             self.components = self.components[: self._base_component_count]
         self.reset()
 
+    def snapshot(self) -> ProcessSnapshot[ClusterRig[NodeT]]:
+        """Freeze the whole cluster so that scenarios can be forked from it.
+
+        Every node's native globals, the runtime's queues, and all Python
+        model state are kept as of this call; see ``ProcessSnapshot``. Step
+        threads are stopped while the snapshot is taken and restarted in each
+        scenario.
+        """
+        runtime = self.runtime
+        threads = 1 if runtime is None else runtime.step_threads
+        if threads == 1:
+            return ProcessSnapshot(self)
+        runtime.set_step_threads(1)
+        try:
+            return ProcessSnapshot(
+                self, on_fork=partial(runtime.set_step_threads, threads)
+            )
+        finally:
+            runtime.set_step_threads(threads)
+
+    def record_trace(
+        self, period: int | float, *, capacity: int, unit: str = "ms"
+    ) -> TraceRecorder:
+        """Start recording trace channels every ``period`` of simulated time.
+
+        Channels are added to the returned recorder; any earlier recording
+        of this cluster is dropped.
+        """
+        if self.runtime is None:
+            raise RuntimeError("trace recording requires a Rust cluster runtime")
+        return TraceRecorder(
+            self.runtime,
+            period_ns=duration_to_ns(period, unit=unit),
+            capacity=capacity,
+        )
+
     def add_component(self, component: ComponentRig) -> ComponentRig:
         return self.add_components(component)[0]
 
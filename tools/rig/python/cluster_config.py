@@ -15,6 +15,16 @@ class ClusterConfig:
     scheduler: SchedulerConfig = field(default_factory=SchedulerConfig)
     dataflow: DataflowConfig = field(default_factory=DataflowConfig)
     interfaces: tuple[Interface, ...] = ()
+    # Threads that step native nodes between dataflow propagation points.
+    # Results are identical for any value; 1 steps nodes in order.
+    step_threads: int = 1
+    # Advance time straight to the next step in which a node or algorithm is
+    # due. Steps stay on the fixed-step grid, so results are unchanged.
+    next_event: bool = False
+
+    def __post_init__(self) -> None:
+        if self.step_threads < 1:
+            raise ValueError(f"step threads must be positive, got {self.step_threads}")
 
 
 __all__ = ["ClusterConfig"]
@@ -114,6 +114,13 @@ class RigRuntime(Protocol):
         self, duration_ns: int, step_ns: int, *, route: bool = True
     ) -> None: ...
 
+    def set_step_threads(self, threads: int) -> None: ...
+
+    @property
+    def step_threads(self) -> int: ...
+
+    def set_next_event(self, enabled: bool) -> None: ...
+
     def set_node_online(self, name: str, online: bool) -> None: ...
 
     def node_index(self, node: str) -> int | None: ...
@@ -124,6 +131,16 @@ class RigRuntime(Protocol):
 
     def node_elapsed_ns_values(self) -> dict[str, int]: ...
 
+    def configure_trace(self, period_ns: int, capacity: int) -> None: ...
+
+    def add_trace_sampler(self, sample: int, context: int = 0) -> int | None: ...
+
+    def add_trace_scalar(self, source_node: str, route_id: int) -> int | None: ...
+
+    def clear_trace(self) -> None: ...
+
+    def trace_view(self): ...
+
     def run_until_dataflow_wait(
         self,
         handle: int,
@@ -16,6 +16,7 @@ from collections.abc import Callable
 from .artifacts import load_shared_library
 from .contracts import RigRuntime
 from .scheduler import PythonSchedulerCallbacks, RustSchedulerCallbacks
+from .trace import RigTraceView
 
 
 class RustRuntimeHost:
@@ -67,6 +68,7 @@ class RustClusterRuntime(RigRuntime):
         self._node_owners: dict[str, object] = {}
         self._route = route
         self._route_callback = self._RouteCallback(self._route_callback_fn)
+        self._step_threads = 1
         host = host or RustRuntimeHost()
         if not hasattr(host, "bind_symbol"):
             raise TypeError("Rig runtime host must implement bind_symbol()")
@@ -105,6 +107,15 @@ class RustClusterRuntime(RigRuntime):
         self._run_for = bind_symbol(
             "rig_cluster_run_for", [ctypes.c_uint64, ctypes.c_uint64, ctypes.c_size_t]
         )
+        self._set_step_threads = bind_symbol(
+            "rig_cluster_set_step_threads", [ctypes.c_uint32]
+        )
+        self._set_next_event = bind_symbol("rig_cluster_set_next_event", [ctypes.c_bool])
+        self._set_node_next_wake = bind_symbol(
+            "rig_cluster_set_node_next_wake",
+            [ctypes.c_uint32, ctypes.c_size_t],
+            ctypes.c_bool,
+        )
         self._add_scalar_route = bind_symbol(
             "rig_cluster_add_scalar_route",
             [
@@ -212,6 +223,25 @@ class RustClusterRuntime(RigRuntime):
             [ctypes.POINTER(ctypes.c_uint64), ctypes.c_uint32],
             ctypes.c_uint32,
         )
+        self._trace_configure = bind_symbol(
+            "rig_cluster_trace_configure", [ctypes.c_uint64, ctypes.c_uint32]
+        )
+        self._trace_add_sampler = bind_symbol(
+            "rig_cluster_trace_add_sampler",
+            [ctypes.c_size_t, ctypes.c_uint64],
+            ctypes.c_uint32,
+        )
+        self._trace_add_scalar = bind_symbol(
+            "rig_cluster_trace_add_scalar",
+            [ctypes.c_uint32, ctypes.c_uint32],
+            ctypes.c_uint32,
+        )
+        self._trace_clear = bind_symbol("rig_cluster_trace_clear")
+        self._trace_view = bind_symbol(
+            "rig_cluster_trace_view",
+            [ctypes.POINTER(RigTraceView)],
+            ctypes.c_bool,
+        )
         self.reset()
 
     def bind_symbol(
@@ -273,6 +303,14 @@ class RustClusterRuntime(RigRuntime):
                         ctypes.c_bool(online),
                     )
                 )
+                if (
+                    index != 0xFFFFFFFF
+                    and scheduler.next_wake
+                    and not self._set_node_next_wake(
+                        ctypes.c_uint32(index), ctypes.c_size_t(scheduler.next_wake)
+                    )
+                ):
+                    raise RuntimeError(f"failed to register next wake for node {name!r}")
             else:
                 raise TypeError(
                     f"node {name!r} returned unsupported scheduler callbacks "
@@ -506,6 +544,21 @@ class RustClusterRuntime(RigRuntime):
     def node_index(self, node: str) -> int | None:
         return self._node_indices.get(node)
 
+    def set_step_threads(self, threads: int) -> None:
+        """Step native nodes on ``threads`` threads; 1 steps them in order."""
+        if threads < 1:
+            raise ValueError(f"step threads must be positive, got {threads}")
+        self._set_step_threads(ctypes.c_uint32(threads))
+        self._step_threads = threads
+
+    @property
+    def step_threads(self) -> int:
+        return self._step_threads
+
+    def set_next_event(self, enabled: bool) -> None:
+        """Skip scheduler steps in which no node or algorithm is due."""
+        self._set_next_event(ctypes.c_bool(enabled))
+
     def run_for(self, duration_ns: int, step_ns: int, *, route: bool = True) -> None:
         route_callback = (
             ctypes.cast(self._route_callback, ctypes.c_void_p).value
@@ -556,6 +609,36 @@ class RustClusterRuntime(RigRuntime):
             )
         )
 
+    def configure_trace(self, period_ns: int, capacity: int) -> None:
+        """Record trace channels every ``period_ns``; see ``TraceRecorder``."""
+        self._trace_configure(ctypes.c_uint64(period_ns), ctypes.c_uint32(capacity))
+
+    def add_trace_sampler(self, sample: int, context: int = 0) -> int | None:
+        return self._trace_channel(
+            self._trace_add_sampler(ctypes.c_size_t(sample), ctypes.c_uint64(context))
+        )
+
+    def add_trace_scalar(self, source_node: str, route_id: int) -> int | None:
+        index = self._node_indices.get(source_node)
+        if index is None:
+            return None
+        return self._trace_channel(
+            self._trace_add_scalar(ctypes.c_uint32(index), ctypes.c_uint32(route_id))
+        )
+
+    def clear_trace(self) -> None:
+        self._trace_clear()
+
+    def trace_view(self) -> RigTraceView:
+        view = RigTraceView()
+        if not self._trace_view(ctypes.byref(view)):
+            raise RuntimeError("failed to read the Rust cluster trace")
+        return view
+
+    @staticmethod
+    def _trace_channel(index: int) -> int | None:
+        return None if index == 0xFFFFFFFF else int(index)
+
     def run_until_dataflow_wait(
         self,
         handle: int,
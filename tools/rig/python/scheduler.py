@@ -35,3 +35,6 @@ class PythonSchedulerCallbacks:
 class RustSchedulerCallbacks:
     run_for: int
     reset: int
+    # Optional ``u64 (*)(void)`` reporting nanoseconds until the node next has
+    # scheduled work; 0 means the node must be stepped every tick.
+    next_wake: int = 0
@@ -0,0 +1,173 @@
+"""Process-level snapshots for forking simulation scenarios from one state."""
+
+from __future__ import annotations
+
+import os
+import pickle
+import struct
+import traceback
+import weakref
+from collections.abc import Callable
+from typing import Generic, TypeVar
+
+ContextT = TypeVar("ContextT")
+
+_LENGTH = struct.Struct("<Q")
+_STOP = b""
+_open_snapshots: weakref.WeakSet[ProcessSnapshot[object]] = weakref.WeakSet()
+
+
+class SnapshotScenarioError(RuntimeError):
+    """Raised when a forked scenario dies or fails with an unpicklable error."""
+
+
+class ProcessSnapshot(Generic[ContextT]):
+    """Frozen copy of the whole process from which scenarios are forked.
+
+    Taking a snapshot forks a holder process that keeps the state of the
+    moment: every loaded shared library's globals, native runtime queues,
+    and Python objects alike. ``run()`` forks the holder again and calls the
+    scenario there with ``context``, so each scenario starts from the same
+    state and the caller's own process is never touched.
+
+    Scenarios and their arguments cross the process boundary with pickle, so
+    a scenario must be a module-level function. Its return value or
+    exception is sent back the same way. The process must be single-threaded
+    when the snapshot is taken; ``on_fork`` runs in every scenario process
+    before the scenario and may restart threads.
+    """
+
+    def __init__(
+        self,
+        context: ContextT,
+        *,
+        on_fork: Callable[[], None] | None = None,
+    ) -> None:
+        self._context = context
+        self._on_fork = on_fork
+        self._pid: int | None = None
+        requests_read, requests_write = os.pipe()
+        results_read, results_write = os.pipe()
+        pid = os.fork()
+        if pid == 0:
+            for snapshot in tuple(_open_snapshots):
+                snapshot._forget()
+            os.close(requests_write)
+            os.close(results_read)
+            try:
+                self._serve(requests_read, results_write)
+            finally:
+                os._exit(0)
+        os.close(requests_read)
+        os.close(results_write)
+        self._requests = requests_write
+        self._results = results_read
+        self._pid = pid
+        _open_snapshots.add(self)
+
+    def run(self, scenario: Callable[..., object], *args: object) -> object:
+        """Run ``scenario(context, *args)`` in a fresh fork of the snapshot."""
+        if self._pid is None:
+            raise RuntimeError("snapshot is closed")
+        _write_message(self._requests, pickle.dumps((scenario, args)))
+        message = _read_message(self._results)
+        if message is None:
+            raise SnapshotScenarioError("snapshot holder exited unexpectedly")
+        ok, value, child_traceback = pickle.loads(message)
+        if ok:
+            return value
+        if isinstance(value, BaseException):
+            raise value from SnapshotScenarioError(child_traceback)
+        raise SnapshotScenarioError(child_traceback)
+
+    def close(self) -> None:
+        if self._pid is None:
+            return
+        _write_message(self._requests, _STOP)
+        pid = self._pid
+        self._forget()
+        os.waitpid(pid, 0)
+
+    def _forget(self) -> None:
+        """Drop this process's handles without stopping the holder."""
+        if self._pid is None:
+            return
+        os.close(self._requests)
+        os.close(self._results)
+        self._pid = None
+        _open_snapshots.discard(self)
+
+    def __enter__(self) -> ProcessSnapshot[ContextT]:
+        return self
+
+    def __exit__(self, *exc_info: object) -> None:
+        self.close()
+
+    def __del__(self) -> None:
+        if getattr(self, "_pid", None) is not None:
+            self.close()
+
+    def _serve(self, requests: int, results: int) -> None:
+        while (message := _read_message(requests)) not in (None, _STOP):
+            reply_read, reply_write = os.pipe()
+            pid = os.fork()
+            if pid == 0:
+                os.close(reply_read)
+                try:
+                    _write_message(reply_write, self._run_scenario(message))
+                finally:
+                    os._exit(0)
+            os.close(reply_write)
+            reply = _read_message(reply_read)
+            os.close(reply_read)
+            _, status = os.waitpid(pid, 0)
+            if reply is None:
+                reply = pickle.dumps(
+                    (False, None, f"scenario process died with wait status {status}")
+                )
+            _write_message(results, reply)
+
+    def _run_scenario(self, message: bytes) -> bytes:
+        try:
+            if self._on_fork is not None:
+                self._on_fork()
+            scenario, args = pickle.loads(message)
+            return pickle.dumps((True, scenario(self._context, *args), ""))
+        except BaseException as exc:  # noqa: BLE001 - reported to the caller
+            child_traceback = traceback.format_exc()
+            try:
+                # Only send exceptions that the caller can rebuild.
+                reply = pickle.dumps((False, exc, child_traceback))
+                pickle.loads(reply)
+                return reply
+            except Exception:  # noqa: BLE001
+                return pickle.dumps((False, None, child_traceback))
+
+
+def _write_message(fd: int, payload: bytes) -> None:
+    data = memoryview(_LENGTH.pack(len(payload)) + payload)
+    while data:
+        written = os.write(fd, data)
+        data = data[written:]
+
+
+def _read_exact(fd: int, length: int) -> bytes | None:
+    chunks = []
+    while length:
+        chunk = os.read(fd, length)
+        if not chunk:
+            return None
+        chunks.append(chunk)
+        length -= len(chunk)
+    return b"".join(chunks)
+
+
+def _read_message(fd: int) -> bytes | None:
+    header = _read_exact(fd, _LENGTH.size)
+    if header is None:
+        return None
+    (length,) = _LENGTH.unpack(header)
+    return _read_exact(fd, length) if length else b""
+
+
+__all__ = ["ProcessSnapshot", "SnapshotScenarioError"]
@@ -1,6 +1,7 @@
 from __future__ import annotations
 
 import ctypes
+import os
 
 import pytest
 
@@ -14,17 +15,21 @@ from rig import (
     ModelRig,
     ModelDataPathDescriptor,
     NodeConfig,
+    ProcessSnapshot,
     Rig,
     RigElement,
     RigRuntime,
     RustClusterRuntime,
     RustRuntimeHost,
     SchedulerConfig,
+    SnapshotScenarioError,
+    Trace,
     duration_to_ns,
     run_until,
 )
 from rig.simple import SimpleComponent, SimpleNodeRig
 from rig.time import RunUntilTimeout
+from rig.trace import RigTraceView
 
 
 def test_core_configuration_preserves_generic_scheduler_and_dataflow():
@@ -289,3 +294,82 @@ def test_cluster_rig_rejects_untyped_elements_at_the_boundary():
     cluster = ClusterRig(node=SimpleComponent())
     with pytest.raises(TypeError, match="RigElement contract"):
         cluster.add_components(object())
+
+
+def _append_and_read(state: list[int], value: int) -> list[int]:
+    state.append(value)
+    return list(state)
+
+
+def _raise_value_error(state: list[int]) -> None:
+    raise ValueError(f"bad state {state}")
+
+
+def _exit_abruptly(state: list[int]) -> None:
+    os._exit(3)
+
+
+def test_process_snapshot_forks_each_scenario_from_the_same_state():
+    state = [1]
+    with ProcessSnapshot(state) as snapshot:
+        state.append(99)
+
+        assert snapshot.run(_append_and_read, 2) == [1, 2]
+        assert snapshot.run(_append_and_read, 3) == [1, 3]
+        with pytest.raises(ValueError, match=r"bad state \[1\]"):
+            snapshot.run(_raise_value_error)
+        with pytest.raises(SnapshotScenarioError, match="died"):
+            snapshot.run(_exit_abruptly)
+        assert snapshot.run(_append_and_read, 4) == [1, 4]
+
+    assert state == [1, 99]
+    with pytest.raises(RuntimeError, match="closed"):
+        snapshot.run(_append_and_read, 5)
+
+
+def test_trace_assertions_cover_limits_settling_and_latency(tmp_path):
+    nan = float("nan")
+    trace = Trace(
+        [0, 10, 20, 30, 40, 50],
+        {
+            "request": [0, 1, 1, 0, 1, 0],
+            "ack": [nan, 0, 0, 1, 0, 1],
+            "speed": [0.0, 8.0, 11.0, 9.5, 10.2, 9.9],
+        },
+    )
+
+    assert trace.never_exceeds("speed", 11.0)
+    with pytest.raises(AssertionError, match="reached 11.0 at 20 ns"):
+        trace.assert_never_exceeds("speed", 10.5)
+    assert trace.settling_time_ns("speed", 10.0, 0.5) == 30
+    assert trace.window(start_ns=30).settling_time_ns("speed", 10.0, 0.5) == 0
+    with pytest.raises(AssertionError, match="settled after 30 ns"):
+        trace.assert_settles("speed", 10.0, 0.5, within_ns=20)
+    assert trace.latencies_ns("request", "ack") == [20, 10]
+    assert trace.assert_max_latency("request", "ack", limit_ns=20) == 20
+    assert trace.window(end_ns=40).max_latency_ns("request", "ack") == 20
+    assert trace.window(start_ns=40, end_ns=50).max_latency_ns("request", "ack") is None
+
+    trace.window(end_ns=20).to_csv(tmp_path / "trace.csv")
+    assert (tmp_path / "trace.csv").read_text().splitlines() == [
+        "time_ns,request,ack,speed",
+        "0,0,nan,0.0",
+        "10,1,0,8.0",
+    ]
+
+
+def test_trace_reads_native_columns_in_place():
+    time_ns = (ctypes.c_uint64 * 4)(5, 10, 15, 0)
+    values = (ctypes.c_double * 4)(1.0, 2.0, 3.0, 0.0)
+    columns = (ctypes.POINTER(ctypes.c_double) * 1)(values)
+    view = RigTraceView(time_ns, columns, 1, 3, 4, 2)
+
+    trace = Trace.from_view(view, ["value"])
+    kept = trace.copy()
+    values[2] = 30.0
+
+    assert (len(trace), trace.dropped) == (3, 2)
+    assert list(trace.time_ns) == [5, 10, 15]
+    assert list(trace["value"]) == [1.0, 2.0, 30.0]
+    assert list(kept["value"]) == [1.0, 2.0, 3.0]
+    assert list(trace.window(10, 15)["value"]) == [2.0]
@@ -0,0 +1,277 @@
+"""Columnar traces recorded by the Rig runtime and assertions over them."""
+
+from __future__ import annotations
+
+import array
+import csv
+import ctypes
+import math
+import os
+from bisect import bisect_left
+from collections.abc import Callable, Mapping, Sequence
+
+ValuePredicate = Callable[[float], bool]
+
+
+class RigTraceView(ctypes.Structure):
+    """In-place view of the runtime's trace buffers."""
+
+    _fields_ = [
+        ("time_ns", ctypes.POINTER(ctypes.c_uint64)),
+        ("columns", ctypes.POINTER(ctypes.POINTER(ctypes.c_double))),
+        ("channel_count", ctypes.c_uint32),
+        ("len", ctypes.c_uint32),
+        ("capacity", ctypes.c_uint32),
+        ("dropped", ctypes.c_uint64),
+    ]
+
+
+def is_set(value: float) -> bool:
+    """Default predicate for boolean channels: non-zero and sampled."""
+    return value == value and value != 0.0
+
+
+def _native_column(pointer, ctype, length: int, fmt: str) -> memoryview:
+    address = ctypes.cast(pointer, ctypes.c_void_p).value
+    if length == 0 or address is None:
+        return memoryview(array.array(fmt))
+    return memoryview((ctype * length).from_address(address)).cast("B").cast(fmt)
+
+
+class Trace:
+    """Recorded channels sharing one time column.
+
+    A trace read from a :class:`TraceRecorder` reads the runtime's buffers in
+    place: it is only valid until the recorder is configured again or the
+    cluster is reset, and later samples are not visible through it. Use
+    :meth:`copy` to keep one beyond that. Windows share their parent's
+    buffers.
+    """
+
+    def __init__(
+        self,
+        time_ns: Sequence[int],
+        columns: Mapping[str, Sequence[float]],
+        *,
+        dropped: int = 0,
+    ) -> None:
+        for name, column in columns.items():
+            if len(column) != len(time_ns):
+                raise ValueError(
+                    f"trace channel {name!r} has {len(column)} samples, "
+                    f"expected {len(time_ns)}"
+                )
+        self.time_ns = time_ns
+        self.columns = dict(columns)
+        self.dropped = dropped
+
+    @classmethod
+    def from_view(cls, view: RigTraceView, names: Sequence[str]) -> Trace:
+        length = int(view.len)
+        time_ns = _native_column(view.time_ns, ctypes.c_uint64, length, "Q")
+        columns = {
+            name: _native_column(view.columns[index], ctypes.c_double, length, "d")
+            for index, name in enumerate(names[: view.channel_count])
+        }
+        return cls(time_ns, columns, dropped=int(view.dropped))
+
+    def __len__(self) -> int:
+        return len(self.time_ns)
+
+    def __getitem__(self, name: str) -> Sequence[float]:
+        try:
+            return self.columns[name]
+        except KeyError as exc:
+            raise KeyError(
+                f"trace channel {name!r} was not recorded; "
+                f"expected one of {', '.join(self.columns)}"
+            ) from exc
+
+    def copy(self) -> Trace:
+        return Trace(
+            array.array("Q", self.time_ns),
+            {name: array.array("d", column) for name, column in self.columns.items()},
+            dropped=self.dropped,
+        )
+
+    def window(self, start_ns: int | None = None, end_ns: int | None = None) -> Trace:
+        """Samples taken at ``start_ns <= time < end_ns``."""
+        start = 0 if start_ns is None else bisect_left(self.time_ns, start_ns)
+        end = len(self) if end_ns is None else bisect_left(self.time_ns, end_ns)
+        return Trace(
+            self.time_ns[start:end],
+            {name: column[start:end] for name, column in self.columns.items()},
+            dropped=self.dropped,
+        )
+
+    def _first_violation(
+        self, name: str, predicate: ValuePredicate
+    ) -> tuple[int, float] | None:
+        for timestamp_ns, value in zip(self.time_ns, self[name]):
+            if value == value and predicate(value):
+                return int(timestamp_ns), float(value)
+        return None
+
+    def never_exceeds(self, name: str, limit: float) -> bool:
+        """Whether every sampled value is at most ``limit``."""
+        return self._first_violation(name, lambda value: value > limit) is None
+
+    def assert_never_exceeds(self, name: str, limit: float) -> None:
+        violation = self._first_violation(name, lambda value: value > limit)
+        if violation is not None:
+            timestamp_ns, value = violation
+            raise AssertionError(
+                f"{name} reached {value} at {timestamp_ns} ns, above {limit}"
+            )
+
+    def settling_time_ns(
+        self, name: str, target: float, tolerance: float
+    ) -> int | None:
+        """Time from the first sample until ``name`` stays within ``tolerance``
+        of ``target`` for the rest of the trace, or None if it never does.
+        Unsampled values count as outside the band."""
+        column = self[name]
+        settled_index = None
+        for index in range(len(column) - 1, -1, -1):
+            if not abs(column[index] - target) <= tolerance:
+                break
+            settled_index = index
+        if settled_index is None:
+            return None
+        return int(self.time_ns[settled_index] - self.time_ns[0])
+
+    def assert_settles(
+        self, name: str, target: float, tolerance: float, *, within_ns: int
+    ) -> int:
+        settling_ns = self.settling_time_ns(name, target, tolerance)
+        if settling_ns is None or settling_ns > within_ns:
+            last = self[name][-1] if len(self) else math.nan
+            outcome = (
+                f"did not settle (last {last})"
+                if settling_ns is None
+                else f"settled after {settling_ns} ns"
+            )
+            raise AssertionError(
+                f"{name} {outcome}; expected {target} ± {tolerance} within {within_ns} ns"
+            )
+        return settling_ns
+
+    def latencies_ns(
+        self,
+        trigger: str,
+        response: str,
+        *,
+        trigger_when: ValuePredicate = is_set,
+        response_when: ValuePredicate = is_set,
+    ) -> list[int | None]:
+        """Delay from each rising edge of ``trigger_when`` to the first
+        sample from then on at which ``response_when`` holds. Edges that the
+        trace ends before answering give None."""
+        triggers = self[trigger]
+        responses = self[response]
+        latencies: list[int | None] = []
+        armed = False
+        answered_index = -1
+        for index, value in enumerate(triggers):
+            active = trigger_when(value)
+            if active and not armed:
+                if answered_index < index:
+                    answered_index = next(
+                        (
+                            later
+                            for later in range(index, len(responses))
+                            if response_when(responses[later])
+                        ),
+                        len(responses),
+                    )
+                latencies.append(
+                    int(self.time_ns[answered_index] - self.time_ns[index])
+                    if answered_index < len(responses)
+                    else None
+                )
+            armed = active
+        return latencies
+
+    def max_latency_ns(self, trigger: str, response: str, **predicates) -> int | None:
+        """Worst trigger-to-response delay; None if a trigger went unanswered."""
+        latencies = self.latencies_ns(trigger, response, **predicates)
+        if None in latencies:
+            return None
+        return max(latencies, default=0)
+
+    def assert_max_latency(
+        self, trigger: str, response: str, *, limit_ns: int, **predicates
+    ) -> int:
+        latencies = self.latencies_ns(trigger, response, **predicates)
+        if None in latencies:
+            raise AssertionError(
+                f"{response} never answered {latencies.count(None)} of "
+                f"{len(latencies)} {trigger} edges"
+            )
+        worst = max(latencies, default=0)
+        if worst > limit_ns:
+            raise AssertionError(
+                f"{trigger} -> {response} took {worst} ns, limit {limit_ns} ns"
+            )
+        return worst
+
+    def to_csv(self, path: str | os.PathLike[str]) -> None:
+        """Write one row per sample: ``time_ns`` followed by every channel."""
+        with open(path, "w", newline="") as handle:
+            writer = csv.writer(handle)
+            writer.writerow(("time_ns", *self.columns))
+            writer.writerows(zip(self.time_ns, *self.columns.values()))
+
+
+class TraceRecorder:
+    """Named channels of the runtime's trace recording.
+
+    The runtime samples every channel once per ``period_ns`` of simulated
+    time, at the end of the scheduler step that reaches the due time, into
+    ``capacity`` preallocated samples; later samples are counted as dropped.
+    Creating a recorder replaces any recording already configured on the
+    runtime.
+    """
+
+    def __init__(self, runtime, *, period_ns: int, capacity: int) -> None:
+        if period_ns <= 0:
+            raise ValueError(f"trace period must be positive, got {period_ns} ns")
+        if not 0 < capacity < 2**32:
+            raise ValueError(f"trace capacity must be a positive u32, got {capacity}")
+        self._runtime = runtime
+        self.period_ns = period_ns
+        self.capacity = capacity
+        self._names: list[str] = []
+        runtime.configure_trace(period_ns, capacity)
+
+    @property
+    def names(self) -> tuple[str, ...]:
+        return tuple(self._names)
+
+    def add_channel(self, name: str, index: int | None) -> None:
+        """Name the column a runtime ``add_trace_*`` call returned."""
+        if name in self._names:
+            raise ValueError(f"trace channel {name!r} already exists")
+        if index is None or index != len(self._names):
+            raise RuntimeError(f"failed to add trace channel {name!r}")
+        self._names.append(name)
+
+    def add_sampler(self, name: str, sample: int, context: int = 0) -> None:
+        """Trace ``sample(context)``, a native ``double (*)(uint64_t)``."""
+        self.add_channel(name, self._runtime.add_trace_sampler(sample, context))
+
+    def add_scalar(self, name: str, source_node: str, route_id: int) -> None:
+        """Trace the latest value of a scalar edge."""
+        self.add_channel(
+            name, self._runtime.add_trace_scalar(source_node, route_id)
+        )
+
+    def clear(self) -> None:
+        """Drop the samples so far and record again from now."""
+        self._runtime.clear_trace()
+
+    def trace(self) -> Trace:
+        return Trace.from_view(self._runtime.trace_view(), self._names)
+
+
+__all__ = ["RigTraceView", "Trace", "TraceRecorder", "is_set"]
@@ -43,6 +43,14 @@ pub trait DataflowRuntime {
     fn runtime_algorithms(&self) -> &RuntimeAlgorithms;
     fn runtime_algorithms_mut(&mut self) -> &mut RuntimeAlgorithms;
     fn mark_scheduler_dirty(&mut self);
+    /// Whether the scheduler may skip steps in which nothing is due.
+    fn next_event_enabled(&self) -> bool {
+        false
+    }
+    /// Nanoseconds until the earliest online node must be stepped again.
+    fn next_node_wake_ns(&self) -> u64 {
+        0
+    }
     fn scalar_source_pending(&self, _group_index: usize) -> bool {
         false
     }
@@ -52,6 +60,8 @@ pub trait DataflowRuntime {
     fn mark_scalar_edge_ready(&mut self, _node: u32, _route_id: u32) {}
     fn mark_scalar_input_pending(&mut self, _node: u32) {}
     fn route_scalar_event(&mut self, _source_node: u32, _route_id: u32, _event: ScalarEvent) {}
+    /// Called at the end of every scheduler step, after the dataflow graph ran.
+    fn record_trace(&mut self) {}
 }
 
 pub type RuntimeResetFn = fn();
@@ -885,6 +895,35 @@ impl DataflowGraph {
         }
     }
 
+    /// Nanoseconds until an algorithm of this graph is next due, assuming no
+    /// new input arrives. Zero if anything is queued or pending right now.
+    pub(super) fn next_due_delay_ns(&self, runtime: &dyn DataflowRuntime) -> u64 {
+        if !self.queue.is_empty()
+            || self
+                .polled_algorithms
+                .iter()
+                .any(|&index| self.pending_state(runtime, index))
+        {
+            return 0;
+        }
+        let mut delay_ns = u64::MAX;
+        for (node_index, schedules) in self.schedules_by_owner.iter().enumerate() {
+            if !runtime.node_online(node_index as u32) {
+                continue;
+            }
+            for &index in schedules {
+                if let Some(DataflowSchedule::Periodic { next_due_ns, .. }) = self
+                    .algorithms
+                    .get(index)
+                    .map(|algorithm| algorithm.schedule)
+                {
+                    delay_ns = delay_ns.min(next_due_ns.saturating_sub(runtime.elapsed_ns()));
+                }
+            }
+        }
+        delay_ns
+    }
+
     fn run_due_algorithms(&mut self, runtime: &dyn DataflowRuntime) {
         for node_index in 0..self.schedules_by_owner.len() {
             if !runtime.node_online(node_index as u32) {
@@ -10,6 +10,7 @@ pub mod runtime;
 pub mod scalar;
 pub mod scalar_source;
 pub mod scheduler;
+pub mod trace;
 
 pub mod model;
 
@@ -27,7 +28,10 @@ pub use interfaces::{
     InterfaceCaller, InterfaceDataflow, InterfaceEndpoint, InterfaceImplementation,
 };
 pub use model::{ModelRuntime, NodeModel, NodeTarget};
-pub use node::{RigNode, RigNodeResetFn, RigNodeRunForFn, RigNodeScheduler, RigPythonScheduledFn};
+pub use node::{
+    RigNode, RigNodeNextWakeFn, RigNodeResetFn, RigNodeRunForFn, RigNodeScheduler,
+    RigPythonScheduledFn,
+};
 pub use rig::{Rig, RigElement};
 pub use runtime::{NoBackend, RigBackend, RigRuntime};
 pub use scalar::{
@@ -35,6 +39,7 @@ pub use scalar::{
     ScalarSendManyFn, ScalarSink, ScalarSinkSetFn,
 };
 pub use scheduler::{RigScheduler, SchedulerCallbackContext};
+pub use trace::{RigTraceSampleFn, RigTraceView, TraceRecorder, TraceSource};
 
 #[cfg(test)]
 mod tests {
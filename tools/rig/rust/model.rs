@@ -11,6 +11,12 @@ pub trait ModelRuntime {
     unsafe fn reset_scheduler(&mut self);
 
     unsafe fn run_for_ns(&mut self, elapsed_ns: u64);
+
+    /// Nanoseconds until the model next has scheduled work if no input
+    /// arrives. Zero, the default, asks to be stepped on every tick.
+    fn next_wake_ns(&self) -> u64 {
+        0
+    }
 }
 
 pub trait NodeTarget<Runtime: ModelRuntime> {
@@ -56,6 +62,10 @@ where
         unsafe { self.controller.run_for_ns(elapsed_ns) };
     }
 
+    pub fn next_wake_ns(&self) -> u64 {
+        self.controller.next_wake_ns()
+    }
+
     pub fn controller(&mut self) -> &mut Runtime {
         &mut self.controller
     }
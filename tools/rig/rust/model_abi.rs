@@ -21,6 +21,11 @@ macro_rules! rig_model_abi {
             }
         }
 
+        #[unsafe(no_mangle)]
+        pub extern "C" fn rig_model_next_wake_ns() -> u64 {
+            $model.lock().unwrap().next_wake_ns()
+        }
+
         #[unsafe(no_mangle)]
         pub extern "C" fn rig_model_datapath_count() -> u32 {
             let mut model = $model.lock().unwrap();
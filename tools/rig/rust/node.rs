@@ -1,7 +1,13 @@
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Condvar, Mutex};
+use std::thread::{self, JoinHandle};
+
 use super::scheduler::SchedulerCallbackContext;
 
 pub type RigNodeRunForFn = unsafe extern "C" fn(u64);
 pub type RigNodeResetFn = unsafe extern "C" fn();
+/// Nanoseconds until the node next has scheduled work if no input arrives.
+pub type RigNodeNextWakeFn = unsafe extern "C" fn() -> u64;
 pub type RigPythonScheduledFn = unsafe extern "C" fn(*const SchedulerCallbackContext);
 
 #[derive(Clone, Copy)]
@@ -9,6 +15,7 @@ pub enum RigNodeScheduler {
     RustRuntimeModel,
     External {
         run_for: RigNodeRunForFn,
+        next_wake: Option<RigNodeNextWakeFn>,
     },
     Python {
         scheduled: Option<RigPythonScheduledFn>,
@@ -28,7 +35,10 @@ pub struct RigNode {
 impl RigNode {
     pub(super) fn external(run_for: RigNodeRunForFn, reset: RigNodeResetFn, online: bool) -> Self {
         Self {
-            scheduler: RigNodeScheduler::External { run_for },
+            scheduler: RigNodeScheduler::External {
+                run_for,
+                next_wake: None,
+            },
             reset: Some(reset),
             online,
             elapsed_ns: 0,
@@ -87,6 +97,37 @@ impl RigNode {
         )
     }
 
+    pub(super) fn external_run_for(&self) -> Option<RigNodeRunForFn> {
+        match self.scheduler {
+            RigNodeScheduler::External { run_for, .. } => Some(run_for),
+            _ => None,
+        }
+    }
+
+    pub(super) fn set_next_wake(&mut self, wake: RigNodeNextWakeFn) -> bool {
+        let RigNodeScheduler::External { next_wake, .. } = &mut self.scheduler else {
+            return false;
+        };
+        *next_wake = Some(wake);
+        true
+    }
+
+    /// Nanoseconds until this node must be stepped again. External nodes
+    /// that cannot report it are stepped every tick; other nodes are driven
+    /// by their dataflow algorithms.
+    pub(super) fn next_wake_ns(&self) -> u64 {
+        match self.scheduler {
+            RigNodeScheduler::External {
+                next_wake: Some(next_wake),
+                ..
+            } => unsafe { next_wake() },
+            RigNodeScheduler::External {
+                next_wake: None, ..
+            } => 0,
+            RigNodeScheduler::RustRuntimeModel | RigNodeScheduler::Python { .. } => u64::MAX,
+        }
+    }
+
     pub(super) fn run_for(&mut self, delta_ns: u64) {
         match self.scheduler {
             RigNodeScheduler::RustRuntimeModel => {}
@@ -137,3 +178,154 @@ impl RigNode {
         )
     }
 }
+
+/// One step of external nodes shared with the stepper threads.
+struct StepJob {
+    run_for: Vec<RigNodeRunForFn>,
+    delta_ns: u64,
+    next: AtomicUsize,
+    remaining: AtomicUsize,
+}
+
+impl StepJob {
+    /// Claim and run nodes until none are left. Returns true if this call
+    /// finished the last node.
+    fn run(&self) -> bool {
+        let mut finished_last = false;
+        loop {
+            let index = self.next.fetch_add(1, Ordering::Relaxed);
+            let Some(run_for) = self.run_for.get(index) else {
+                return finished_last;
+            };
+            unsafe { run_for(self.delta_ns) };
+            finished_last = self.remaining.fetch_sub(1, Ordering::AcqRel) == 1;
+        }
+    }
+}
+
+#[derive(Default)]
+struct StepperState {
+    job: Option<Arc<StepJob>>,
+    generation: u64,
+    done_generation: u64,
+    shutdown: bool,
+}
+
+#[derive(Default)]
+struct StepperShared {
+    state: Mutex<StepperState>,
+    start: Condvar,
+    done: Condvar,
+}
+
+/// Steps external nodes on a fixed pool of threads.
+///
+/// Every external node is backed by its own shared library, so between
+/// dataflow propagation points the nodes share no state and may run in any
+/// order. Threads claim nodes from a shared counter, so a slow node does not
+/// hold back the others. All node-visible effects are collected by the
+/// dataflow graph after the step, in node order, so results do not depend
+/// on the number of threads.
+pub struct RigNodeStepper {
+    shared: Arc<StepperShared>,
+    workers: Vec<JoinHandle<()>>,
+}
+
+impl RigNodeStepper {
+    /// A stepper that runs nodes on `threads` threads, counting the caller.
+    pub(super) fn new(threads: usize) -> Self {
+        let shared = Arc::new(StepperShared::default());
+        let workers = (1..threads.max(1))
+            .map(|index| {
+                let shared = Arc::clone(&shared);
+                thread::Builder::new()
+                    .name(format!("rig-step-{index}"))
+                    .spawn(move || Self::worker(&shared))
+                    .expect("failed to spawn Rig stepper thread")
+            })
+            .collect();
+        Self { shared, workers }
+    }
+
+    pub(super) fn threads(&self) -> usize {
+        self.workers.len() + 1
+    }
+
+    fn worker(shared: &StepperShared) {
+        let mut seen_generation = 0;
+        loop {
+            let job = {
+                let mut state = shared.state.lock().unwrap();
+                while !state.shutdown && state.generation == seen_generation {
+                    state = shared.start.wait(state).unwrap();
+                }
+                if state.shutdown {
+                    return;
+                }
+                seen_generation = state.generation;
+                state.job.clone()
+            };
+            let Some(job) = job else {
+                continue;
+            };
+            if job.run() {
+                let mut state = shared.state.lock().unwrap();
+                state.done_generation = seen_generation;
+                shared.done.notify_all();
+            }
+        }
+    }
+
+    /// Run every online external node in `nodes` for `delta_ns` and return
+    /// once all of them have finished.
+    pub(super) fn run_for(&self, nodes: &mut [RigNode], delta_ns: u64) {
+        let run_for: Vec<RigNodeRunForFn> = nodes
+            .iter()
+            .filter(|node| node.online)
+            .filter_map(RigNode::external_run_for)
+            .collect();
+        if run_for.len() > 1 && !self.workers.is_empty() {
+            let job = Arc::new(StepJob {
+                remaining: AtomicUsize::new(run_for.len()),
+                run_for,
+                delta_ns,
+                next: AtomicUsize::new(0),
+            });
+            let generation = {
+                let mut state = self.shared.state.lock().unwrap();
+                state.generation += 1;
+                state.job = Some(Arc::clone(&job));
+                self.shared.start.notify_all();
+                state.generation
+            };
+            if !job.run() {
+                let mut state = self.shared.state.lock().unwrap();
+                while state.done_generation != generation {
+                    state = self.shared.done.wait(state).unwrap();
+                }
+            }
+            self.shared.state.lock().unwrap().job = None;
+        } else {
+            for run_for in run_for {
+                unsafe { run_for(delta_ns) };
+            }
+        }
+
+        for node in nodes
+            .iter_mut()
+            .filter(|node| node.online && node.needs_run_step())
+        {
+            node.elapsed_ns = node.elapsed_ns.saturating_add(delta_ns);
+        }
+    }
+}
+
+impl Drop for RigNodeStepper {
+    fn drop(&mut self) {
+        self.shared.state.lock().unwrap().shutdown = true;
+        self.shared.start.notify_all();
+        for worker in self.workers.drain(..) {
+            let _ = worker.join();
+        }
+    }
+}
@@ -8,13 +8,15 @@
 use super::algorithms::{self, RuntimeAlgorithms};
 use super::dataflow::{DataflowAlgorithm, DataflowEdgeKey, DataflowRuntime, DataflowWait};
 use super::node::{
-    RigNode, RigNodeResetFn, RigNodeRunForFn, RigNodeScheduler, RigPythonScheduledFn,
+    RigNode, RigNodeNextWakeFn, RigNodeResetFn, RigNodeRunForFn, RigNodeScheduler, RigNodeStepper,
+    RigPythonScheduledFn,
 };
 use super::scalar::{
     self, ScalarCountFn, ScalarEvent, ScalarInterface, ScalarRecvManyFn, ScalarRoute, ScalarSink,
     ScalarSinkSetFn,
 };
 use super::scheduler::{self, RigScheduler};
+use super::trace::{RigTraceView, TraceRecorder, TraceSource};
 
 // Keep this re-export available to the test module when this file is included
 // by a firmware runtime module as well as when it is compiled standalone.
@@ -34,6 +36,10 @@ pub trait RigBackend: Default {
     fn cancel_dataflow_wait(&mut self, _wait: DataflowWait) {}
     fn append_algorithm_specs(&self, _specs: &mut Vec<DataflowAlgorithm>) {}
     fn scalar_state_ready(&mut self, _node: u32, _route_id: u32, _value: f32) {}
+    /// Read a trace channel registered with `TraceSource::Backend`.
+    fn sample_trace(&self, _key: u64) -> f64 {
+        f64::NAN
+    }
     fn scalar_interface(&self) -> &ScalarInterface;
     fn scalar_interface_mut(&mut self) -> &mut ScalarInterface;
 }
@@ -60,6 +66,11 @@ pub struct RigRuntime<B: RigBackend = NoBackend> {
     pub(crate) scheduler: RigScheduler,
     pub(crate) backend: B,
     pub(crate) elapsed_ns: u64,
+    /// Set when external nodes are stepped on more than one thread.
+    pub(crate) stepper: Option<RigNodeStepper>,
+    /// Set when idle scheduler steps are skipped.
+    pub(crate) next_event: bool,
+    pub(crate) trace: TraceRecorder,
 }
 
 impl<B: RigBackend + 'static> std::ops::Deref for RigRuntime<B> {
@@ -90,6 +101,9 @@ impl<B: RigBackend + 'static> RigRuntime<B> {
             scheduler: RigScheduler::default(),
             backend,
             elapsed_ns: 0,
+            stepper: None,
+            next_event: false,
+            trace: TraceRecorder::default(),
         }
     }
 
@@ -107,6 +121,38 @@ impl<B: RigBackend + 'static> RigRuntime<B> {
         self.scheduler.reset();
         self.backend.reset();
         self.elapsed_ns = 0;
+        self.trace = TraceRecorder::default();
+    }
+
+    /// Step external nodes on `threads` threads. One thread, the default,
+    /// steps them in node order on the caller's thread. Survives `reset()`.
+    pub fn set_step_threads(&mut self, threads: usize) {
+        if self.step_threads() == threads.max(1) {
+            return;
+        }
+        self.stepper = (threads > 1).then(|| RigNodeStepper::new(threads));
+    }
+
+    pub fn step_threads(&self) -> usize {
+        self.stepper.as_ref().map_or(1, RigNodeStepper::threads)
+    }
+
+    /// Advance straight to the next step in which a node or algorithm is due
+    /// instead of visiting every `max_step_ns` in between. Steps that do run
+    /// stay on the same grid, so traces match fixed stepping as long as every
+    /// external node reports its next wake. Survives `reset()`.
+    pub fn set_next_event(&mut self, enabled: bool) {
+        self.next_event = enabled;
+    }
+
+    pub fn next_event(&self) -> bool {
+        self.next_event
+    }
+
+    pub fn set_node_next_wake(&mut self, node: u32, next_wake: RigNodeNextWakeFn) -> bool {
+        self.nodes
+            .get_mut(node as usize)
+            .is_some_and(|node| node.set_next_wake(next_wake))
     }
 
     pub fn add_node(
@@ -205,6 +251,25 @@ impl<B: RigBackend + 'static> RigRuntime<B> {
         advanced_ns
     }
 
+    /// Record every trace channel each `period_ns` of simulated time into
+    /// buffers of `capacity` samples. Drops the channels of any previous
+    /// recording; a zero period stops recording.
+    pub fn configure_trace(&mut self, period_ns: u64, capacity: usize) {
+        self.trace.configure(period_ns, capacity, self.elapsed_ns);
+    }
+
+    pub fn add_trace_channel(&mut self, source: TraceSource) -> Option<u32> {
+        self.trace.add_channel(source)
+    }
+
+    pub fn clear_trace(&mut self) {
+        self.trace.clear(self.elapsed_ns);
+    }
+
+    pub fn trace_view(&self) -> RigTraceView {
+        self.trace.view()
+    }
+
     pub fn elapsed_ns(&self) -> u64 {
         self.elapsed_ns
     }
@@ -457,6 +522,10 @@ impl<B: RigBackend + 'static> DataflowRuntime for RigRuntime<B> {
     }
 
     fn run_external_nodes(&mut self, delta_ns: u64) {
+        if let Some(stepper) = &self.stepper {
+            stepper.run_for(&mut self.nodes, delta_ns);
+            return;
+        }
         for node in self
             .nodes
             .iter_mut()
@@ -466,6 +535,22 @@ impl<B: RigBackend + 'static> DataflowRuntime for RigRuntime<B> {
         }
     }
 
+    fn next_event_enabled(&self) -> bool {
+        self.next_event
+    }
+
+    fn next_node_wake_ns(&self) -> u64 {
+        // A due trace sample ends a merged step like a node wake does, so
+        // next-event runs sample at the same instants as fixed stepping.
+        self.nodes
+            .iter()
+            .filter(|node| node.online)
+            .map(RigNode::next_wake_ns)
+            .min()
+            .unwrap_or(u64::MAX)
+            .min(self.trace.next_due_delay_ns(self.elapsed_ns))
+    }
+
     fn advance_time(&mut self, delta_ns: u64) {
         self.elapsed_ns = self.elapsed_ns.saturating_add(delta_ns);
     }
@@ -474,6 +559,24 @@ impl<B: RigBackend + 'static> DataflowRuntime for RigRuntime<B> {
         self.elapsed_ns
     }
 
+    fn record_trace(&mut self) {
+        if !self.trace.is_due(self.elapsed_ns) {
+            return;
+        }
+        let mut trace = std::mem::take(&mut self.trace);
+        trace.record(self.elapsed_ns, |source| match source {
+            TraceSource::Sampler { sample, context } => unsafe { sample(context) },
+            TraceSource::Scalar {
+                source_node,
+                route_id,
+            } => self
+                .latest_scalar_event(source_node, route_id)
+                .map_or(f64::NAN, |event| f64::from(event.value)),
+            TraceSource::Backend { key } => self.backend.sample_trace(key),
+        });
+        self.trace = trace;
+    }
+
     fn python_period_ns(&self, node: u32) -> Option<u64> {
         self.nodes
             .get(node as usize)
@@ -626,6 +729,226 @@ mod tests {
         ));
     }
 
+    // Each replay node stands in for a firmware library with its own globals.
+    macro_rules! replay_node {
+        ($name:ident, $reset:ident, $seed:expr) => {
+            mod $name {
+                use std::sync::Mutex;
+
+                pub static STATE: Mutex<(u64, Vec<u64>)> = Mutex::new(($seed, Vec::new()));
+
+                pub unsafe extern "C" fn run_for(delta_ns: u64) {
+                    let mut state = STATE.lock().unwrap();
+                    let (value, outbox) = &mut *state;
+                    // Uneven work so that threads finish in varying order
+                    for _ in 0..(*value % 2000) {
+                        *value = value.rotate_left(5) ^ delta_ns.wrapping_mul($seed);
+                    }
+                    *value = value
+                        .wrapping_mul(0x9e37_79b9_7f4a_7c15)
+                        .wrapping_add(delta_ns);
+                    if *value % 3 == 0 {
+                        outbox.push(*value);
+                    }
+                }
+
+                pub unsafe extern "C" fn $reset() {
+                    *STATE.lock().unwrap() = ($seed, Vec::new());
+                }
+            }
+        };
+    }
+
+    replay_node!(replay_a, reset, 1);
+    replay_node!(replay_b, reset, 2);
+    replay_node!(replay_c, reset, 3);
+    replay_node!(replay_d, reset, 4);
+    replay_node!(replay_e, reset, 5);
+
+    fn replay_hash(threads: usize) -> u64 {
+        let nodes: [(
+            RigNodeRunForFn,
+            RigNodeResetFn,
+            &std::sync::Mutex<(u64, Vec<u64>)>,
+        ); 5] = [
+            (replay_a::run_for, replay_a::reset, &replay_a::STATE),
+            (replay_b::run_for, replay_b::reset, &replay_b::STATE),
+            (replay_c::run_for, replay_c::reset, &replay_c::STATE),
+            (replay_d::run_for, replay_d::reset, &replay_d::STATE),
+            (replay_e::run_for, replay_e::reset, &replay_e::STATE),
+        ];
+        let mut runtime = RigRuntime::<NoBackend>::default();
+        runtime.set_step_threads(threads);
+        for (run_for, reset, _) in nodes {
+            unsafe { reset() };
+            runtime.add_node(run_for, reset, true);
+        }
+        runtime.set_node_online(3, false);
+
+        let mut hash = 0xcbf2_9ce4_8422_2325_u64;
+        let mut fold = |value: u64| hash = (hash ^ value).wrapping_mul(0x0100_0000_01b3);
+        for step in 0..200 {
+            if step == 100 {
+                runtime.set_node_online(3, true);
+            }
+            assert_eq!(runtime.run_for_ns(1_000_000, 1_000_000), 1_000_000);
+            for (index, (_, _, state)) in nodes.iter().enumerate() {
+                let mut state = state.lock().unwrap();
+                fold(index as u64);
+                fold(state.0);
+                for event in state.1.drain(..) {
+                    fold(event);
+                }
+                fold(runtime.node_elapsed_ns(index as u32));
+            }
+        }
+        hash
+    }
+
+    #[test]
+    fn parallel_stepping_replays_the_sequential_trace() {
+        let sequential = replay_hash(1);
+        for threads in [2, 3, 8] {
+            assert_eq!(replay_hash(threads), sequential, "{threads} step threads");
+        }
+    }
+
+    // A ticker node stands in for firmware with one periodic task.
+    macro_rules! ticker_node {
+        ($name:ident, $period_ns:expr) => {
+            mod $name {
+                use std::sync::Mutex;
+
+                // (remainder, steps, task run times)
+                pub static STATE: Mutex<(u64, u64, Vec<u64>)> = Mutex::new((0, 0, Vec::new()));
+                pub static ELAPSED: Mutex<u64> = Mutex::new(0);
+
+                pub unsafe extern "C" fn run_for(delta_ns: u64) {
+                    let mut state = STATE.lock().unwrap();
+                    let mut elapsed = ELAPSED.lock().unwrap();
+                    *elapsed += delta_ns;
+                    state.0 += delta_ns;
+                    state.1 += 1;
+                    if state.0 >= $period_ns {
+                        state.0 %= $period_ns;
+                        state.2.push(*elapsed);
+                    }
+                }
+
+                #[allow(dead_code)]
+                pub unsafe extern "C" fn next_wake() -> u64 {
+                    $period_ns - STATE.lock().unwrap().0
+                }
+
+                pub unsafe extern "C" fn reset() {
+                    *STATE.lock().unwrap() = (0, 0, Vec::new());
+                    *ELAPSED.lock().unwrap() = 0;
+                }
+            }
+        };
+    }
+
+    ticker_node!(ticker_fast, 1_000_000);
+    ticker_node!(ticker_slow, 3_250_000);
+    ticker_node!(ticker_untracked, 1_000_000);
+    ticker_node!(ticker_traced, 1_000_000);
+
+    fn ticker_trace(next_event: bool) -> (Vec<Vec<u64>>, u64) {
+        let nodes: [(RigNodeRunForFn, RigNodeNextWakeFn, RigNodeResetFn); 2] = [
+            (
+                ticker_fast::run_for,
+                ticker_fast::next_wake,
+                ticker_fast::reset,
+            ),
+            (
+                ticker_slow::run_for,
+                ticker_slow::next_wake,
+                ticker_slow::reset,
+            ),
+        ];
+        let mut runtime = RigRuntime::<NoBackend>::default();
+        runtime.set_next_event(next_event);
+        for (run_for, next_wake, reset) in nodes {
+            unsafe { reset() };
+            let node = runtime.add_node(run_for, reset, true);
+            assert!(runtime.set_node_next_wake(node, next_wake));
+        }
+        for _ in 0..10 {
+            assert_eq!(runtime.run_for_ns(7_000_000, 100_000), 7_000_000);
+        }
+        assert_eq!(runtime.elapsed_ns(), 70_000_000);
+        let fast = ticker_fast::STATE.lock().unwrap().clone();
+        let slow = ticker_slow::STATE.lock().unwrap().clone();
+        (vec![fast.2, slow.2], fast.1)
+    }
+
+    #[test]
+    fn next_event_stepping_replays_the_fixed_step_trace() {
+        let (fixed, fixed_steps) = ticker_trace(false);
+        let (next_event, next_event_steps) = ticker_trace(true);
+        assert_eq!(fixed[0].len(), 70);
+        assert_eq!(fixed[1].len(), 21);
+        assert_eq!(next_event, fixed);
+        assert_eq!(fixed_steps, 700);
+        assert!(next_event_steps < 100, "{next_event_steps} steps");
+    }
+
+    #[test]
+    fn next_event_steps_every_tick_for_nodes_without_a_wake_callback() {
+        let mut runtime = RigRuntime::<NoBackend>::default();
+        runtime.set_next_event(true);
+        unsafe { ticker_untracked::reset() };
+        runtime.add_node(ticker_untracked::run_for, ticker_untracked::reset, true);
+
+        assert_eq!(scheduler::run_next_step(&mut runtime, 10, 3), 3);
+        assert_eq!(runtime.elapsed_ns(), 3);
+    }
+
+    unsafe extern "C" fn traced_ticks(_context: u64) -> f64 {
+        ticker_traced::STATE.lock().unwrap().2.len() as f64
+    }
+
+    #[test]
+    fn trace_samples_each_period_in_fixed_and_next_event_runs() {
+        let traces = [false, true].map(|next_event| {
+            let mut runtime = RigRuntime::<NoBackend>::default();
+            runtime.set_next_event(next_event);
+            unsafe { ticker_traced::reset() };
+            let node = runtime.add_node(ticker_traced::run_for, ticker_traced::reset, true);
+            assert!(runtime.set_node_next_wake(node, ticker_traced::next_wake));
+            // The first sample is due at once and lands at the end of the first step.
+            runtime.configure_trace(2_500_000, 5);
+            let channel = runtime.add_trace_channel(TraceSource::Sampler {
+                sample: traced_ticks,
+                context: 0,
+            });
+            assert_eq!(channel, Some(0));
+            assert_eq!(
+                runtime.add_trace_channel(TraceSource::Backend { key: 7 }),
+                Some(1)
+            );
+
+            runtime.run_for_ns(10_000_000, 100_000);
+
+            let view = runtime.trace_view();
+            assert_eq!((view.channel_count, view.len, view.dropped), (2, 5, 0));
+            let len = view.len as usize;
+            let columns = unsafe { std::slice::from_raw_parts(view.columns, 2) };
+            let time_ns = unsafe { std::slice::from_raw_parts(view.time_ns, len) }.to_vec();
+            let ticks = unsafe { std::slice::from_raw_parts(columns[0], len) }.to_vec();
+            let backend = unsafe { std::slice::from_raw_parts(columns[1], len) };
+            assert!(backend.iter().all(|value| value.is_nan()));
+            (time_ns, ticks)
+        });
+
+        assert_eq!(traces[0], traces[1]);
+        assert_eq!(
+            traces[0].0,
+            [100_000, 2_500_000, 5_000_000, 7_500_000, 10_000_000]
+        );
+        assert_eq!(traces[0].1, [0.0, 2.0, 5.0, 7.0, 10.0]);
+    }
+
     #[test]
     fn canceling_a_wait_notifies_the_backend_lifecycle_hook() {
         let mut runtime = RigRuntime::<TestBackend>::default();
@@ -271,7 +271,7 @@ pub(super) fn run_next_step(
 
     ensure_dataflow_graph(runtime);
 
-    let delta_ns = remaining_ns.min(max_step_ns);
+    let delta_ns = remaining_ns.min(next_step_ns(runtime, max_step_ns));
     if delta_ns == 0 {
         return 0;
     }
@@ -279,9 +279,33 @@ pub(super) fn run_next_step(
     runtime.run_external_nodes(delta_ns);
     runtime.advance_time(delta_ns);
     run_dataflow_graph(runtime);
+    runtime.record_trace();
     delta_ns
 }
 
+/// Step size for the next scheduler step. In next-event mode, steps in which
+/// no node or algorithm would be due are merged into one step of a whole
+/// number of `max_step_ns`, so the run visits the same instants as fixed
+/// stepping would whenever something actually happens.
+fn next_step_ns(runtime: &dyn DataflowRuntime, max_step_ns: u64) -> u64 {
+    if !runtime.next_event_enabled() {
+        return max_step_ns;
+    }
+    let scheduler = runtime.scheduler();
+    if !scheduler.deferred_ready_edges.is_empty()
+        || !scheduler.deferred_input_pending_nodes.is_empty()
+    {
+        return max_step_ns;
+    }
+    let wake_ns = runtime
+        .next_node_wake_ns()
+        .min(scheduler.graph.next_due_delay_ns(runtime));
+    wake_ns
+        .div_ceil(max_step_ns)
+        .max(1)
+        .saturating_mul(max_step_ns)
+}
+
 pub(super) fn mark_dataflow_edge_ready(runtime: &mut dyn DataflowRuntime, key: DataflowEdgeKey) {
     ensure_dataflow_graph(runtime);
     if runtime.scheduler().graph.algorithms.is_empty() {
@@ -0,0 +1,223 @@
+// Columnar trace recording owned by Rig.
+//
+// The recorder samples a fixed set of channels at a fixed simulation period
+// into buffers allocated up front, so a long run records without allocating
+// and observers can read the columns in place. What a channel reads is
+// decided by its source: a sampler exported by a node library, the latest
+// value of a scalar edge, or a key only the backend understands.
+
+use std::ptr;
+
+/// Reads one traced value. `context` is the value registered with the channel.
+pub type RigTraceSampleFn = unsafe extern "C" fn(context: u64) -> f64;
+
+#[derive(Clone, Copy)]
+pub enum TraceSource {
+    Sampler {
+        sample: RigTraceSampleFn,
+        context: u64,
+    },
+    Scalar {
+        source_node: u32,
+        route_id: u32,
+    },
+    Backend {
+        key: u64,
+    },
+}
+
+/// In-place view of the recorded columns. Pointers stay valid until the
+/// recorder is configured again or the runtime is reset.
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct RigTraceView {
+    pub time_ns: *const u64,
+    /// One pointer per channel, each to `capacity` values.
+    pub columns: *const *const f64,
+    pub channel_count: u32,
+    pub len: u32,
+    pub capacity: u32,
+    /// Samples that were due after the buffers filled up.
+    pub dropped: u64,
+}
+
+impl Default for RigTraceView {
+    fn default() -> Self {
+        Self {
+            time_ns: ptr::null(),
+            columns: ptr::null(),
+            channel_count: 0,
+            len: 0,
+            capacity: 0,
+            dropped: 0,
+        }
+    }
+}
+
+/// Samples every channel once per `period_ns` of simulated time.
+///
+/// A sample is taken at the end of the first step that reaches its due time
+/// and is stamped with the time actually reached. Columns are allocated for
+/// `capacity` samples when the channel is added; samples due after that are
+/// counted as dropped rather than growing the buffers.
+#[derive(Default)]
+pub struct TraceRecorder {
+    period_ns: u64,
+    next_sample_ns: u64,
+    capacity: usize,
+    sources: Vec<TraceSource>,
+    time_ns: Box<[u64]>,
+    columns: Vec<Box<[f64]>>,
+    column_ptrs: Vec<*const f64>,
+    len: usize,
+    dropped: u64,
+}
+
+// The raw column pointers only ever point into `columns`, which the recorder
+// owns, so moving it to another thread moves them together.
+unsafe impl Send for TraceRecorder {}
+
+impl TraceRecorder {
+    /// Start a new recording. Channels and samples of any previous recording
+    /// are dropped; a zero period or capacity disables recording.
+    pub fn configure(&mut self, period_ns: u64, capacity: usize, elapsed_ns: u64) {
+        let capacity = if period_ns == 0 { 0 } else { capacity };
+        *self = Self {
+            period_ns,
+            next_sample_ns: elapsed_ns,
+            capacity,
+            time_ns: vec![0; capacity].into_boxed_slice(),
+            ..Self::default()
+        };
+    }
+
+    pub fn is_enabled(&self) -> bool {
+        self.capacity > 0
+    }
+
+    /// Add a channel and return its column index. Samples recorded before the
+    /// channel existed read as NaN.
+    pub fn add_channel(&mut self, source: TraceSource) -> Option<u32> {
+        if !self.is_enabled() {
+            return None;
+        }
+        let mut column = vec![f64::NAN; self.capacity].into_boxed_slice();
+        self.column_ptrs.push(column.as_mut_ptr());
+        self.columns.push(column);
+        self.sources.push(source);
+        Some((self.sources.len() - 1) as u32)
+    }
+
+    /// Drop the recorded samples but keep the channels.
+    pub fn clear(&mut self, elapsed_ns: u64) {
+        self.len = 0;
+        self.dropped = 0;
+        self.next_sample_ns = elapsed_ns;
+    }
+
+    pub fn is_due(&self, elapsed_ns: u64) -> bool {
+        self.is_enabled() && !self.sources.is_empty() && elapsed_ns >= self.next_sample_ns
+    }
+
+    /// Simulated time until the next sample is due, or `u64::MAX` if none is.
+    pub fn next_due_delay_ns(&self, elapsed_ns: u64) -> u64 {
+        if !self.is_enabled() || self.sources.is_empty() {
+            return u64::MAX;
+        }
+        self.next_sample_ns.saturating_sub(elapsed_ns)
+    }
+
+    /// Record one sample of every channel if one is due.
+    pub fn record(&mut self, elapsed_ns: u64, mut sample: impl FnMut(TraceSource) -> f64) {
+        if !self.is_due(elapsed_ns) {
+            return;
+        }
+        self.next_sample_ns = (elapsed_ns / self.period_ns + 1) * self.period_ns;
+        if self.len == self.capacity {
+            self.dropped += 1;
+            return;
+        }
+        self.time_ns[self.len] = elapsed_ns;
+        for (column, source) in self.columns.iter_mut().zip(&self.sources) {
+            column[self.len] = sample(*source);
+        }
+        self.len += 1;
+    }
+
+    pub fn view(&self) -> RigTraceView {
+        RigTraceView {
+            time_ns: self.time_ns.as_ptr(),
+            columns: self.column_ptrs.as_ptr(),
+            channel_count: self.sources.len() as u32,
+            len: self.len as u32,
+            capacity: self.capacity as u32,
+            dropped: self.dropped,
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn column(recorder: &TraceRecorder, channel: usize) -> &[f64] {
+        &recorder.columns[channel][..recorder.len]
+    }
+
+    #[test]
+    fn samples_once_per_period_at_the_time_reached() {
+        let mut recorder = TraceRecorder::default();
+        recorder.configure(10, 8, 0);
+        recorder
+            .add_channel(TraceSource::Backend { key: 0 })
+            .unwrap();
+
+        for elapsed_ns in [4, 10, 12, 19, 35, 40] {
+            recorder.record(elapsed_ns, |_| elapsed_ns as f64 / 2.0);
+        }
+
+        assert_eq!(&recorder.time_ns[..recorder.len], &[4, 10, 35, 40]);
+        assert_eq!(column(&recorder, 0), &[2.0, 5.0, 17.5, 20.0]);
+        assert_eq!(recorder.next_due_delay_ns(40), 10);
+    }
+
+    #[test]
+    fn full_buffers_drop_samples_and_late_channels_start_as_nan() {
+        let mut recorder = TraceRecorder::default();
+        recorder.configure(1, 2, 0);
+        recorder
+            .add_channel(TraceSource::Backend { key: 0 })
+            .unwrap();
+        recorder.record(0, |_| 1.0);
+        recorder
+            .add_channel(TraceSource::Backend { key: 1 })
+            .unwrap();
+        recorder.record(1, |source| match source {
+            TraceSource::Backend { key } => key as f64,
+            _ => unreachable!(),
+        });
+        recorder.record(2, |_| 3.0);
+
+        let view = recorder.view();
+        assert_eq!((view.channel_count, view.len, view.dropped), (2, 2, 1));
+        assert_eq!(column(&recorder, 0), &[1.0, 0.0]);
+        assert!(column(&recorder, 1)[0].is_nan());
+        assert_eq!(column(&recorder, 1)[1], 1.0);
+
+        recorder.clear(5);
+        assert_eq!(recorder.view().len, 0);
+        assert!(recorder.is_due(5));
+    }
+
+    #[test]
+    fn zero_period_disables_recording() {
+        let mut recorder = TraceRecorder::default();
+        recorder.configure(0, 8, 0);
+        assert!(
+            recorder
+                .add_channel(TraceSource::Backend { key: 0 })
+                .is_none()
+        );
+        assert_eq!(recorder.next_due_delay_ns(0), u64::MAX);
+    }
+}
@@ -12,9 +12,10 @@ pub use rust_decode_generated::{forward_route_for_bus, forward_route_for_pair, f
 pub use rust_model_generated::{AnyMessage, Bus};
 pub use yamcan::{
     bus_descriptor_for, BusBinding, BusDescriptor, BusInterfaceType, BusRouter, CanData,
-    CanFrame, DecodedCanMessage, DecodedMessage, ForwardMessage, ForwardPolicy, ForwardRoute,
-    MessageDecodeResult, MessageDescriptor, MessageMetadata, NetworkBus, ReceivedCanMessage,
-    SignalAccessor, SignalDescriptor, SignalKind, SignalMeasurement, UnhandledMessage,
+    CanFrame, DecodedCanMessage, DecodedMessage, EnumValueDescriptor, ForwardMessage,
+    ForwardPolicy, ForwardRoute, MessageDecodeResult, MessageDescriptor, MessageMetadata,
+    NetworkBus, ReceivedCanMessage, SignalAccessor, SignalDescriptor, SignalKind,
+    SignalMeasurement, UnhandledMessage,
 };
 
 pub type YamcanRouter = BusRouter<rust_decode_generated::GeneratedNetwork>;
@@ -82,3 +83,7 @@ pub fn message_descriptors() -> &'static [MessageDescriptor<Bus>] {
 pub fn signal_descriptors() -> &'static [SignalDescriptor<Bus>] {
     rust_model_generated::signal_descriptors()
 }
+
+pub fn enum_value_descriptors() -> &'static [EnumValueDescriptor] {
+    rust_model_generated::enum_value_descriptors()
+}